@@ -0,0 +1,110 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++ includes
+#include <iostream>
+#include <mutex>
+#include <string>
+
+/**
+ * @file log_sink.hpp
+ * @brief Declares the logging interface used by the ROS-free protocol core
+ * @date 19/10/26
+ */
+
+/**
+ * @brief Log level
+ */
+enum LogLevel
+{
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR,
+    FATAL
+};
+
+/**
+ * @class LogSink
+ * @brief Receives the log output of the framer and the SBF and NMEA parsers
+ *
+ * The ROS node forwards to rosconsole, other users of the protocol core may
+ * provide their own sink.
+ */
+class LogSink
+{
+public:
+    virtual ~LogSink() {}
+
+    /**
+     * @brief Log function
+     * @param[in] logLevel Log level
+     * @param[in] s String to log
+     */
+    virtual void log(LogLevel logLevel, const std::string& s) = 0;
+};
+
+/**
+ * @class StreamLogSink
+ * @brief Writes log output with at least a given level to a stream
+ */
+class StreamLogSink : public LogSink
+{
+public:
+    /**
+     * @param[in] os Stream to write to, has to outlive the sink
+     * @param[in] min_level Messages below this level are discarded
+     */
+    explicit StreamLogSink(std::ostream& os = std::cerr,
+                           LogLevel min_level = LogLevel::INFO) :
+        os_(os), min_level_(min_level)
+    {
+    }
+
+    void log(LogLevel logLevel, const std::string& s) override
+    {
+        if (logLevel < min_level_)
+            return;
+        static const char* const prefixes[] = {"[DEBUG] ", "[INFO] ", "[WARN] ",
+                                               "[ERROR] ", "[FATAL] "};
+        std::lock_guard<std::mutex> lock(mutex_);
+        os_ << prefixes[logLevel] << s << std::endl;
+    }
+
+private:
+    //! Stream to write to
+    std::ostream& os_;
+    //! Minimum level to be written
+    LogLevel min_level_;
+    //! Serializes concurrent writes
+    std::mutex mutex_;
+};
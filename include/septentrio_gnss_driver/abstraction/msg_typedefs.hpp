@@ -0,0 +1,155 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// ROS time, as used in the message headers
+#include <ros/time.h>
+// Timestamp in nanoseconds
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+// ROS msg includes
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <diagnostic_msgs/DiagnosticStatus.h>
+#include <geometry_msgs/PoseWithCovarianceStamped.h>
+#include <geometry_msgs/Quaternion.h>
+#include <geometry_msgs/TwistWithCovarianceStamped.h>
+#include <gps_common/GPSFix.h>
+#include <nav_msgs/Odometry.h>
+#include <sensor_msgs/Imu.h>
+#include <sensor_msgs/NavSatFix.h>
+#include <sensor_msgs/TimeReference.h>
+// GNSS msg includes
+#include <septentrio_gnss_driver/AttCovEuler.h>
+#include <septentrio_gnss_driver/AttEuler.h>
+#include <septentrio_gnss_driver/BaseVectorCart.h>
+#include <septentrio_gnss_driver/BaseVectorGeod.h>
+#include <septentrio_gnss_driver/BlockHeader.h>
+#include <septentrio_gnss_driver/MeasEpoch.h>
+#include <septentrio_gnss_driver/MeasEpochChannelType1.h>
+#include <septentrio_gnss_driver/MeasEpochChannelType2.h>
+#include <septentrio_gnss_driver/MeasEpochColumnar.h>
+#include <septentrio_gnss_driver/PVTCartesian.h>
+#include <septentrio_gnss_driver/PVTGeodetic.h>
+#include <septentrio_gnss_driver/PosCovCartesian.h>
+#include <septentrio_gnss_driver/PosCovGeodetic.h>
+#include <septentrio_gnss_driver/ReceiverTime.h>
+#include <septentrio_gnss_driver/VectorInfoCart.h>
+#include <septentrio_gnss_driver/VectorInfoGeod.h>
+#include <septentrio_gnss_driver/VelCovCartesian.h>
+#include <septentrio_gnss_driver/VelCovGeodetic.h>
+// NMEA msg includes
+#include <nmea_msgs/Gpgga.h>
+#include <nmea_msgs/Gpgsa.h>
+#include <nmea_msgs/Gpgsv.h>
+#include <nmea_msgs/Gprmc.h>
+// INS msg includes
+#include <septentrio_gnss_driver/ExtSensorMeas.h>
+#include <septentrio_gnss_driver/IMUSetup.h>
+#include <septentrio_gnss_driver/INSNavCart.h>
+#include <septentrio_gnss_driver/INSNavGeod.h>
+#include <septentrio_gnss_driver/VelSensorSetup.h>
+
+/**
+ * @file msg_typedefs.hpp
+ * @brief Declares the message types filled by the SBF and NMEA parsers
+ *
+ * Only the generated message headers and ros/time.h are needed, which do not
+ * depend on roscpp or a running ROS master.
+ * @date 19/10/26
+ */
+
+// ROS timestamp
+typedef ros::Time TimestampRos;
+
+// ROS messages
+typedef diagnostic_msgs::DiagnosticArray DiagnosticArrayMsg;
+typedef diagnostic_msgs::DiagnosticStatus DiagnosticStatusMsg;
+typedef geometry_msgs::Quaternion QuaternionMsg;
+typedef geometry_msgs::PoseWithCovarianceStamped PoseWithCovarianceStampedMsg;
+typedef geometry_msgs::TwistWithCovarianceStamped TwistWithCovarianceStampedMsg;
+typedef gps_common::GPSFix GPSFixMsg;
+typedef gps_common::GPSStatus GPSStatusMsg;
+typedef sensor_msgs::NavSatFix NavSatFixMsg;
+typedef sensor_msgs::NavSatStatus NavSatStatusMsg;
+typedef sensor_msgs::TimeReference TimeReferenceMsg;
+typedef sensor_msgs::Imu ImuMsg;
+typedef nav_msgs::Odometry LocalizationUtmMsg;
+
+// Septentrio GNSS SBF messages
+typedef septentrio_gnss_driver::BaseVectorCart BaseVectorCartMsg;
+typedef septentrio_gnss_driver::BaseVectorGeod BaseVectorGeodMsg;
+typedef septentrio_gnss_driver::BlockHeader BlockHeaderMsg;
+typedef septentrio_gnss_driver::MeasEpoch MeasEpochMsg;
+typedef septentrio_gnss_driver::MeasEpochChannelType1 MeasEpochChannelType1Msg;
+typedef septentrio_gnss_driver::MeasEpochChannelType2 MeasEpochChannelType2Msg;
+typedef septentrio_gnss_driver::MeasEpochColumnar MeasEpochColumnarMsg;
+typedef septentrio_gnss_driver::AttCovEuler AttCovEulerMsg;
+typedef septentrio_gnss_driver::AttEuler AttEulerMsg;
+typedef septentrio_gnss_driver::PVTCartesian PVTCartesianMsg;
+typedef septentrio_gnss_driver::PVTGeodetic PVTGeodeticMsg;
+typedef septentrio_gnss_driver::PosCovCartesian PosCovCartesianMsg;
+typedef septentrio_gnss_driver::PosCovGeodetic PosCovGeodeticMsg;
+typedef septentrio_gnss_driver::ReceiverTime ReceiverTimeMsg;
+typedef septentrio_gnss_driver::VectorInfoCart VectorInfoCartMsg;
+typedef septentrio_gnss_driver::VectorInfoGeod VectorInfoGeodMsg;
+typedef septentrio_gnss_driver::VelCovCartesian VelCovCartesianMsg;
+typedef septentrio_gnss_driver::VelCovGeodetic VelCovGeodeticMsg;
+
+// NMEA messages
+typedef nmea_msgs::Gpgga GpggaMsg;
+typedef nmea_msgs::Gpgsa GpgsaMsg;
+typedef nmea_msgs::Gpgsv GpgsvMsg;
+typedef nmea_msgs::Gprmc GprmcMsg;
+
+// Septentrio INS+GNSS SBF messages
+typedef septentrio_gnss_driver::INSNavCart INSNavCartMsg;
+typedef septentrio_gnss_driver::INSNavGeod INSNavGeodMsg;
+typedef septentrio_gnss_driver::IMUSetup IMUSetupMsg;
+typedef septentrio_gnss_driver::VelSensorSetup VelSensorSetupMsg;
+typedef septentrio_gnss_driver::ExtSensorMeas ExtSensorMeasMsg;
+
+/**
+ * @brief Convert nsec timestamp to ROS timestamp
+ * @param[in] ts timestamp in nanoseconds (Unix epoch)
+ * @return ROS timestamp
+ */
+inline TimestampRos timestampToRos(Timestamp ts)
+{
+    TimestampRos tsr;
+    tsr.fromNSec(ts);
+    return tsr;
+}
+
+/**
+ * @brief Convert ROS timestamp to nsec timestamp
+ * @param[in] ts ROS timestamp
+ * @return timestamp in nanoseconds (Unix epoch)
+ */
+inline Timestamp timestampFromRos(const TimestampRos& tsr) { return tsr.toNSec(); }
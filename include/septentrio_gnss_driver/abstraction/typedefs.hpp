@@ -31,156 +31,77 @@
 #pragma once
 
 // std includes
+#include <map>
+#include <memory>
 #include <numeric>
+#include <sstream>
 #include <unordered_map>
+// Boost includes
+#include <boost/make_shared.hpp>
 // ROS includes
 #include <ros/ros.h>
+#include <rosgraph_msgs/Clock.h>
+#include <tf2_msgs/TFMessage.h>
 // tf2 includes
 #include <tf2_eigen/tf2_eigen.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
-// ROS msg includes
-#include <diagnostic_msgs/DiagnosticArray.h>
-#include <diagnostic_msgs/DiagnosticStatus.h>
-#include <geometry_msgs/PoseWithCovarianceStamped.h>
-#include <geometry_msgs/Quaternion.h>
-#include <geometry_msgs/TwistWithCovarianceStamped.h>
-#include <gps_common/GPSFix.h>
-#include <nav_msgs/Odometry.h>
-#include <sensor_msgs/Imu.h>
-#include <sensor_msgs/NavSatFix.h>
-#include <sensor_msgs/TimeReference.h>
-// GNSS msg includes
-#include <septentrio_gnss_driver/AttCovEuler.h>
-#include <septentrio_gnss_driver/AttEuler.h>
-#include <septentrio_gnss_driver/BaseVectorCart.h>
-#include <septentrio_gnss_driver/BaseVectorGeod.h>
-#include <septentrio_gnss_driver/BlockHeader.h>
-#include <septentrio_gnss_driver/MeasEpoch.h>
-#include <septentrio_gnss_driver/MeasEpochChannelType1.h>
-#include <septentrio_gnss_driver/MeasEpochChannelType2.h>
-#include <septentrio_gnss_driver/PVTCartesian.h>
-#include <septentrio_gnss_driver/PVTGeodetic.h>
-#include <septentrio_gnss_driver/PosCovCartesian.h>
-#include <septentrio_gnss_driver/PosCovGeodetic.h>
-#include <septentrio_gnss_driver/ReceiverTime.h>
-#include <septentrio_gnss_driver/VectorInfoCart.h>
-#include <septentrio_gnss_driver/VectorInfoGeod.h>
-#include <septentrio_gnss_driver/VelCovCartesian.h>
-#include <septentrio_gnss_driver/VelCovGeodetic.h>
-// NMEA msg includes
-#include <nmea_msgs/Gpgga.h>
-#include <nmea_msgs/Gpgsa.h>
-#include <nmea_msgs/Gpgsv.h>
-#include <nmea_msgs/Gprmc.h>
-// INS msg includes
-#include <septentrio_gnss_driver/ExtSensorMeas.h>
-#include <septentrio_gnss_driver/IMUSetup.h>
-#include <septentrio_gnss_driver/INSNavCart.h>
-#include <septentrio_gnss_driver/INSNavGeod.h>
-#include <septentrio_gnss_driver/VelSensorSetup.h>
 // Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/abstraction/msg_typedefs.hpp>
+#include <septentrio_gnss_driver/communication/bag_writer.hpp>
+#include <septentrio_gnss_driver/communication/latency_estimator.hpp>
+#include <septentrio_gnss_driver/communication/realtime.hpp>
+#include <septentrio_gnss_driver/communication/rx_statistics.hpp>
 #include <septentrio_gnss_driver/communication/settings.h>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
 
-// Timestamp in nanoseconds (Unix epoch)
-typedef uint64_t Timestamp;
-// ROS timestamp
-typedef ros::Time TimestampRos;
-
-// ROS messages
-typedef diagnostic_msgs::DiagnosticArray DiagnosticArrayMsg;
-typedef diagnostic_msgs::DiagnosticStatus DiagnosticStatusMsg;
-typedef geometry_msgs::Quaternion QuaternionMsg;
-typedef geometry_msgs::PoseWithCovarianceStamped PoseWithCovarianceStampedMsg;
-typedef geometry_msgs::TwistWithCovarianceStamped TwistWithCovarianceStampedMsg;
+// ROS messages only used by the node
 typedef geometry_msgs::TransformStamped TransformStampedMsg;
-typedef gps_common::GPSFix GPSFixMsg;
-typedef gps_common::GPSStatus GPSStatusMsg;
-typedef sensor_msgs::NavSatFix NavSatFixMsg;
-typedef sensor_msgs::NavSatStatus NavSatStatusMsg;
-typedef sensor_msgs::TimeReference TimeReferenceMsg;
-typedef sensor_msgs::Imu ImuMsg;
-typedef nav_msgs::Odometry LocalizationUtmMsg;
-
-// Septentrio GNSS SBF messages
-typedef septentrio_gnss_driver::BaseVectorCart BaseVectorCartMsg;
-typedef septentrio_gnss_driver::BaseVectorGeod BaseVectorGeodMsg;
-typedef septentrio_gnss_driver::BlockHeader BlockHeaderMsg;
-typedef septentrio_gnss_driver::MeasEpoch MeasEpochMsg;
-typedef septentrio_gnss_driver::MeasEpochChannelType1 MeasEpochChannelType1Msg;
-typedef septentrio_gnss_driver::MeasEpochChannelType2 MeasEpochChannelType2Msg;
-typedef septentrio_gnss_driver::AttCovEuler AttCovEulerMsg;
-typedef septentrio_gnss_driver::AttEuler AttEulerMsg;
-typedef septentrio_gnss_driver::PVTCartesian PVTCartesianMsg;
-typedef septentrio_gnss_driver::PVTGeodetic PVTGeodeticMsg;
-typedef septentrio_gnss_driver::PosCovCartesian PosCovCartesianMsg;
-typedef septentrio_gnss_driver::PosCovGeodetic PosCovGeodeticMsg;
-typedef septentrio_gnss_driver::ReceiverTime ReceiverTimeMsg;
-typedef septentrio_gnss_driver::VectorInfoCart VectorInfoCartMsg;
-typedef septentrio_gnss_driver::VectorInfoGeod VectorInfoGeodMsg;
-typedef septentrio_gnss_driver::VelCovCartesian VelCovCartesianMsg;
-typedef septentrio_gnss_driver::VelCovGeodetic VelCovGeodeticMsg;
-
-// NMEA messages
-typedef nmea_msgs::Gpgga GpggaMsg;
-typedef nmea_msgs::Gpgsa GpgsaMsg;
-typedef nmea_msgs::Gpgsv GpgsvMsg;
-typedef nmea_msgs::Gprmc GprmcMsg;
-
-// Septentrio INS+GNSS SBF messages
-typedef septentrio_gnss_driver::INSNavCart INSNavCartMsg;
-typedef septentrio_gnss_driver::INSNavGeod INSNavGeodMsg;
-typedef septentrio_gnss_driver::IMUSetup IMUSetupMsg;
-typedef septentrio_gnss_driver::VelSensorSetup VelSensorSetupMsg;
-typedef septentrio_gnss_driver::ExtSensorMeas ExtSensorMeasMsg;
-
-/**
- * @brief Convert nsec timestamp to ROS timestamp
- * @param[in] ts timestamp in nanoseconds (Unix epoch)
- * @return ROS timestamp
- */
-inline TimestampRos timestampToRos(Timestamp ts)
-{
-    TimestampRos tsr;
-    tsr.fromNSec(ts);
-    return tsr;
-}
-
-/**
- * @brief Convert ROS timestamp to nsec timestamp
- * @param[in] ts ROS timestamp
- * @return timestamp in nanoseconds (Unix epoch)
- */
-inline Timestamp timestampFromRos(const TimestampRos& tsr) { return tsr.toNSec(); }
-
-/**
- * @brief Log level for ROS logging
- */
-enum LogLevel
-{
-    DEBUG,
-    INFO,
-    WARN,
-    ERROR,
-    FATAL
-};
+typedef rosgraph_msgs::Clock ClockMsg;
 
 /**
  * @class ROSaicNodeBase
  * @brief This class is the base class for abstraction
  */
-class ROSaicNodeBase
+class ROSaicNodeBase : public LogSink
 {
 public:
-    ROSaicNodeBase() : pNh_(new ros::NodeHandle("~")), tfListener_(tfBuffer_) {}
+    /**
+     * @brief Constructor
+     * @param[in] name Name of the Rx when several are handled by one process,
+     * its parameters are then read from and its topics, services and
+     * subscriptions placed into the namespace of this name, except for
+     * /diagnostics and /clock, empty for a single Rx
+     */
+    explicit ROSaicNodeBase(const std::string& name = std::string()) :
+        pNh_(name.empty() ? new ros::NodeHandle("~")
+                          : new ros::NodeHandle(ros::NodeHandle("~"), name)),
+        name_(name), tf2Publisher_(new tf2_ros::TransformBroadcaster),
+        tfListener_(new tf2_ros::TransformListener(tfBuffer_))
+    {
+    }
+
+    /**
+     * @brief Constructor for offline use without ROS master, messages are
+     * written to a bag instead of being published
+     * @param[in] bag_writer Writer of the bag, has to outlive the node, nullptr
+     * to discard the messages, e.g. for benchmarks
+     * @param[in] params Parameters by name, e.g. "publish/gpsfix" -> "true",
+     * replacing the parameter server
+     */
+    ROSaicNodeBase(io_comm_rx::BagWriter* bag_writer,
+                   const std::map<std::string, std::string>& params) :
+        bag_writer_(bag_writer), offline_params_(params)
+    {
+    }
 
     virtual ~ROSaicNodeBase() {}
 
     void registerSubscriber()
     {
-        ros::NodeHandle nh;
+        ros::NodeHandle nh(name_);
         if (settings_.ins_vsm_ros_source == "odometry")
             odometrySubscriber_ = nh.subscribe<nav_msgs::Odometry>(
                 "odometry_vsm", 10, &ROSaicNodeBase::callbackOdometry, this);
@@ -200,7 +121,9 @@ public:
     bool getUint32Param(const std::string& name, uint32_t& val, uint32_t defaultVal)
     {
         int32_t tempVal;
-        if ((!pNh_->getParam(name, tempVal)) || (tempVal < 0))
+        bool found = pNh_ ? pNh_->getParam(name, tempVal)
+                          : offlineParam(name, tempVal, static_cast<int32_t>(-1));
+        if (!found || (tempVal < 0))
         {
             val = defaultVal;
             return false;
@@ -220,32 +143,145 @@ public:
     template <typename T>
     bool param(const std::string& name, T& val, const T& defaultVal)
     {
+        if (!pNh_)
+            return offlineParam(name, val, defaultVal);
         return pNh_->param(name, val, defaultVal);
     };
 
+    /**
+     * @brief Gets the parameters that determine which messages are published
+     * and how they are built, shared by the node and offline conversion
+     * @return False if a parameter is invalid
+     */
+    bool getOutputParams()
+    {
+        param("frame_id", settings_.frame_id, (std::string) "gnss");
+        param("imu_frame_id", settings_.imu_frame_id, (std::string) "imu");
+        param("poi_frame_id", settings_.poi_frame_id, (std::string) "base_link");
+        param("vsm_frame_id", settings_.vsm_frame_id, (std::string) "vsm");
+        param("aux1_frame_id", settings_.aux1_frame_id, (std::string) "aux1");
+        param("vehicle_frame_id", settings_.vehicle_frame_id,
+              settings_.poi_frame_id);
+        param("local_frame_id", settings_.local_frame_id, (std::string) "odom");
+        param("insert_local_frame", settings_.insert_local_frame, false);
+        param("lock_utm_zone", settings_.lock_utm_zone, true);
+        param("leap_seconds", settings_.leap_seconds, -128);
+
+        param("receiver_type", settings_.septentrio_receiver_type,
+              std::string("gnss"));
+        if (!((settings_.septentrio_receiver_type == "gnss") ||
+              (settings_.septentrio_receiver_type == "ins") ||
+              (settings_.septentrio_receiver_type == "ins_in_gnss_mode")))
+        {
+            this->log(LogLevel::FATAL, "Unkown septentrio_receiver_type " +
+                                           settings_.septentrio_receiver_type +
+                                           " use either gnss or ins.");
+            return false;
+        }
+
+        if (settings_.septentrio_receiver_type == "ins_in_gnss_mode")
+        {
+            settings_.septentrio_receiver_type = "gnss";
+            settings_.ins_in_gnss_mode = true;
+        }
+
+        // multi_antenna param
+        param("multi_antenna", settings_.multi_antenna, false);
+
+        // Publishing parameters
+        bool is_gnss = (settings_.septentrio_receiver_type == "gnss");
+        bool is_ins = (settings_.septentrio_receiver_type == "ins");
+        param("publish/gpst", settings_.publish_gpst, false);
+        param("publish/navsatfix", settings_.publish_navsatfix, true);
+        param("publish/gpsfix", settings_.publish_gpsfix, false);
+        param("publish/pose", settings_.publish_pose, false);
+        param("publish/diagnostics", settings_.publish_diagnostics, false);
+        param("publish/statistics", settings_.publish_statistics, false);
+        param("publish/latency", settings_.publish_latency, false);
+        param("latency/congestion_threshold",
+              settings_.latency_congestion_threshold, 0.05);
+        param("publish/gpgga", settings_.publish_gpgga, false);
+        param("publish/gprmc", settings_.publish_gprmc, false);
+        param("publish/gpgsa", settings_.publish_gpgsa, false);
+        param("publish/gpgsv", settings_.publish_gpgsv, false);
+        param("publish/measepoch", settings_.publish_measepoch, false);
+        param("publish/measepoch_columnar", settings_.publish_measepoch_columnar,
+              false);
+        param("publish/pvtcartesian", settings_.publish_pvtcartesian, false);
+        param("publish/pvtgeodetic", settings_.publish_pvtgeodetic, is_gnss);
+        param("publish/basevectorcart", settings_.publish_basevectorcart, false);
+        param("publish/basevectorgeod", settings_.publish_basevectorgeod, false);
+        param("publish/poscovcartesian", settings_.publish_poscovcartesian, false);
+        param("publish/poscovgeodetic", settings_.publish_poscovgeodetic, is_gnss);
+        param("publish/velcovgeodetic", settings_.publish_velcovgeodetic, is_gnss);
+        param("publish/atteuler", settings_.publish_atteuler,
+              is_gnss && settings_.multi_antenna);
+        param("publish/attcoveuler", settings_.publish_attcoveuler,
+              is_gnss && settings_.multi_antenna);
+        param("publish/insnavcart", settings_.publish_insnavcart, false);
+        param("publish/insnavgeod", settings_.publish_insnavgeod, is_ins);
+        param("publish/imusetup", settings_.publish_imusetup, false);
+        param("publish/velsensorsetup", settings_.publish_velsensorsetup, false);
+        param("publish/exteventinsnavgeod", settings_.publish_exteventinsnavgeod,
+              false);
+        param("publish/exteventinsnavcart", settings_.publish_exteventinsnavcart,
+              false);
+        param("publish/extsensormeas", settings_.publish_extsensormeas, false);
+        param("publish/imu", settings_.publish_imu, false);
+        param("publish/localization", settings_.publish_localization, false);
+        param("publish/twist", settings_.publish_twist, false);
+        param("publish/tf", settings_.publish_tf, false);
+
+        param("use_ros_axis_orientation", settings_.use_ros_axis_orientation,
+              true);
+
+        // INS solution reference point
+        param("ins_use_poi", settings_.ins_use_poi, false);
+
+        if (settings_.publish_tf && !settings_.ins_use_poi)
+        {
+            this->log(
+                LogLevel::ERROR,
+                "If tf shall be published, ins_use_poi has to be set to true! It is set automatically to true.");
+            settings_.ins_use_poi = true;
+        }
+
+        if (settings_.publish_atteuler)
+        {
+            if (!settings_.multi_antenna)
+            {
+                this->log(
+                    LogLevel::WARN,
+                    "AttEuler needs multi-antenna receiver. Multi-antenna setting automatically activated. Deactivate publishing of AttEuler if multi-antenna operation is not available.");
+                settings_.multi_antenna = true;
+            }
+        }
+        return true;
+    }
+
     /**
      * @brief Log function to provide abstraction of ROS loggers
      * @param[in] logLevel Log level
      * @param[in] s String to log
      */
-    void log(LogLevel logLevel, const std::string& s)
+    void log(LogLevel logLevel, const std::string& s) override
     {
         switch (logLevel)
         {
         case LogLevel::DEBUG:
-            ROS_DEBUG_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_DEBUG_STREAM(ros::this_node::getName() << logName() << ": " << s);
             break;
         case LogLevel::INFO:
-            ROS_INFO_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_INFO_STREAM(ros::this_node::getName() << logName() << ": " << s);
             break;
         case LogLevel::WARN:
-            ROS_WARN_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_WARN_STREAM(ros::this_node::getName() << logName() << ": " << s);
             break;
         case LogLevel::ERROR:
-            ROS_ERROR_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_ERROR_STREAM(ros::this_node::getName() << logName() << ": " << s);
             break;
         case LogLevel::FATAL:
-            ROS_FATAL_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_FATAL_STREAM(ros::this_node::getName() << logName() << ": " << s);
             break;
         default:
             break;
@@ -258,6 +294,39 @@ public:
      */
     Timestamp getTime() { return ros::Time::now().toNSec(); }
 
+    /**
+     * @brief Gets the runtime statistics of the stream from the Rx
+     * @return Statistics, updated by the reading and parsing threads
+     */
+    io_comm_rx::RxStatistics& statistics() { return statistics_; }
+
+    /**
+     * @brief Gets the estimator of the transport latency of SBF blocks
+     * @return Estimator, fed by the parsing thread
+     */
+    io_comm_rx::LatencyEstimator& latency() { return latency_; }
+
+    /**
+     * @brief Names a thread of the driver "<name>_<role>", "rx_<role>" for a
+     * single Rx, and sets its CPU affinity and scheduling as configured for its
+     * role
+     * @param[in] thread Thread
+     * @param[in] role Role, e.g. "io" or "parsing"
+     */
+    void configureThread(pthread_t thread, const std::string& role)
+    {
+        std::string name = (name_.empty() ? std::string("rx") : name_) + "_" + role;
+        ThreadSettings thread_settings;
+        auto it = settings_.threads.find(role);
+        if (it != settings_.threads.end())
+            thread_settings = it->second;
+        std::string error;
+        if (!io_comm_rx::realtime::configureThread(thread, name, thread_settings,
+                                                   error))
+            this->log(LogLevel::WARN,
+                      "Unable to configure thread " + name + ": " + error);
+    }
+
     /**
      * @brief Publishing function
      * @param[in] topic String of topic
@@ -266,13 +335,48 @@ public:
     template <typename M>
     void publishMessage(const std::string& topic, const M& msg)
     {
+        if (!pNh_)
+        {
+            if (bag_writer_)
+                bag_writer_->write(topic, boost::make_shared<M>(msg));
+            return;
+        }
         auto it = topicMap_.find(topic);
         if (it != topicMap_.end())
         {
             it->second.publish(msg);
         } else
         {
-            ros::Publisher pub = pNh_->advertise<M>(topic, queueSize_);
+            ros::Publisher pub = pNh_->advertise<M>(topicName(topic), queueSize_);
+            topicMap_.insert(std::make_pair(topic, pub));
+            pub.publish(msg);
+        }
+    }
+
+    /**
+     * @brief Publishing function for messages held by shared pointer
+     *
+     * Intra-process subscribers receive the very same object without copy, the
+     * message must thus not be altered after publishing.
+     * @param[in] topic String of topic
+     * @param[in] msg Shared pointer to the ROS message to be published
+     */
+    template <typename M>
+    void publishMessage(const std::string& topic, const boost::shared_ptr<M>& msg)
+    {
+        if (!pNh_)
+        {
+            if (bag_writer_)
+                bag_writer_->write(topic, msg);
+            return;
+        }
+        auto it = topicMap_.find(topic);
+        if (it != topicMap_.end())
+        {
+            it->second.publish(msg);
+        } else
+        {
+            ros::Publisher pub = pNh_->advertise<M>(topicName(topic), queueSize_);
             topicMap_.insert(std::make_pair(topic, pub));
             pub.publish(msg);
         }
@@ -280,6 +384,9 @@ public:
 
     /**
      * @brief Publishing function for tf
+     *
+     * Offline, the transform is written to the bag on /tf without insertion of
+     * the local frame, as there is no tf tree to look it up in.
      * @param[in] msg ROS localization message to be converted to tf
      */
     void publishTf(const LocalizationUtmMsg& loc)
@@ -303,6 +410,17 @@ public:
         transformStamped.transform.rotation.z = loc.pose.pose.orientation.z;
         transformStamped.transform.rotation.w = loc.pose.pose.orientation.w;
 
+        if (!pNh_)
+        {
+            if (bag_writer_)
+            {
+                auto tf = boost::make_shared<tf2_msgs::TFMessage>();
+                tf->transforms.push_back(transformStamped);
+                bag_writer_->write("/tf", tf);
+            }
+            return;
+        }
+
         if (settings_.insert_local_frame)
         {
             geometry_msgs::TransformStamped T_l_b;
@@ -344,7 +462,7 @@ public:
             transformStamped.child_frame_id = settings_.local_frame_id;
         }
 
-        tf2Publisher_.sendTransform(transformStamped);
+        tf2Publisher_->sendTransform(transformStamped);
     }
 
 private:
@@ -455,20 +573,91 @@ private:
     }
 
 protected:
-    //! Node handle pointer
+    /**
+     * @brief Gets the suffix of the node name in log messages
+     * @return "/<name>" when several Rxs are handled, empty otherwise
+     */
+    std::string logName() const { return name_.empty() ? name_ : "/" + name_; }
+
+    //! Node handle pointer, null when used offline
     std::shared_ptr<ros::NodeHandle> pNh_;
+    //! Name of the Rx when several are handled by one process, empty otherwise
+    std::string name_;
     //! Settings
     Settings settings_;
+    //! Runtime statistics of the stream from the Rx
+    io_comm_rx::RxStatistics statistics_;
+    //! Estimator of the transport latency of SBF blocks
+    io_comm_rx::LatencyEstimator latency_;
     //! Send velocity to communication layer (virtual)
     virtual void sendVelocity(const std::string& velNmea) = 0;
 
 private:
+    /**
+     * @brief Places a topic into the namespace of the Rx
+     * @param[in] topic Topic, e.g. "/navsatfix"
+     * @return The topic, prefixed by "/<name>" when several Rxs are handled
+     * unless it is shared by all of them
+     */
+    std::string topicName(const std::string& topic) const
+    {
+        if (name_.empty() || (topic == "/diagnostics") || (topic == "/clock"))
+            return topic;
+        return "/" + name_ + topic;
+    }
+
+    /**
+     * @brief Gets a parameter from the ones handed over for offline use
+     * @return True if it could be retrieved, false if not
+     */
+    template <typename T>
+    bool offlineParam(const std::string& name, T& val, const T& defaultVal)
+    {
+        auto it = offline_params_.find(name);
+        if ((it != offline_params_.end()) && fromString(it->second, val))
+            return true;
+        val = defaultVal;
+        return false;
+    }
+
+    template <typename T>
+    static bool fromString(const std::string& str, T& val)
+    {
+        std::istringstream iss(str);
+        iss >> val;
+        return !iss.fail() && iss.eof();
+    }
+
+    static bool fromString(const std::string& str, std::string& val)
+    {
+        val = str;
+        return true;
+    }
+
+    static bool fromString(const std::string& str, bool& val)
+    {
+        std::istringstream iss(str);
+        iss >> std::boolalpha >> val;
+        return !iss.fail() && iss.eof();
+    }
+
+    //! Lists are not supported offline
+    template <typename T>
+    static bool fromString(const std::string& /*str*/, std::vector<T>& /*val*/)
+    {
+        return false;
+    }
+
+    //! Writer of the bag when used offline, null otherwise
+    io_comm_rx::BagWriter* bag_writer_ = nullptr;
+    //! Parameters when used offline
+    std::map<std::string, std::string> offline_params_;
     //! Map of topics and publishers
     std::unordered_map<std::string, ros::Publisher> topicMap_;
     //! Publisher queue size
     uint32_t queueSize_ = 1;
     //! Transform publisher
-    tf2_ros::TransformBroadcaster tf2Publisher_;
+    std::unique_ptr<tf2_ros::TransformBroadcaster> tf2Publisher_;
     //! Odometry subscriber
     ros::Subscriber odometrySubscriber_;
     //! Twist subscriber
@@ -478,5 +667,5 @@ private:
     //! tf buffer
     tf2_ros::Buffer tfBuffer_;
     // tf listener
-    tf2_ros::TransformListener tfListener_;
+    std::unique_ptr<tf2_ros::TransformListener> tfListener_;
 };
\ No newline at end of file
@@ -28,57 +28,28 @@
 //
 // *****************************************************************************
 
-// ROS includes
-#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
-
 // C++ library includes
-#include <algorithm>
 #include <cstdint>
 
-#ifndef CIRCULAR_BUFFER_HPP
-#define CIRCULAR_BUFFER_HPP
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
 
 /**
- * @file circular_buffer.hpp
- * @brief Declares a class for creating, writing to and reading from a circular
- * bufffer
- * @date 25/09/20
+ * @file allocation_counter.hpp
+ * @date 19/10/26
+ * @brief Counts heap allocations of the benchmarks
+ *
+ * Linking allocation_counter.cpp replaces the global operator new, such that
+ * every allocation of the executable is counted.
  */
 
-/**
- * @class CircularBuffer
- * @brief Class for creating, writing to and reading from a circular buffer
- */
-class CircularBuffer
-{
-public:
-    //! Constructor of CircularBuffer
-    explicit CircularBuffer(ROSaicNodeBase* node, std::size_t capacity);
-    //! Destructor of CircularBuffer
-    ~CircularBuffer();
-    //! Returns size_
-    std::size_t size() const { return size_; }
-    //! Returns capacity_
-    std::size_t capacity() const { return capacity_; }
-    //! Returns number of bytes written.
-    std::size_t write(const uint8_t* data, std::size_t bytes);
-    //! Returns number of bytes read.
-    std::size_t read(uint8_t* data, std::size_t bytes);
+namespace benchmark_utilities {
 
-private:
-    //! Pointer to the node
-    ROSaicNodeBase* node_;
-    //! Specifies where we start writing
-    std::size_t head_;
-    //! Specifies where we start reading
-    std::size_t tail_;
-    //! Number of bytes that have been written but not yet read
-    std::size_t size_;
-    //! Capacity of the circular buffer
-    std::size_t capacity_;
-    //! Pointer that always points to the same memory address, hence could be const
-    //! pointer
-    uint8_t* data_;
-};
+    /**
+     * @brief Number of heap allocations since the start of the program, counted
+     * with relaxed atomics
+     */
+    uint64_t allocations();
+} // namespace benchmark_utilities
 
-#endif // for CIRCULAR_BUFFER_HPP
\ No newline at end of file
+#endif // ALLOCATION_COUNTER_HPP
@@ -56,6 +56,13 @@
 //
 // *****************************************************************************
 
+// C++ library includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 // Boost includes
 #include <boost/algorithm/string/join.hpp>
 #include <boost/asio.hpp>
@@ -67,7 +74,10 @@
 #include <boost/thread/condition.hpp>
 
 // ROSaic includes
-#include <septentrio_gnss_driver/communication/circular_buffer.hpp>
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/parse_queue.hpp>
+#include <septentrio_gnss_driver/communication/socket_timestamps.hpp>
+#include <septentrio_gnss_driver/communication/stream_recorder.hpp>
 
 #ifndef ASYNC_MANAGER_HPP
 #define ASYNC_MANAGER_HPP
@@ -96,6 +106,8 @@ namespace io_comm_rx {
         virtual ~Manager() {}
         //! Sets the callback function
         virtual void setCallback(const Callback& callback) = 0;
+        //! Sets the recorder the raw stream is teed to, nullptr to stop
+        virtual void setRecorder(StreamRecorder* recorder) = 0;
         //! Sends commands to the receiver
         virtual bool send(const std::string& cmd) = 0;
         //! Waits count seconds before throwing ROS_INFO message in case no message
@@ -122,10 +134,20 @@ namespace io_comm_rx {
          * boost::asio::serial_port or boost::asio::tcp::ip
          * @param io_service The io_context object. The io_context represents your
          * program's link to the operating system's I/O services
-         * @param[in] buffer_size Size of the circular buffer in bytes
+         * @param[in] shared_io_service Whether io_service is shared with other
+         * connections and run by their common worker threads, the stream is then
+         * parsed by these threads as well instead of threads of its own
+         * @param[in] queue_policy What the reading thread does if the parsing
+         * thread falls behind, not used with a shared io_service
+         * @param[in] queue_capacity Capacity of the queue between the reading
+         * and the parsing thread in bytes
+         * @param[in] buffer_size Size of the read buffer in bytes
          */
         AsyncManager(ROSaicNodeBase* node, boost::shared_ptr<StreamT> stream,
                      boost::shared_ptr<boost::asio::io_service> io_service,
+                     bool shared_io_service = false,
+                     DropPolicy queue_policy = DropPolicy::BLOCK,
+                     std::size_t queue_capacity = 262144,
                      std::size_t buffer_size = 16384);
         virtual ~AsyncManager();
 
@@ -136,6 +158,12 @@ namespace io_comm_rx {
          */
         void setCallback(const Callback& callback) { read_callback_ = callback; }
 
+        /**
+         * @brief Tees all bytes read, before framing, to a recorder
+         * @param recorder The recorder, has to outlive the manager or be reset
+         */
+        void setRecorder(StreamRecorder* recorder) { recorder_ = recorder; }
+
         void wait(uint16_t* count);
 
         /**
@@ -159,28 +187,53 @@ namespace io_comm_rx {
         void asyncReadSomeHandler(const boost::system::error_code& error,
                                   std::size_t bytes_transferred);
 
-        //! Sends command "cmd" to the Rx
-        void write(const std::string& cmd);
+        //! Handler for waiting on a socket with kernel receive timestamps, reads
+        //! the available bytes together with their timestamp
+        void asyncWaitHandler(const boost::system::error_code& error);
 
-        //! Closes stream "stream_"
-        void close();
+        //! Hands bytes read into in_ over to the parsing thread
+        void handleRead(const boost::system::error_code& error,
+                        std::size_t bytes_transferred, Timestamp inTime);
 
-        //! Tries parsing SBF/NMEA whenever the boolean class variable "try_parsing"
-        //! is true
-        void tryParsing();
+        //! Starts the next read after a handler, posted to the io_service unless
+        //! it is shared
+        void continueReading(const boost::system::error_code& error);
 
-        //! Mutex to control changes of class variable "try_parsing"
-        boost::mutex parse_mutex_;
+        //! Parses bytes in the calling thread together with the rest of an
+        //! incomplete block or sentence carried over from the previous call, used
+        //! with a shared io_service
+        void parse(Timestamp recvTime, const uint8_t* data, std::size_t size);
 
-        //! Determines when the tryParsing() method will attempt parsing SBF/NMEA
-        bool try_parsing_;
+        //! Parses pending_ and keeps an incomplete block or sentence at its end
+        void parsePending(Timestamp recvTime);
 
-        //! Determines when the asyncReadSomeHandler() method should write SBF/NMEA
-        //! into the circular buffer
-        bool allow_writing_;
+        //! Marks a read or write as finished, has to be the last access to this
+        //! instance in its handler
+        void finished();
 
-        //! Condition variable complementing "parse_mutex"
-        boost::condition_variable parsing_condition_;
+        //! Native handle of TCP sockets, for which kernel receive timestamps can
+        //! be enabled
+        static int nativeSocket(boost::asio::ip::tcp::socket& stream)
+        {
+            return stream.native_handle();
+        }
+
+        //! Serial ports have no kernel receive timestamps
+        template <typename S>
+        static int nativeSocket(S&)
+        {
+            return -1;
+        }
+
+        //! Sends command "cmd" to the Rx
+        void write(const std::string& cmd);
+
+        //! Closes stream "stream_", must not run concurrently with the handlers
+        //! of this connection
+        void close();
+
+        //! Parses SBF/NMEA whenever a read arrives in queue_
+        void tryParsing();
 
         //! Stream, represents either serial or TCP/IP connection
         boost::shared_ptr<StreamT> stream_;
@@ -191,9 +244,9 @@ namespace io_comm_rx {
         //! Buffer for async_read_some() to read continuous SBF/NMEA stream
         std::vector<uint8_t> in_;
 
-        //! Circular buffer to avoid unsuccessful SBF/NMEA parsing due to incomplete
-        //! messages
-        CircularBuffer circular_buffer_;
+        //! Bounded queue from the reading to the parsing thread, nullptr with a
+        //! shared io_service
+        std::unique_ptr<ParseQueue> queue_;
 
         //! New thread for receiving incoming messages
         boost::shared_ptr<boost::thread> async_background_thread_;
@@ -207,8 +260,9 @@ namespace io_comm_rx {
         //! Callback to be called once message arrives
         Callback read_callback_;
 
-        //! Whether or not we want to sever the connection to the Rx
-        bool stopping_;
+        //! Whether or not we want to sever the connection to the Rx, read by the
+        //! handlers on the threads of the io_service
+        std::atomic<bool> stopping_;
 
         /// Size of in_ buffers
         const std::size_t buffer_size_;
@@ -228,71 +282,55 @@ namespace io_comm_rx {
         //! initially)
         uint16_t do_read_count_;
 
-        //! Timestamp of receiving buffer
-        Timestamp recvTime_;
+        //! Recorder of the raw stream, nullptr if not recording
+        std::atomic<StreamRecorder*> recorder_{nullptr};
+
+        //! Socket read with kernel receive timestamps, -1 if not supported
+        int socket_fd_ = -1;
+
+        //! Whether the first kernel receive timestamp was checked against the
+        //! clock of the node
+        bool kernel_time_checked_ = false;
+
+        //! Whether io_service_ is shared with other connections
+        const bool shared_io_service_;
+
+        //! Serializes the handlers of this connection, which may run on several
+        //! threads if io_service_ is shared
+        boost::asio::io_service::strand strand_;
+
+        //! Number of started reads and writes whose handlers did not yet finish
+        std::atomic<uint32_t> outstanding_{0};
+
+        //! Guards outstanding_ reaching 0
+        std::mutex outstanding_mutex_;
+
+        //! Notified once outstanding_ reaches 0
+        std::condition_variable all_finished_;
+
+        //! Rest of an incomplete block or sentence to be parsed with the next
+        //! bytes
+        std::vector<uint8_t> pending_;
     };
 
     template <typename StreamT>
     void AsyncManager<StreamT>::tryParsing()
     {
-        uint8_t* to_be_parsed = new uint8_t[buffer_size_ * 16];
-        uint8_t* to_be_parsed_index = to_be_parsed;
-        bool timed_out = false;
-        std::size_t shift_bytes = 0;
-        std::size_t arg_for_read_callback = 0;
-
-        while (!timed_out &&
-               !stopping_) // Loop will stop if condition variable timed out
-        {
-            boost::mutex::scoped_lock lock(parse_mutex_);
-            parsing_condition_.wait_for(lock, boost::chrono::seconds(10),
-                                        [this]() { return try_parsing_; });
-            bool timed_out = !try_parsing_;
-            if (timed_out)
-                break;
-            try_parsing_ = false;
-            allow_writing_ = true;
-            std::size_t current_buffer_size = circular_buffer_.size();
-            arg_for_read_callback += current_buffer_size;
-            circular_buffer_.read(to_be_parsed + shift_bytes, current_buffer_size);
-            Timestamp revcTime = recvTime_;
-            lock.unlock();
-            parsing_condition_.notify_one();
-
-            try
-            {
-                node_->log(
-                    LogLevel::DEBUG,
-                    "Calling read_callback_() method, with number of bytes to be parsed being " +
-                        std::to_string(arg_for_read_callback));
-                read_callback_(revcTime, to_be_parsed_index, arg_for_read_callback);
-            } catch (std::size_t& parsing_failed_here)
-            {
-                to_be_parsed_index += parsing_failed_here;
-                arg_for_read_callback -= parsing_failed_here;
-                node_->log(LogLevel::DEBUG, "Current buffer size is " +
-                                                std::to_string(current_buffer_size) +
-                                                " and parsing_failed_here is " +
-                                                std::to_string(parsing_failed_here));
-                if (arg_for_read_callback < 0) // In case some parsing error was not
-                                               // caught, which should never happen..
-                {
-                    to_be_parsed_index = to_be_parsed;
-                    shift_bytes = 0;
-                    arg_for_read_callback = 0;
-                    continue;
-                }
-                shift_bytes += current_buffer_size;
-                continue;
-            }
-            to_be_parsed_index = to_be_parsed;
-            shift_bytes = 0;
-            arg_for_read_callback = 0;
-        }
-        node_->log(
-            LogLevel::INFO,
-            "TryParsing() method finished since it did not receive anything to parse for 10 seconds..");
-        delete[] to_be_parsed; // Freeing memory
+        // No page faults once data arrives
+        pending_.resize(buffer_size_ * 16);
+        realtime::prefault(pending_.data(), pending_.size());
+        pending_.clear();
+
+        Timestamp recvTime;
+        // Each read is parsed with its receive time, together with the rest of
+        // an incomplete block or sentence of the previous one
+        while (!stopping_ &&
+               queue_->pop(pending_, recvTime, std::chrono::seconds(10)))
+            parsePending(recvTime);
+        if (!stopping_)
+            node_->log(
+                LogLevel::INFO,
+                "TryParsing() method finished since it did not receive anything to parse for 10 seconds..");
     }
 
     template <typename StreamT>
@@ -305,18 +343,26 @@ namespace io_comm_rx {
             return true;
         }
 
-        io_service_->post(boost::bind(&AsyncManager<StreamT>::write, this, cmd));
+        ++outstanding_;
+        strand_.post(boost::bind(&AsyncManager<StreamT>::write, this, cmd));
         return true;
     }
 
     template <typename StreamT>
     void AsyncManager<StreamT>::write(const std::string& cmd)
     {
-        boost::asio::write(*stream_, boost::asio::buffer(cmd.data(), cmd.size()));
-        // Prints the data that was sent
-        node_->log(LogLevel::DEBUG, "Sent the following " +
-                                        std::to_string(cmd.size()) +
-                                        " bytes to the Rx: \n" + cmd);
+        boost::system::error_code error;
+        boost::asio::write(*stream_, boost::asio::buffer(cmd.data(), cmd.size()),
+                           error);
+        if (error)
+            node_->log(LogLevel::ERROR,
+                       "Unable to send command to the Rx: " + error.message());
+        else
+            // Prints the data that was sent
+            node_->log(LogLevel::DEBUG, "Sent the following " +
+                                            std::to_string(cmd.size()) +
+                                            " bytes to the Rx: \n" + cmd);
+        finished();
     }
 
     template <typename StreamT>
@@ -329,11 +375,12 @@ namespace io_comm_rx {
     AsyncManager<StreamT>::AsyncManager(
         ROSaicNodeBase* node, boost::shared_ptr<StreamT> stream,
         boost::shared_ptr<boost::asio::io_service> io_service,
+        bool shared_io_service, DropPolicy queue_policy, std::size_t queue_capacity,
         std::size_t buffer_size) :
         node_(node),
         timer_(*(io_service.get()), boost::posix_time::seconds(1)), stopping_(false),
-        try_parsing_(false), allow_writing_(true), do_read_count_(0),
-        buffer_size_(buffer_size), count_max_(6), circular_buffer_(node, buffer_size)
+        do_read_count_(0), buffer_size_(buffer_size), count_max_(6),
+        shared_io_service_(shared_io_service), strand_(*io_service)
     // Since buffer_size = 16384 in declaration, no need in definition anymore (even
     // yields error message, due to "overwrite").
     {
@@ -343,7 +390,29 @@ namespace io_comm_rx {
         stream_ = stream;
         io_service_ = io_service;
         in_.resize(buffer_size_);
+        socket_fd_ = nativeSocket(*stream_);
+        if (socket_fd_ >= 0)
+        {
+            if (socket_timestamps::enable(socket_fd_))
+                node_->log(LogLevel::INFO,
+                           "Stamping the stream from the Rx with kernel receive "
+                           "timestamps.");
+            else
+                socket_fd_ = -1;
+        }
 
+        if (shared_io_service_)
+        {
+            // The worker threads of the shared io_service read and parse
+            node_->statistics().setBufferCapacity(buffer_size_ * 16);
+            pending_.reserve(buffer_size_ * 16);
+            // Started right away, a posted read would not be counted in
+            // outstanding_ before it runs
+            read();
+            return;
+        }
+        queue_.reset(new ParseQueue(node_, &node_->statistics(), queue_capacity,
+                                    queue_policy));
         io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
         // This function is used to ask the io_service to execute the given handler,
         // but without allowing the io_service to call the handler from inside this
@@ -355,6 +424,7 @@ namespace io_comm_rx {
         // otherwise while post queues the work no matter what.
         async_background_thread_.reset(new boost::thread(
             boost::bind(&boost::asio::io_service::run, io_service_)));
+        node_->configureThread(async_background_thread_->native_handle(), "io");
         // Note that io_service_ is already pointer, hence need dereferencing
         // operator & (ampersand). If the value of the pointer for the current thread
         // is changed using reset(), then the previous value is destroyed by calling
@@ -365,32 +435,64 @@ namespace io_comm_rx {
         uint16_t count = 0;
         waiting_thread_.reset(new boost::thread(
             boost::bind(&AsyncManager::callAsyncWait, this, &count)));
+        node_->configureThread(waiting_thread_->native_handle(), "waiting");
 
         node_->log(LogLevel::DEBUG, "Launching tryParsing() thread..");
         parsing_thread_.reset(
             new boost::thread(boost::bind(&AsyncManager::tryParsing, this)));
+        node_->configureThread(parsing_thread_->native_handle(), "parsing");
     } // Calls std::terminate() on thread just created
 
     template <typename StreamT>
     AsyncManager<StreamT>::~AsyncManager()
     {
-        close();
+        stopping_ = true;
+        if (shared_io_service_)
+        {
+            // The shared io_service keeps running, the stream is closed on the
+            // strand so that no handler of this connection uses it meanwhile.
+            // Wait for the handlers, which are cancelled by close().
+            ++outstanding_;
+            strand_.post([this]() {
+                close();
+                finished();
+            });
+            std::unique_lock<std::mutex> lock(outstanding_mutex_);
+            all_finished_.wait(lock, [this] { return outstanding_ == 0; });
+            return;
+        }
         io_service_->stop();
-        try_parsing_ = true;
-        parsing_condition_.notify_one();
+        queue_->close();
         parsing_thread_->join();
         waiting_thread_->join();
         async_background_thread_->join();
+        // No handler runs anymore
+        close();
     }
 
     template <typename StreamT>
     void AsyncManager<StreamT>::read()
     {
+        ++outstanding_;
+        if (socket_fd_ >= 0)
+        {
+            // Waits for data only, it is read together with its timestamp in
+            // asyncWaitHandler
+            stream_->async_read_some(
+                boost::asio::null_buffers(),
+                strand_.wrap(
+                    boost::bind(&AsyncManager<StreamT>::asyncWaitHandler, this,
+                                boost::asio::placeholders::error)));
+            if (do_read_count_ < 5)
+                ++do_read_count_;
+            return;
+        }
         stream_->async_read_some(
             boost::asio::buffer(in_.data(), in_.size()),
-            boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
-                        boost::asio::placeholders::error,
-                        boost::asio::placeholders::bytes_transferred));
+            strand_.wrap(
+                boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
+                            boost::asio::placeholders::error,
+                            boost::asio::placeholders::bytes_transferred)));
         // The handler is async_read_some_handler, whose call is postponed to
         // when async_read_some completes.
         if (do_read_count_ < 5)
@@ -400,32 +502,160 @@ namespace io_comm_rx {
     template <typename StreamT>
     void AsyncManager<StreamT>::asyncReadSomeHandler(
         const boost::system::error_code& error, std::size_t bytes_transferred)
+    {
+        handleRead(error, bytes_transferred, node_->getTime());
+        finished();
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::asyncWaitHandler(
+        const boost::system::error_code& error)
     {
         if (error)
         {
-            node_->log(LogLevel::ERROR,
-                       "Rx ASIO input buffer read error: " + error.message() + ", " +
-                           std::to_string(bytes_transferred));
+            handleRead(error, 0, 0);
+            finished();
+            return;
+        }
+        uint64_t kernel_time;
+        ssize_t n = socket_timestamps::receive(socket_fd_, in_.data(), in_.size(),
+                                               kernel_time);
+        if (n < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+                // Spurious wakeup
+                continueReading(boost::system::error_code());
+            else
+                handleRead(boost::system::error_code(
+                               errno, boost::system::system_category()),
+                           0, 0);
+            finished();
+            return;
+        }
+        if (n == 0)
+        {
+            handleRead(boost::asio::error::eof, 0, 0);
+            finished();
+            return;
+        }
+
+        Timestamp inTime = node_->getTime();
+        if (kernel_time != 0)
+        {
+            // Kernel timestamps are wall-clock time, they cannot be used with
+            // e.g. simulated time of the node
+            if (!kernel_time_checked_)
+            {
+                kernel_time_checked_ = true;
+                int64_t diff = static_cast<int64_t>(inTime - kernel_time);
+                if ((diff > 1000000000) || (diff < -1000000000))
+                {
+                    node_->log(LogLevel::WARN,
+                               "Kernel receive timestamps differ from the time "
+                               "of the node by more than 1 s, not using them.");
+                    socket_fd_ = -1;
+                }
+            }
+            if (socket_fd_ >= 0)
+                inTime = kernel_time;
+        }
+        handleRead(boost::system::error_code(), static_cast<std::size_t>(n),
+                   inTime);
+        finished();
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::handleRead(const boost::system::error_code& error,
+                                           std::size_t bytes_transferred,
+                                           Timestamp inTime)
+    {
+        if (error)
+        {
+            // Reads cancelled by close() are expected
+            if (!stopping_ || (error != boost::asio::error::operation_aborted))
+                node_->log(LogLevel::ERROR, "Rx ASIO input buffer read error: " +
+                                                error.message() + ", " +
+                                                std::to_string(bytes_transferred));
         } else if (bytes_transferred > 0)
         {
-            Timestamp inTime = node_->getTime();
+            node_->statistics().addBytes(bytes_transferred);
+            StreamRecorder* recorder = recorder_;
+            if (recorder)
+                recorder->write(inTime, in_.data(), bytes_transferred);
             if (read_callback_ &&
                 !stopping_) // Will be false in InitializeSerial (first call)
                             // since read_callback_ not added yet..
             {
-                boost::mutex::scoped_lock lock(parse_mutex_);
-                parsing_condition_.wait(lock, [this]() { return allow_writing_; });
-                circular_buffer_.write(in_.data(), bytes_transferred);
-                allow_writing_ = false;
-                try_parsing_ = true;
-                recvTime_ = inTime;
-                lock.unlock();
-                parsing_condition_.notify_one();
+                if (shared_io_service_)
+                {
+                    parse(inTime, in_.data(), bytes_transferred);
+                    continueReading(error);
+                    return;
+                }
+                // Waits or drops according to the policy if the parsing thread
+                // falls behind
+                queue_->push(inTime, in_.data(), bytes_transferred);
             }
         }
 
-        if (!stopping_)
+        continueReading(error);
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::continueReading(
+        const boost::system::error_code& error)
+    {
+        if (stopping_)
+            return;
+        if (!shared_io_service_)
             io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
+        else if (!error)
+            // Reads are chained, hence never concurrent for one connection
+            read();
+        else
+            // Retrying would keep a worker thread busy for a lost connection
+            node_->log(LogLevel::ERROR, "Stopped reading from the Rx.");
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::parse(Timestamp recvTime, const uint8_t* data,
+                                      std::size_t size)
+    {
+        pending_.insert(pending_.end(), data, data + size);
+        node_->statistics().updateBufferLevel(pending_.size());
+        parsePending(recvTime);
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::parsePending(Timestamp recvTime)
+    {
+        std::size_t arg_for_read_callback = pending_.size();
+        try
+        {
+            read_callback_(recvTime, pending_.data(), arg_for_read_callback);
+            pending_.clear();
+        } catch (std::size_t& parsing_failed_here)
+        {
+            pending_.erase(pending_.begin(), pending_.begin() + parsing_failed_here);
+            // Far longer than any block or sentence, hence not going to be parsed
+            if (pending_.size() > buffer_size_ * 16)
+            {
+                node_->log(LogLevel::WARN,
+                           "Discarding " + std::to_string(pending_.size()) +
+                               " bytes that could not be parsed.");
+                pending_.clear();
+            }
+        }
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::finished()
+    {
+        // Notifying under the lock keeps the destructor from returning, and
+        // thus destroying all_finished_, before notify_all() is done
+        std::lock_guard<std::mutex> lock(outstanding_mutex_);
+        if (--outstanding_ == 0)
+            all_finished_.notify_all();
     }
 
     template <typename StreamT>
@@ -0,0 +1,146 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+// Boost includes
+#include <boost/shared_ptr.hpp>
+// ROS includes
+#include <ros/message_traits.h>
+#include <rosbag/bag.h>
+
+#ifndef BAG_WRITER_HPP
+#define BAG_WRITER_HPP
+
+/**
+ * @file bag_writer.hpp
+ * @brief Declares a class that writes ROS messages to a rosbag in a thread of
+ * its own
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class BagWriter
+     * @brief Writes messages to a rosbag on a writer thread, so that serialization
+     * and disk I/O overlap with decoding
+     *
+     * Messages are queued by shared pointer and must not be altered afterwards.
+     * If the queue is full, write() blocks, so that no message is dropped. If a
+     * write fails, the writer stops and close() throws the error. Needs no ROS
+     * master.
+     */
+    class BagWriter
+    {
+    public:
+        /**
+         * @brief Opens the bag, throws rosbag::BagException on failure
+         * @param[in] file_name The name of (or path to) the bag to be written
+         * @param[in] max_queued Maximum number of messages waiting to be written
+         */
+        explicit BagWriter(const std::string& file_name,
+                           std::size_t max_queued = 4096);
+
+        //! Writes the remaining messages and closes the bag, errors are only
+        //! reported by close()
+        ~BagWriter();
+
+        BagWriter(const BagWriter&) = delete;
+        BagWriter& operator=(const BagWriter&) = delete;
+
+        /**
+         * @brief Queues a message, stamped with its header time if it has one or
+         * else with the time of the message written before
+         * @param[in] topic Topic of the message
+         * @param[in] msg Shared pointer to the message
+         */
+        template <typename M>
+        void write(const std::string& topic, const boost::shared_ptr<M>& msg)
+        {
+            boost::shared_ptr<const M> cmsg(msg);
+            const ros::Time* stamp = ros::message_traits::timeStamp(*cmsg);
+            push([this, topic, cmsg, stamp](rosbag::Bag& bag) {
+                if (stamp && !stamp->isZero())
+                    last_stamp_ = *stamp;
+                bag.write(topic, last_stamp_, cmsg);
+            });
+        }
+
+        /**
+         * @brief Writes the remaining messages and closes the bag
+         *
+         * Throws the error that stopped the writer thread, e.g.
+         * rosbag::BagException if the disk is full.
+         */
+        void close();
+
+        //! Number of messages written so far
+        uint64_t written() const;
+
+    private:
+        //! Queues a write operation, blocks while the queue is full
+        void push(std::function<void(rosbag::Bag&)> op);
+
+        //! Writer thread
+        void run();
+
+        //! The bag, only accessed by the writer thread once it runs
+        rosbag::Bag bag_;
+        //! Maximum number of queued messages
+        std::size_t max_queued_;
+        //! Queued write operations
+        std::deque<std::function<void(rosbag::Bag&)>> queue_;
+        //! Protects queue_, closing_, error_ and written_
+        mutable std::mutex mutex_;
+        //! Signals changes of queue_ and closing_
+        std::condition_variable cv_;
+        //! Whether the bag is being closed
+        bool closing_ = false;
+        //! Error that stopped the writer thread, thrown by close()
+        std::exception_ptr error_;
+        //! Number of messages written so far
+        uint64_t written_ = 0;
+        //! Bag time of the last message, bag times must not be zero
+        ros::Time last_stamp_ = ros::TIME_MIN;
+        //! Writer thread
+        std::thread thread_;
+    };
+} // namespace io_comm_rx
+
+#endif // BAG_WRITER_HPP
@@ -0,0 +1,179 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+// Boost includes
+#include <boost/variant.hpp>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/abstraction/msg_typedefs.hpp>
+#include <septentrio_gnss_driver/communication/settings.h>
+
+#ifndef BATCH_DECODER_HPP
+#define BATCH_DECODER_HPP
+
+/**
+ * @file batch_decoder.hpp
+ * @brief Declares a decoder that converts whole SBF logs on all cores
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Any message the batch decoder produces
+    typedef boost::variant<
+        PVTCartesianMsg::Ptr, PVTGeodeticMsg::Ptr, BaseVectorCartMsg::Ptr,
+        BaseVectorGeodMsg::Ptr, PosCovCartesianMsg::Ptr, PosCovGeodeticMsg::Ptr,
+        VelCovGeodeticMsg::Ptr, AttEulerMsg::Ptr, AttCovEulerMsg::Ptr,
+        INSNavCartMsg::Ptr, INSNavGeodMsg::Ptr, IMUSetupMsg::Ptr,
+        VelSensorSetupMsg::Ptr, ExtSensorMeasMsg::Ptr, MeasEpochMsg::Ptr,
+        MeasEpochColumnarMsg::Ptr>
+        DecodedMsg;
+
+    /**
+     * @brief A message decoded from one SBF block
+     */
+    struct DecodedBlock
+    {
+        //! GPS time in milliseconds since the GPS epoch
+        uint64_t gps_time;
+        //! Topic the message belongs to
+        const char* topic;
+        //! The message
+        DecodedMsg msg;
+    };
+
+    /**
+     * @class DecodeSink
+     * @brief Receives the output of the BatchDecoder, e.g. to publish or to store
+     * it
+     *
+     * Messages are handed over one at a time from the thread that called
+     * BatchDecoder::decode(), in TOW order.
+     */
+    class DecodeSink
+    {
+    public:
+        virtual ~DecodeSink() {}
+
+        /**
+         * @brief Takes one decoded message
+         * @param[in] topic Topic the message belongs to
+         * @param[in] msg The message, must not be altered
+         */
+        virtual void write(const std::string& topic, const DecodedMsg& msg) = 0;
+    };
+
+    /**
+     * @class BatchDecoder
+     * @brief Decodes an SBF log on a pool of worker threads
+     *
+     * The log is cut into chunks, which are resynchronized on the first valid,
+     * CRC-checked SBF block at or after their start and decoded independently.
+     * Results are merged in TOW order and handed to a DecodeSink. Only blocks
+     * that are decoded without state from other blocks are supported, i.e. the
+     * SBF topics of sbf_block_table.hpp enabled in the settings. Composite
+     * messages like /gpsfix or /pose need the sequential path of RxMessage, see
+     * unsupportedOutputs().
+     */
+    class BatchDecoder
+    {
+    public:
+        /**
+         * @param[in] logger Sink for log output, has to be thread-safe
+         * @param[in] settings Settings of which the publish flags, frame IDs,
+         * leap seconds and axis convention are used
+         * @param[in] threads Number of worker threads, 0 for the number of cores
+         */
+        BatchDecoder(LogSink* logger, const Settings* settings,
+                     unsigned threads = 0);
+
+        /**
+         * @brief Decodes the whole log, returns when all messages are written
+         * @param[in] data Start of the log
+         * @param[in] size Size of the log in bytes
+         * @param[in] sink Receives the decoded messages
+         * @param[in] stop Optional flag to abort decoding early
+         */
+        void decode(const uint8_t* data, std::size_t size, DecodeSink& sink,
+                    const std::atomic<bool>* stop = nullptr);
+
+        //! Number of messages written to the sink
+        uint64_t decodedMessages() const { return decoded_messages_; }
+
+        //! Number of SBF blocks that could not be parsed
+        uint64_t parseErrors() const { return parse_errors_; }
+
+        /**
+         * @brief Topics enabled in the settings that are not produced in batch
+         * mode, e.g. to warn about them
+         */
+        std::vector<std::string> unsupportedOutputs() const;
+
+    private:
+        /**
+         * @brief Leap seconds from the settings or else from the first
+         * ReceiverTime block of the log
+         */
+        int32_t leapSeconds(const uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Decodes the blocks starting within [begin, end) of the log
+         */
+        void decodeChunk(const uint8_t* data, std::size_t size, std::size_t begin,
+                         std::size_t end, std::vector<DecodedBlock>& blocks);
+
+        /**
+         * @brief Decodes one SBF block into zero, one or more messages
+         */
+        void decodeBlock(const std::vector<uint8_t>& block,
+                         std::vector<DecodedBlock>& blocks);
+
+        //! Sink for log output
+        LogSink* logger_;
+        //! Settings of the driver
+        const Settings* settings_;
+        //! Number of worker threads
+        unsigned threads_;
+        //! Leap seconds applied to the time stamps
+        int32_t leap_seconds_ = 0;
+        //! Number of messages written to the sink
+        uint64_t decoded_messages_ = 0;
+        //! Number of SBF blocks that could not be parsed
+        std::atomic<uint64_t> parse_errors_;
+    };
+} // namespace io_comm_rx
+
+#endif // BATCH_DECODER_HPP
@@ -94,6 +94,7 @@
 
 // ROSaic and C++ includes
 #include <algorithm>
+#include <vector>
 #include <septentrio_gnss_driver/communication/rx_message.hpp>
 
 /**
@@ -102,15 +103,6 @@
  * @brief Handles callbacks when reading NMEA/SBF messages
  */
 
-extern bool g_response_received;
-extern boost::mutex g_response_mutex;
-extern boost::condition_variable g_response_condition;
-extern bool g_cd_received;
-extern boost::mutex g_cd_mutex;
-extern boost::condition_variable g_cd_condition;
-extern uint32_t g_cd_count;
-extern std::string g_rx_tcp_port;
-
 namespace io_comm_rx {
     /**
      * @class CallbackHandler
@@ -188,11 +180,17 @@ namespace io_comm_rx {
                               boost::shared_ptr<AbstractCallbackHandler>>
             CallbackMap;
 
-        CallbackHandlers(ROSaicNodeBase* node, Settings* settings) : 
-            node_(node),
-            rx_message_(node, settings),
+        CallbackHandlers(ROSaicNodeBase* node, Settings* settings) :
+            node_(node), rx_message_(node, settings, &connection_),
             settings_(settings)
-        {}
+        {
+        }
+
+        /**
+         * @brief Gets the state of the command exchange with the Rx
+         * @return State, shared with the thread sending the commands
+         */
+        ConnectionState& connection() { return connection_; }
 
         /**
          * @brief Adds a pair to the multimap "callbackmap_", with the message_key
@@ -234,6 +232,18 @@ namespace io_comm_rx {
          */
         void readCallback(Timestamp recvTimestamp, const uint8_t* data, std::size_t& size);
 
+        /**
+         * @brief Sets the SBF blocks that are decoded first among those of a
+         * live read, the others follow in their original order
+         *
+         * Must be called before the first read is handled. If only some of the
+         * blocks of an enabled composite message like /gpsfix are given, the
+         * others are added with a warning.
+         * @param[in] block_numbers SBF block numbers of high priority, none to
+         * decode all messages in the order they are read
+         */
+        void prioritize(const std::vector<int32_t>& block_numbers);
+
         //! Callback handlers multimap for Rx messages; it needs to be public since
         //! we copy-assign (did not work otherwise) new callbackmap_, after inserting
         //! a pair to the multimap within the DefineMessages() method of the
@@ -241,111 +251,136 @@ namespace io_comm_rx {
         CallbackMap callbackmap_;
 
     private:
+        /**
+         * @brief Decodes the message rx_message_ points to and throws its offset
+         * from data if it is incomplete
+         * @param[in] data Buffer handed to readCallback()
+         */
+        void decode(const uint8_t* data);
+
+        /**
+         * @brief Decodes the SBF blocks of low priority deferred while reading
+         * the buffer
+         * @param[in] recvTimestamp Timestamp of buffer reception
+         * @param[in] data Buffer handed to readCallback()
+         * @param[in] size Size of the buffer
+         */
+        void decodeDeferred(Timestamp recvTimestamp, const uint8_t* data,
+                            std::size_t size);
+
         //! Pointer to Node
         ROSaicNodeBase* node_;
 
+        //! State of the command exchange with the Rx, declared before
+        //! rx_message_, which keeps a pointer to it
+        ConnectionState connection_;
+
         //! RxMessage parser
         RxMessage rx_message_;
 
         //! Settings
         Settings* settings_;
 
-        //! The "static" keyword resolves construct-by-copying issues related to this
-        //! mutex by making it available throughout the code unit. The mutex
-        //! constructor list contains "mutex (const mutex&) = delete", hence
-        //! construct-by-copying a mutex is explicitly prohibited. The get_handlers()
-        //! method of the Comm_IO class hence forces us to make this mutex static.
-        static boost::mutex callback_mutex_;
+        //! Serializes handling and insertion of callbacks, per connection so that
+        //! several Rxs can be handled concurrently
+        boost::mutex callback_mutex_;
+
+        //! Whether an SBF block, indexed by its number, has high decoding
+        //! priority, empty if messages are decoded in the order they are read
+        std::vector<bool> priority_;
+
+        //! Offsets of the deferred SBF blocks in the buffer being read
+        std::vector<std::size_t> deferred_;
 
         //! Determines which of the SBF blocks necessary for the gps_common::GPSFix
         //! ROS message arrives last and thus launches its construction
-        static std::string do_gpsfix_;
+        std::string do_gpsfix_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the gps_common::GPSFix
         //! ROS message arrives last and thus launches its construction
-        static std::string do_insgpsfix_;
+        std::string do_insgpsfix_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! NavSatFixMsg ROS message arrives last and thus launches its
         //! construction
-        static std::string do_navsatfix_;
+        std::string do_navsatfix_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the
         //! NavSatFixMsg ROS message arrives last and thus launches its construction
-        static std::string do_insnavsatfix_;
+        std::string do_insnavsatfix_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! geometry_msgs/PoseWithCovarianceStamped ROS message arrives last and thus
         //! launches its construction
-        static std::string do_pose_;
+        std::string do_pose_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the
         //! geometry_msgs/PoseWithCovarianceStamped ROS message arrives last and thus
         //! launches its construction
-        static std::string do_inspose_;
+        std::string do_inspose_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! diagnostic_msgs/DiagnosticArray ROS message arrives last and thus
         //! launches its construction
-        static std::string do_diagnostics_;
+        std::string do_diagnostics_ = "4014";
 
         //! Determines which of the SBF blocks necessary for the
         //! sensor_msgs/Imu ROS message arrives last and thus
         //! launches its construction
-        static std::string do_imu_;
+        std::string do_imu_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! nav_msgs/Odometry ROS message arrives last and thus
         //! launches its construction
-        static std::string do_inslocalization_;
+        std::string do_inslocalization_ = "4226";
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for GPSFix to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> GPSFixMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static GPSFixMap gpsfix_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const GPSFixMap gpsfix_map;
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for NavSatFix to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> NavSatFixMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static NavSatFixMap navsatfix_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const NavSatFixMap navsatfix_map;
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for PoseWithCovarianceStamped to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> PoseWithCovarianceStampedMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static PoseWithCovarianceStampedMap pose_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const PoseWithCovarianceStampedMap pose_map;
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for DiagnosticArray to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> DiagnosticArrayMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static DiagnosticArrayMap diagnosticarray_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const DiagnosticArrayMap diagnosticarray_map;
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for Imu to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> ImuMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static ImuMap imu_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const ImuMap imu_map;
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for Localization to a uint32_t
         typedef std::unordered_map<std::string, uint32_t> LocalizationMap;
 
-        //! All instances of the CallbackHandlers class shall have access to the map
-        //! without reinitializing it, hence static
-        static LocalizationMap localization_map;
+        //! Lookup table shared by all instances of the CallbackHandlers class,
+        //! hence static and constant
+        static const LocalizationMap localization_map;
     };
 
 } // namespace io_comm_rx
@@ -0,0 +1,147 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ includes
+#include <cstdint>
+#include <deque>
+
+#ifndef CLOCK_OFFSET_MODEL_HPP
+#define CLOCK_OFFSET_MODEL_HPP
+
+/**
+ * @file clock_offset_model.hpp
+ * @brief Declares an online model of the offset between GNSS and host time
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class ClockOffsetModel
+     * @brief Maps GNSS time into the host clock via an online model of offset and
+     * drift
+     *
+     * Every block yields a sample of host receive time minus GNSS time, i.e. the
+     * clock offset plus the delay of output, transport and parsing. The delay is
+     * never negative, hence the lower envelope of the samples follows the offset
+     * best: the minimum per second of GNSS time is kept for the latest seconds and
+     * a line, i.e. offset and drift, is fitted to these minima by least squares
+     * whenever a second is complete. Until enough seconds are available for the
+     * drift, only the offset is estimated.
+     *
+     * Mapped times are free of the jitter of the delivery and monotonic for
+     * increasing GNSS time, while the receiver clock need not be synchronized to
+     * the host clock. Leap seconds are part of the offset. A step of the host
+     * clock by more than a second restarts the model.
+     */
+    class ClockOffsetModel
+    {
+    public:
+        //! Number of seconds of GNSS time of which the minima are fitted
+        static const std::size_t WINDOW = 64;
+
+        /**
+         * @brief Adds a sample
+         * @param[in] gnss_time GNSS time of the block in nanoseconds
+         * @param[in] host_time Host receive time of the block in nanoseconds
+         */
+        void addSample(uint64_t gnss_time, uint64_t host_time);
+
+        //! Whether at least one sample has been added
+        bool valid() const { return has_current_; }
+
+        /**
+         * @brief Maps GNSS time into the host clock
+         *
+         * Not monotonically increasing GNSS time, e.g. of an older epoch, is
+         * mapped as is.
+         * @param[in] gnss_time GNSS time in nanoseconds
+         * @return Host time in nanoseconds, gnss_time if the model is not valid
+         */
+        uint64_t toHost(uint64_t gnss_time);
+
+        //! Fitted host time minus GNSS time at the latest sample in nanoseconds
+        double offset() const;
+        //! Fitted drift of the host clock relative to GNSS time, e.g. 1e-6 is 1
+        //! ppm
+        double drift() const { return drift_; }
+
+        //! Forgets all samples
+        void reset();
+
+    private:
+        /**
+         * @struct Bin
+         * @brief Lowest sample of one second of GNSS time
+         */
+        struct Bin
+        {
+            //! Second of GNSS time
+            uint64_t second;
+            //! GNSS time of the lowest sample in ns relative to reference_time_
+            double time;
+            //! Lowest sample in ns relative to reference_offset_
+            double offset;
+        };
+
+        //! Fits offset and drift to the completed bins, or to the current one
+        //! if there are none
+        void fit();
+
+        //! Offset modelled at GNSS time relative to reference_time_ in ns
+        double model(double time) const
+        {
+            return offset_ + drift_ * (time - fit_time_);
+        }
+
+        //! Lowest samples of the latest WINDOW completed seconds, oldest first
+        std::deque<Bin> bins_;
+        //! Lowest sample of the current second
+        Bin current_;
+        //! Whether current_ holds a sample
+        bool has_current_ = false;
+        //! GNSS time of the first sample, the reference of Bin::time
+        uint64_t reference_time_ = 0;
+        //! Offset of the first sample, the reference of Bin::offset
+        int64_t reference_offset_ = 0;
+        //! Fitted offset at fit_time_ relative to reference_offset_ in ns
+        double offset_ = 0.0;
+        //! Fitted drift
+        double drift_ = 0.0;
+        //! Mean time of the fitted bins relative to reference_time_ in ns
+        double fit_time_ = 0.0;
+        //! Latest GNSS time mapped by toHost()
+        uint64_t last_gnss_time_ = 0;
+        //! Host time it was mapped to
+        uint64_t last_host_time_ = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // CLOCK_OFFSET_MODEL_HPP
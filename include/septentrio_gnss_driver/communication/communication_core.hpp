@@ -109,8 +109,13 @@ namespace io_comm_rx {
         /**
          * @brief Constructor of the class Comm_IO
          * @param[in] node Pointer to node
+         * @param[in] settings Settings of the node
+         * @param[in] io_service I/O service shared with other connections and
+         * run by their common worker threads, nullptr for one of its own
          */
-        Comm_IO(ROSaicNodeBase* node, Settings* settings);
+        Comm_IO(ROSaicNodeBase* node, Settings* settings,
+                const boost::shared_ptr<boost::asio::io_service>& io_service =
+                    boost::shared_ptr<boost::asio::io_service>());
         /**
          * @brief Default destructor of the class Comm_IO
          */
@@ -134,6 +139,32 @@ namespace io_comm_rx {
          * */
         void defineMessages();
 
+        /**
+         * @brief Reads a whole SBF file in the calling thread, e.g. for offline
+         * conversion, and returns once the file has been parsed
+         * @param[in] file_name The name of (or path to) the SBF file
+         * @return False if the file could not be read, the error is logged
+         */
+        bool readSBFFile(const std::string& file_name);
+
+        /**
+         * @brief Parses data as if it was read from the Rx, e.g. for benchmarks
+         *
+         * Throws the offset of an incomplete block or sentence like the read
+         * callback of the managers does.
+         * @param[in] recv_time Receive time of the data
+         * @param[in] data Data to be parsed
+         * @param[in] size Number of bytes
+         */
+        void parse(Timestamp recv_time, const uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Decodes the given SBF blocks of a read from a live Rx ahead of
+         * the others, as initializeIO() does with decode_priority
+         * @param[in] block_numbers SBF block numbers, none to decode in order
+         */
+        void prioritize(const std::vector<int32_t>& block_numbers);
+
         /**
          * @brief Hands over NMEA velocity message over to the send() method of
          * manager_
@@ -150,8 +181,9 @@ namespace io_comm_rx {
         /**
          * @brief Sets up the stage for SBF file reading
          * @param[in] file_name The name of (or path to) the SBF file, e.g. "xyz.sbf"
+         * @return False if the file could not be read, the error is logged
          */
-        void prepareSBFFileReading(std::string file_name);
+        bool prepareSBFFileReading(std::string file_name);
 
         /**
          * @brief Sets up the stage for PCAP file reading
@@ -192,10 +224,21 @@ namespace io_comm_rx {
         /**
          * @brief Initializes SBF file reading and reads SBF file by repeatedly
          * calling read_callback_()
+         *
+         * Throws std::runtime_error if the file cannot be opened or the rosbag
+         * of batch mode cannot be written.
          * @param[in] file_name The name of (or path to) the SBF file, e.g. "xyz.sbf"
          */
         void initializeSBFFileReading(std::string file_name);
 
+        /**
+         * @brief Reads a gzip or zstd compressed SBF file, decompressed on a
+         * thread of its own, by repeatedly calling read_callback_()
+         * @param[in] file_name The name of (or path to) the compressed SBF file,
+         * e.g. "xyz.sbf.zst"
+         */
+        void readCompressedSBFFile(const std::string& file_name);
+
         /**
          * @brief Initializes PCAP file reading and reads PCAP file by repeatedly
          * calling read_callback_()
@@ -240,11 +283,17 @@ namespace io_comm_rx {
         bool serial_;
         //! Saves the port description
         std::string serial_port_;
+        //! Records the raw stream of the Rx, declared before manager_ so that it
+        //! outlives it
+        std::unique_ptr<StreamRecorder> recorder_;
         //! Processes I/O stream data
         //! This declaration is deliberately stream-independent (Serial or TCP).
         boost::shared_ptr<Manager> manager_;
         //! Baudrate at the moment, unless InitializeSerial or ResetSerial fail
         uint32_t baudrate_;
+        //! I/O service shared with other connections, nullptr if the manager
+        //! runs one of its own
+        boost::shared_ptr<boost::asio::io_service> shared_io_service_;
 
         bool nmeaActivated_ = false;
 
@@ -0,0 +1,83 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// Boost includes
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+// C++ includes
+#include <cstdint>
+#include <string>
+
+#ifndef CONNECTION_STATE_HPP
+#define CONNECTION_STATE_HPP
+
+/**
+ * @file connection_state.hpp
+ * @brief Declares the state of the command exchange with one Rx
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @struct ConnectionState
+     * @brief Synchronizes the configuration thread, which sends commands, with
+     * the parsing thread, which receives the replies of the Rx
+     *
+     * Each connection has its own, so that several Rxs can be handled by one
+     * process.
+     */
+    struct ConnectionState
+    {
+        //! Mutex to control changes of "response_received"
+        boost::mutex response_mutex;
+        //! Determines whether a command reply was received from the Rx
+        bool response_received = false;
+        //! Condition variable complementing "response_mutex"
+        boost::condition_variable response_condition;
+        //! Mutex to control changes of "cd_received"
+        boost::mutex cd_mutex;
+        //! Determines whether the connection descriptor was received from the Rx
+        bool cd_received = false;
+        //! Condition variable complementing "cd_mutex"
+        boost::condition_variable cd_condition;
+        //! Whether or not we still want to read the connection descriptor, which
+        //! we only want in the very beginning to know whether it is IP10, IP11
+        //! etc.
+        bool read_cd = true;
+        //! Rx TCP port, e.g. IP10 or IP11, to which ROSaic is connected to
+        std::string rx_tcp_port;
+        //! Since after SSSSSSSSSSS we need to wait for second connection
+        //! descriptor, we have to count the connection descriptors
+        uint32_t cd_count = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // CONNECTION_STATE_HPP
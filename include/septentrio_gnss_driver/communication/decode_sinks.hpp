@@ -0,0 +1,131 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/bag_writer.hpp>
+#include <septentrio_gnss_driver/communication/batch_decoder.hpp>
+
+#ifndef DECODE_SINKS_HPP
+#define DECODE_SINKS_HPP
+
+/**
+ * @file decode_sinks.hpp
+ * @brief Declares sinks that publish or store the output of the BatchDecoder
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class PublisherSink
+     * @brief Publishes decoded messages via the node
+     */
+    class PublisherSink : public DecodeSink
+    {
+    public:
+        //! @param[in] node Pointer to the node
+        explicit PublisherSink(ROSaicNodeBase* node) : node_(node) {}
+
+        void write(const std::string& topic, const DecodedMsg& msg) override
+        {
+            boost::apply_visitor(Visitor{node_, topic}, msg);
+        }
+
+    private:
+        struct Visitor : public boost::static_visitor<void>
+        {
+            ROSaicNodeBase* node;
+            const std::string& topic;
+
+            Visitor(ROSaicNodeBase* node, const std::string& topic) :
+                node(node), topic(topic)
+            {
+            }
+
+            template <typename P>
+            void operator()(const P& msg) const
+            {
+                node->publishMessage(topic, msg);
+            }
+        };
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+    };
+
+    /**
+     * @class BagSink
+     * @brief Writes decoded messages to a rosbag, stamped with their header time
+     *
+     * Writing runs on a thread of its own, overlapping with decoding. Needs no
+     * ROS master. Throws rosbag::BagException if the bag cannot be opened.
+     */
+    class BagSink : public DecodeSink
+    {
+    public:
+        //! @param[in] file_name The name of (or path to) the bag to be written
+        explicit BagSink(const std::string& file_name) : writer_(file_name) {}
+
+        void write(const std::string& topic, const DecodedMsg& msg) override
+        {
+            boost::apply_visitor(Visitor{writer_, topic}, msg);
+        }
+
+        /**
+         * @brief Writes the remaining messages and closes the bag, throws if
+         * writing failed
+         */
+        void close() { writer_.close(); }
+
+    private:
+        struct Visitor : public boost::static_visitor<void>
+        {
+            BagWriter& writer;
+            const std::string& topic;
+
+            Visitor(BagWriter& writer, const std::string& topic) :
+                writer(writer), topic(topic)
+            {
+            }
+
+            template <typename P>
+            void operator()(const P& msg) const
+            {
+                writer.write(topic, msg);
+            }
+        };
+
+        //! Writer of the bag, closes it on destruction if close() was not called
+        BagWriter writer_;
+    };
+} // namespace io_comm_rx
+
+#endif // DECODE_SINKS_HPP
@@ -0,0 +1,163 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef DECOMPRESSING_READER_HPP
+#define DECOMPRESSING_READER_HPP
+
+/**
+ * @file decompressing_reader.hpp
+ * @brief Declares a class that reads gzip or zstd compressed files as a stream
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class DecompressingReader
+     * @brief Decompresses a gzip or zstd compressed file on a thread of its own,
+     * so that decompression overlaps with decoding
+     *
+     * The thread decompresses ahead in chunks of bounded size and stops while
+     * the given number of chunks has not been read yet, such that memory use
+     * does not depend on the size of the file. The format is detected from the
+     * magic at the start of the file. Concatenated gzip members and zstd frames
+     * are read one after the other.
+     */
+    class DecompressingReader
+    {
+    public:
+        /**
+         * @brief Opens the file and starts decompressing, throws
+         * std::runtime_error if the file cannot be opened or is neither gzip nor
+         * zstd compressed
+         * @param[in] file_name The name of (or path to) the compressed file
+         * @param[in] chunk_size Size of the decompressed chunks in bytes
+         * @param[in] max_chunks Maximum number of chunks decompressed ahead
+         */
+        explicit DecompressingReader(const std::string& file_name,
+                                     std::size_t chunk_size = 1024 * 1024,
+                                     std::size_t max_chunks = 4);
+
+        //! Stops decompressing and closes the file
+        ~DecompressingReader();
+
+        DecompressingReader(const DecompressingReader&) = delete;
+        DecompressingReader& operator=(const DecompressingReader&) = delete;
+
+        /**
+         * @brief Whether a file is to be read decompressed, judged by its name
+         * @param[in] file_name The name of (or path to) the file
+         * @return True for the extensions .gz and .zst
+         */
+        static bool isCompressed(const std::string& file_name);
+
+        /**
+         * @brief Reads decompressed bytes, waits for the decompression thread if
+         * none are available yet
+         *
+         * Throws std::runtime_error if the file turns out to be corrupt.
+         * @param[out] data Buffer for the bytes
+         * @param[in] size Size of the buffer
+         * @return Number of bytes read, 0 at the end of the file
+         */
+        std::size_t read(uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Opens the decompressed stream as a read-only FILE, e.g. for
+         * libpcap
+         *
+         * The reader has to outlive the FILE, which is closed with fclose().
+         * @return The FILE, nullptr on failure
+         */
+        FILE* openStream();
+
+    private:
+        //! Compression formats
+        enum Format
+        {
+            GZIP,
+            ZSTD
+        };
+
+        //! Decompression thread
+        void run();
+
+        //! Decompresses a gzip file, returns an error message on failure
+        std::string inflateGzip();
+
+        //! Decompresses a zstd file, returns an error message on failure
+        std::string decompressZstd();
+
+        //! Hands a decompressed chunk to the reader, false if stopped
+        bool push(std::vector<uint8_t>&& chunk);
+
+        //! The compressed file
+        FILE* file_;
+        //! Compression format of the file
+        Format format_;
+        //! Size of the decompressed chunks
+        std::size_t chunk_size_;
+        //! Maximum number of chunks decompressed ahead
+        std::size_t max_chunks_;
+
+        //! Decompressed chunks not read yet
+        std::deque<std::vector<uint8_t>> chunks_;
+        //! Chunk currently read from
+        std::vector<uint8_t> current_;
+        //! Position of the next byte to read in current_
+        std::size_t current_pos_ = 0;
+        //! Protects chunks_, finished_, error_ and stopping_
+        std::mutex mutex_;
+        //! Signals changes of chunks_, finished_ and stopping_
+        std::condition_variable cv_;
+        //! Whether the whole file has been decompressed
+        bool finished_ = false;
+        //! Error message of the decompression thread, empty if none
+        std::string error_;
+        //! Whether the reader is being destroyed
+        bool stopping_ = false;
+
+        //! Decompression thread
+        std::thread thread_;
+    };
+} // namespace io_comm_rx
+
+#endif // DECOMPRESSING_READER_HPP
@@ -0,0 +1,172 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ includes
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifndef LATENCY_ESTIMATOR_HPP
+#define LATENCY_ESTIMATOR_HPP
+
+/**
+ * @file latency_estimator.hpp
+ * @brief Declares the estimator of the transport latency of SBF blocks
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class RobustTrack
+     * @brief Robust running estimate of a noisy quantity with outliers
+     *
+     * Exponentially weighted mean whose innovations are clipped to a multiple of
+     * the running mean absolute deviation, such that single late blocks do not
+     * pull the estimate.
+     */
+    class RobustTrack
+    {
+    public:
+        //! Adds a sample
+        void update(double x);
+
+        //! Number of samples so far
+        uint64_t count() const { return count_; }
+        //! Current estimate
+        double estimate() const { return estimate_; }
+        //! Current mean absolute deviation
+        double deviation() const { return deviation_; }
+
+    private:
+        //! Number of samples so far
+        uint64_t count_ = 0;
+        //! Current estimate
+        double estimate_ = 0.0;
+        //! Mean absolute deviation of the samples from the estimate
+        double deviation_ = 0.0;
+    };
+
+    /**
+     * @class LatencyEstimator
+     * @brief Estimates how stale SBF blocks are when they arrive
+     *
+     * The latency of a block is its receive time minus its GNSS time, converted
+     * to UTC with the leap seconds from ReceiverTime. It thus includes the output
+     * delay of the Rx, the transport and any buffering on the way, and is only
+     * meaningful if the system clock is synchronized, e.g. via NTP or PTP.
+     *
+     * The latency is tracked robustly overall and per block number. The baseline
+     * follows the lowest latency seen, slowly rising to adapt to changes of the
+     * link. A latency well above the baseline hints at congestion of the link or
+     * buffering. Moreover, the distribution of the latest samples is kept, as well
+     * as the latency reported by the Rx itself in INS blocks.
+     *
+     * Samples are added by the parsing thread and read by another one, hence
+     * access is guarded by a mutex.
+     */
+    class LatencyEstimator
+    {
+    public:
+        //! Number of latest samples of which the distribution is given
+        static const std::size_t WINDOW = 1024;
+
+        /**
+         * @struct Summary
+         * @brief Latency estimates at one point in time, all in seconds
+         */
+        struct Summary
+        {
+            //! Number of samples so far, the other fields are only valid if
+            //! there are any
+            uint64_t samples = 0;
+            //! Robust estimate of the latency of all blocks
+            double latency = 0.0;
+            //! Mean absolute deviation of the latency
+            double deviation = 0.0;
+            //! Lowest latency seen, slowly rising
+            double baseline = 0.0;
+            //! Distribution of the latest WINDOW samples
+            double minimum = 0.0;
+            double median = 0.0;
+            double percentile90 = 0.0;
+            double percentile99 = 0.0;
+            double maximum = 0.0;
+            //! Latency per block number
+            std::map<uint16_t, double> blocks;
+            //! Latency reported by the Rx per INS block number
+            std::map<uint16_t, double> reported;
+        };
+
+        LatencyEstimator();
+
+        /**
+         * @brief Adds the latency of a block
+         * @param[in] block_number SBF block number
+         * @param[in] latency_ns Receive time minus GNSS time in nanoseconds
+         */
+        void addSample(uint16_t block_number, int64_t latency_ns);
+
+        /**
+         * @brief Adds the latency reported by the Rx in an INS block
+         * @param[in] block_number SBF block number, e.g. 4226 for INSNavGeod
+         * @param[in] latency Valid latency field of the block in 0.0001 s
+         */
+        void addReportedLatency(uint16_t block_number, uint16_t latency);
+
+        /**
+         * @brief Takes a consistent copy of the latency estimates
+         * @param[out] summary Estimates in seconds
+         */
+        void summary(Summary& summary) const;
+
+        //! Forgets all samples
+        void reset();
+
+    private:
+        //! Guards all members
+        mutable std::mutex mutex_;
+        //! Latency of all blocks in seconds
+        RobustTrack overall_;
+        //! Latency per block number in seconds
+        std::map<uint16_t, RobustTrack> blocks_;
+        //! Latency reported by the Rx per INS block number in seconds
+        std::map<uint16_t, RobustTrack> reported_;
+        //! Lowest latency seen in seconds, slowly rising
+        double baseline_;
+        //! Latest samples in seconds, ring of WINDOW entries
+        std::vector<double> window_;
+        //! Next position in window_
+        std::size_t window_pos_ = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // LATENCY_ESTIMATOR_HPP
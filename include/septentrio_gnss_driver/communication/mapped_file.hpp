@@ -0,0 +1,86 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+/**
+ * @file mapped_file.hpp
+ * @brief Declares a class that maps a file read-only into memory
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Pages are loaded on first access and may be evicted again by the kernel,
+     * so the memory needed is independent of the file size and the first bytes
+     * are available immediately.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Maps the file, throws std::runtime_error on failure
+         * @param[in] file_name The name of (or path to) the file
+         * @param[in] sequential Whether the kernel is advised that the file will
+         * be read sequentially, i.e. to read ahead aggressively and drop pages
+         * soon after they have been read
+         */
+        explicit MappedFile(const std::string& file_name, bool sequential = true);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //! Start of the mapped file, nullptr if the file is empty
+        const uint8_t* data() const { return data_; }
+
+        //! Size of the file in bytes
+        std::size_t size() const { return size_; }
+
+    private:
+        //! Start of the mapping
+        const uint8_t* data_ = nullptr;
+        //! Size of the mapping
+        std::size_t size_ = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // MAPPED_FILE_HPP
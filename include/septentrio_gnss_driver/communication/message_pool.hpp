@@ -0,0 +1,167 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+// Boost includes
+#include <boost/shared_ptr.hpp>
+
+#ifndef MESSAGE_POOL_HPP
+#define MESSAGE_POOL_HPP
+
+/**
+ * @file message_pool.hpp
+ * @brief Declares a pool of recycled ROS messages for variable-length messages
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class MessagePool
+     * @brief Hands out messages whose vectors keep their capacity between epochs
+     *
+     * A message acquired from the pool is returned to it as soon as the last
+     * boost::shared_ptr referring to it is released, i.e. once the driver and all
+     * (intra-process) subscribers are done with it. Messages are handed out with
+     * their previous content, it is up to the caller to overwrite or clear() every
+     * field, which keeps the capacity of the std::vector members. The free list
+     * is shared with the deleter, so messages still held by subscribers after the
+     * pool has been destroyed are simply deleted.
+     */
+    template <typename M>
+    class MessagePool
+    {
+    public:
+        typedef boost::shared_ptr<M> MsgPtr;
+
+        /**
+         * @brief Constructor of the MessagePool class
+         * @param[in] max_free Maximum number of released messages kept for reuse
+         */
+        explicit MessagePool(std::size_t max_free = 8) :
+            storage_(std::make_shared<Storage>())
+        {
+            storage_->max_free = max_free;
+            storage_->free.reserve(max_free);
+        }
+
+        /**
+         * @brief Returns a recycled message, or a new one if none is available
+         * @return Shared pointer that gives the message back to the pool on
+         * release
+         */
+        MsgPtr acquire()
+        {
+            M* msg = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(storage_->mutex);
+                if (!storage_->free.empty())
+                {
+                    msg = storage_->free.back();
+                    storage_->free.pop_back();
+                }
+            }
+            if (!msg)
+            {
+                msg = new M();
+                std::lock_guard<std::mutex> lock(storage_->mutex);
+                ++storage_->allocations;
+            }
+            return MsgPtr(msg, Recycler(storage_));
+        }
+
+        //! Number of messages that had to be allocated since construction
+        std::size_t allocations() const
+        {
+            std::lock_guard<std::mutex> lock(storage_->mutex);
+            return storage_->allocations;
+        }
+
+        //! Number of messages currently waiting for reuse
+        std::size_t available() const
+        {
+            std::lock_guard<std::mutex> lock(storage_->mutex);
+            return storage_->free.size();
+        }
+
+    private:
+        //! State shared between the pool and the deleters of handed out messages
+        struct Storage
+        {
+            ~Storage()
+            {
+                for (M* msg : free)
+                    delete msg;
+            }
+
+            //! Protects the free list, released messages may come from any thread
+            std::mutex mutex;
+            //! Released messages waiting for reuse
+            std::vector<M*> free;
+            //! Maximum size of the free list
+            std::size_t max_free = 0;
+            //! Number of messages allocated so far
+            std::size_t allocations = 0;
+        };
+
+        //! Custom deleter putting released messages back into the free list
+        struct Recycler
+        {
+            explicit Recycler(const std::shared_ptr<Storage>& storage) :
+                storage_(storage)
+            {
+            }
+
+            void operator()(M* msg) const
+            {
+                if (std::shared_ptr<Storage> storage = storage_.lock())
+                {
+                    std::lock_guard<std::mutex> lock(storage->mutex);
+                    if (storage->free.size() < storage->max_free)
+                    {
+                        storage->free.push_back(msg);
+                        return;
+                    }
+                }
+                delete msg;
+            }
+
+            std::weak_ptr<Storage> storage_;
+        };
+
+        std::shared_ptr<Storage> storage_;
+    };
+} // namespace io_comm_rx
+
+#endif // MESSAGE_POOL_HPP
@@ -0,0 +1,246 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/communication/rx_statistics.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+
+#ifndef PARSE_QUEUE_HPP
+#define PARSE_QUEUE_HPP
+
+/**
+ * @file parse_queue.hpp
+ * @brief Declares the bounded queue between the reading and the parsing thread
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @brief What the reading thread does if the parser falls behind and the
+     * queue is full
+     */
+    enum class DropPolicy
+    {
+        //! Waits for the parser, data is eventually lost by the Rx or the kernel
+        BLOCK,
+        //! Drops the SBF blocks and NMEA sentences of the oldest epoch
+        DROP_OLDEST,
+        //! Drops the oldest SBF blocks and NMEA sentences that are neither PVT
+        //! nor INS first, then the oldest epoch
+        DROP_LOW_PRIORITY
+    };
+
+    /**
+     * @class ParseQueue
+     * @brief Bounded queue of the bytes read from the Rx that are yet to be
+     * parsed
+     *
+     * With a drop policy, reads are cut into SBF blocks and NMEA sentences by a
+     * Framer, so that only complete frames are dropped and the parser never has
+     * to resynchronize. Bytes outside of frames, e.g. command replies, are kept
+     * unless nothing else is left to drop. An incomplete frame at the end of a
+     * read is held back until it is complete. With BLOCK, reads are queued as
+     * they are.
+     *
+     * pop() returns the bytes of one read at a time, so that each keeps its
+     * receive time.
+     */
+    class ParseQueue
+    {
+    public:
+        /**
+         * @param[in] logger Sink for log output, has to outlive the queue
+         * @param[in] statistics Counters of blocked reads, drops and the queue
+         * level, have to outlive the queue
+         * @param[in] capacity Capacity in bytes
+         * @param[in] policy What to do if the queue is full
+         */
+        ParseQueue(LogSink* logger, RxStatistics* statistics,
+                   std::size_t capacity, DropPolicy policy);
+
+        ParseQueue(const ParseQueue&) = delete;
+        ParseQueue& operator=(const ParseQueue&) = delete;
+
+        /**
+         * @brief Converts the name of a policy, i.e. "block", "drop_oldest" or
+         * "drop_low_priority"
+         * @param[in] name Name of the policy
+         * @param[out] policy The policy
+         * @return False if the name is unknown
+         */
+        static bool toPolicy(const std::string& name, DropPolicy& policy);
+
+        /**
+         * @brief Whether an SBF block carries PVT, attitude or INS solutions or
+         * IMU measurements, which DROP_LOW_PRIORITY keeps longest
+         * @param[in] block_number SBF block number
+         */
+        static bool isNavigation(uint16_t block_number);
+
+        /**
+         * @brief Queues a read, called by the reading thread
+         *
+         * With BLOCK, waits until the parser made room, otherwise drops
+         * according to the policy if the queue is full.
+         * @param[in] recv_time Receive time in nanoseconds
+         * @param[in] data Bytes read
+         * @param[in] size Number of bytes read
+         * @return False if the queue was closed
+         */
+        bool push(uint64_t recv_time, const uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Takes the queued bytes of the oldest read, called by the parsing
+         * thread
+         * @param[out] data The bytes are appended to it
+         * @param[out] recv_time Receive time of the read
+         * @param[in] timeout Time to wait for a read
+         * @return False if nothing was read within the timeout or the queue was
+         * closed
+         */
+        bool pop(std::vector<uint8_t>& data, uint64_t& recv_time,
+                 std::chrono::milliseconds timeout);
+
+        //! Wakes up and ends both threads
+        void close();
+
+        //! Number of queued bytes
+        std::size_t size() const;
+
+    private:
+        //! Drop priority of a segment, lowest first
+        enum class Priority : uint8_t
+        {
+            LOW,
+            NAVIGATION,
+            UNFRAMED
+        };
+
+        //! Bytes of one frame, or bytes outside of frames, or one read with
+        //! BLOCK
+        struct Segment
+        {
+            //! Receive time of the read that completed the segment
+            uint64_t recv_time;
+            //! Sequence number of that read
+            uint64_t read;
+            //! Epoch, counted up with each new TOW of the SBF blocks
+            uint64_t epoch;
+            //! Drop priority
+            Priority priority;
+            //! The bytes
+            std::vector<uint8_t> bytes;
+        };
+
+        //! Segment found by the reading thread, not yet copied into the queue
+        struct Staged
+        {
+            std::size_t offset;
+            std::size_t size;
+            uint64_t epoch;
+            Priority priority;
+        };
+
+        //! Cuts data into staged_
+        //! @return Number of bytes staged, the rest is an incomplete frame
+        std::size_t frame(const uint8_t* data, std::size_t size);
+
+        //! Stages bytes outside of frames, merged with a preceding such segment
+        void stageUnframed(std::size_t offset, std::size_t size);
+
+        //! Copies a staged segment into the queue, mutex_ has to be locked
+        void enqueue(uint64_t recv_time, const uint8_t* data,
+                     const Staged& staged);
+
+        //! Drops segments according to the policy, mutex_ has to be locked
+        //! @return False if there was nothing left to drop
+        bool dropOne();
+
+        //! Drops the segments of the epoch of the oldest frame
+        //! @return False if there was no frame
+        bool dropOldestEpoch();
+
+        //! Removes a segment and counts it as dropped
+        std::deque<Segment>::iterator drop(std::deque<Segment>::iterator it);
+
+        //! Sink for log output
+        LogSink* logger_;
+        //! Counters of blocked reads, drops and the queue level
+        RxStatistics* statistics_;
+        //! Capacity in bytes
+        const std::size_t capacity_;
+        //! What to do if the queue is full
+        const DropPolicy policy_;
+
+        //! Frames reads if a drop policy is used, only used by the reading
+        //! thread like the members up to read_
+        Framer framer_;
+        //! Incomplete frame at the end of the previous read
+        std::vector<uint8_t> carry_;
+        //! Segments of the current read
+        std::vector<Staged> staged_;
+        //! Current epoch
+        uint64_t epoch_ = 0;
+        //! TOW of the current epoch
+        uint32_t tow_ = 0;
+        //! Sequence number of the current read
+        uint64_t read_ = 0;
+
+        //! Protects the members below
+        mutable std::mutex mutex_;
+        //! Signals the parsing thread that a read was queued
+        std::condition_variable not_empty_;
+        //! Signals the reading thread that the parser made room
+        std::condition_variable not_full_;
+        //! Queued segments, oldest first
+        std::deque<Segment> segments_;
+        //! Buffers of popped segments, reused to avoid allocations
+        std::vector<std::vector<uint8_t>> spare_;
+        //! Number of queued bytes
+        std::size_t size_ = 0;
+        //! Time of the last warning about dropped data
+        std::chrono::steady_clock::time_point last_warning_;
+        //! Whether close() was called
+        bool closed_ = false;
+    };
+} // namespace io_comm_rx
+
+#endif // PARSE_QUEUE_HPP
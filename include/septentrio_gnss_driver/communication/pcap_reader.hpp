@@ -32,8 +32,11 @@
 #define PCAP_READER_H
 
 #include <cstdint>
+#include <memory>
 #include <pcap/pcap.h>
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/decompressing_reader.hpp>
+#include <septentrio_gnss_driver/communication/tcp_reassembler.hpp>
 #include <vector>
 
 /**
@@ -64,7 +67,11 @@ namespace pcapReader {
 
     /**
      * @class PcapDevice
-     * @brief Class for handling a pcap file
+     * @brief Class for handling a pcap or pcapng file
+     *
+     * Supports Ethernet (with 802.1Q/802.1ad VLAN tags), Linux cooked (SLL and
+     * SLL2), BSD loopback and raw IP captures of TCP over IPv4 and IPv6. The
+     * payload is reassembled per TCP flow.
      */
     class PcapDevice
     {
@@ -73,13 +80,14 @@ namespace pcapReader {
 
         /**
          * @brief Constructor for PcapDevice
-         * @param[out] buffer Buffer to write read raw data to
+         * @param[in] filter Packet filter in pcap-filter syntax
          */
-        explicit PcapDevice(ROSaicNodeBase* node, buffer_t& buffer);
+        PcapDevice(ROSaicNodeBase* node, const std::string& filter = "tcp");
 
         /**
          * @brief Try to open a pcap file
-         * @param[in] device Path to pcap file
+         * @param[in] device Path to pcap file, read decompressed if it ends with
+         * .gz or .zst
          * @return True if success, false otherwise
          */
         bool connect(const char* device);
@@ -96,25 +104,60 @@ namespace pcapReader {
         bool isConnected() const;
 
         /**
-         * @brief Attempt to read a packet and store data to buffer
+         * @brief Attempt to read a packet and add its payload to the stream of its
+         * TCP flow
+         *
+         * Payload is only added in sequence order. At the end of the file, gaps
+         * are skipped such that all payload is added.
          * @return Result of read operation
          */
         ReadResult read();
 
+        /**
+         * @brief Gets the stream of a TCP flow that payload has been added to
+         * since it was returned last
+         *
+         * The caller consumes bytes by erasing them from the front of the stream.
+         * @return The stream, nullptr if no payload has been added
+         */
+        buffer_t* nextStream() { return m_reassembler.nextReadyStream(); }
+
+        /**
+         * @brief Capture time of the packet read last
+         * @return Timestamp in nanoseconds (Unix epoch), 0 before the first
+         * packet
+         */
+        Timestamp lastPacketTime() const { return m_lastPktTime; }
+
         //! Destructor for PcapDevice
         ~PcapDevice();
 
     private:
+        /**
+         * @brief Hands the TCP payload of a packet to the reassembler
+         * @param[in] data Packet starting with the link layer header
+         * @param[in] length Captured length of the packet
+         */
+        void processPacket(const uint8_t* data, std::size_t length);
+
         //! Pointer to the node
         ROSaicNodeBase* node_;
-        //! Reference to raw data buffer to write to
-        buffer_t& m_dataBuff;
+        //! Decompresses the pcap file if it is compressed, has to outlive
+        //! m_device
+        std::unique_ptr<io_comm_rx::DecompressingReader> m_reader;
         //! File handle to pcap file
         pcap_t* m_device{nullptr};
         bpf_program m_pktFilter{};
+        //! Packet filter in pcap-filter syntax
+        std::string m_filter;
+        //! Link layer header type of the file
+        int m_linkType = 0;
+        //! Reassembles the payload of the TCP flows
+        TcpReassembler m_reassembler;
+        //! Capture time of the packet read last
+        Timestamp m_lastPktTime = 0;
         char m_errBuff[BUFFSIZE]{};
         char* m_deviceName;
-        buffer_t m_lastPkt;
     };
 } // namespace pcapReader
 
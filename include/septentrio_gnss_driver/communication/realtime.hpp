@@ -0,0 +1,90 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <pthread.h>
+#include <string>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/settings.h>
+
+#ifndef REALTIME_HPP
+#define REALTIME_HPP
+
+/**
+ * @file realtime.hpp
+ * @brief Declares naming, affinity and scheduling of threads and locking of
+ * memory
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @namespace realtime
+     * Settings for low-latency operation. Real-time scheduling policies and
+     * locking memory need the capabilities CAP_SYS_NICE and CAP_IPC_LOCK or
+     * corresponding limits (ulimit -r and -l).
+     */
+    namespace realtime {
+
+        /**
+         * @brief Names a thread and sets its CPU affinity and scheduling
+         * @param[in] thread Thread, e.g. pthread_self()
+         * @param[in] name Name, truncated to the 15 characters Linux allows
+         * @param[in] settings Affinity and scheduling, left as inherited if empty
+         * and "other"
+         * @param[out] error Reason in case of failure
+         * @return False if any setting could not be applied
+         */
+        bool configureThread(pthread_t thread, const std::string& name,
+                             const ThreadSettings& settings, std::string& error);
+
+        /**
+         * @brief Locks current and future memory of the process into RAM and
+         * keeps freed heap in the process, so that later allocations do not
+         * page fault
+         * @param[in] prefault_heap Bytes of heap to fault in up front
+         * @param[out] error Reason in case of failure
+         * @return False if the memory could not be locked
+         */
+        bool lockMemory(std::size_t prefault_heap, std::string& error);
+
+        /**
+         * @brief Faults in the pages of a buffer without changing its content
+         * @param[in] data Buffer
+         * @param[in] size Size of the buffer
+         */
+        void prefault(uint8_t* data, std::size_t size);
+    } // namespace realtime
+} // namespace io_comm_rx
+
+#endif // REALTIME_HPP
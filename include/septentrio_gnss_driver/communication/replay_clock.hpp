@@ -0,0 +1,99 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <chrono>
+#include <cstdint>
+
+#ifndef REPLAY_CLOCK_HPP
+#define REPLAY_CLOCK_HPP
+
+/**
+ * @file replay_clock.hpp
+ * @brief Declares a clock that paces the replay of logs
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class ReplayClock
+     * @brief Paces the replay of logs in real time, at a multiple of real time or
+     * as fast as possible
+     *
+     * The first log time is anchored to the wall clock and every later log time
+     * is due at a fixed offset from that anchor. Time spent between two calls
+     * is thus not added to the waiting time and does not accumulate as drift.
+     */
+    class ReplayClock
+    {
+    public:
+        /**
+         * @param[in] rate Replay speed as a multiple of real time, 0 or less to
+         * replay as fast as possible
+         */
+        explicit ReplayClock(double rate = 1.0);
+
+        /**
+         * @brief Changes the replay speed, the clock is anchored anew if it
+         * differs from the current one
+         * @param[in] rate Replay speed as a multiple of real time, 0 or less to
+         * replay as fast as possible
+         */
+        void setRate(double rate);
+
+        /**
+         * @brief Blocks until the given log time is due
+         *
+         * Returns immediately when replaying as fast as possible or if the log
+         * time is already overdue. If the log time jumps back by more than a
+         * second, e.g. at the start of another log, the clock is anchored anew.
+         * @param[in] log_time Log time in nanoseconds (Unix epoch)
+         */
+        void sleepUntil(uint64_t log_time);
+
+        //! Forgets the anchor, the next log time is anchored anew
+        void reset() { anchored_ = false; }
+
+    private:
+        //! Replay speed as a multiple of real time, 0 or less for unthrottled
+        double rate_;
+        //! Whether the anchor is set
+        bool anchored_ = false;
+        //! Log time anchored to the wall clock
+        uint64_t anchor_log_time_ = 0;
+        //! Wall clock time of the anchor
+        std::chrono::steady_clock::time_point anchor_wall_time_;
+        //! Latest log time handed to sleepUntil()
+        uint64_t last_log_time_ = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // REPLAY_CLOCK_HPP
@@ -101,6 +101,7 @@
 #endif
 
 // C++ libraries
+#include <array>
 #include <cassert> // for assert
 #include <cstddef>
 #include <map>
@@ -112,6 +113,11 @@
 #include <boost/tokenizer.hpp>
 // ROSaic includes
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/clock_offset_model.hpp>
+#include <septentrio_gnss_driver/communication/connection_state.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
+#include <septentrio_gnss_driver/communication/replay_clock.hpp>
+#include <septentrio_gnss_driver/communication/satellite_store.hpp>
 #include <septentrio_gnss_driver/crc/crc.h>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
@@ -128,9 +134,6 @@
  * @brief Defines a class that reads messages handed over from the circular buffer
  */
 
-extern bool g_read_cd;
-extern uint32_t g_cd_count;
-
 //! Enum for NavSatFix's status.status field, which is obtained from PVTGeodetic's
 //! Mode field
 enum TypeOfPVT_Enum
@@ -208,11 +211,15 @@ namespace io_comm_rx {
          * The const-ness of the argument just means the function promises not to
          * change it.. Recall: static_cast by the way can remove or add const-ness,
          * no other C++ cast is capable of removing it (not even reinterpret_cast)
-         * @param[in] data Pointer to the buffer that is about to be analyzed
-         * @param[in] size Size of the buffer (as handed over by async_read_some)
-         */
-        RxMessage(ROSaicNodeBase* node, Settings* settings) :
-            node_(node), settings_(settings), unix_time_(0)
+         * @param[in] node Pointer to the node
+         * @param[in] settings Settings of the node
+         * @param[in] connection State of the command exchange with the Rx,
+         * nullptr if connection descriptors shall not be read, e.g. offline
+         */
+        RxMessage(ROSaicNodeBase* node, Settings* settings,
+                  ConnectionState* connection = nullptr) :
+            node_(node), settings_(settings), connection_(connection),
+            unix_time_(0)
         {
             found_ = false;
             crc_check_ = false;
@@ -305,6 +312,9 @@ namespace io_comm_rx {
         bool isSBF();
         //! Determines whether data_ currently points to an NMEA message
         bool isNMEA();
+        //! Determines whether the NMEA message data_ points to has a valid checksum,
+        //! messages without checksum or not yet complete are considered valid
+        bool isValidNMEA();
         //! Determines whether data_ currently points to an NMEA message
         bool isResponse();
         //! Determines whether data_ currently points to a connection descriptor
@@ -367,10 +377,18 @@ namespace io_comm_rx {
          */
         void next();
 
+        /**
+         * @brief Jumps over the complete SBF block data_ points to without
+         * decoding it, as next() does after read()
+         * @return False if its CRC is wrong, in which case data_ is left
+         * unchanged
+         */
+        bool skipBlock();
+
         /**
          * @brief Publishing function
          * @param[in] topic String of topic
-         * @param[in] msg ROS message to be published
+         * @param[in] msg ROS message, or shared pointer to it, to be published
          */
         template <typename M>
         void publish(const std::string& topic, const M& msg);
@@ -433,11 +451,24 @@ namespace io_comm_rx {
         bool ins_localization_complete(uint32_t id);
 
     private:
+        //! Times the message builders in isolation, see decode_benchmark.cpp
+        friend class DecodeBenchmark;
+
         /**
          * @brief Pointer to the node
          */
         ROSaicNodeBase* node_;
 
+        /**
+         * @brief State of the command exchange with the Rx, may be nullptr
+         */
+        ConnectionState* connection_;
+
+        /**
+         * @brief Whether connection descriptors are still to be read
+         */
+        bool readCd() const { return connection_ && connection_->read_cd; }
+
         /**
          * @brief Timestamp of receiving buffer
          */
@@ -507,21 +538,48 @@ namespace io_comm_rx {
         ExtSensorMeasMsg last_extsensmeas_;
 
         /**
-         * @brief Since GPSFix needs ChannelStatus, incoming ChannelStatus blocks
-         * need to be stored
+         * @brief Last ChannelStatus block, kept as parsing buffer such that its
+         * vectors keep their capacity
          */
         ChannelStatus last_channelstatus_;
 
         /**
-         * @brief Since GPSFix needs MeasEpoch (for SNRs), incoming MeasEpoch blocks
-         * need to be stored
+         * @brief Recycled MeasEpoch messages, whose nested vectors keep their
+         * capacity between epochs
+         */
+        MessagePool<MeasEpochMsg> measepoch_pool_;
+
+        /**
+         * @brief Recycled columnar MeasEpoch messages, whose arrays keep their
+         * capacity between epochs
+         */
+        MessagePool<MeasEpochColumnarMsg> measepoch_columnar_pool_;
+
+        /**
+         * @brief State of all satellites and signals, updated from incoming
+         * ChannelStatus and MeasEpoch blocks, from which GPSFix and diagnostics
+         * take their satellite information
+         */
+        SatelliteStore satellite_store_;
+
+        /**
+         * @brief Recycled GPSFix messages, whose satellite arrays keep their
+         * capacity between epochs
          */
-        MeasEpochMsg last_measepoch_;
+        MessagePool<GPSFixMsg> gpsfix_pool_;
 
         /**
-         * @brief Since GPSFix needs DOP, incoming DOP blocks need to be stored
+         * @brief Recycled DiagnosticArray messages, whose values keep their
+         * capacity between epochs
          */
-        DOP last_dop_;
+        MessagePool<DiagnosticArrayMsg> diagnosticarray_pool_;
+
+        /**
+         * @brief Since GPSFix needs DOP, incoming DOP blocks need to be stored.
+         * Zero-initialized, i.e. reported as unavailable, since GPSFix does not
+         * wait for DOP.
+         */
+        DOP last_dop_ = DOP();
 
         /**
          * @brief Since GPSFix needs VelCovGeodetic, incoming VelCovGeodetic blocks
@@ -575,19 +633,15 @@ namespace io_comm_rx {
         //! by the time stamps found in the SBF blocks therein.
         Timestamp unix_time_;
 
-        //! Current leap seconds as received, do not use value is -128
-        int8_t current_leap_seconds_ = -128;
-
-        //! For GPSFix: Whether the ChannelStatus block of the current epoch has
-        //! arrived or not
-        bool channelstatus_has_arrived_gpsfix_ = false;
+        //! Paces the replay of files against the wall clock
+        ReplayClock replay_clock_;
 
-        //! For GPSFix: Whether the MeasEpoch block of the current epoch has arrived
-        //! or not
-        bool measepoch_has_arrived_gpsfix_ = false;
+        //! Maps GNSS time into the host clock if use_clock_model is set, only
+        //! fed by live streams
+        ClockOffsetModel clock_model_;
 
-        //! For GPSFix: Whether the DOP block of the current epoch has arrived or not
-        bool dop_has_arrived_gpsfix_ = false;
+        //! Current leap seconds as received, do not use value is -128
+        int8_t current_leap_seconds_ = -128;
 
         //! For GPSFix: Whether the PVTGeodetic block of the current epoch has
         //! arrived or not
@@ -664,9 +718,10 @@ namespace io_comm_rx {
 
         /**
          * @brief "Callback" function when constructing GPSFix messages
-         * @return A smart pointer to the ROS message GPSFix just created
+         * @return A smart pointer to the ROS message GPSFix just created, drawn
+         * from gpsfix_pool_
          */
-        GPSFixMsg GPSFixCallback();
+        GPSFixMsg::Ptr GPSFixCallback();
 
         /**
          * @brief "Callback" function when constructing PoseWithCovarianceStamped
@@ -679,10 +734,10 @@ namespace io_comm_rx {
         /**
          * @brief "Callback" function when constructing
          * DiagnosticArrayMsg messages
-         * @return A ROS message
-         * DiagnosticArrayMsg just created
+         * @return A smart pointer to the ROS message
+         * DiagnosticArrayMsg just created, drawn from diagnosticarray_pool_
          */
-        DiagnosticArrayMsg DiagnosticArrayCallback();
+        DiagnosticArrayMsg::Ptr DiagnosticArrayCallback();
 
         /**
          * @brief "Callback" function when constructing
@@ -710,7 +765,8 @@ namespace io_comm_rx {
         TwistWithCovarianceStampedMsg TwistCallback(bool fromIns = false);
 
         /**
-         * @brief Waits according to time when reading from file
+         * @brief Waits according to time when reading from file and publishes
+         * it on /clock if requested
          */
         void wait(Timestamp time_obj);
 
@@ -741,10 +797,20 @@ namespace io_comm_rx {
          */
         Timestamp timestampSBF(const uint8_t* data, bool use_gnss_time);
 
+        /**
+         * @brief Calculates the GPS time in the Unix Epoch time format, i.e.
+         * without leap seconds
+         * @param[in] tow (Time of Week) in milliseconds
+         * @param[in] wnc (Week Number Counter)
+         * @return Nanoseconds since 1970-01-01 on the GPS time scale
+         */
+        static Timestamp gpsTimestamp(uint32_t tow, uint16_t wnc);
+
         /**
          * @brief Calculates the timestamp, in the Unix Epoch time format
          * This is either done using the TOW as transmitted with the SBF block (if
-         * "use_gnss" is true), or using the current time.
+         * "use_gnss" is true), or using the current time, mapped from the TOW by
+         * the clock offset model if it is used.
          * @param[in] tow (Time of Week) Number of milliseconds that elapsed since
          * the beginning of the current GPS week as transmitted by the SBF block
          * @param[in] wnc (Week Number Counter) counts the number of complete weeks
@@ -0,0 +1,258 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#ifndef RX_STATISTICS_HPP
+#define RX_STATISTICS_HPP
+
+/**
+ * @file rx_statistics.hpp
+ * @brief Declares the runtime statistics of the stream from the Rx
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class RxStatistics
+     * @brief Counts throughput, errors and buffer occupancy of the stream from the
+     * Rx
+     *
+     * The counters are updated on the hot path by the reading and the parsing
+     * thread, hence they are relaxed atomics: they are not ordered among each
+     * other, which is fine for statistics. Snapshots are taken by another thread,
+     * e.g. once per second, and turned into a diagnostic status.
+     */
+    class RxStatistics
+    {
+    public:
+        //! Number of distinct SBF block numbers, i.e. 13 bits
+        static const std::size_t NR_BLOCK_NUMBERS = 8192;
+
+        /**
+         * @struct Block
+         * @brief Counters of one SBF block number, or of all NMEA sentences
+         */
+        struct Block
+        {
+            //! SBF block number, 0 for the NMEA sentences
+            uint16_t id;
+            //! Number of complete blocks received
+            uint64_t count;
+            //! Number of blocks decoded, i.e. handed to the callbacks
+            uint64_t decoded;
+            //! Time spent decoding and publishing in nanoseconds
+            uint64_t decode_ns;
+        };
+
+        /**
+         * @struct Snapshot
+         * @brief Plain copy of all counters at a given time
+         */
+        struct Snapshot
+        {
+            //! Time since construction or last reset in nanoseconds
+            uint64_t uptime_ns = 0;
+            //! Bytes read from the Rx
+            uint64_t bytes_received = 0;
+            //! SBF blocks with wrong CRC
+            uint64_t crc_failures = 0;
+            //! Bytes skipped while resynchronizing
+            uint64_t skipped_bytes = 0;
+            //! Incomplete blocks or sentences carried over to the next read
+            uint64_t incomplete_carries = 0;
+            //! SBF blocks decoded after the others of a read that were dropped
+            //! since they could not be decoded
+            uint64_t dropped_deferred_blocks = 0;
+            //! NMEA sentences with wrong checksum
+            uint64_t nmea_checksum_failures = 0;
+            //! Messages that were not published
+            uint64_t dropped_publishes = 0;
+            //! Highest occupancy of the input buffer in bytes
+            uint64_t buffer_high_water = 0;
+            //! Capacity of the input buffer in bytes, 0 if unknown
+            uint64_t buffer_capacity = 0;
+            //! Reads that waited for the parser since the input buffer was full
+            uint64_t blocked_reads = 0;
+            //! Bytes dropped from the full input buffer
+            uint64_t dropped_bytes = 0;
+            //! Blocks, sentences or runs of other bytes dropped from the full
+            //! input buffer
+            uint64_t dropped_frames = 0;
+            //! Thereof PVT, attitude, INS and IMU blocks and position sentences
+            uint64_t dropped_navigation_frames = 0;
+            //! Counters of the block numbers received so far, ascending
+            std::vector<Block> blocks;
+        };
+
+        RxStatistics();
+
+        //! Adds bytes read from the Rx
+        void addBytes(std::size_t bytes)
+        {
+            bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        //! Adds bytes skipped while searching for the next sync bytes
+        void addSkippedBytes(std::size_t bytes)
+        {
+            skipped_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        //! Counts an SBF block with wrong CRC
+        void addCrcFailure()
+        {
+            crc_failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Counts an incomplete block or sentence carried over to the next read
+        void addIncompleteCarry()
+        {
+            incomplete_carries_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Counts a deferred SBF block that was dropped since it could not be
+        //! decoded
+        void addDroppedDeferredBlock()
+        {
+            dropped_deferred_blocks_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Counts an NMEA sentence with wrong checksum
+        void addNmeaChecksumFailure()
+        {
+            nmea_checksum_failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Counts a message that was not published
+        void addDroppedPublish()
+        {
+            dropped_publishes_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Counts a complete SBF block, block_number 0 for an NMEA sentence
+        void addBlock(uint16_t block_number)
+        {
+            blocks_[block_number & (NR_BLOCK_NUMBERS - 1)].count.fetch_add(
+                1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Adds the time spent decoding a block
+         * @param[in] block_number SBF block number, 0 for an NMEA sentence
+         * @param[in] ns Decoding time in nanoseconds
+         */
+        void addDecodeTime(uint16_t block_number, uint64_t ns)
+        {
+            BlockCounters& block = blocks_[block_number & (NR_BLOCK_NUMBERS - 1)];
+            block.decoded.fetch_add(1, std::memory_order_relaxed);
+            block.decode_ns.fetch_add(ns, std::memory_order_relaxed);
+        }
+
+        //! Counts a read that waited for the parser
+        void addBlockedRead()
+        {
+            blocked_reads_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Counts a block, sentence or run of other bytes dropped from the
+         * full input buffer
+         * @param[in] bytes Number of bytes dropped
+         * @param[in] navigation Whether it was a PVT, attitude, INS or IMU block
+         * or a position sentence
+         */
+        void addQueueDrop(std::size_t bytes, bool navigation)
+        {
+            dropped_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+            dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+            if (navigation)
+                dropped_navigation_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! Sets the capacity of the input buffer
+        void setBufferCapacity(std::size_t capacity)
+        {
+            buffer_capacity_.store(capacity, std::memory_order_relaxed);
+        }
+
+        //! Raises the high-water mark of the input buffer to size if lower
+        void updateBufferLevel(std::size_t size)
+        {
+            uint64_t high_water = buffer_high_water_.load(std::memory_order_relaxed);
+            while ((size > high_water) &&
+                   !buffer_high_water_.compare_exchange_weak(
+                       high_water, size, std::memory_order_relaxed))
+                ;
+        }
+
+        //! Takes a snapshot of all counters
+        void snapshot(Snapshot& snapshot) const;
+
+        //! Sets all counters and the uptime to zero
+        void reset();
+
+    private:
+        //! Counters of one block number, see Block
+        struct BlockCounters
+        {
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> decoded{0};
+            std::atomic<uint64_t> decode_ns{0};
+        };
+
+        //! Counters, see Snapshot
+        std::atomic<uint64_t> bytes_received_{0};
+        std::atomic<uint64_t> crc_failures_{0};
+        std::atomic<uint64_t> skipped_bytes_{0};
+        std::atomic<uint64_t> incomplete_carries_{0};
+        std::atomic<uint64_t> dropped_deferred_blocks_{0};
+        std::atomic<uint64_t> nmea_checksum_failures_{0};
+        std::atomic<uint64_t> dropped_publishes_{0};
+        std::atomic<uint64_t> buffer_high_water_{0};
+        std::atomic<uint64_t> buffer_capacity_{0};
+        std::atomic<uint64_t> blocked_reads_{0};
+        std::atomic<uint64_t> dropped_bytes_{0};
+        std::atomic<uint64_t> dropped_frames_{0};
+        std::atomic<uint64_t> dropped_navigation_frames_{0};
+        //! Counters per block number
+        std::array<BlockCounters, NR_BLOCK_NUMBERS> blocks_;
+        //! Start of the statistics, i.e. construction or last reset
+        std::atomic<std::chrono::steady_clock::rep> start_;
+    };
+} // namespace io_comm_rx
+
+#endif // RX_STATISTICS_HPP
@@ -0,0 +1,227 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/msg_typedefs.hpp>
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+// C++ library includes
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifndef SATELLITE_STORE_HPP
+#define SATELLITE_STORE_HPP
+
+/**
+ * @file satellite_store.hpp
+ * @brief Declares a class keeping the state of each satellite and signal across
+ * epochs
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Number of distinct SBF SVIDs (SVID is an 8 bit field)
+    static const std::size_t NR_OF_SVIDS = 256;
+    //! Number of distinct SBF signal numbers, those from 32 on are encoded in
+    //! MeasEpoch's ObsInfo
+    static const std::size_t NR_OF_SIGNAL_TYPES = 64;
+
+    /**
+     * @struct SignalState
+     * @brief State of one signal of a satellite, as last seen in MeasEpoch
+     */
+    struct SignalState
+    {
+        //! MeasEpoch update counter of the last update, 0 if never seen
+        uint32_t epoch = 0;
+        //! TOW of the last MeasEpoch containing the signal in ms
+        uint32_t tow = 0;
+        //! WNC of the last MeasEpoch containing the signal
+        uint16_t wnc = 0;
+        //! Lock time in s as provided by MeasEpoch (clipped at 65535 resp. 254)
+        uint16_t lock_time = 0;
+        //! C/N0 in dB-Hz
+        float cno = 0.0f;
+    };
+
+    /**
+     * @struct SatelliteState
+     * @brief State of one satellite, updated incrementally from the SBF blocks
+     * MeasEpoch and ChannelStatus (and SatVisibility-like sources of elevation and
+     * azimuth)
+     */
+    struct SatelliteState
+    {
+        //! MeasEpoch update counter of the last update, 0 if never seen
+        uint32_t measepoch_epoch = 0;
+        //! TOW of the last MeasEpoch containing the satellite in ms
+        uint32_t measepoch_tow = 0;
+        //! WNC of the last MeasEpoch containing the satellite
+        uint16_t measepoch_wnc = 0;
+        //! C/N0 of the first channel tracking the satellite in the last MeasEpoch,
+        //! truncated to integer dB-Hz as in GPSFix
+        int32_t cno = 0;
+        //! TOW of the last elevation and azimuth update in ms
+        uint32_t visibility_tow = 0;
+        //! WNC of the last elevation and azimuth update
+        uint16_t visibility_wnc = 0;
+        //! Whether elevation and azimuth have ever been set
+        bool visibility_valid = false;
+        //! Elevation in degrees
+        int16_t elevation = 0;
+        //! Azimuth in degrees
+        uint16_t azimuth = 0;
+        //! ChannelStatus update counter of the last update, 0 if never seen
+        uint32_t channelstatus_epoch = 0;
+        //! Whether at least one signal of the satellite was used in the PVT
+        //! according to the ChannelStatus of channelstatus_epoch
+        bool used_in_pvt = false;
+        //! Signals indexed by SBF signal number
+        std::array<SignalState, NR_OF_SIGNAL_TYPES> signals;
+    };
+
+    /**
+     * @struct ChannelEntry
+     * @brief Satellite of one ChannelSatInfo sub-block of the last ChannelStatus
+     */
+    struct ChannelEntry
+    {
+        //! SVID of the satellite
+        uint8_t svid;
+        //! Number of ChannelStateInfo sub-blocks flagging usage in the PVT
+        uint16_t pvt_signals;
+    };
+
+    /**
+     * @class SatelliteStore
+     * @brief Keeps the state of each satellite (SVID x signal type) across epochs
+     *
+     * Every block only updates the entries it carries information for, such that
+     * composite messages (GPSFix, diagnostics) can be assembled from the latest
+     * known state without waiting for all blocks of one epoch. Nothing is ever
+     * cleared, the update counters tell which entries belong to the last block.
+     */
+    class SatelliteStore
+    {
+    public:
+        /**
+         * @brief Updates C/N0 and lock times from a MeasEpoch block
+         * @param[in] msg Successfully parsed MeasEpoch
+         */
+        void update(const MeasEpochMsg& msg);
+
+        /**
+         * @brief Updates elevation, azimuth and PVT usage from a ChannelStatus
+         * block
+         * @param[in] msg Successfully parsed ChannelStatus
+         */
+        void update(const ChannelStatus& msg);
+
+        /**
+         * @brief Updates elevation and azimuth of one satellite, e.g. from
+         * ChannelStatus or SatVisibility
+         * @param[in] svid SVID of the satellite
+         * @param[in] elevation Elevation in degrees
+         * @param[in] azimuth Azimuth in degrees
+         * @param[in] tow TOW of the source block in ms
+         * @param[in] wnc WNC of the source block
+         */
+        void updateVisibility(uint8_t svid, int16_t elevation, uint16_t azimuth,
+                              uint32_t tow, uint16_t wnc);
+
+        //! Returns the state of satellite svid
+        const SatelliteState& satellite(uint8_t svid) const
+        {
+            return satellites_[svid];
+        }
+
+        //! Whether the satellite is in sync according to the last MeasEpoch
+        bool inSync(uint8_t svid) const
+        {
+            return (measepoch_epoch_ != 0) &&
+                   (satellites_[svid].measepoch_epoch == measepoch_epoch_);
+        }
+
+        //! Whether the signal is tracked according to the last MeasEpoch
+        bool signalTracked(uint8_t svid, uint8_t signal) const
+        {
+            return (measepoch_epoch_ != 0) &&
+                   (satellites_[svid].signals[signal % NR_OF_SIGNAL_TYPES]
+                        .epoch == measepoch_epoch_);
+        }
+
+        //! Whether the satellite is used in the PVT according to the last
+        //! ChannelStatus
+        bool usedInPvt(uint8_t svid) const
+        {
+            return (channelstatus_epoch_ != 0) &&
+                   (satellites_[svid].channelstatus_epoch == channelstatus_epoch_) &&
+                   satellites_[svid].used_in_pvt;
+        }
+
+        //! Satellites in the order of the last ChannelStatus block
+        const std::vector<ChannelEntry>& channels() const { return channels_; }
+
+        //! Number of channels (MeasEpochChannelType1) in the last MeasEpoch
+        std::size_t numberOfChannelsInSync() const { return channels_in_sync_; }
+
+        //! Number of distinct satellites in the last MeasEpoch
+        std::size_t numberOfSatellitesInSync() const { return satellites_in_sync_; }
+
+        //! Number of distinct satellites used in the PVT according to the last
+        //! ChannelStatus
+        std::size_t numberOfSatellitesUsed() const { return satellites_used_; }
+
+        //! Whether a MeasEpoch block has been stored yet
+        bool hasMeasEpoch() const { return measepoch_epoch_ != 0; }
+
+        //! Whether a ChannelStatus block has been stored yet
+        bool hasChannelStatus() const { return channelstatus_epoch_ != 0; }
+
+    private:
+        //! State per SVID
+        std::array<SatelliteState, NR_OF_SVIDS> satellites_;
+        //! Update counter of MeasEpoch, 0 before the first one
+        uint32_t measepoch_epoch_ = 0;
+        //! Update counter of ChannelStatus, 0 before the first one
+        uint32_t channelstatus_epoch_ = 0;
+        //! Satellites of the last ChannelStatus in block order
+        std::vector<ChannelEntry> channels_;
+        //! Number of MeasEpochChannelType1 sub-blocks in the last MeasEpoch
+        std::size_t channels_in_sync_ = 0;
+        //! Number of distinct satellites in the last MeasEpoch
+        std::size_t satellites_in_sync_ = 0;
+        //! Number of distinct satellites used in PVT in the last ChannelStatus
+        std::size_t satellites_used_ = 0;
+    };
+} // namespace io_comm_rx
+
+#endif // SATELLITE_STORE_HPP
@@ -0,0 +1,337 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstdint>
+#include <string>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/abstraction/msg_typedefs.hpp>
+#include <septentrio_gnss_driver/communication/settings.h>
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+
+#ifndef SBF_BLOCK_TABLE_HPP
+#define SBF_BLOCK_TABLE_HPP
+
+/**
+ * @file sbf_block_table.hpp
+ * @brief Declares the table of SBF blocks that have a topic of their own
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Carries the message type of a table entry
+    template <typename M>
+    struct SbfMsgTag
+    {
+        typedef M type;
+    };
+
+    /**
+     * @brief Topic and frame of an SBF block that has a topic of its own
+     */
+    struct SbfBlockInfo
+    {
+        //! Name of the block for log output
+        const char* name;
+        //! Topic the block is published on
+        const char* topic;
+        //! Whether the topic is enabled in the settings
+        bool publish;
+        //! Frame ID of the message
+        const std::string& frame_id;
+    };
+
+    /**
+     * @brief Looks up an SBF block in the table of blocks that have a topic of
+     * their own
+     *
+     * This is the one place that maps blocks to message types, topics, frames
+     * and parsers, it is used by RxMessage as well as by BatchDecoder. The
+     * visitor is called as visitor(SbfMsgTag<M>(), info, parser) once per topic
+     * of the block, where the parser has the signature bool(LogSink*, It, It,
+     * M&).
+     * @param[in] id ID of the SBF block
+     * @param[in] settings Settings of which the publish flags, frame IDs and
+     * axis convention are used
+     * @param[in] visitor Called for each topic of the block
+     * @return False if the block has no topic of its own
+     */
+    template <typename Visitor>
+    bool visitSbfBlock(uint16_t id, const Settings& settings, Visitor&& visitor)
+    {
+        const Settings& s = settings;
+        bool ros_axis = s.use_ros_axis_orientation;
+        const std::string& ins_frame_id =
+            s.ins_use_poi ? s.poi_frame_id : s.frame_id;
+        switch (id)
+        {
+        case 4006:
+        {
+            visitor(SbfMsgTag<PVTCartesianMsg>(),
+                    SbfBlockInfo{"PVTCartesian", "/pvtcartesian",
+                                 s.publish_pvtcartesian, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       PVTCartesianMsg& msg) {
+                        return PVTCartesianParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 4007:
+        {
+            visitor(SbfMsgTag<PVTGeodeticMsg>(),
+                    SbfBlockInfo{"PVTGeodetic", "/pvtgeodetic",
+                                 s.publish_pvtgeodetic, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       PVTGeodeticMsg& msg) {
+                        return PVTGeodeticParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 4043:
+        {
+            visitor(SbfMsgTag<BaseVectorCartMsg>(),
+                    SbfBlockInfo{"BaseVectorCart", "/basevectorcart",
+                                 s.publish_basevectorcart, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       BaseVectorCartMsg& msg) {
+                        return BaseVectorCartParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 4028:
+        {
+            visitor(SbfMsgTag<BaseVectorGeodMsg>(),
+                    SbfBlockInfo{"BaseVectorGeod", "/basevectorgeod",
+                                 s.publish_basevectorgeod, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       BaseVectorGeodMsg& msg) {
+                        return BaseVectorGeodParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 5905:
+        {
+            visitor(SbfMsgTag<PosCovCartesianMsg>(),
+                    SbfBlockInfo{"PosCovCartesian", "/poscovcartesian",
+                                 s.publish_poscovcartesian, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       PosCovCartesianMsg& msg) {
+                        return PosCovCartesianParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 5906:
+        {
+            visitor(SbfMsgTag<PosCovGeodeticMsg>(),
+                    SbfBlockInfo{"PosCovGeodetic", "/poscovgeodetic",
+                                 s.publish_poscovgeodetic, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       PosCovGeodeticMsg& msg) {
+                        return PosCovGeodeticParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 5908:
+        {
+            visitor(SbfMsgTag<VelCovGeodeticMsg>(),
+                    SbfBlockInfo{"VelCovGeodetic", "/velcovgeodetic",
+                                 s.publish_velcovgeodetic, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       VelCovGeodeticMsg& msg) {
+                        return VelCovGeodeticParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        case 5938:
+        {
+            visitor(SbfMsgTag<AttEulerMsg>(),
+                    SbfBlockInfo{"AttEuler", "/atteuler", s.publish_atteuler,
+                                 s.frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               AttEulerMsg& msg) {
+                        return AttEulerParser(logger, it, itEnd, msg, ros_axis);
+                    });
+            return true;
+        }
+        case 5939:
+        {
+            visitor(SbfMsgTag<AttCovEulerMsg>(),
+                    SbfBlockInfo{"AttCovEuler", "/attcoveuler",
+                                 s.publish_attcoveuler, s.frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               AttCovEulerMsg& msg) {
+                        return AttCovEulerParser(logger, it, itEnd, msg,
+                                                 ros_axis);
+                    });
+            return true;
+        }
+        case 4225:
+        case 4229:
+        {
+            bool ext_event = (id == 4229);
+            visitor(SbfMsgTag<INSNavCartMsg>(),
+                    ext_event ? SbfBlockInfo{"ExtEventINSNavCart",
+                                             "/exteventinsnavcart",
+                                             s.publish_exteventinsnavcart,
+                                             ins_frame_id}
+                              : SbfBlockInfo{"INSNavCart", "/insnavcart",
+                                             s.publish_insnavcart,
+                                             ins_frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               INSNavCartMsg& msg) {
+                        return INSNavCartParser(logger, it, itEnd, msg,
+                                                ros_axis);
+                    });
+            return true;
+        }
+        case 4226:
+        case 4230:
+        {
+            bool ext_event = (id == 4230);
+            visitor(SbfMsgTag<INSNavGeodMsg>(),
+                    ext_event ? SbfBlockInfo{"ExtEventINSNavGeod",
+                                             "/exteventinsnavgeod",
+                                             s.publish_exteventinsnavgeod,
+                                             ins_frame_id}
+                              : SbfBlockInfo{"INSNavGeod", "/insnavgeod",
+                                             s.publish_insnavgeod,
+                                             ins_frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               INSNavGeodMsg& msg) {
+                        return INSNavGeodParser(logger, it, itEnd, msg,
+                                                ros_axis);
+                    });
+            return true;
+        }
+        case 4224:
+        {
+            visitor(SbfMsgTag<IMUSetupMsg>(),
+                    SbfBlockInfo{"IMUSetup", "/imusetup", s.publish_imusetup,
+                                 s.vehicle_frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               IMUSetupMsg& msg) {
+                        return IMUSetupParser(logger, it, itEnd, msg, ros_axis);
+                    });
+            return true;
+        }
+        case 4244:
+        {
+            visitor(SbfMsgTag<VelSensorSetupMsg>(),
+                    SbfBlockInfo{"VelSensorSetup", "/velsensorsetup",
+                                 s.publish_velsensorsetup, s.vehicle_frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               VelSensorSetupMsg& msg) {
+                        return VelSensorSetupParser(logger, it, itEnd, msg,
+                                                    ros_axis);
+                    });
+            return true;
+        }
+        case 4050:
+        {
+            // Whether the block holds IMU measurements is only of interest for
+            // /imu, which RxMessage composes itself
+            visitor(SbfMsgTag<ExtSensorMeasMsg>(),
+                    SbfBlockInfo{"ExtSensorMeas", "/extsensormeas",
+                                 s.publish_extsensormeas, s.imu_frame_id},
+                    [ros_axis](LogSink* logger, auto it, auto itEnd,
+                               ExtSensorMeasMsg& msg) {
+                        bool has_imu_meas = false;
+                        return ExtSensorMeasParser(logger, it, itEnd, msg,
+                                                   ros_axis, has_imu_meas);
+                    });
+            return true;
+        }
+        case 4027:
+        {
+            visitor(SbfMsgTag<MeasEpochColumnarMsg>(),
+                    SbfBlockInfo{"MeasEpoch", "/measepoch_columnar",
+                                 s.publish_measepoch_columnar, s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd,
+                       MeasEpochColumnarMsg& msg) {
+                        return MeasEpochColumnarParser(logger, it, itEnd, msg);
+                    });
+            visitor(SbfMsgTag<MeasEpochMsg>(),
+                    SbfBlockInfo{"MeasEpoch", "/measepoch", s.publish_measepoch,
+                                 s.frame_id},
+                    [](LogSink* logger, auto it, auto itEnd, MeasEpochMsg& msg) {
+                        return MeasEpochParser(logger, it, itEnd, msg);
+                    });
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    //! Parses if the table entry is of the type of the message
+    template <typename M, typename Parser, typename It>
+    bool parseSbfEntry(SbfMsgTag<M>, const SbfBlockInfo& info, Parser& parser,
+                       LogSink* logger, It it, It itEnd, M& msg)
+    {
+        if (!parser(logger, it, itEnd, msg))
+            return false;
+        msg.header.frame_id = info.frame_id;
+        return true;
+    }
+
+    //! Skips table entries of another type than the message
+    template <typename T, typename Parser, typename It, typename M>
+    bool parseSbfEntry(SbfMsgTag<T>, const SbfBlockInfo&, Parser&, LogSink*, It,
+                       It, M&)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Parses an SBF block into the message type of its table entry and
+     * sets the frame ID
+     *
+     * For callers that keep the message, e.g. to compose /gpsfix from it.
+     * @return False if the block could not be parsed or has no table entry of
+     * type M
+     */
+    template <typename M, typename It>
+    bool parseSbfBlock(LogSink* logger, const Settings& settings, uint16_t id,
+                       It it, It itEnd, M& msg)
+    {
+        bool parsed = false;
+        visitSbfBlock(id, settings,
+                      [&](auto tag, const SbfBlockInfo& info, auto parser) {
+                          parsed = parsed || parseSbfEntry(tag, info, parser,
+                                                           logger, it, itEnd,
+                                                           msg);
+                      });
+        return parsed;
+    }
+} // namespace io_comm_rx
+
+#endif // SBF_BLOCK_TABLE_HPP
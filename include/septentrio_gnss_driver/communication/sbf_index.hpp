@@ -0,0 +1,136 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+
+#ifndef SBF_INDEX_HPP
+#define SBF_INDEX_HPP
+
+/**
+ * @file sbf_index.hpp
+ * @brief Declares an index of the epochs in an SBF log
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @brief Start of an epoch in an SBF log, i.e. of the first block with a new
+     * time stamp
+     */
+    struct SbfEpoch
+    {
+        //! GPS time in milliseconds since the GPS epoch (1980-01-06)
+        uint64_t gps_time;
+        //! Offset of the first block of the epoch from the start of the file
+        uint64_t offset;
+    };
+
+    /**
+     * @class SbfIndex
+     * @brief Maps the epochs (WNc/TOW) of an SBF log to file offsets, so that
+     * replay can start and stop at given times without reading the whole log
+     *
+     * The index may be stored next to the log as a sidecar file, which is only
+     * used again for a log of the same size.
+     */
+    class SbfIndex
+    {
+    public:
+        /**
+         * @brief Builds the index in one pass over the log
+         *
+         * The log is cut into one chunk per thread. Each thread resynchronizes
+         * on the first valid SBF block at or after the start of its chunk and
+         * indexes all blocks starting within it.
+         * @param[in] logger Sink for log output
+         * @param[in] data Start of the log
+         * @param[in] size Size of the log in bytes
+         * @param[in] threads Number of threads, 0 for the number of cores
+         */
+        void build(LogSink* logger, const uint8_t* data, std::size_t size,
+                   unsigned threads = 0);
+
+        /**
+         * @brief Loads the index from a sidecar file
+         * @param[in] file_name The name of (or path to) the sidecar file
+         * @param[in] log_size Size of the log in bytes
+         * @return False if the file is missing, invalid or for another log size
+         */
+        bool load(const std::string& file_name, uint64_t log_size);
+
+        /**
+         * @brief Stores the index in a sidecar file
+         * @param[in] file_name The name of (or path to) the sidecar file
+         * @param[in] log_size Size of the log in bytes
+         * @return False if the file could not be written
+         */
+        bool save(const std::string& file_name, uint64_t log_size) const;
+
+        /**
+         * @brief Offset of the first epoch at or after the given time
+         *
+         * Epochs are assumed to be in chronological order, as recorded.
+         * @param[in] gps_time GPS time in milliseconds since the GPS epoch
+         * @param[in] log_size Size of the log in bytes, returned if no such
+         * epoch exists
+         */
+        uint64_t startOffset(uint64_t gps_time, uint64_t log_size) const;
+
+        /**
+         * @brief Offset of the first epoch after the given time
+         * @param[in] gps_time GPS time in milliseconds since the GPS epoch
+         * @param[in] log_size Size of the log in bytes, returned if no such
+         * epoch exists
+         */
+        uint64_t endOffset(uint64_t gps_time, uint64_t log_size) const;
+
+        //! Epochs in file order
+        const std::vector<SbfEpoch>& epochs() const { return epochs_; }
+
+        //! GPS time in milliseconds since the GPS epoch from WNc and TOW
+        static uint64_t gpsTime(uint16_t wnc, uint32_t tow)
+        {
+            return static_cast<uint64_t>(wnc) * 604800000 + tow;
+        }
+
+    private:
+        //! Epochs in file order
+        std::vector<SbfEpoch> epochs_;
+    };
+} // namespace io_comm_rx
+
+#endif // SBF_INDEX_HPP
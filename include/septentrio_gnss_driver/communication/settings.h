@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <map>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -99,6 +100,16 @@ struct RtkSettings
     std::vector<RtkSerial> serial;
 };
 
+struct ThreadSettings
+{
+    //! CPUs the thread may run on, empty for all
+    std::vector<int32_t> cpus;
+    //! Scheduling policy: "other", "fifo" or "rr"
+    std::string policy = "other";
+    //! Scheduling priority, 1 to 99 for "fifo" and "rr"
+    int32_t priority = 0;
+};
+
 //! Settings struct
 struct Settings
 {
@@ -194,6 +205,8 @@ struct Settings
     bool publish_gpgsv;
     //! Whether or not to publish the MeasEpoch message
     bool publish_measepoch;
+    //! Whether or not to publish the MeasEpoch message in columnar layout
+    bool publish_measepoch_columnar;
     //! Whether or not to publish the PVTCartesianMsg
     //! message
     bool publish_pvtcartesian;
@@ -241,6 +254,12 @@ struct Settings
     bool publish_pose;
     //! Whether or not to publish the DiagnosticArrayMsg message
     bool publish_diagnostics;
+    //! Whether or not to publish the runtime statistics at 1 Hz on /diagnostics
+    bool publish_statistics;
+    //! Whether or not to publish the latency estimates at 1 Hz on /diagnostics
+    bool publish_latency;
+    //! Latency above the baseline in seconds that is reported as congestion
+    double latency_congestion_threshold;
     //! Whether or not to publish the ImuMsg message
     bool publish_imu;
     //! Whether or not to publish the LocalizationMsg message
@@ -261,6 +280,10 @@ struct Settings
     //! (in the SBF case) and UTC (in the NMEA case) data. If false, times are
     //! constructed within the driver via time(NULL) of the \<ctime\> library.
     bool use_gnss_time;
+    //! If use_gnss_time is false, whether to map the TOW/WNC of SBF blocks into
+    //! the host clock by an online clock offset model instead of using the
+    //! receive time
+    bool use_clock_model = false;
     //! The frame ID used in the header of every published ROS message
     std::string frame_id;
     //! The frame ID used in the header of published ROS Imu message
@@ -282,6 +305,43 @@ struct Settings
     bool read_from_sbf_log = false;
     //! Whether or not we are reading from a PCAP file
     bool read_from_pcap = false;
+    //! Packet filter applied when reading from a PCAP file, in pcap-filter syntax
+    std::string pcap_filter;
+    //! Pacing of PCAP replay, "sbf" for SBF time or "packet" for capture time
+    std::string pcap_pacing;
+    //! Replay speed of files as a multiple of real time, 0 for unthrottled
+    double replay_rate;
+    //! Whether or not to publish the replayed time on /clock
+    bool publish_clock;
+    //! Unix time in seconds at which SBF replay starts, 0 for the start of the log
+    double replay_start_time;
+    //! Unix time in seconds at which SBF replay ends, 0 for the end of the log
+    double replay_end_time;
+    //! Whether or not to keep the SBF index in a sidecar file next to the log
+    bool replay_index_file;
+    //! Whether or not to decode SBF logs on all cores, without pacing
+    bool replay_batch;
+    //! Bag written in batch mode instead of publishing, empty to publish
+    std::string replay_batch_output;
+    //! Directory to record the raw stream of the Rx to, empty to not record
+    std::string record_directory;
+    //! Prefix of the names of recorded files
+    std::string record_prefix;
+    //! Size in MB after which a new recording file is started, 0 for no limit
+    uint32_t record_max_file_size;
+    //! Duration in seconds after which a new recording file is started, 0 for
+    //! no limit
+    double record_max_file_duration;
+    //! What to do if parsing falls behind reading: "block", "drop_oldest" or
+    //! "drop_low_priority"
+    std::string parse_queue_policy;
+    //! Capacity of the queue between reading and parsing in kB
+    uint32_t parse_queue_capacity;
+    //! Whether the SBF blocks in decode_priority_blocks are decoded ahead of
+    //! the others read along with them
+    bool decode_priority;
+    //! SBF block numbers of high decoding priority
+    std::vector<int32_t> decode_priority_blocks;
     //! VSM source for INS
     std::string ins_vsm_ros_source;
     //! Whether or not to use individual elements of 3D velocity (v_x, v_y, v_z)
@@ -302,4 +362,10 @@ struct Settings
     uint32_t ins_vsm_serial_baud_rate;
     //! Wether VSM shall be kept open om shutdown
     bool ins_vsm_serial_keep_open;
+    //! Affinity and scheduling of the threads by role, e.g. "io" or "parsing"
+    std::map<std::string, ThreadSettings> threads;
+    //! Whether to lock all memory of the process into RAM
+    bool lock_memory = false;
+    //! Heap in MB faulted in at startup if memory is locked
+    uint32_t prefault_heap = 0;
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+#ifndef SOCKET_TIMESTAMPS_HPP
+#define SOCKET_TIMESTAMPS_HPP
+
+/**
+ * @file socket_timestamps.hpp
+ * @brief Declares reading from sockets with kernel receive timestamps
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @namespace socket_timestamps
+     * Software receive timestamps of the kernel, i.e. the time a packet arrived
+     * at the network stack instead of the time the reading thread woke up, which
+     * adds the scheduler latency. Stamps are taken from CLOCK_REALTIME. TCP
+     * sockets need Linux 4.13 or newer, where a read is stamped with the arrival
+     * of the latest segment it holds.
+     */
+    namespace socket_timestamps {
+
+        /**
+         * @brief Enables kernel receive timestamps on a socket
+         * @param[in] fd Native socket handle
+         * @return Whether they are supported
+         */
+        bool enable(int fd);
+
+        /**
+         * @brief Reads available data without blocking, like recv()
+         * @param[in] fd Native socket handle
+         * @param[out] data Buffer to read into
+         * @param[in] size Size of the buffer
+         * @param[out] recv_time Kernel receive time in nanoseconds since the Unix
+         * epoch, 0 if there is none
+         * @return Number of bytes read, 0 at the end of the stream, -1 on error
+         * with errno set, e.g. to EAGAIN if no data is available
+         */
+        ssize_t receive(int fd, uint8_t* data, std::size_t size,
+                        uint64_t& recv_time);
+    } // namespace socket_timestamps
+} // namespace io_comm_rx
+
+#endif // SOCKET_TIMESTAMPS_HPP
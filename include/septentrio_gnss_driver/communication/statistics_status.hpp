@@ -0,0 +1,72 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/msg_typedefs.hpp>
+#include <septentrio_gnss_driver/communication/latency_estimator.hpp>
+#include <septentrio_gnss_driver/communication/rx_statistics.hpp>
+
+#ifndef STATISTICS_STATUS_HPP
+#define STATISTICS_STATUS_HPP
+
+/**
+ * @file statistics_status.hpp
+ * @brief Declares the conversion of the runtime statistics and latency estimates
+ * of the core library into diagnostic statuses
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @brief Fills a diagnostic status from a snapshot of the runtime statistics
+     *
+     * Rates are given over the interval since the previous snapshot, or since
+     * the start if there is none.
+     * @param[in] current Current snapshot
+     * @param[in] previous Previous snapshot, may be nullptr
+     * @param[out] status Diagnostic status
+     */
+    void toStatus(const RxStatistics::Snapshot& current,
+                  const RxStatistics::Snapshot* previous,
+                  DiagnosticStatusMsg& status);
+
+    /**
+     * @brief Fills a diagnostic status with the latency estimates
+     * @param[in] latency Latency estimator
+     * @param[in] congestion_threshold Latency above the baseline in seconds that
+     * is reported as congestion or buffering
+     * @param[out] status Diagnostic status
+     */
+    void toStatus(const LatencyEstimator& latency, double congestion_threshold,
+                  DiagnosticStatusMsg& status);
+} // namespace io_comm_rx
+
+#endif // STATISTICS_STATUS_HPP
@@ -0,0 +1,213 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#ifndef STREAM_GENERATOR_HPP
+#define STREAM_GENERATOR_HPP
+
+/**
+ * @file stream_generator.hpp
+ * @brief Declares a class that generates synthetic SBF and NMEA streams
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class StreamGenerator
+     * @brief Generates the output of a GNSS receiver moving on a circle, for
+     * benchmarks and simulation without hardware or recorded logs
+     *
+     * Output is appended in the groups a receiver is typically configured
+     * with, each stamped with the time set last:
+     * - pvt(): PVTCartesian, PVTGeodetic, PosCovGeodetic, VelCovGeodetic,
+     *   AttEuler, AttCovEuler and DOP, or INSNavGeod for an INS
+     * - imu(): ExtSensorMeas with acceleration and angular rate
+     * - measurements(): MeasEpoch and ChannelStatus
+     * - status(): ReceiverTime, ReceiverStatus, QualityInd and ReceiverSetup
+     * - nmea(): GGA, RMC, GSA and GSV
+     *
+     * Blocks carry valid CRCs and are padded to multiples of 4 bytes as the
+     * receiver does.
+     */
+    class StreamGenerator
+    {
+    public:
+        /**
+         * @param[in] satellites Number of tracked satellites
+         * @param[in] signals Number of signals per satellite in MeasEpoch
+         * @param[in] period Time between epochs in milliseconds
+         * @param[in] nmea Whether NMEA sentences are generated by epoch()
+         * @param[in] ins Whether an INS is simulated, with INSNavGeod instead
+         * of the GNSS PVT and attitude blocks and INS firmware
+         */
+        explicit StreamGenerator(uint8_t satellites = 24, uint8_t signals = 2,
+                                 uint32_t period = 100, bool nmea = true,
+                                 bool ins = false);
+
+        /**
+         * @brief Appends all groups of the next epoch, status once per second,
+         * and advances the time by one period
+         * @param[in,out] out Buffer the epoch is appended to
+         */
+        void epoch(std::vector<uint8_t>& out);
+
+        /**
+         * @brief Sets the time of the following output
+         * @param[in] gps_time GPS time in milliseconds since 1980-01-06
+         */
+        void setTime(uint64_t gps_time);
+
+        /**
+         * @brief Sets the sub-blocks of INSNavGeod, by default position,
+         * attitude and velocity with standard deviations
+         * @param[in] sb_list SBList field, bits 0 to 7
+         */
+        void setInsSubBlocks(uint16_t sb_list) { ins_sb_list_ = sb_list & 0xff; }
+
+        //! GPS time of the following output in milliseconds since 1980-01-06
+        uint64_t time() const { return time_; }
+
+        //! GPS week number of the following output
+        uint16_t wnc() const { return static_cast<uint16_t>(time_ / 604800000); }
+
+        //! Time of week of the following output in milliseconds
+        uint32_t tow() const { return static_cast<uint32_t>(time_ % 604800000); }
+
+        //! Appends the position, velocity and attitude blocks
+        void pvt(std::vector<uint8_t>& out);
+        //! Appends an ExtSensorMeas block
+        void imu(std::vector<uint8_t>& out);
+        //! Appends MeasEpoch and ChannelStatus
+        void measurements(std::vector<uint8_t>& out);
+        //! Appends ReceiverTime, ReceiverStatus, QualityInd and ReceiverSetup
+        void status(std::vector<uint8_t>& out);
+        //! Appends GGA, RMC, GSA and GSV
+        void nmea(std::vector<uint8_t>& out);
+
+        /**
+         * @brief Appends an SBF Comment block, which the driver ignores
+         * @param[in] text Comment, truncated to 120 characters
+         * @param[in] gps_time GPS time of the block in milliseconds since
+         * 1980-01-06
+         * @param[in,out] out Buffer the block is appended to
+         */
+        static void comment(const std::string& text, uint64_t gps_time,
+                            std::vector<uint8_t>& out);
+
+        /**
+         * @brief GPS time of a Unix time
+         * @param[in] unix_time Unix time in milliseconds
+         * @return GPS time in milliseconds since 1980-01-06
+         */
+        static uint64_t gpsTime(uint64_t unix_time);
+
+        /**
+         * @brief Unix time of a GPS time
+         * @param[in] gps_time GPS time in milliseconds since 1980-01-06
+         * @return Unix time in milliseconds
+         */
+        static uint64_t unixTime(uint64_t gps_time);
+
+        /**
+         * @brief Name of an SBF block
+         * @param[in] id Block number without revision
+         * @return The name, or the number if the block is unknown
+         */
+        static std::string blockName(uint16_t id);
+
+    private:
+        //! Position on the circle at the current time
+        struct State
+        {
+            double latitude;
+            double longitude;
+            double height;
+            double vn;
+            double ve;
+            double heading;
+        };
+
+        State state() const;
+
+        void pvtCartesian(std::vector<uint8_t>& out, const State& s);
+        void pvtGeodetic(std::vector<uint8_t>& out, const State& s);
+        void posCovGeodetic(std::vector<uint8_t>& out);
+        void velCovGeodetic(std::vector<uint8_t>& out);
+        void attEuler(std::vector<uint8_t>& out, const State& s);
+        void attCovEuler(std::vector<uint8_t>& out);
+        void dop(std::vector<uint8_t>& out);
+        void insNavGeod(std::vector<uint8_t>& out, const State& s);
+        void measEpoch(std::vector<uint8_t>& out);
+        void channelStatus(std::vector<uint8_t>& out);
+        void receiverTime(std::vector<uint8_t>& out);
+        void receiverStatus(std::vector<uint8_t>& out);
+        void qualityInd(std::vector<uint8_t>& out);
+        void receiverSetup(std::vector<uint8_t>& out);
+        void gga(std::vector<uint8_t>& out, const State& s);
+        void rmc(std::vector<uint8_t>& out, const State& s);
+        void gsa(std::vector<uint8_t>& out);
+        void gsv(std::vector<uint8_t>& out);
+
+        //! Appends an NMEA sentence given without "$" and checksum
+        static void sentence(std::vector<uint8_t>& out, const std::string& body);
+
+        //! UTC of the current time as broken-down time
+        struct tm utc() const;
+
+        //! UTC time of day of the current time as hhmmss.ss
+        std::string utcTime() const;
+
+        //! Number of tracked satellites
+        uint8_t satellites_;
+        //! Number of signals per satellite
+        uint8_t signals_;
+        //! Time between epochs in milliseconds
+        uint32_t period_;
+        //! Whether NMEA sentences are generated by epoch()
+        bool nmea_;
+        //! Whether an INS is simulated
+        bool ins_;
+        //! Sub-blocks of INSNavGeod
+        uint16_t ins_sb_list_;
+        //! GPS time of the following output in milliseconds
+        uint64_t time_;
+        //! GPS time of the first output in milliseconds, for the uptime
+        uint64_t start_;
+    };
+} // namespace io_comm_rx
+
+#endif // STREAM_GENERATOR_HPP
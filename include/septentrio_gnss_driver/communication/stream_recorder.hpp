@@ -0,0 +1,202 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+
+#ifndef STREAM_RECORDER_HPP
+#define STREAM_RECORDER_HPP
+
+/**
+ * @file stream_recorder.hpp
+ * @brief Declares a class that records the raw byte stream of the Rx to disk
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @brief Receive time of the bytes starting at a given offset of a recording
+     */
+    struct RecordedRead
+    {
+        //! Offset of the first byte that was read
+        uint64_t offset;
+        //! Receive time in nanoseconds
+        uint64_t recv_time;
+    };
+
+    /**
+     * @class StreamRecorder
+     * @brief Tees the raw byte stream of the Rx, i.e. before framing, to rotating
+     * .sbf files
+     *
+     * Reads are copied into one of two large buffers. A writer thread of its own
+     * writes the other buffer to disk, such that the read path never waits for
+     * the disk. If both buffers are full, the read is dropped and counted.
+     *
+     * Next to each file <name>.sbf the index <name>.sbf.ts maps file offsets to
+     * receive times: the magic "SBFTS001", followed by one RecordedRead per read.
+     * Files are rotated between reads, hence an SBF block may be split over two
+     * consecutive files.
+     */
+    class StreamRecorder
+    {
+    public:
+        /**
+         * @brief Starts the writer thread, the first file is opened with the
+         * first read
+         * @param[in] logger Sink for log output
+         * @param[in] directory Directory of the recordings, created if missing
+         * @param[in] prefix Prefix of the file names, which are completed by the
+         * UTC receive time of the first read and a sequence number
+         * @param[in] max_file_size Size in bytes after which a new file is
+         * started, 0 for no limit
+         * @param[in] max_file_duration Duration in seconds after which a new file
+         * is started, 0 for no limit
+         * @param[in] buffer_size Size of each of the two buffers in bytes
+         */
+        StreamRecorder(LogSink* logger, const std::string& directory,
+                       const std::string& prefix, uint64_t max_file_size,
+                       double max_file_duration,
+                       std::size_t buffer_size = 4 * 1024 * 1024);
+
+        //! Writes the remaining data and closes the files
+        ~StreamRecorder();
+
+        StreamRecorder(const StreamRecorder&) = delete;
+        StreamRecorder& operator=(const StreamRecorder&) = delete;
+
+        /**
+         * @brief Records a read, never waits for the disk
+         * @param[in] recv_time Receive time in nanoseconds
+         * @param[in] data Bytes read
+         * @param[in] size Number of bytes read
+         */
+        void write(uint64_t recv_time, const uint8_t* data, std::size_t size);
+
+        //! Writes the remaining data and closes the files
+        void close();
+
+        //! Number of bytes dropped since both buffers were full
+        uint64_t dropped() const;
+
+        //! Writing thread, e.g. to set its affinity and scheduling
+        std::thread::native_handle_type nativeHandle()
+        {
+            return thread_.native_handle();
+        }
+
+    private:
+        //! Reads collected for one large write
+        struct Chunk
+        {
+            std::vector<uint8_t> data;
+            //! Offsets relative to the start of the chunk
+            std::vector<RecordedRead> reads;
+        };
+
+        //! Writer thread
+        void run();
+
+        //! Writes a chunk to the files, rotating them as needed
+        void writeChunk(const Chunk& chunk);
+
+        //! Appends to the current data file and its index
+        bool append(const uint8_t* data, std::size_t size,
+                    const std::vector<RecordedRead>& reads);
+
+        //! Opens a new data file and index named after the receive time
+        bool openFiles(uint64_t recv_time);
+
+        //! Closes the current data file and index
+        void closeFiles();
+
+        //! Logs an error and stops recording
+        void fail(const std::string& what);
+
+        //! Sink for log output
+        LogSink* logger_;
+        //! Directory of the recordings
+        std::string directory_;
+        //! Prefix of the file names
+        std::string prefix_;
+        //! Size after which a new file is started, 0 for no limit
+        uint64_t max_file_size_;
+        //! Duration in nanoseconds after which a new file is started, 0 for none
+        uint64_t max_file_duration_;
+        //! Size of each of the two buffers
+        std::size_t buffer_size_;
+
+        //! The two buffers
+        Chunk chunks_[2];
+        //! Buffer reads are copied into
+        Chunk* active_;
+        //! Buffer being written by the writer thread, nullptr if none
+        Chunk* flushing_ = nullptr;
+        //! Protects active_, flushing_, closing_ and dropped_
+        mutable std::mutex mutex_;
+        //! Signals a full buffer or closing
+        std::condition_variable cv_;
+        //! Whether the recorder is being closed
+        bool closing_ = false;
+        //! Number of bytes dropped since both buffers were full
+        uint64_t dropped_ = 0;
+
+        //! Members below are only accessed by the writer thread
+        //! Descriptor of the current data file, -1 if none
+        int data_fd_ = -1;
+        //! Descriptor of the current index, -1 if none
+        int index_fd_ = -1;
+        //! Number of bytes in the current data file
+        uint64_t file_size_ = 0;
+        //! Receive time of the first read in the current data file
+        uint64_t file_start_ = 0;
+        //! Number of files started
+        uint32_t file_count_ = 0;
+        //! Whether recording stopped due to an error
+        bool failed_ = false;
+        //! Number of dropped bytes already reported
+        uint64_t dropped_reported_ = 0;
+
+        //! Writer thread
+        std::thread thread_;
+    };
+} // namespace io_comm_rx
+
+#endif // STREAM_RECORDER_HPP
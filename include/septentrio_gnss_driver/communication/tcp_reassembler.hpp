@@ -0,0 +1,180 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+
+#ifndef TCP_REASSEMBLER_HPP
+#define TCP_REASSEMBLER_HPP
+
+/**
+ * @file tcp_reassembler.hpp
+ * @brief Declares a class that reassembles the byte streams of captured TCP
+ * flows
+ * @date 19/10/26
+ */
+
+namespace pcapReader {
+
+    /**
+     * @brief Identifies a TCP flow, i.e. one direction of a connection
+     */
+    struct TcpFlowKey
+    {
+        //! IP version, 4 or 6
+        uint8_t ip_version = 4;
+        //! Source address, IPv4 addresses use the first 4 bytes
+        std::array<uint8_t, 16> src_addr{};
+        //! Destination address, IPv4 addresses use the first 4 bytes
+        std::array<uint8_t, 16> dst_addr{};
+        //! Source port
+        uint16_t src_port = 0;
+        //! Destination port
+        uint16_t dst_port = 0;
+
+        bool operator<(const TcpFlowKey& other) const;
+
+        //! Human-readable form, e.g. "192.168.3.1:28784 -> 192.168.3.2:50432"
+        std::string toString() const;
+    };
+
+    /**
+     * @class TcpReassembler
+     * @brief Reassembles the payload of captured TCP segments per flow, in
+     * sequence order
+     *
+     * Retransmitted and overlapping bytes are dropped, segments arriving ahead
+     * of missing ones are held back until the missing ones arrive. If more than
+     * the given number of bytes is held back for a flow, the missing bytes are
+     * assumed to be lost: the gap is reported and skipped. A capture starting
+     * in the middle of a connection is reassembled from its first segment on.
+     */
+    class TcpReassembler
+    {
+    public:
+        /**
+         * @brief Constructor of the class TcpReassembler
+         * @param[in] logger Sink for gap reports
+         * @param[in] max_held_back Maximum number of bytes held back per flow
+         * while waiting for missing segments
+         */
+        explicit TcpReassembler(LogSink* logger,
+                                std::size_t max_held_back = 1024 * 1024);
+
+        /**
+         * @brief Adds a captured segment
+         * @param[in] key Flow of the segment
+         * @param[in] seq Sequence number of the segment
+         * @param[in] syn Whether the SYN flag is set, i.e. a connection starts
+         * @param[in] payload Payload of the segment
+         * @param[in] length Length of the payload in bytes
+         */
+        void addSegment(const TcpFlowKey& key, uint32_t seq, bool syn,
+                        const uint8_t* payload, std::size_t length);
+
+        /**
+         * @brief Skips all remaining gaps, e.g. at the end of a capture, such
+         * that all held back bytes become available
+         */
+        void flush();
+
+        /**
+         * @brief Gets the stream of a flow that has received bytes in order
+         * since it was returned last
+         *
+         * The caller consumes bytes by erasing them from the front of the stream.
+         * @return The stream, nullptr if no flow has received bytes
+         */
+        std::vector<uint8_t>* nextReadyStream();
+
+        //! Number of gaps skipped so far
+        uint64_t gaps() const { return gaps_; }
+
+        //! Number of bytes missing in the skipped gaps
+        uint64_t missingBytes() const { return missing_bytes_; }
+
+        //! Number of retransmitted bytes dropped so far
+        uint64_t retransmittedBytes() const { return retransmitted_bytes_; }
+
+    private:
+        //! State of a flow
+        struct Flow
+        {
+            //! Reassembled bytes not consumed yet
+            std::vector<uint8_t> stream;
+            //! Sequence number of the next byte expected
+            uint32_t next_seq = 0;
+            //! Position of the next byte expected in the whole flow
+            uint64_t next_offset = 0;
+            //! Segments ahead of missing ones by their position in the flow
+            std::map<uint64_t, std::vector<uint8_t>> held_back;
+            //! Number of bytes in held_back
+            std::size_t held_back_bytes = 0;
+            //! Whether the flow is queued in ready_
+            bool ready = false;
+            //! Name for gap reports
+            std::string name;
+        };
+
+        //! Appends bytes in order to the stream of a flow
+        void append(Flow& flow, const uint8_t* data, std::size_t length);
+
+        //! Appends held back segments that are in order now
+        void drain(Flow& flow);
+
+        //! Skips the gap before the first held back segment
+        void skipGap(Flow& flow);
+
+        //! Sink for gap reports
+        LogSink* logger_;
+        //! Maximum number of bytes held back per flow
+        std::size_t max_held_back_;
+        //! Flows by key, flows are never moved in memory
+        std::map<TcpFlowKey, Flow> flows_;
+        //! Flows that have received bytes in order since returned last
+        std::deque<Flow*> ready_;
+        //! Number of gaps skipped so far
+        uint64_t gaps_ = 0;
+        //! Number of bytes missing in the skipped gaps
+        uint64_t missing_bytes_ = 0;
+        //! Number of retransmitted bytes dropped so far
+        uint64_t retransmitted_bytes_ = 0;
+    };
+} // namespace pcapReader
+
+#endif // TCP_REASSEMBLER_HPP
@@ -31,10 +31,6 @@
 #ifndef CRC_H
 #define CRC_H
 
-// ROSaic includes
-// The following imports structs into which SBF blocks can be unpacked then shipped
-// to handler functions
-#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
 // C++ libary includes
 #include <cstdint>
 #include <stdbool.h>
@@ -71,7 +71,9 @@
 // tf2 includes
 #include <tf2_ros/transform_listener.h>
 // ROSaic includes
+#include <septentrio_gnss_driver/GetStatistics.h>
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/statistics_status.hpp>
 
 /**
  * @namespace rosaic_node
@@ -89,7 +91,14 @@ namespace rosaic_node {
         //! The constructor initializes and runs the ROSaic node, if everything works
         //! fine. It loads the user-defined ROS parameters, subscribes to Rx
         //! messages, and publishes requested ROS messages...
-        ROSaicNode();
+        //! @param[in] name Name of the Rx when several are handled by one
+        //! process, empty for a single Rx
+        //! @param[in] io_service I/O service shared with the other Rxs, nullptr
+        //! for one of its own
+        explicit ROSaicNode(
+            const std::string& name = std::string(),
+            const boost::shared_ptr<boost::asio::io_service>& io_service =
+                boost::shared_ptr<boost::asio::io_service>());
 
     private:
         /**
@@ -127,11 +136,70 @@ namespace rosaic_node {
 
         void sendVelocity(const std::string& velNmea);
 
+        /**
+         * @brief Publishes the runtime statistics and latency estimates on
+         * /diagnostics
+         * @param[in] event Timer event, called at 1 Hz
+         */
+        void publishStatistics(const ros::TimerEvent& event);
+        /**
+         * @brief Service callback returning the runtime statistics and latency
+         * estimates
+         * @param[in] req Request, whether to reset the statistics and estimates
+         * @param[out] res Response holding the statistics and estimates
+         * @return Always true
+         */
+        bool getStatistics(septentrio_gnss_driver::GetStatistics::Request& req,
+                           septentrio_gnss_driver::GetStatistics::Response& res);
+
         //! Handles communication with the Rx
         io_comm_rx::Comm_IO IO_;
         //! tf2 buffer and listener
         tf2_ros::Buffer tfBuffer_;
         std::unique_ptr<tf2_ros::TransformListener> tfListener_;
+        //! Timer publishing the runtime statistics and latency estimates
+        ros::Timer statisticsTimer_;
+        //! Service returning the runtime statistics and latency estimates
+        ros::ServiceServer statisticsService_;
+        //! Statistics of the previous publication or request, for the rates
+        io_comm_rx::RxStatistics::Snapshot lastStatistics_;
+    };
+
+    /**
+     * @class MultiReceiverNode
+     * @brief Handles several Rxs in one process, each by a ROSaicNode in the
+     * namespace of its name
+     *
+     * The connections share one io_service, whose worker threads read and parse
+     * the streams of all Rxs, so that the number of threads does not grow with
+     * the number of Rxs.
+     */
+    class MultiReceiverNode
+    {
+    public:
+        /**
+         * @brief Starts the worker threads and the nodes, the latter each on a
+         * thread of its own until the Rx is connected and configured
+         * @param[in] receivers Names of the Rxs
+         * @param[in] io_threads Number of worker threads
+         */
+        MultiReceiverNode(const std::vector<std::string>& receivers,
+                          uint32_t io_threads);
+        //! Stops the nodes before the worker threads, which are needed to
+        //! reset the Rxs
+        ~MultiReceiverNode();
+
+    private:
+        //! I/O service shared by the connections to the Rxs
+        boost::shared_ptr<boost::asio::io_service> ioService_;
+        //! Keeps the worker threads running while no connection is open
+        std::unique_ptr<boost::asio::io_service::work> work_;
+        //! Worker threads running ioService_
+        boost::thread_group workers_;
+        //! Nodes, one per Rx
+        std::vector<std::unique_ptr<ROSaicNode>> nodes_;
+        //! Threads constructing the nodes
+        boost::thread_group starters_;
     };
 } // namespace rosaic_node
 
@@ -0,0 +1,82 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/communication_core.hpp>
+
+#ifndef SBF_TO_BAG_HPP
+#define SBF_TO_BAG_HPP
+
+/**
+ * @file sbf_to_bag.hpp
+ * @date 19/10/26
+ * @brief Offline conversion of SBF logs to rosbags without a ROS master
+ */
+
+namespace rosaic_node {
+    /**
+     * @class SbfToBag
+     * @brief Converts an SBF log to a rosbag with the same messages the node
+     * would publish, including GPSFix, NavSatFix, Pose and Localization
+     *
+     * Parameters are given by name instead of being read from the parameter
+     * server. The log is read from a memory mapping and decoded in the calling
+     * thread, while the messages are serialized and written to the bag by a
+     * writer thread.
+     */
+    class SbfToBag : ROSaicNodeBase
+    {
+    public:
+        /**
+         * @brief Constructor of the class SbfToBag
+         * @param[in] bag_writer Writer of the output bag, has to outlive the
+         * converter
+         * @param[in] params Parameters by name, e.g. "publish/gpsfix" -> "true"
+         */
+        SbfToBag(io_comm_rx::BagWriter* bag_writer,
+                 const std::map<std::string, std::string>& params);
+
+        /**
+         * @brief Converts the whole SBF log
+         * @param[in] file_name The name of (or path to) the SBF log
+         * @return False if a parameter is invalid or the log could not be read
+         */
+        bool convert(const std::string& file_name);
+
+    private:
+        //! No velocity is sent to a receiver offline
+        void sendVelocity(const std::string& velNmea) {}
+
+        //! Handles reading and decoding of the log
+        io_comm_rx::Comm_IO IO_;
+    };
+} // namespace rosaic_node
+
+#endif // for SBF_TO_BAG_HPP
@@ -58,22 +58,25 @@ static const uint16_t MAXSB_MEASEPOCH_T2 =
 //! Max number of vector info sub-blocks
 static const uint8_t MAXSB_NBVECTORINFO = 30;
 
-//! 0x24 is ASCII for $ - 1st byte in each message
-static const uint8_t SBF_SYNC_BYTE_1 = 0x24;
-//! 0x40 is ASCII for @ - 2nd byte to indicate SBF block
-static const uint8_t SBF_SYNC_BYTE_2 = 0x40;
-
 // C++
 #include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
 // Boost
 #include <boost/spirit/include/qi.hpp>
-#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
 #include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
 
 /**
  * @file sbf_structs.hpp
  * @brief Declares and defines structs into which SBF blocks are unpacked then
  * shipped to handler functions
+ *
+ * The parsers of blocks that are published as is take the type to fill as
+ * template parameter: Either the plain struct of the same name declared here or
+ * the ROS message generated from msg/, which has the same fields plus a ROS
+ * header. This file thus needs no ROS headers.
  * @date 17/08/20
  */
 
@@ -232,37 +235,526 @@ struct ReceiverStatus
 };
 
 /**
- * @brief CRC look-up table for fast computation of the 16-bit CRC for SBF blocks.
- *
- * Provided by Septenrio (c) 2020 Septentrio N.V./S.A., Belgium.
- */
-static const std::array<uint16_t, 256> CRC_LOOK_UP = {
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7, 0x8108, 0x9129,
-    0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210, 0x3273, 0x2252,
-    0x52b5, 0x4294, 0x72f7, 0x62d6, 0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c,
-    0xf3ff, 0xe3de, 0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
-    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d, 0x3653, 0x2672,
-    0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4, 0xb75b, 0xa77a, 0x9719, 0x8738,
-    0xf7df, 0xe7fe, 0xd79d, 0xc7bc, 0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861,
-    0x2802, 0x3823, 0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
-    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12, 0xdbfd, 0xcbdc,
-    0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a, 0x6ca6, 0x7c87, 0x4ce4, 0x5cc5,
-    0x2c22, 0x3c03, 0x0c60, 0x1c41, 0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b,
-    0x8d68, 0x9d49, 0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
-    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78, 0x9188, 0x81a9,
-    0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f, 0x1080, 0x00a1, 0x30c2, 0x20e3,
-    0x5004, 0x4025, 0x7046, 0x6067, 0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c,
-    0xe37f, 0xf35e, 0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d, 0x34e2, 0x24c3,
-    0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xa7db, 0xb7fa, 0x8799, 0x97b8,
-    0xe75f, 0xf77e, 0xc71d, 0xd73c, 0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676,
-    0x4615, 0x5634, 0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3, 0xcb7d, 0xdb5c,
-    0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a, 0x4a75, 0x5a54, 0x6a37, 0x7a16,
-    0x0af1, 0x1ad0, 0x2ab3, 0x3a92, 0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b,
-    0x9de8, 0x8dc9, 0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
-    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36,
-    0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
+ * @class MeasEpochChannelType2
+ * @brief Struct for the SBF sub-block "MeasEpochChannelType2"
+ */
+struct MeasEpochChannelType2
+{
+    uint8_t type;
+    uint8_t lock_time;
+    uint8_t cn0;
+    uint8_t offsets_msb;
+    int8_t carrier_msb;
+    uint8_t obs_info;
+    uint16_t code_offset_lsb;
+    uint16_t carrier_lsb;
+    uint16_t doppler_offset_lsb;
+};
+
+/**
+ * @class MeasEpochChannelType1
+ * @brief Struct for the SBF sub-block "MeasEpochChannelType1"
+ */
+struct MeasEpochChannelType1
+{
+    uint8_t rx_channel;
+    uint8_t type;
+    uint8_t sv_id;
+    uint8_t misc;
+    uint32_t code_lsb;
+    int32_t doppler;
+    uint16_t carrier_lsb;
+    int8_t carrier_msb;
+    uint8_t cn0;
+    uint16_t lock_time;
+    uint8_t obs_info;
+    uint8_t n2;
+
+    std::vector<MeasEpochChannelType2> type2;
+};
+
+/**
+ * @class MeasEpoch
+ * @brief Struct for the SBF block "MeasEpoch"
+ */
+struct MeasEpoch
+{
+    BlockHeader block_header;
+
+    uint8_t n;
+    uint8_t sb1_length;
+    uint8_t sb2_length;
+    uint8_t common_flags;
+    uint8_t cum_clk_jumps;
+
+    std::vector<MeasEpochChannelType1> type1;
+};
+
+/**
+ * @class MeasEpochColumnar
+ * @brief Struct for the SBF block "MeasEpoch" decoded into one column per
+ * field, see msg/MeasEpochColumnar.msg for units
+ */
+struct MeasEpochColumnar
+{
+    BlockHeader block_header;
+
+    uint8_t common_flags;
+    uint8_t cum_clk_jumps;
+
+    std::vector<uint8_t> sv_id;
+    std::vector<uint8_t> signal;
+    std::vector<uint8_t> antenna;
+    std::vector<uint8_t> rx_channel;
+    std::vector<double> pseudorange;
+    std::vector<double> carrier_phase;
+    std::vector<double> doppler;
+    std::vector<float> cn0;
+    std::vector<uint16_t> lock_time;
+    std::vector<uint8_t> obs_info;
+};
+
+/**
+ * @class ReceiverTime
+ * @brief Struct for the SBF block "ReceiverTime"
+ */
+struct ReceiverTime
+{
+    BlockHeader block_header;
+
+    int8_t utc_year;
+    int8_t utc_month;
+    int8_t utc_day;
+    int8_t utc_hour;
+    int8_t utc_min;
+    int8_t utc_second;
+    int8_t delta_ls;
+    uint8_t sync_level;
+};
+
+/**
+ * @class PVTCartesian
+ * @brief Struct for the SBF block "PVTCartesian"
+ */
+struct PVTCartesian
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    double x;
+    double y;
+    double z;
+    float undulation;
+    float vx;
+    float vy;
+    float vz;
+    float cog;
+    double rx_clk_bias;
+    float rx_clk_drift;
+    uint8_t time_system;
+    uint8_t datum;
+    uint8_t nr_sv;
+    uint8_t wa_corr_info;
+    uint16_t reference_id;
+    uint16_t mean_corr_age;
+    uint32_t signal_info;
+    uint8_t alert_flag;
+    uint8_t nr_bases;
+    uint16_t ppp_info;
+    uint16_t latency;
+    uint16_t h_accuracy;
+    uint16_t v_accuracy;
+    uint8_t misc;
+};
+
+/**
+ * @class PVTGeodetic
+ * @brief Struct for the SBF block "PVTGeodetic"
+ */
+struct PVTGeodetic
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    double latitude;
+    double longitude;
+    double height;
+    float undulation;
+    float vn;
+    float ve;
+    float vu;
+    float cog;
+    double rx_clk_bias;
+    float rx_clk_drift;
+    uint8_t time_system;
+    uint8_t datum;
+    uint8_t nr_sv;
+    uint8_t wa_corr_info;
+    uint16_t reference_id;
+    uint16_t mean_corr_age;
+    uint32_t signal_info;
+    uint8_t alert_flag;
+    uint8_t nr_bases;
+    uint16_t ppp_info;
+    uint16_t latency;
+    uint16_t h_accuracy;
+    uint16_t v_accuracy;
+    uint8_t misc;
+};
+
+/**
+ * @class AttEuler
+ * @brief Struct for the SBF block "AttEuler"
+ */
+struct AttEuler
+{
+    BlockHeader block_header;
+
+    uint8_t nr_sv;
+    uint8_t error;
+    uint16_t mode;
+    float heading;
+    float pitch;
+    float roll;
+    float pitch_dot;
+    float roll_dot;
+    float heading_dot;
+};
+
+/**
+ * @class AttCovEuler
+ * @brief Struct for the SBF block "AttCovEuler"
+ */
+struct AttCovEuler
+{
+    BlockHeader block_header;
+
+    uint8_t error;
+    float cov_headhead;
+    float cov_pitchpitch;
+    float cov_rollroll;
+    float cov_headpitch;
+    float cov_headroll;
+    float cov_pitchroll;
+};
+
+/**
+ * @class VectorInfoCart
+ * @brief Struct for the SBF sub-block "VectorInfoCart"
+ */
+struct VectorInfoCart
+{
+    uint8_t nr_sv;
+    uint8_t error;
+    uint8_t mode;
+    uint8_t misc;
+    double delta_x;
+    double delta_y;
+    double delta_z;
+    float delta_vx;
+    float delta_vy;
+    float delta_vz;
+    uint16_t azimuth;
+    int16_t elevation;
+    uint16_t reference_id;
+    uint16_t corr_age;
+    uint32_t signal_info;
+};
+
+/**
+ * @class BaseVectorCart
+ * @brief Struct for the SBF block "BaseVectorCart"
+ */
+struct BaseVectorCart
+{
+    BlockHeader block_header;
+
+    uint8_t n;
+    uint8_t sb_length;
+
+    std::vector<VectorInfoCart> vector_info_cart;
+};
+
+/**
+ * @class VectorInfoGeod
+ * @brief Struct for the SBF sub-block "VectorInfoGeod"
+ */
+struct VectorInfoGeod
+{
+    uint8_t nr_sv;
+    uint8_t error;
+    uint8_t mode;
+    uint8_t misc;
+    double delta_east;
+    double delta_north;
+    double delta_up;
+    float delta_ve;
+    float delta_vn;
+    float delta_vu;
+    uint16_t azimuth;
+    int16_t elevation;
+    uint16_t reference_id;
+    uint16_t corr_age;
+    uint32_t signal_info;
+};
+
+/**
+ * @class BaseVectorGeod
+ * @brief Struct for the SBF block "BaseVectorGeod"
+ */
+struct BaseVectorGeod
+{
+    BlockHeader block_header;
+
+    uint8_t n;
+    uint8_t sb_length;
+
+    std::vector<VectorInfoGeod> vector_info_geod;
+};
+
+/**
+ * @class PosCovCartesian
+ * @brief Struct for the SBF block "PosCovCartesian"
+ */
+struct PosCovCartesian
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    float cov_xx;
+    float cov_yy;
+    float cov_zz;
+    float cov_bb;
+    float cov_xy;
+    float cov_xz;
+    float cov_xb;
+    float cov_yz;
+    float cov_yb;
+    float cov_zb;
+};
+
+/**
+ * @class PosCovGeodetic
+ * @brief Struct for the SBF block "PosCovGeodetic"
+ */
+struct PosCovGeodetic
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    float cov_latlat;
+    float cov_lonlon;
+    float cov_hgthgt;
+    float cov_bb;
+    float cov_latlon;
+    float cov_lathgt;
+    float cov_latb;
+    float cov_lonhgt;
+    float cov_lonb;
+    float cov_hb;
+};
+
+/**
+ * @class VelCovCartesian
+ * @brief Struct for the SBF block "VelCovCartesian"
+ */
+struct VelCovCartesian
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    float cov_vxvx;
+    float cov_vyvy;
+    float cov_vzvz;
+    float cov_dtdt;
+    float cov_vxvy;
+    float cov_vxvz;
+    float cov_vxdt;
+    float cov_vyvz;
+    float cov_vydt;
+    float cov_vzdt;
+};
+
+/**
+ * @class VelCovGeodetic
+ * @brief Struct for the SBF block "VelCovGeodetic"
+ */
+struct VelCovGeodetic
+{
+    BlockHeader block_header;
+
+    uint8_t mode;
+    uint8_t error;
+    float cov_vnvn;
+    float cov_veve;
+    float cov_vuvu;
+    float cov_dtdt;
+    float cov_vnve;
+    float cov_vnvu;
+    float cov_vndt;
+    float cov_vevu;
+    float cov_vedt;
+    float cov_vudt;
+};
+
+/**
+ * @class INSNavCart
+ * @brief Struct for the SBF block "INSNavCart"
+ */
+struct INSNavCart
+{
+    BlockHeader block_header;
+
+    uint8_t gnss_mode;
+    uint8_t error;
+    uint16_t info;
+    uint16_t gnss_age;
+    double x;
+    double y;
+    double z;
+    uint16_t accuracy;
+    uint16_t latency;
+    uint8_t datum;
+    uint16_t sb_list;
+    float x_std_dev;
+    float y_std_dev;
+    float z_std_dev;
+    float xy_cov;
+    float xz_cov;
+    float yz_cov;
+    float heading;
+    float pitch;
+    float roll;
+    float heading_std_dev;
+    float pitch_std_dev;
+    float roll_std_dev;
+    float heading_pitch_cov;
+    float heading_roll_cov;
+    float pitch_roll_cov;
+    float vx;
+    float vy;
+    float vz;
+    float vx_std_dev;
+    float vy_std_dev;
+    float vz_std_dev;
+    float vx_vy_cov;
+    float vx_vz_cov;
+    float vy_vz_cov;
+};
+
+/**
+ * @class INSNavGeod
+ * @brief Struct for the SBF block "INSNavGeod"
+ */
+struct INSNavGeod
+{
+    BlockHeader block_header;
+
+    uint8_t gnss_mode;
+    uint8_t error;
+    uint16_t info;
+    uint16_t gnss_age;
+    double latitude;
+    double longitude;
+    double height;
+    float undulation;
+    uint16_t accuracy;
+    uint16_t latency;
+    uint8_t datum;
+    uint16_t sb_list;
+    float latitude_std_dev;
+    float longitude_std_dev;
+    float height_std_dev;
+    float latitude_longitude_cov;
+    float latitude_height_cov;
+    float longitude_height_cov;
+    float heading;
+    float pitch;
+    float roll;
+    float heading_std_dev;
+    float pitch_std_dev;
+    float roll_std_dev;
+    float heading_pitch_cov;
+    float heading_roll_cov;
+    float pitch_roll_cov;
+    float ve;
+    float vn;
+    float vu;
+    float ve_std_dev;
+    float vn_std_dev;
+    float vu_std_dev;
+    float ve_vn_cov;
+    float ve_vu_cov;
+    float vn_vu_cov;
+};
+
+/**
+ * @class IMUSetup
+ * @brief Struct for the SBF block "IMUSetup"
+ */
+struct IMUSetup
+{
+    BlockHeader block_header;
+
+    uint8_t serial_port;
+    float ant_lever_arm_x;
+    float ant_lever_arm_y;
+    float ant_lever_arm_z;
+    float theta_x;
+    float theta_y;
+    float theta_z;
+};
+
+/**
+ * @class VelSensorSetup
+ * @brief Struct for the SBF block "VelSensorSetup"
+ */
+struct VelSensorSetup
+{
+    BlockHeader block_header;
+
+    uint8_t port;
+    float lever_arm_x;
+    float lever_arm_y;
+    float lever_arm_z;
+};
+
+/**
+ * @class ExtSensorMeas
+ * @brief Struct for the SBF block "ExtSensorMeas"
+ */
+struct ExtSensorMeas
+{
+    BlockHeader block_header;
+
+    uint8_t n;
+    uint8_t sb_length;
+
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> sensor_model;
+    std::vector<uint8_t> type;
+    std::vector<uint8_t> obs_info;
+
+    double acceleration_x;
+    double acceleration_y;
+    double acceleration_z;
+    double angular_rate_x;
+    double angular_rate_y;
+    double angular_rate_z;
+    float velocity_x;
+    float velocity_y;
+    float velocity_z;
+    float std_dev_x;
+    float std_dev_y;
+    float std_dev_z;
+    float sensor_temperature; /* [deg C] */
+    double zero_velocity_flag;
+};
 
 namespace qi = boost::spirit::qi;
 
@@ -369,18 +861,18 @@ bool qiCharsToStringParser(It& it, std::string& val, std::size_t num)
  * @brief Qi based parser for the SBF block "BlockHeader" plus receiver time stamp
  */
 template <typename It, typename Hdr>
-bool BlockHeaderParser(ROSaicNodeBase* node, It& it, Hdr& block_header)
+bool BlockHeaderParser(LogSink* logger, It& it, Hdr& block_header)
 {
     qiLittleEndianParser(it, block_header.sync_1);
     if (block_header.sync_1 != SBF_SYNC_BYTE_1)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong sync byte 1.");
+        logger->log(LogLevel::ERROR, "Parse error: Wrong sync byte 1.");
         return false;
     }
     qiLittleEndianParser(it, block_header.sync_2);
     if (block_header.sync_2 != SBF_SYNC_BYTE_2)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong sync byte 2.");
+        logger->log(LogLevel::ERROR, "Parse error: Wrong sync byte 2.");
         return false;
     }
     qiLittleEndianParser(it, block_header.crc);
@@ -414,7 +906,7 @@ void ChannelStateInfoParser(It& it, ChannelStateInfo& msg, uint8_t sb2_length)
  * @brief Qi based parser or the SBF sub-block "ChannelSatInfo"
  */
 template <typename It>
-bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it, ChannelSatInfo& msg,
+bool ChannelSatInfoParser(LogSink* logger, It& it, ChannelSatInfo& msg,
                           uint8_t sb1_length, uint8_t sb2_length)
 {
     qiLittleEndianParser(it, msg.sv_id);
@@ -426,8 +918,8 @@ bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it, ChannelSatInfo& msg,
     qiLittleEndianParser(it, msg.n2);
     if (msg.n2 > MAXSB_CHANNELSTATEINFO)
     {
-        node->log(LogLevel::ERROR, "Parse error: Too many ChannelStateInfo " +
-                                       std::to_string(msg.n2));
+        logger->log(LogLevel::ERROR, "Parse error: Too many ChannelStateInfo " +
+                                         std::to_string(msg.n2));
         return false;
     }
     qiLittleEndianParser(it, msg.rx_channel);
@@ -446,21 +938,21 @@ bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it, ChannelSatInfo& msg,
  * @brief Qi based parser for the SBF block "ChannelStatus"
  */
 template <typename It>
-bool ChannelStatusParser(ROSaicNodeBase* node, It it, It itEnd, ChannelStatus& msg)
+bool ChannelStatusParser(LogSink* logger, It it, It itEnd, ChannelStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4013)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     if (msg.n > MAXSB_CHANNELSATINFO)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Too many ChannelSatInfo " + std::to_string(msg.n));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Too many ChannelSatInfo " + std::to_string(msg.n));
         return false;
     }
     qiLittleEndianParser(it, msg.sb1_length);
@@ -469,12 +961,13 @@ bool ChannelStatusParser(ROSaicNodeBase* node, It it, It itEnd, ChannelStatus& m
     msg.satInfo.resize(msg.n);
     for (auto& satInfo : msg.satInfo)
     {
-        if (!ChannelSatInfoParser(node, it, satInfo, msg.sb1_length, msg.sb2_length))
+        if (!ChannelSatInfoParser(logger, it, satInfo, msg.sb1_length,
+                                  msg.sb2_length))
             return false;
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -485,15 +978,15 @@ bool ChannelStatusParser(ROSaicNodeBase* node, It it, It itEnd, ChannelStatus& m
  * @brief Qi based parser for the SBF block "DOP"
  */
 template <typename It>
-bool DOPParser(ROSaicNodeBase* node, It it, It itEnd, DOP& msg)
+bool DOPParser(LogSink* logger, It it, It itEnd, DOP& msg)
 {
 
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4001)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.nr_sv);
@@ -511,7 +1004,7 @@ bool DOPParser(ROSaicNodeBase* node, It it, It itEnd, DOP& msg)
     qiLittleEndianParser(it, msg.vpl);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -521,9 +1014,8 @@ bool DOPParser(ROSaicNodeBase* node, It it, It itEnd, DOP& msg)
  * MeasEpochChannelType2Parser
  * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType2"
  */
-template <typename It>
-void MeasEpochChannelType2Parser(It& it, MeasEpochChannelType2Msg& msg,
-                                 uint8_t sb2_length)
+template <typename It, typename Msg>
+void MeasEpochChannelType2Parser(It& it, Msg& msg, uint8_t sb2_length)
 {
     qiLittleEndianParser(it, msg.type);
     qiLittleEndianParser(it, msg.lock_time);
@@ -541,10 +1033,9 @@ void MeasEpochChannelType2Parser(It& it, MeasEpochChannelType2Msg& msg,
  * @class MeasEpochChannelType1Parser
  * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType1"
  */
-template <typename It>
-bool MeasEpochChannelType1Parser(ROSaicNodeBase* node, It& it,
-                                 MeasEpochChannelType1Msg& msg, uint8_t sb1_length,
-                                 uint8_t sb2_length)
+template <typename It, typename Msg>
+bool MeasEpochChannelType1Parser(LogSink* logger, It& it, Msg& msg,
+                                 uint8_t sb1_length, uint8_t sb2_length)
 {
     qiLittleEndianParser(it, msg.rx_channel);
     qiLittleEndianParser(it, msg.type);
@@ -561,8 +1052,8 @@ bool MeasEpochChannelType1Parser(ROSaicNodeBase* node, It& it,
     std::advance(it, sb1_length - 20); // skip padding
     if (msg.n2 > MAXSB_MEASEPOCH_T2)
     {
-        node->log(LogLevel::ERROR, "Parse error: Too many MeasEpochChannelType2 " +
-                                       std::to_string(msg.n2));
+        logger->log(LogLevel::ERROR, "Parse error: Too many MeasEpochChannelType2 " +
+                                         std::to_string(msg.n2));
         return false;
     }
     msg.type2.resize(msg.n2);
@@ -577,22 +1068,22 @@ bool MeasEpochChannelType1Parser(ROSaicNodeBase* node, It& it,
  * @class MeasEpoch
  * @brief Qi based parser for the SBF block "MeasEpoch"
  */
-template <typename It>
-bool MeasEpochParser(ROSaicNodeBase* node, It it, It itEnd, MeasEpochMsg& msg)
+template <typename It, typename Msg>
+bool MeasEpochParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4027)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     if (msg.n > MAXSB_MEASEPOCH_T1)
     {
-        node->log(LogLevel::ERROR, "Parse error: Too many MeasEpochChannelType1 " +
-                                       std::to_string(msg.n));
+        logger->log(LogLevel::ERROR, "Parse error: Too many MeasEpochChannelType1 " +
+                                         std::to_string(msg.n));
         return false;
     }
     qiLittleEndianParser(it, msg.sb1_length);
@@ -600,17 +1091,300 @@ bool MeasEpochParser(ROSaicNodeBase* node, It it, It itEnd, MeasEpochMsg& msg)
     qiLittleEndianParser(it, msg.common_flags);
     if (msg.block_header.revision > 0)
         qiLittleEndianParser(it, msg.cum_clk_jumps);
+    else
+        msg.cum_clk_jumps = 0; // msg may be recycled
     ++it; // reserved
     msg.type1.resize(msg.n);
     for (auto& type1 : msg.type1)
     {
-        if (!MeasEpochChannelType1Parser(node, it, type1, msg.sb1_length,
+        if (!MeasEpochChannelType1Parser(logger, it, type1, msg.sb1_length,
                                          msg.sb2_length))
             return false;
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        return false;
+    }
+    return true;
+};
+
+/**
+ * @brief Carrier frequency of an SBF signal number in Hz
+ * @param[in] signal Signal number as defined in the SBF reference guide
+ * @param[in] freq_nr GLONASS frequency number, ignored for other signals
+ * @return Carrier frequency in Hz, 0 if the signal is unknown
+ */
+inline double signalFrequency(uint8_t signal, int8_t freq_nr)
+{
+    switch (signal)
+    {
+    case 0:
+    case 1:
+    case 5:
+    case 6:
+    case 13:
+    case 17:
+    case 24:
+    case 32:
+    case 33:
+        return 1575.42e6;
+    case 2:
+    case 3:
+    case 7:
+        return 1227.60e6;
+    case 4:
+    case 14:
+    case 15:
+    case 20:
+    case 25:
+    case 26:
+    case 37:
+        return 1176.45e6;
+    case 8:
+    case 9:
+        return 1602.0e6 + freq_nr * 0.5625e6;
+    case 10:
+    case 11:
+        return 1246.0e6 + freq_nr * 0.4375e6;
+    case 12:
+        return 1202.025e6;
+    case 19:
+    case 27:
+        return 1278.75e6;
+    case 21:
+    case 29:
+    case 34:
+        return 1207.14e6;
+    case 22:
+        return 1191.795e6;
+    case 28:
+        return 1561.098e6;
+    case 30:
+        return 1268.52e6;
+    default:
+        return 0.0;
+    }
+}
+
+/**
+ * @brief Signal number from the "Type" and "ObsInfo" fields of a MeasEpoch
+ * sub-block
+ */
+inline uint8_t measEpochSignal(uint8_t type, uint8_t obs_info)
+{
+    uint8_t sig_idx_lo = type & 31;
+    if (sig_idx_lo == 31)
+        return (obs_info >> 3) + 32;
+    return sig_idx_lo;
+}
+
+/**
+ * @brief GLONASS frequency number from the "ObsInfo" field of a MeasEpoch
+ * sub-block, only meaningful for GLONASS signals
+ */
+inline int8_t measEpochFreqNr(uint8_t obs_info)
+{
+    return static_cast<int8_t>((obs_info >> 3) - 8);
+}
+
+/**
+ * @brief Appends one signal to the columns of a MeasEpochColumnar message
+ */
+template <typename Msg>
+inline void pushMeasEpochColumnarSignal(Msg& msg, uint8_t sv_id, uint8_t rx_channel,
+                                        uint8_t type, uint8_t signal,
+                                        uint8_t obs_info, double frequency,
+                                        double pseudorange, double doppler,
+                                        double carrier_cycles, bool carrier_valid,
+                                        uint8_t cn0, uint16_t lock_time)
+{
+    static const double c = 299792458.0;
+    static const double dnu = -2e10;
+    msg.sv_id.push_back(sv_id);
+    msg.signal.push_back(signal);
+    msg.antenna.push_back(type >> 5);
+    msg.rx_channel.push_back(rx_channel);
+    msg.pseudorange.push_back(pseudorange);
+    if ((pseudorange != dnu) && carrier_valid && (frequency > 0.0))
+        msg.carrier_phase.push_back(pseudorange * frequency / c + carrier_cycles);
+    else
+        msg.carrier_phase.push_back(dnu);
+    msg.doppler.push_back(doppler);
+    if (cn0 == 255)
+        msg.cn0.push_back(static_cast<float>(dnu));
+    else if ((signal == 1) || (signal == 2))
+        msg.cn0.push_back(cn0 * 0.25f);
+    else
+        msg.cn0.push_back(cn0 * 0.25f + 10.0f);
+    msg.lock_time.push_back(lock_time);
+    msg.obs_info.push_back(obs_info);
+}
+
+/**
+ * @class MeasEpochColumnar
+ * @brief Qi based parser for the SBF block "MeasEpoch" into one array per
+ * observable
+ *
+ * The sub-blocks are decoded straight into the columns, so no intermediate
+ * MeasEpochChannelType1/2 messages are created. Capacity of the arrays is
+ * kept if msg is recycled.
+ */
+template <typename It, typename Msg>
+bool MeasEpochColumnarParser(LogSink* logger, It it, It itEnd, Msg& msg)
+{
+    static const double dnu = -2e10;
+    if (!BlockHeaderParser(logger, it, msg.block_header))
+        return false;
+    if (msg.block_header.id != 4027)
+    {
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
+        return false;
+    }
+    uint8_t n;
+    uint8_t sb1_length;
+    uint8_t sb2_length;
+    qiLittleEndianParser(it, n);
+    if (n > MAXSB_MEASEPOCH_T1)
+    {
+        logger->log(LogLevel::ERROR, "Parse error: Too many MeasEpochChannelType1 " +
+                                         std::to_string(n));
+        return false;
+    }
+    qiLittleEndianParser(it, sb1_length);
+    qiLittleEndianParser(it, sb2_length);
+    if ((sb1_length < 20) || (sb2_length < 12))
+    {
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Invalid MeasEpoch sub-block lengths " +
+                        std::to_string(sb1_length) + " and " +
+                        std::to_string(sb2_length));
+        return false;
+    }
+    qiLittleEndianParser(it, msg.common_flags);
+    if (msg.block_header.revision > 0)
+        qiLittleEndianParser(it, msg.cum_clk_jumps);
+    else
+        msg.cum_clk_jumps = 0; // msg may be recycled
+    ++it; // reserved
+
+    msg.sv_id.clear();
+    msg.signal.clear();
+    msg.antenna.clear();
+    msg.rx_channel.clear();
+    msg.pseudorange.clear();
+    msg.carrier_phase.clear();
+    msg.doppler.clear();
+    msg.cn0.clear();
+    msg.lock_time.clear();
+    msg.obs_info.clear();
+
+    for (uint8_t i = 0; i < n; ++i)
+    {
+        if (std::distance(it, itEnd) < sb1_length)
+        {
+            logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
+            return false;
+        }
+        uint8_t rx_channel;
+        uint8_t type;
+        uint8_t sv_id;
+        uint8_t misc;
+        uint32_t code_lsb;
+        int32_t doppler;
+        uint16_t carrier_lsb;
+        int8_t carrier_msb;
+        uint8_t cn0;
+        uint16_t lock_time;
+        uint8_t obs_info;
+        uint8_t n2;
+        qiLittleEndianParser(it, rx_channel);
+        qiLittleEndianParser(it, type);
+        qiLittleEndianParser(it, sv_id);
+        qiLittleEndianParser(it, misc);
+        qiLittleEndianParser(it, code_lsb);
+        qiLittleEndianParser(it, doppler);
+        qiLittleEndianParser(it, carrier_lsb);
+        qiLittleEndianParser(it, carrier_msb);
+        qiLittleEndianParser(it, cn0);
+        qiLittleEndianParser(it, lock_time);
+        qiLittleEndianParser(it, obs_info);
+        qiLittleEndianParser(it, n2);
+        std::advance(it, sb1_length - 20); // skip padding
+        if (n2 > MAXSB_MEASEPOCH_T2)
+        {
+            logger->log(LogLevel::ERROR,
+                        "Parse error: Too many MeasEpochChannelType2 " +
+                            std::to_string(n2));
+            return false;
+        }
+
+        uint8_t signal1 = measEpochSignal(type, obs_info);
+        double freq1 = signalFrequency(signal1, measEpochFreqNr(obs_info));
+        double pr1 = dnu;
+        if (((misc & 15) != 0) || (code_lsb != 0))
+            pr1 = (misc & 15) * 4294967.296 + code_lsb * 0.001;
+        double doppler1 = dnu;
+        if (doppler != std::numeric_limits<int32_t>::min())
+            doppler1 = doppler * 0.0001;
+        pushMeasEpochColumnarSignal(
+            msg, sv_id, rx_channel, type, signal1, obs_info, freq1, pr1, doppler1,
+            (carrier_msb * 65536 + carrier_lsb) * 0.001,
+            (carrier_msb != -128) || (carrier_lsb != 0), cn0, lock_time);
+
+        if (std::distance(it, itEnd) < static_cast<int32_t>(n2) * sb2_length)
+        {
+            logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
+            return false;
+        }
+        for (uint8_t j = 0; j < n2; ++j)
+        {
+            uint8_t type2;
+            uint8_t lock_time2;
+            uint8_t cn02;
+            uint8_t offsets_msb;
+            int8_t carrier_msb2;
+            uint8_t obs_info2;
+            uint16_t code_offset_lsb;
+            uint16_t carrier_lsb2;
+            uint16_t doppler_offset_lsb;
+            qiLittleEndianParser(it, type2);
+            qiLittleEndianParser(it, lock_time2);
+            qiLittleEndianParser(it, cn02);
+            qiLittleEndianParser(it, offsets_msb);
+            qiLittleEndianParser(it, carrier_msb2);
+            qiLittleEndianParser(it, obs_info2);
+            qiLittleEndianParser(it, code_offset_lsb);
+            qiLittleEndianParser(it, carrier_lsb2);
+            qiLittleEndianParser(it, doppler_offset_lsb);
+            std::advance(it, sb2_length - 12); // skip padding
+
+            // sign-extend 3 bit code offset and 5 bit Doppler offset MSBs
+            int32_t code_offset_msb = ((offsets_msb & 7) ^ 4) - 4;
+            int32_t doppler_offset_msb = ((offsets_msb >> 3) ^ 16) - 16;
+            double pr2 = dnu;
+            if ((pr1 != dnu) &&
+                ((code_offset_msb != -4) || (code_offset_lsb != 0)))
+                pr2 = pr1 + (code_offset_msb * 65536 + code_offset_lsb) * 0.001;
+            double doppler2 = dnu;
+            uint8_t signal2 = measEpochSignal(type2, obs_info2);
+            double freq2 = signalFrequency(signal2, measEpochFreqNr(obs_info2));
+            if ((doppler1 != dnu) && (freq1 > 0.0) && (freq2 > 0.0) &&
+                ((doppler_offset_msb != -16) || (doppler_offset_lsb != 0)))
+                doppler2 =
+                    doppler1 * freq2 / freq1 +
+                    (doppler_offset_msb * 65536 + doppler_offset_lsb) * 0.0001;
+            pushMeasEpochColumnarSignal(
+                msg, sv_id, rx_channel, type2, signal2, obs_info2, freq2, pr2,
+                doppler2, (carrier_msb2 * 65536 + carrier_lsb2) * 0.001,
+                (carrier_msb2 != -128) || (carrier_lsb2 != 0), cn02,
+                (lock_time2 == 255) ? 65535 : lock_time2);
+        }
+    }
+    if (it > itEnd)
+    {
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -621,14 +1395,14 @@ bool MeasEpochParser(ROSaicNodeBase* node, It it, It itEnd, MeasEpochMsg& msg)
  * @brief Qi based parser for the SBF block "ReceiverSetup"
  */
 template <typename It>
-bool ReceiverSetupParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverSetup& msg)
+bool ReceiverSetupParser(LogSink* logger, It it, It itEnd, ReceiverSetup& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5902)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     std::advance(it, 2); // reserved
@@ -667,7 +1441,7 @@ bool ReceiverSetupParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverSetup& m
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -677,15 +1451,15 @@ bool ReceiverSetupParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverSetup& m
  * ReceiverTimeParser
  * @brief Struct for the SBF block "ReceiverTime"
  */
-template <typename It>
-bool ReceiverTimesParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg& msg)
+template <typename It, typename Msg>
+bool ReceiverTimesParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.utc_year);
@@ -698,7 +1472,7 @@ bool ReceiverTimesParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg&
     qiLittleEndianParser(it, msg.sync_level);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -708,15 +1482,15 @@ bool ReceiverTimesParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg&
  * PVTCartesianParser
  * @brief Qi based parser for the SBF block "PVTCartesian"
  */
-template <typename It>
-bool PVTCartesianParser(ROSaicNodeBase* node, It it, It itEnd, PVTCartesianMsg& msg)
+template <typename It, typename Msg>
+bool PVTCartesianParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4006)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -753,7 +1527,7 @@ bool PVTCartesianParser(ROSaicNodeBase* node, It it, It itEnd, PVTCartesianMsg&
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -763,15 +1537,15 @@ bool PVTCartesianParser(ROSaicNodeBase* node, It it, It itEnd, PVTCartesianMsg&
  * PVTGeodeticParser
  * @brief Qi based parser for the SBF block "PVTGeodetic"
  */
-template <typename It>
-bool PVTGeodeticParser(ROSaicNodeBase* node, It it, It itEnd, PVTGeodeticMsg& msg)
+template <typename It, typename Msg>
+bool PVTGeodeticParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4007)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -808,7 +1582,7 @@ bool PVTGeodeticParser(ROSaicNodeBase* node, It it, It itEnd, PVTGeodeticMsg& ms
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -818,16 +1592,16 @@ bool PVTGeodeticParser(ROSaicNodeBase* node, It it, It itEnd, PVTGeodeticMsg& ms
  * AttEulerParser
  * @brief Qi based parser for the SBF block "AttEuler"
  */
-template <typename It>
-bool AttEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttEulerMsg& msg,
+template <typename It, typename Msg>
+bool AttEulerParser(LogSink* logger, It it, It itEnd, Msg& msg,
                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5938)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.nr_sv);
@@ -853,7 +1627,7 @@ bool AttEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttEulerMsg& msg,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -863,16 +1637,16 @@ bool AttEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttEulerMsg& msg,
  * AttCovEulerParser
  * @brief Qi based parser for the SBF block "AttCovEuler"
  */
-template <typename It>
-bool AttCovEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttCovEulerMsg& msg,
+template <typename It, typename Msg>
+bool AttCovEulerParser(LogSink* logger, It it, It itEnd, Msg& msg,
                        bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5939)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     ++it; // reserved
@@ -892,7 +1666,7 @@ bool AttCovEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttCovEulerMsg& ms
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -902,8 +1676,8 @@ bool AttCovEulerParser(ROSaicNodeBase* node, It it, It itEnd, AttCovEulerMsg& ms
  * VectorInfoCartParser
  * @brief Qi based parser for the SBF sub-block "VectorInfoCart"
  */
-template <typename It>
-void VectorInfoCartParser(It& it, VectorInfoCartMsg& msg, uint8_t sb_length)
+template <typename It, typename Msg>
+void VectorInfoCartParser(It& it, Msg& msg, uint8_t sb_length)
 {
     qiLittleEndianParser(it, msg.nr_sv);
     qiLittleEndianParser(it, msg.error);
@@ -927,23 +1701,22 @@ void VectorInfoCartParser(It& it, VectorInfoCartMsg& msg, uint8_t sb_length)
  * @class BaseVectorCart
  * @brief Qi based parser for the SBF block "BaseVectorCart"
  */
-template <typename It>
-bool BaseVectorCartParser(ROSaicNodeBase* node, It it, It itEnd,
-                          BaseVectorCartMsg& msg)
+template <typename It, typename Msg>
+bool BaseVectorCartParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4043)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Too many VectorInfoCart " + std::to_string(msg.n));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Too many VectorInfoCart " + std::to_string(msg.n));
         return false;
     }
     qiLittleEndianParser(it, msg.sb_length);
@@ -954,7 +1727,7 @@ bool BaseVectorCartParser(ROSaicNodeBase* node, It it, It itEnd,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -964,8 +1737,8 @@ bool BaseVectorCartParser(ROSaicNodeBase* node, It it, It itEnd,
  * VectorInfoGeodParser
  * @brief Qi based parser for the SBF sub-block "VectorInfoGeod"
  */
-template <typename It>
-void VectorInfoGeodParser(It& it, VectorInfoGeodMsg& msg, uint8_t sb_length)
+template <typename It, typename Msg>
+void VectorInfoGeodParser(It& it, Msg& msg, uint8_t sb_length)
 {
     qiLittleEndianParser(it, msg.nr_sv);
     qiLittleEndianParser(it, msg.error);
@@ -989,23 +1762,22 @@ void VectorInfoGeodParser(It& it, VectorInfoGeodMsg& msg, uint8_t sb_length)
  * @class BaseVectorGeod
  * @brief Qi based parser for the SBF block "BaseVectorGeod"
  */
-template <typename It>
-bool BaseVectorGeodParser(ROSaicNodeBase* node, It it, It itEnd,
-                          BaseVectorGeodMsg& msg)
+template <typename It, typename Msg>
+bool BaseVectorGeodParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4028)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Too many VectorInfoGeod " + std::to_string(msg.n));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Too many VectorInfoGeod " + std::to_string(msg.n));
         return false;
     }
     qiLittleEndianParser(it, msg.sb_length);
@@ -1016,7 +1788,7 @@ bool BaseVectorGeodParser(ROSaicNodeBase* node, It it, It itEnd,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1026,16 +1798,16 @@ bool BaseVectorGeodParser(ROSaicNodeBase* node, It it, It itEnd,
  * INSNavCartParser
  * @brief Qi based parser for the SBF block "INSNavCart"
  */
-template <typename It>
-bool INSNavCartParser(ROSaicNodeBase* node, It it, It itEnd, INSNavCartMsg& msg,
+template <typename It, typename Msg>
+bool INSNavCartParser(LogSink* logger, It it, It itEnd, Msg& msg,
                       bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if ((msg.block_header.id != 4225) && (msg.block_header.id != 4229))
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.gnss_mode);
@@ -1154,7 +1926,7 @@ bool INSNavCartParser(ROSaicNodeBase* node, It it, It itEnd, INSNavCartMsg& msg,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1164,16 +1936,15 @@ bool INSNavCartParser(ROSaicNodeBase* node, It it, It itEnd, INSNavCartMsg& msg,
  * PosCovCartesianParser
  * @brief Qi based parser for the SBF block "PosCovCartesian"
  */
-template <typename It>
-bool PosCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
-                           PosCovCartesianMsg& msg)
+template <typename It, typename Msg>
+bool PosCovCartesianParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5905)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -1190,7 +1961,7 @@ bool PosCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
     qiLittleEndianParser(it, msg.cov_zb);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1200,16 +1971,15 @@ bool PosCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
  * PosCovGeodeticParser
  * @brief Qi based parser for the SBF block "PosCovGeodetic"
  */
-template <typename It>
-bool PosCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
-                          PosCovGeodeticMsg& msg)
+template <typename It, typename Msg>
+bool PosCovGeodeticParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5906)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -1226,7 +1996,7 @@ bool PosCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
     qiLittleEndianParser(it, msg.cov_hb);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1236,16 +2006,15 @@ bool PosCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
  * VelCovCartesianParser
  * @brief Qi based parser for the SBF block "VelCovCartesian"
  */
-template <typename It>
-bool VelCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
-                           VelCovCartesianMsg& msg)
+template <typename It, typename Msg>
+bool VelCovCartesianParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5907)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -1262,7 +2031,7 @@ bool VelCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
     qiLittleEndianParser(it, msg.cov_vzdt);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1272,16 +2041,15 @@ bool VelCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
  * VelCovGeodeticParser
  * @brief Qi based parser for the SBF block "VelCovGeodetic"
  */
-template <typename It>
-bool VelCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
-                          VelCovGeodeticMsg& msg)
+template <typename It, typename Msg>
+bool VelCovGeodeticParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5908)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.mode);
@@ -1298,7 +2066,7 @@ bool VelCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
     qiLittleEndianParser(it, msg.cov_vudt);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1309,21 +2077,21 @@ bool VelCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
  * @brief @brief Qi based parser for the SBF block "QualityInd"
  */
 template <typename It>
-bool QualityIndParser(ROSaicNodeBase* node, It it, It itEnd, QualityInd& msg)
+bool QualityIndParser(LogSink* logger, It it, It itEnd, QualityInd& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4082)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     if (msg.n > 40)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Too many indicators " + std::to_string(msg.n));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Too many indicators " + std::to_string(msg.n));
         return false;
     }
     ++it; // reserved
@@ -1335,7 +2103,7 @@ bool QualityIndParser(ROSaicNodeBase* node, It it, It itEnd, QualityInd& msg)
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1360,14 +2128,14 @@ void AgcStateParser(It it, AgcState& msg, uint8_t sb_length)
  * @brief Struct for the SBF block "ReceiverStatus"
  */
 template <typename It>
-bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverStatus& msg)
+bool ReceiverStatusParser(LogSink* logger, It it, It itEnd, ReceiverStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4014)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.cpu_load);
@@ -1378,8 +2146,8 @@ bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverStatus&
     qiLittleEndianParser(it, msg.n);
     if (msg.n > 18)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Too many AGCState " + std::to_string(msg.n));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Too many AGCState " + std::to_string(msg.n));
         return false;
     }
     qiLittleEndianParser(it, msg.sb_length);
@@ -1392,7 +2160,7 @@ bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverStatus&
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1402,15 +2170,15 @@ bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverStatus&
  * ReceiverTimeParser
  * @brief Struct for the SBF block "ReceiverTime"
  */
-template <typename It>
-bool ReceiverTimeParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg& msg)
+template <typename It, typename Msg>
+bool ReceiverTimeParser(LogSink* logger, It it, It itEnd, Msg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.utc_year);
@@ -1423,7 +2191,7 @@ bool ReceiverTimeParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg&
     qiLittleEndianParser(it, msg.sync_level);
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1433,16 +2201,16 @@ bool ReceiverTimeParser(ROSaicNodeBase* node, It it, It itEnd, ReceiverTimeMsg&
  * INSNavGeodParser
  * @brief Qi based parser for the SBF block "INSNavGeod"
  */
-template <typename It>
-bool INSNavGeodParser(ROSaicNodeBase* node, It it, It itEnd, INSNavGeodMsg& msg,
+template <typename It, typename Msg>
+bool INSNavGeodParser(LogSink* logger, It it, It itEnd, Msg& msg,
                       bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if ((msg.block_header.id != 4226) && (msg.block_header.id != 4230))
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.gnss_mode);
@@ -1562,7 +2330,7 @@ bool INSNavGeodParser(ROSaicNodeBase* node, It it, It itEnd, INSNavGeodMsg& msg,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1572,16 +2340,16 @@ bool INSNavGeodParser(ROSaicNodeBase* node, It it, It itEnd, INSNavGeodMsg& msg,
  * IMUSetupParser
  * @brief Qi based parser for the SBF block "IMUSetup"
  */
-template <typename It>
-bool IMUSetupParser(ROSaicNodeBase* node, It it, It itEnd, IMUSetupMsg& msg,
+template <typename It, typename Msg>
+bool IMUSetupParser(LogSink* logger, It it, It itEnd, Msg& msg,
                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4224)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     ++it; // reserved
@@ -1600,7 +2368,7 @@ bool IMUSetupParser(ROSaicNodeBase* node, It it, It itEnd, IMUSetupMsg& msg,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1610,16 +2378,16 @@ bool IMUSetupParser(ROSaicNodeBase* node, It it, It itEnd, IMUSetupMsg& msg,
  * VelSensorSetupParser
  * @brief Qi based parser for the SBF block "VelSensorSetup"
  */
-template <typename It>
-bool VelSensorSetupParser(ROSaicNodeBase* node, It it, It itEnd,
-                          VelSensorSetupMsg& msg, bool use_ros_axis_orientation)
+template <typename It, typename Msg>
+bool VelSensorSetupParser(LogSink* logger, It it, It itEnd, Msg& msg,
+                          bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4244)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     ++it; // reserved
@@ -1634,7 +2402,7 @@ bool VelSensorSetupParser(ROSaicNodeBase* node, It it, It itEnd,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     return true;
@@ -1644,25 +2412,24 @@ bool VelSensorSetupParser(ROSaicNodeBase* node, It it, It itEnd,
  * ExtSensorMeasParser
  * @brief Qi based parser for the SBF block "ExtSensorMeas"
  */
-template <typename It>
-bool ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd,
-                         ExtSensorMeasMsg& msg, bool use_ros_axis_orientation,
-                         bool& hasImuMeas)
+template <typename It, typename Msg>
+bool ExtSensorMeasParser(LogSink* logger, It it, It itEnd, Msg& msg,
+                         bool use_ros_axis_orientation, bool& hasImuMeas)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(logger, it, msg.block_header))
         return false;
     if (msg.block_header.id != 4050)
     {
-        node->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
-                                       std::to_string(msg.block_header.id));
+        logger->log(LogLevel::ERROR, "Parse error: Wrong header ID " +
+                                         std::to_string(msg.block_header.id));
         return false;
     }
     qiLittleEndianParser(it, msg.n);
     qiLittleEndianParser(it, msg.sb_length);
     if (msg.sb_length != 28)
     {
-        node->log(LogLevel::ERROR,
-                  "Parse error: Wrong sb_length " + std::to_string(msg.sb_length));
+        logger->log(LogLevel::ERROR,
+                    "Parse error: Wrong sb_length " + std::to_string(msg.sb_length));
         return false;
     }
 
@@ -1763,7 +2530,7 @@ bool ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd,
         }
         default:
         {
-            node->log(
+            logger->log(
                 LogLevel::ERROR,
                 "Unknown external sensor measurement type in SBF ExtSensorMeas.");
             std::advance(it, 24);
@@ -1773,7 +2540,7 @@ bool ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd,
     }
     if (it > itEnd)
     {
-        node->log(LogLevel::ERROR, "Parse error: iterator past end.");
+        logger->log(LogLevel::ERROR, "Parse error: iterator past end.");
         return false;
     }
     hasImuMeas = hasAcc && hasOmega;
@@ -0,0 +1,113 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+
+#ifndef FRAMER_HPP
+#define FRAMER_HPP
+
+/**
+ * @file framer.hpp
+ * @brief Declares a class that cuts a byte stream into SBF blocks and NMEA
+ * sentences
+ * @date 19/10/26
+ */
+
+/**
+ * @brief Kind of a frame found by the Framer
+ */
+enum class FrameType
+{
+    SBF,
+    NMEA
+};
+
+/**
+ * @brief A complete SBF block or NMEA sentence inside the buffer handed to the
+ * Framer, not a copy
+ */
+struct Frame
+{
+    FrameType type;
+    const uint8_t* data;
+    std::size_t size;
+};
+
+/**
+ * @class Framer
+ * @brief Finds complete SBF blocks and NMEA sentences in a byte stream
+ *
+ * SBF blocks are delimited by their length field and checked against their CRC,
+ * NMEA sentences ($G... or $P...) end with a line feed. Anything else, e.g.
+ * command replies, is skipped byte by byte. Data may arrive in arbitrary
+ * pieces: If a frame is incomplete, next() stops at its first byte and the
+ * caller has to hand it in again together with the following data.
+ */
+class Framer
+{
+public:
+    /**
+     * @param[in] logger Sink for log output, has to outlive the framer
+     * @param[in] crc_check Whether SBF blocks with wrong CRC are discarded
+     */
+    explicit Framer(LogSink* logger, bool crc_check = true);
+
+    /**
+     * @brief Searches the next complete frame
+     * @param[in,out] data Start of the unprocessed bytes, advanced past the
+     * frame found or to the start of an incomplete frame
+     * @param[in,out] count Number of unprocessed bytes, reduced accordingly
+     * @param[out] frame The frame found, points into the buffer of data
+     * @return True if a complete frame was found, false if more data is needed
+     */
+    bool next(const uint8_t*& data, std::size_t& count, Frame& frame);
+
+    //! Number of SBF blocks discarded due to a wrong CRC
+    uint64_t crcErrors() const { return crc_errors_; }
+
+    //! Number of bytes that were not part of any frame
+    uint64_t skippedBytes() const { return skipped_bytes_; }
+
+private:
+    //! Sink for log output
+    LogSink* logger_;
+    //! Whether SBF blocks with wrong CRC are discarded
+    bool crc_check_;
+    //! Number of SBF blocks discarded due to a wrong CRC
+    uint64_t crc_errors_ = 0;
+    //! Number of bytes that were not part of any frame
+    uint64_t skipped_bytes_ = 0;
+};
+
+#endif // FRAMER_HPP
@@ -60,9 +60,10 @@
 #define GPGGA_HPP
 
 // ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_parsers/nmea_structs.hpp>
 #include <septentrio_gnss_driver/parsers/parser_base_class.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
-// Boost and ROS includes
+// Boost includes
 #include <boost/make_shared.hpp>
 
 /**
@@ -76,13 +77,13 @@
  * @brief Derived class for parsing GGA messages
  * @date 13/08/20
  */
-class GpggaParser : public BaseParser<GpggaMsg>
+class GpggaParser : public BaseParser<Gpgga>
 {
 public:
     /**
      * @brief Constructor of the class GpggaParser
      */
-    GpggaParser() : BaseParser<GpggaMsg>(), was_last_gpgga_valid_(false) {}
+    GpggaParser() : BaseParser<Gpgga>(), was_last_gpgga_valid_(false) {}
 
     /**
      * @brief Returns the ASCII message ID, here "$GPGGA"
@@ -93,11 +94,11 @@ public:
     /**
      * @brief Parses one GGA message
      * @param[in] sentence The GGA message to be parsed
-     * @return A ROS message pointer of ROS type GpggaMsg
+     * @return A struct of type Gpgga
      */
-    GpggaMsg parseASCII(const NMEASentence& sentence, const std::string& frame_id,
-                        bool use_gnss_time,
-                        Timestamp time_obj) noexcept(false) override;
+    Gpgga parseASCII(const NMEASentence& sentence, const std::string& frame_id,
+                     bool use_gnss_time,
+                     Timestamp time_obj) noexcept(false) override;
 
     /**
      * @brief Tells us whether the last GGA message was valid or not
@@ -60,9 +60,10 @@
 #define GPGSA_HPP
 
 // ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_parsers/nmea_structs.hpp>
 #include <septentrio_gnss_driver/parsers/parser_base_class.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
-// Boost and ROS includes
+// Boost includes
 #include <boost/make_shared.hpp>
 
 /**
@@ -76,13 +77,13 @@
  * @brief Derived class for parsing GSA messages
  * @date 29/09/20
  */
-class GpgsaParser : public BaseParser<GpgsaMsg>
+class GpgsaParser : public BaseParser<Gpgsa>
 {
 public:
     /**
      * @brief Constructor of the class GpgsaParser
      */
-    GpgsaParser() : BaseParser<GpgsaMsg>() {}
+    GpgsaParser() : BaseParser<Gpgsa>() {}
 
     /**
      * @brief Returns the ASCII message ID, here "$GPGSA"
@@ -93,11 +94,11 @@ public:
     /**
      * @brief Parses one GSA message
      * @param[in] sentence The GSA message to be parsed
-     * @return A ROS message pointer of ROS type GpgsaMsg
+     * @return A struct of type Gpgsa
      */
-    GpgsaMsg parseASCII(const NMEASentence& sentence, const std::string& frame_id,
-                        bool use_gnss_time,
-                        Timestamp time_obj) noexcept(false) override;
+    Gpgsa parseASCII(const NMEASentence& sentence, const std::string& frame_id,
+                     bool use_gnss_time,
+                     Timestamp time_obj) noexcept(false) override;
 
     /**
      * @brief Declares the string MESSAGE_ID
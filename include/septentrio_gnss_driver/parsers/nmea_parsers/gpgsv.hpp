@@ -60,9 +60,10 @@
 #define GPGSV_HPP
 
 // ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_parsers/nmea_structs.hpp>
 #include <septentrio_gnss_driver/parsers/parser_base_class.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
-// Boost and ROS includes
+// Boost includes
 #include <boost/make_shared.hpp>
 
 /**
@@ -76,13 +77,13 @@
  * @brief Derived class for parsing GSV messages
  * @date 29/09/20
  */
-class GpgsvParser : public BaseParser<GpgsvMsg>
+class GpgsvParser : public BaseParser<Gpgsv>
 {
 public:
     /**
      * @brief Constructor of the class GpgsvParser
      */
-    GpgsvParser() : BaseParser<GpgsvMsg>() {}
+    GpgsvParser() : BaseParser<Gpgsv>() {}
 
     /**
      * @brief Returns the ASCII message ID, here "$GPGSV"
@@ -93,11 +94,11 @@ public:
     /**
      * @brief Parses one GSV message
      * @param[in] sentence The GSV message to be parsed
-     * @return A ROS message pointer of ROS type nmea_msgs::GpgsvPtr
+     * @return A struct of type Gpgsv
      */
-    GpgsvMsg parseASCII(const NMEASentence& sentence, const std::string& frame_id,
-                        bool use_gnss_time,
-                        Timestamp time_obj) noexcept(false) override;
+    Gpgsv parseASCII(const NMEASentence& sentence, const std::string& frame_id,
+                     bool use_gnss_time,
+                     Timestamp time_obj) noexcept(false) override;
 
     /**
      * @brief Declares the string MESSAGE_ID
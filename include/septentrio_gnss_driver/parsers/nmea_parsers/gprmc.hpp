@@ -60,9 +60,10 @@
 #define GPRMC_HPP
 
 // ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_parsers/nmea_structs.hpp>
 #include <septentrio_gnss_driver/parsers/parser_base_class.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
-// Boost and ROS includes
+// Boost includes
 #include <boost/make_shared.hpp>
 
 /**
@@ -76,13 +77,13 @@
  * @brief Derived class for parsing RMC messages
  * @date 28/09/20
  */
-class GprmcParser : public BaseParser<GprmcMsg>
+class GprmcParser : public BaseParser<Gprmc>
 {
 public:
     /**
      * @brief Constructor of the class GprmcParser
      */
-    GprmcParser() : BaseParser<GprmcMsg>(), was_last_gprmc_valid_(false) {}
+    GprmcParser() : BaseParser<Gprmc>(), was_last_gprmc_valid_(false) {}
 
     /**
      * @brief Returns the ASCII message ID, here "$GPRMC"
@@ -93,11 +94,11 @@ public:
     /**
      * @brief Parses one RMC message
      * @param[in] sentence The RMC message to be parsed
-     * @return A ROS message pointer of ROS type GprmcMsg
+     * @return A struct of type Gprmc
      */
-    GprmcMsg parseASCII(const NMEASentence& sentence, const std::string& frame_id,
-                        bool use_gnss_time,
-                        Timestamp time_obj) noexcept(false) override;
+    Gprmc parseASCII(const NMEASentence& sentence, const std::string& frame_id,
+                     bool use_gnss_time,
+                     Timestamp time_obj) noexcept(false) override;
 
     /**
      * @brief Tells us whether the last RMC message was valid/usable or not
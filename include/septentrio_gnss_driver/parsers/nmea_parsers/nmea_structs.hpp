@@ -0,0 +1,152 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstdint>
+#include <string>
+#include <vector>
+// Rosaic includes
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
+
+#ifndef NMEA_STRUCTS_HPP
+#define NMEA_STRUCTS_HPP
+
+/**
+ * @file nmea_structs.hpp
+ * @brief Declares the structs filled by the NMEA parsers
+ *
+ * The fields are named as in the nmea_msgs messages, which the node fills from
+ * these structs.
+ * @date 19/10/26
+ */
+
+/**
+ * @brief Time stamp and frame of a parsed NMEA sentence
+ */
+struct NmeaHeader
+{
+    //! Time stamp in nanoseconds (Unix epoch)
+    Timestamp stamp = 0;
+    std::string frame_id;
+};
+
+/**
+ * @class Gpgga
+ * @brief Struct for the NMEA sentence "GGA"
+ */
+struct Gpgga
+{
+    NmeaHeader header;
+
+    std::string message_id;
+    double utc_seconds = 0.0;
+    double lat = 0.0;
+    double lon = 0.0;
+    std::string lat_dir;
+    std::string lon_dir;
+    uint32_t gps_qual = 0;
+    uint32_t num_sats = 0;
+    float hdop = 0.0f;
+    float alt = 0.0f;
+    std::string altitude_units;
+    float undulation = 0.0f;
+    std::string undulation_units;
+    uint32_t diff_age = 0;
+    std::string station_id;
+};
+
+/**
+ * @class Gprmc
+ * @brief Struct for the NMEA sentence "RMC"
+ */
+struct Gprmc
+{
+    NmeaHeader header;
+
+    std::string message_id;
+    double utc_seconds = 0.0;
+    std::string position_status;
+    double lat = 0.0;
+    double lon = 0.0;
+    std::string lat_dir;
+    std::string lon_dir;
+    float speed = 0.0f; /* [m/s] */
+    float track = 0.0f;
+    std::string date;
+    float mag_var = 0.0f;
+    std::string mag_var_direction;
+    std::string mode_indicator;
+};
+
+/**
+ * @class Gpgsa
+ * @brief Struct for the NMEA sentence "GSA"
+ */
+struct Gpgsa
+{
+    NmeaHeader header;
+
+    std::string message_id;
+    std::string auto_manual_mode;
+    uint8_t fix_mode = 0;
+    std::vector<uint8_t> sv_ids;
+    float pdop = 0.0f;
+    float hdop = 0.0f;
+    float vdop = 0.0f;
+};
+
+/**
+ * @class GpgsvSatellite
+ * @brief Struct for one satellite of the NMEA sentence "GSV"
+ */
+struct GpgsvSatellite
+{
+    uint8_t prn = 0;
+    uint8_t elevation = 0;
+    uint16_t azimuth = 0;
+    int8_t snr = 0;
+};
+
+/**
+ * @class Gpgsv
+ * @brief Struct for the NMEA sentence "GSV"
+ */
+struct Gpgsv
+{
+    NmeaHeader header;
+
+    std::string message_id;
+    uint8_t n_msgs = 0;
+    uint8_t msg_number = 0;
+    uint8_t n_satellites = 0;
+    std::vector<GpgsvSatellite> satellites;
+};
+
+#endif // NMEA_STRUCTS_HPP
@@ -35,6 +35,7 @@
 #include "nmea_sentence.hpp"
 #include "parse_exception.hpp"
 #include "parsing_utilities.hpp"
+#include <septentrio_gnss_driver/abstraction/timestamp.hpp>
 
 /**
  * @file parser_base_class.hpp
@@ -55,8 +56,7 @@
  * templates are useful when a class defines something that is independent of
  * the data type, as here the notion of parsing.
  *
- * @tparam T The ROS message pointer type that the parser should produce, e.g.
- * nmea_msgs::GpggaPtr.
+ * @tparam T The struct that the parser should produce, e.g. Gpgga.
  */
 template <typename T>
 class BaseParser
@@ -98,14 +98,13 @@ public:
     virtual const std::string getMessageID() const = 0;
 
     /**
-     * @brief Converts bin_msg into a ROS message pointer (e.g. nmea_msgs::GpggaPtr)
-     * and returns it
+     * @brief Converts bin_msg into a struct (e.g. Gpgga) and returns it
      *
      * The returned value should not be NULL. ParseException will be thrown
      * if there are any issues parsing the block.
      *
      * @param[in] bin_msg The message to convert, of type const SBFStructT
-     * @return A valid ROS message pointer
+     * @return A valid struct
      */
     template <typename SBFStructT>
     T parseBinary(const SBFStructT& bin_msg) noexcept(false)
@@ -115,13 +114,13 @@ public:
 
     /**
      * @brief Converts an NMEA sentence - both standardized and proprietary ones -
-     * into a ROS message pointer (e.g. nmea_msgs::GpggaPtr) and returns it
+     * into a struct (e.g. Gpgga) and returns it
      *
      * The returned value should not be NULL. ParseException will be thrown
      * if there are any issues parsing the message.
      * @param[in] sentence The standardized NMEA sentence to convert, of type
      * NMEASentence
-     * @return A valid ROS message pointer
+     * @return A valid struct
      */
     virtual T parseASCII(const NMEASentence& sentence, const std::string& frame_id,
                          bool use_gnss_time, Timestamp time_obj) noexcept(false)
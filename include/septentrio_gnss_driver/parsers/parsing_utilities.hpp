@@ -41,8 +41,11 @@
 #include <Eigen/LU>
 // Boost includes
 #include <boost/math/constants/constants.hpp>
-// ROS includes
-#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+//! 0x24 is ASCII for $ - 1st byte in each message
+static const uint8_t SBF_SYNC_BYTE_1 = 0x24;
+//! 0x40 is ASCII for @ - 2nd byte to indicate SBF block
+static const uint8_t SBF_SYNC_BYTE_2 = 0x40;
 
 /**
  * @file parsing_utilities.hpp
@@ -298,15 +301,6 @@ namespace parsing_utilities {
      */
     double convertDMSToDegrees(double dms);
 
-    /**
-     * @brief Transforms Euler angles to a quaternion
-     * @param[in] yaw Yaw, i.e. heading, about the Up-axis
-     * @param[in] pitch Pitch about the new North-axis
-     * @param[in] roll Roll about the new East-axis
-     * @return ROS message representing a quaternion
-     */
-    QuaternionMsg convertEulerToQuaternion(double yaw, double pitch, double roll);
-
     /**
      * @brief Transforms the input polling period [milliseconds] into a std::string
      * number that can be appended to either sec or msec for Rx commands
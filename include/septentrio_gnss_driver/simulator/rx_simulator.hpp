@@ -0,0 +1,312 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+// POSIX includes
+#include <sys/socket.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+
+#ifndef RX_SIMULATOR_HPP
+#define RX_SIMULATOR_HPP
+
+/**
+ * @file rx_simulator.hpp
+ * @date 19/10/26
+ * @brief Simulator of a Septentrio receiver for load and latency tests of the
+ * driver without hardware
+ */
+
+namespace rx_simulator {
+
+    //! Shared, immutable piece of the output stream
+    typedef std::shared_ptr<const std::vector<uint8_t>> Chunk;
+
+    /**
+     * @brief Options of the simulator
+     */
+    struct Options
+    {
+        //! TCP port to listen on, 0 for none
+        uint16_t tcp_port = 28784;
+        //! Whether a pseudo terminal is opened
+        bool pty = false;
+        //! Symbolic link to the pseudo terminal, empty for none
+        std::string pty_link;
+        //! Name of the port in the prompt of the pseudo terminal
+        std::string pty_prompt = "COM1";
+        //! Destination host:port of UDP output, empty for none
+        std::string udp_destination;
+        //! Recorded SBF log to replay instead of generated output
+        std::string input;
+        //! Whether an INS is simulated
+        bool ins = false;
+        //! Number of tracked satellites
+        uint8_t satellites = 24;
+        //! Number of signals per satellite
+        uint8_t signals = 2;
+        //! Rate of the PVT blocks in Hz
+        double pvt_rate = 10.0;
+        //! Rate of ExtSensorMeas in Hz
+        double imu_rate = 0.0;
+        //! Rate of MeasEpoch and ChannelStatus in Hz
+        double meas_rate = 1.0;
+        //! Rate of the status blocks in Hz
+        double status_rate = 1.0;
+        //! Rate of the NMEA sentences in Hz
+        double nmea_rate = 1.0;
+        //! Whether output starts on connection instead of with sso or sno
+        bool stream_on_connect = false;
+        //! Whether a Comment block with the send time precedes each write
+        bool send_timestamps = false;
+        //! Maximum number of chunks queued per connection, more are dropped
+        std::size_t max_queued = 256;
+    };
+
+    /**
+     * @class Session
+     * @brief One connection of the simulator: TCP client, pseudo terminal or
+     * UDP destination
+     *
+     * Commands are answered with replies as the receiver gives them, followed
+     * by the prompt, e.g. "IP10>". Output is written by a thread of its own
+     * from a bounded queue, such that a slow client drops output instead of
+     * delaying the other connections.
+     */
+    class Session
+    {
+    public:
+        /**
+         * @brief Starts the threads of the session
+         * @param[in] logger Sink for log output, has to outlive the session
+         * @param[in] fd Socket or pseudo terminal master, closed by the session
+         * @param[in] name Name for log output
+         * @param[in] prompt Port name in the prompt, empty for output only
+         * @param[in] options Options of the simulator
+         * @param[in] destination Destination of a UDP socket, nullptr else
+         * @param[in] destination_length Size of destination
+         */
+        Session(LogSink* logger, int fd, const std::string& name,
+                const std::string& prompt, const Options& options,
+                const sockaddr_storage* destination = nullptr,
+                socklen_t destination_length = 0);
+
+        //! Stops the threads and closes the connection
+        ~Session();
+
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+        /**
+         * @brief Queues output, dropped if its kind is not enabled or the
+         * queue is full
+         * @param[in] chunk Output to be written
+         * @param[in] nmea Whether the chunk holds NMEA instead of SBF
+         */
+        void push(const Chunk& chunk, bool nmea);
+
+        //! Whether the peer closed the connection
+        bool closed() const { return closed_; }
+
+        //! Name for log output
+        const std::string& name() const { return name_; }
+
+        //! Number of bytes written
+        uint64_t sentBytes() const { return sent_bytes_; }
+
+        //! Number of chunks dropped since the queue was full
+        uint64_t droppedChunks() const { return dropped_chunks_; }
+
+    private:
+        //! Reads and answers commands
+        void readLoop();
+
+        //! Writes queued output
+        void writeLoop();
+
+        //! Answers one command line, given without line end
+        void handleCommand(const std::string& line);
+
+        //! Writes all bytes under the write mutex, false on error or stop
+        bool writeAll(const uint8_t* data, std::size_t size);
+
+        //! Writes a command reply
+        void reply(const std::string& text);
+
+        //! Sink for log output
+        LogSink* logger_;
+        //! Socket or pseudo terminal master
+        int fd_;
+        //! Name for log output
+        std::string name_;
+        //! Port name in the prompt
+        std::string prompt_;
+        //! Whether a Comment block with the send time precedes each write
+        bool send_timestamps_;
+        //! Maximum number of queued chunks
+        std::size_t max_queued_;
+        //! Destination of a UDP socket
+        sockaddr_storage destination_;
+        //! Size of destination_, 0 if not UDP
+        socklen_t destination_length_;
+        //! Streams with SBF output enabled by sso, used by the reader only
+        std::set<std::string> sbf_streams_;
+        //! Streams with NMEA output enabled by sno, used by the reader only
+        std::set<std::string> nmea_streams_;
+        //! Whether SBF output is enabled
+        std::atomic<bool> sbf_on_;
+        //! Whether NMEA output is enabled
+        std::atomic<bool> nmea_on_;
+        //! Whether the peer closed the connection
+        std::atomic<bool> closed_{false};
+        //! Whether the threads are to stop
+        std::atomic<bool> stop_{false};
+        //! Number of bytes written
+        std::atomic<uint64_t> sent_bytes_{0};
+        //! Number of dropped chunks
+        std::atomic<uint64_t> dropped_chunks_{0};
+        //! Serializes replies and output
+        std::mutex write_mutex_;
+        //! Protects queue_
+        std::mutex queue_mutex_;
+        //! Signals new output or stop to the writer
+        std::condition_variable queue_condition_;
+        //! Output to be written
+        std::deque<Chunk> queue_;
+        //! Reads and answers commands
+        std::thread reader_;
+        //! Writes output
+        std::thread writer_;
+    };
+
+    /**
+     * @class RxSimulator
+     * @brief Streams generated or recorded SBF and NMEA to all connections
+     *
+     * Generated output is scheduled on the system clock: Each group is sent at
+     * the full multiples of its period, stamped with that time in GPS time.
+     * With use_gnss_time, the delay of a message in the driver's output behind
+     * its header stamp is thus the end-to-end latency on one machine. Recorded
+     * logs are paced by the time of week of their blocks and restamped to the
+     * time they are sent.
+     */
+    class RxSimulator
+    {
+    public:
+        /**
+         * @param[in] logger Sink for log output, has to outlive the simulator
+         * @param[in] options Options of the simulator
+         */
+        RxSimulator(LogSink* logger, const Options& options);
+
+        ~RxSimulator();
+
+        /**
+         * @brief Opens the interfaces and streams until stop() is called
+         * @return False if an interface could not be opened
+         */
+        bool run();
+
+        //! Makes run() return, may be called from a signal handler
+        void stop() { stop_ = true; }
+
+    private:
+        //! Opens the TCP listener
+        bool openTcp();
+
+        //! Opens the pseudo terminal
+        bool openPty();
+
+        //! Opens the UDP socket
+        bool openUdp();
+
+        //! Accepts TCP clients
+        void acceptLoop();
+
+        //! Streams generated output
+        void generate();
+
+        //! Streams the recorded log in a loop
+        bool replay();
+
+        //! Sleeps until a Unix time in milliseconds, false if stopped
+        bool sleepUntil(uint64_t unix_time);
+
+        /**
+         * @brief Hands output to all sessions and removes closed ones
+         * @param[in] sbf SBF blocks, may be empty
+         * @param[in] nmea NMEA sentences, may be empty
+         */
+        void broadcast(std::vector<uint8_t>&& sbf, std::vector<uint8_t>&& nmea);
+
+        //! Logs the throughput of all sessions
+        void logStatistics();
+
+        //! Logs the statistics every ten seconds
+        void logStatisticsPeriodically();
+
+        //! Sink for log output
+        LogSink* logger_;
+        //! Options of the simulator
+        Options options_;
+        //! Whether run() is to return
+        std::atomic<bool> stop_{false};
+        //! TCP listener, -1 if none
+        int listener_ = -1;
+        //! Slave side of the pseudo terminal held open, -1 if none
+        int pty_slave_ = -1;
+        //! Number of TCP connections so far, for the prompt
+        unsigned connections_ = 0;
+        //! Protects sessions_
+        std::mutex sessions_mutex_;
+        //! Open connections
+        std::vector<std::unique_ptr<Session>> sessions_;
+        //! Accepts TCP clients
+        std::thread acceptor_;
+        //! Number of bytes generated or replayed
+        uint64_t bytes_ = 0;
+        //! Unix time in milliseconds of the last statistics output
+        uint64_t last_statistics_ = 0;
+        //! Number of epochs sent late by more than one period
+        uint64_t late_ = 0;
+    };
+} // namespace rx_simulator
+
+#endif // RX_SIMULATOR_HPP
@@ -0,0 +1,716 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// Boost includes
+#include <boost/tokenizer.hpp>
+// ROSaic includes
+#include <septentrio_gnss_driver/benchmark/allocation_counter.hpp>
+#include <septentrio_gnss_driver/communication/rx_message.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+#include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
+#include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
+
+/**
+ * @file decode_benchmark.cpp
+ * @date 19/10/26
+ * @brief Times the SBF and NMEA parsers, the CRC, RxMessage::search() and the
+ * message builders one by one on generated blocks, usage:
+ * decode_benchmark [--filter <substring>] [--min-time <s>] [--json]
+ */
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    //! Keeps the compiler from optimizing away a result
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief One benchmark: runs its operation a given number of times
+     */
+    struct Benchmark
+    {
+        std::string name;
+        //! Bytes processed per iteration, 0 if not meaningful
+        std::size_t bytes;
+        std::function<void(uint64_t)> run;
+    };
+
+    /**
+     * @brief Result of a benchmark
+     */
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        uint64_t ns = 0;
+        std::size_t bytes = 0;
+        uint64_t allocations = 0;
+    };
+
+    /**
+     * @brief Runs a benchmark with as many iterations as fit into min_time
+     *
+     * Like Google Benchmark, the number of iterations starts at one and is
+     * extrapolated from the previous run until a run lasts at least min_time.
+     */
+    Result measure(const Benchmark& benchmark, double min_time)
+    {
+        const uint64_t min_ns = static_cast<uint64_t>(min_time * 1.0e9);
+        Result result;
+        result.name = benchmark.name;
+        result.bytes = benchmark.bytes;
+        uint64_t iterations = 1;
+        while (true)
+        {
+            uint64_t allocations = benchmark_utilities::allocations();
+            Clock::time_point start = Clock::now();
+            benchmark.run(iterations);
+            uint64_t ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                     start)
+                    .count());
+            result.iterations = iterations;
+            result.ns = ns;
+            result.allocations = benchmark_utilities::allocations() - allocations;
+            if ((ns >= min_ns) || (iterations >= (1ull << 40)))
+                return result;
+            // Aim 40 % beyond min_time, growing at most 100-fold per run
+            double factor = (ns > 0) ? 1.4 * min_ns / ns : 100.0;
+            iterations = static_cast<uint64_t>(
+                iterations * std::max(1.1, std::min(factor, 100.0)) + 1);
+        }
+    }
+
+    //! Splits a generated stream into its SBF blocks by block number
+    std::map<uint16_t, std::vector<uint8_t>>
+    splitBlocks(LogSink* logger, const std::vector<uint8_t>& stream)
+    {
+        std::map<uint16_t, std::vector<uint8_t>> blocks;
+        Framer framer(logger);
+        const uint8_t* data = stream.data();
+        std::size_t count = stream.size();
+        Frame frame;
+        while (framer.next(data, count, frame))
+        {
+            if (frame.type != FrameType::SBF)
+                continue;
+            uint16_t id = (frame.data[4] | (frame.data[5] << 8)) & 8191;
+            blocks[id].assign(frame.data, frame.data + frame.size);
+        }
+        return blocks;
+    }
+
+    //! Splits generated NMEA into its sentences by talker and type, e.g. "GPGGA"
+    std::map<std::string, std::string>
+    splitSentences(LogSink* logger, const std::vector<uint8_t>& stream)
+    {
+        std::map<std::string, std::string> sentences;
+        Framer framer(logger);
+        const uint8_t* data = stream.data();
+        std::size_t count = stream.size();
+        Frame frame;
+        while (framer.next(data, count, frame))
+        {
+            if (frame.type != FrameType::NMEA)
+                continue;
+            std::string sentence(reinterpret_cast<const char*>(frame.data),
+                                 frame.size);
+            // The first of several sentences, e.g. GSV, is kept
+            sentences.insert(std::make_pair(sentence.substr(1, 5), sentence));
+        }
+        return sentences;
+    }
+
+    //! Splits a sentence into its fields as RxMessage::read() does
+    NMEASentence tokenize(const std::string& sentence)
+    {
+        typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+        boost::char_separator<char> sep("\r");
+        tokenizer tokens(sentence, sep);
+        std::string one_message = *tokens.begin();
+        boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens);
+        tokenizer tokens_2(one_message, sep_2);
+        std::vector<std::string> body(tokens_2.begin(), tokens_2.end());
+        return NMEASentence(sentence.substr(0, 6), body);
+    }
+
+    void printJson(double min_time, const std::vector<Result>& results)
+    {
+        std::printf("{\n  \"min_time\": %.3f,\n  \"benchmarks\": [", min_time);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            double ns = static_cast<double>(r.ns) / r.iterations;
+            std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+                        "\"ns_per_op\": %.2f, \"bytes_per_op\": %zu, "
+                        "\"mb_per_s\": %.2f, \"allocations_per_op\": %.2f}",
+                        i ? "," : "", r.name.c_str(),
+                        static_cast<unsigned long long>(r.iterations), ns,
+                        r.bytes, (ns > 0.0) ? r.bytes * 1.0e3 / ns : 0.0,
+                        static_cast<double>(r.allocations) / r.iterations);
+        }
+        std::printf("\n  ]\n}\n");
+    }
+
+    void printRow(const Result& r)
+    {
+        double ns = static_cast<double>(r.ns) / r.iterations;
+        std::printf("%-40s %12llu %11.1f %9.2f %8.2f\n", r.name.c_str(),
+                    static_cast<unsigned long long>(r.iterations), ns,
+                    (r.bytes && ns > 0.0) ? r.bytes * 1.0e3 / ns : 0.0,
+                    static_cast<double>(r.allocations) / r.iterations);
+    }
+} // namespace
+
+namespace io_comm_rx {
+
+    /**
+     * @class DecodeBenchmark
+     * @brief Node without ROS master whose messages are discarded, holding the
+     * RxMessage whose state the message builders read
+     */
+    class DecodeBenchmark : ROSaicNodeBase
+    {
+    public:
+        explicit DecodeBenchmark(const std::map<std::string, std::string>& params) :
+            ROSaicNodeBase(nullptr, params), rx_message_(this, &settings_)
+        {
+        }
+
+        //! Reads the parameters like the node does
+        bool init()
+        {
+            if (!getOutputParams())
+                return false;
+            settings_.use_gnss_time = true;
+            return true;
+        }
+
+        LogSink* logger() { return this; }
+
+        //! Whether ROS axis orientation is used, as argument of the parsers
+        bool rosAxes() const { return settings_.use_ros_axis_orientation; }
+
+        //! Reads all messages of a stream, such that the builders find an epoch
+        void feed(const std::vector<uint8_t>& stream)
+        {
+            Framer framer(this);
+            const uint8_t* data = stream.data();
+            std::size_t count = stream.size();
+            Frame frame;
+            while (framer.next(data, count, frame))
+            {
+                std::size_t size = frame.size;
+                rx_message_.newData(0, frame.data, size);
+                rx_message_.search();
+                rx_message_.read(rx_message_.messageID());
+            }
+        }
+
+        /**
+         * @brief Searches all messages of a buffer as the read callback does,
+         * with SBF blocks skipped as after a successful CRC check
+         * @return Number of messages found
+         */
+        std::size_t search(const std::vector<uint8_t>& stream)
+        {
+            std::size_t size = stream.size();
+            std::size_t found = 0;
+            rx_message_.newData(0, stream.data(), size);
+            while (rx_message_.search() != rx_message_.getEndBuffer() &&
+                   rx_message_.found())
+            {
+                rx_message_.crc_check_ = rx_message_.isSBF();
+                ++found;
+            }
+            return found;
+        }
+
+        //! Reads the one message of a buffer as the read callback does
+        bool read(const std::vector<uint8_t>& message)
+        {
+            std::size_t size = message.size();
+            rx_message_.newData(0, message.data(), size);
+            rx_message_.search();
+            return rx_message_.read(rx_message_.messageID());
+        }
+
+        GPSFixMsg::Ptr gpsFix() { return rx_message_.GPSFixCallback(); }
+
+        NavSatFixMsg navSatFix() { return rx_message_.NavSatFixCallback(); }
+
+        PoseWithCovarianceStampedMsg pose()
+        {
+            return rx_message_.PoseWithCovarianceStampedCallback();
+        }
+
+        DiagnosticArrayMsg::Ptr diagnostics()
+        {
+            return rx_message_.DiagnosticArrayCallback();
+        }
+
+        LocalizationUtmMsg localization()
+        {
+            return rx_message_.LocalizationUtmCallback();
+        }
+
+    private:
+        //! No velocity is sent to a receiver offline
+        void sendVelocity(const std::string& velNmea) {}
+
+        //! Parses the blocks and holds the state of the builders
+        RxMessage rx_message_;
+    };
+} // namespace io_comm_rx
+
+namespace {
+
+    using io_comm_rx::DecodeBenchmark;
+    using io_comm_rx::StreamGenerator;
+
+    //! Adds a benchmark of an SBF parser on a block
+    template <typename Msg, typename Parse>
+    void addParser(std::vector<Benchmark>& benchmarks, const std::string& name,
+                   const std::vector<uint8_t>& block, Parse parse)
+    {
+        // Shared, such that the block outlives this function
+        auto data = std::make_shared<std::vector<uint8_t>>(block);
+        benchmarks.push_back({name, block.size(), [data, parse](uint64_t n) {
+                                  Msg msg;
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      bool ok = parse(data->begin(), data->end(),
+                                                      msg);
+                                      doNotOptimize(ok);
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+    }
+
+    //! Adds a benchmark of an NMEA parser on a sentence
+    template <typename Parser>
+    void addNmeaParser(std::vector<Benchmark>& benchmarks, const std::string& name,
+                       const std::string& sentence)
+    {
+        NMEASentence tokens = tokenize(sentence);
+        benchmarks.push_back(
+            {name, sentence.size(), [tokens](uint64_t n) {
+                 Parser parser;
+                 for (uint64_t i = 0; i < n; ++i)
+                 {
+                     auto msg = parser.parseASCII(tokens, "gnss", true, 0);
+                     doNotOptimize(msg);
+                 }
+             }});
+    }
+
+    //! Generates one epoch of the given groups
+    std::vector<uint8_t> generate(uint8_t satellites, uint8_t signals, bool ins,
+                                  uint16_t ins_sb_list = 0x1f)
+    {
+        StreamGenerator generator(satellites, signals, 100, false, ins);
+        generator.setInsSubBlocks(ins_sb_list);
+        std::vector<uint8_t> stream;
+        generator.status(stream);
+        generator.pvt(stream);
+        generator.imu(stream);
+        generator.measurements(stream);
+        return stream;
+    }
+
+    void addSbfParsers(std::vector<Benchmark>& benchmarks, DecodeBenchmark& node)
+    {
+        LogSink* logger = node.logger();
+        bool ros_axes = node.rosAxes();
+        typedef std::vector<uint8_t>::iterator It;
+        auto blocks = splitBlocks(logger, generate(24, 2, false));
+        auto ins_blocks = splitBlocks(logger, generate(24, 2, true));
+
+        addParser<PVTCartesianMsg>(benchmarks, "SBF/PVTCartesian", blocks[4006],
+                                   [logger](It it, It end, PVTCartesianMsg& msg) {
+                                       return PVTCartesianParser(logger, it, end,
+                                                                 msg);
+                                   });
+        addParser<PVTGeodeticMsg>(benchmarks, "SBF/PVTGeodetic", blocks[4007],
+                                  [logger](It it, It end, PVTGeodeticMsg& msg) {
+                                      return PVTGeodeticParser(logger, it, end,
+                                                               msg);
+                                  });
+        addParser<PosCovGeodeticMsg>(
+            benchmarks, "SBF/PosCovGeodetic", blocks[5906],
+            [logger](It it, It end, PosCovGeodeticMsg& msg) {
+                return PosCovGeodeticParser(logger, it, end, msg);
+            });
+        addParser<VelCovGeodeticMsg>(
+            benchmarks, "SBF/VelCovGeodetic", blocks[5908],
+            [logger](It it, It end, VelCovGeodeticMsg& msg) {
+                return VelCovGeodeticParser(logger, it, end, msg);
+            });
+        addParser<AttEulerMsg>(benchmarks, "SBF/AttEuler", blocks[5938],
+                               [logger, ros_axes](It it, It end, AttEulerMsg& msg) {
+                                   return AttEulerParser(logger, it, end, msg,
+                                                         ros_axes);
+                               });
+        addParser<AttCovEulerMsg>(
+            benchmarks, "SBF/AttCovEuler", blocks[5939],
+            [logger, ros_axes](It it, It end, AttCovEulerMsg& msg) {
+                return AttCovEulerParser(logger, it, end, msg, ros_axes);
+            });
+        addParser<DOP>(benchmarks, "SBF/DOP", blocks[4001],
+                       [logger](It it, It end, DOP& msg) {
+                           return DOPParser(logger, it, end, msg);
+                       });
+        addParser<ReceiverTimeMsg>(benchmarks, "SBF/ReceiverTime", blocks[5914],
+                                   [logger](It it, It end, ReceiverTimeMsg& msg) {
+                                       return ReceiverTimeParser(logger, it, end,
+                                                                 msg);
+                                   });
+        addParser<ReceiverStatus>(benchmarks, "SBF/ReceiverStatus", blocks[4014],
+                                  [logger](It it, It end, ReceiverStatus& msg) {
+                                      return ReceiverStatusParser(logger, it, end,
+                                                                  msg);
+                                  });
+        addParser<QualityInd>(benchmarks, "SBF/QualityInd", blocks[4082],
+                              [logger](It it, It end, QualityInd& msg) {
+                                  return QualityIndParser(logger, it, end, msg);
+                              });
+        addParser<ReceiverSetup>(benchmarks, "SBF/ReceiverSetup", blocks[5902],
+                                 [logger](It it, It end, ReceiverSetup& msg) {
+                                     return ReceiverSetupParser(logger, it, end,
+                                                                msg);
+                                 });
+        addParser<ExtSensorMeasMsg>(
+            benchmarks, "SBF/ExtSensorMeas", ins_blocks[4050],
+            [logger, ros_axes](It it, It end, ExtSensorMeasMsg& msg) {
+                bool has_imu_meas = false;
+                return ExtSensorMeasParser(logger, it, end, msg, ros_axes,
+                                           has_imu_meas);
+            });
+
+        // MeasEpoch with N1 satellites and N2 further signals each
+        for (uint8_t satellites : {8, 24, 72})
+        {
+            std::string n1 = "/N1=" + std::to_string(satellites);
+            for (uint8_t signals : {1, 2, 3})
+            {
+                auto measurements =
+                    splitBlocks(logger, generate(satellites, signals, false));
+                std::string n2 = "/N2=" + std::to_string(signals - 1);
+                addParser<MeasEpochMsg>(
+                    benchmarks, "SBF/MeasEpoch" + n1 + n2, measurements[4027],
+                    [logger](It it, It end, MeasEpochMsg& msg) {
+                        return MeasEpochParser(logger, it, end, msg);
+                    });
+                addParser<MeasEpochColumnarMsg>(
+                    benchmarks, "SBF/MeasEpochColumnar" + n1 + n2,
+                    measurements[4027],
+                    [logger](It it, It end, MeasEpochColumnarMsg& msg) {
+                        return MeasEpochColumnarParser(logger, it, end, msg);
+                    });
+            }
+            addParser<ChannelStatus>(
+                benchmarks, "SBF/ChannelStatus" + n1,
+                splitBlocks(logger, generate(satellites, 2, false))[4013],
+                [logger](It it, It end, ChannelStatus& msg) {
+                    return ChannelStatusParser(logger, it, end, msg);
+                });
+        }
+
+        // INSNavGeod without, with the usual and with all sub-blocks, and
+        // cycling through all 256 combinations
+        std::vector<std::vector<uint8_t>> ins_nav_geod;
+        for (uint16_t sb_list = 0; sb_list < 256; ++sb_list)
+            ins_nav_geod.push_back(
+                splitBlocks(logger, generate(24, 2, true, sb_list))[4226]);
+        for (uint16_t sb_list : {0x00, 0x1f, 0xff})
+        {
+            char name[40];
+            std::snprintf(name, sizeof(name), "SBF/INSNavGeod/sb_list=0x%02x",
+                          sb_list);
+            addParser<INSNavGeodMsg>(
+                benchmarks, name, ins_nav_geod[sb_list],
+                [logger, ros_axes](It it, It end, INSNavGeodMsg& msg) {
+                    return INSNavGeodParser(logger, it, end, msg, ros_axes);
+                });
+        }
+        std::size_t total = 0;
+        for (const auto& block : ins_nav_geod)
+            total += block.size();
+        auto all = std::make_shared<std::vector<std::vector<uint8_t>>>(
+            std::move(ins_nav_geod));
+        benchmarks.push_back(
+            {"SBF/INSNavGeod/sb_list=all", total / 256,
+             [all, logger, ros_axes](uint64_t n) {
+                 INSNavGeodMsg msg;
+                 for (uint64_t i = 0; i < n; ++i)
+                 {
+                     std::vector<uint8_t>& block = (*all)[i & 255];
+                     bool ok = INSNavGeodParser(logger, block.begin(),
+                                                block.end(), msg, ros_axes);
+                     doNotOptimize(ok);
+                     doNotOptimize(msg);
+                 }
+             }});
+    }
+
+    void addNmeaParsers(std::vector<Benchmark>& benchmarks, DecodeBenchmark& node)
+    {
+        StreamGenerator generator;
+        std::vector<uint8_t> stream;
+        generator.nmea(stream);
+        auto sentences = splitSentences(node.logger(), stream);
+        addNmeaParser<GpggaParser>(benchmarks, "NMEA/GGA", sentences["GPGGA"]);
+        addNmeaParser<GprmcParser>(benchmarks, "NMEA/RMC", sentences["GPRMC"]);
+        addNmeaParser<GpgsaParser>(benchmarks, "NMEA/GSA", sentences["GPGSA"]);
+        addNmeaParser<GpgsvParser>(benchmarks, "NMEA/GSV", sentences["GPGSV"]);
+        std::string gga = sentences["GPGGA"];
+        benchmarks.push_back({"NMEA/GGA/tokenize", gga.size(), [gga](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      NMEASentence tokens = tokenize(gga);
+                                      doNotOptimize(tokens);
+                                  }
+                              }});
+    }
+
+    void addCrc(std::vector<Benchmark>& benchmarks)
+    {
+        for (std::size_t size : {96, 1024, 8192})
+        {
+            auto data = std::make_shared<std::vector<uint8_t>>(size);
+            for (std::size_t i = 0; i < size; ++i)
+                (*data)[i] = static_cast<uint8_t>(i * 131 + 7);
+            benchmarks.push_back(
+                {"compute16CCITT/" + std::to_string(size), size,
+                 [data](uint64_t n) {
+                     for (uint64_t i = 0; i < n; ++i)
+                     {
+                         uint16_t crc = compute16CCITT(data->data(), data->size());
+                         doNotOptimize(crc);
+                     }
+                 }});
+        }
+    }
+
+    void addSearch(std::vector<Benchmark>& benchmarks, DecodeBenchmark& node)
+    {
+        // One second of output at 10 Hz
+        StreamGenerator generator;
+        auto stream = std::make_shared<std::vector<uint8_t>>();
+        for (int i = 0; i < 10; ++i)
+            generator.epoch(*stream);
+        stream->resize(stream->size() + 8, 0);
+        benchmarks.push_back({"RxMessage::search/stream", stream->size(),
+                              [stream, &node](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      std::size_t found = node.search(*stream);
+                                      doNotOptimize(found);
+                                  }
+                              }});
+        // Nothing to be found, e.g. after a corrupted length
+        auto noise = std::make_shared<std::vector<uint8_t>>(4096);
+        for (std::size_t i = 0; i < noise->size(); ++i)
+            (*noise)[i] = static_cast<uint8_t>('A' + i % 26);
+        benchmarks.push_back({"RxMessage::search/noise", noise->size(),
+                              [noise, &node](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      std::size_t found = node.search(*noise);
+                                      doNotOptimize(found);
+                                  }
+                              }});
+    }
+
+    void addBuilders(std::vector<Benchmark>& benchmarks, DecodeBenchmark& gnss,
+                     DecodeBenchmark& ins)
+    {
+        // The builders read the state left by the blocks of one epoch
+        std::vector<uint8_t> gnss_stream = generate(24, 2, false);
+        gnss.feed(gnss_stream);
+        benchmarks.push_back({"GPSFixCallback", 0, [&gnss](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = gnss.gpsFix();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+        benchmarks.push_back({"NavSatFixCallback", 0, [&gnss](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = gnss.navSatFix();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+        benchmarks.push_back({"PoseWithCovarianceStampedCallback", 0,
+                              [&gnss](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = gnss.pose();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+        benchmarks.push_back({"DiagnosticArrayCallback", 0, [&gnss](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = gnss.diagnostics();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+
+        std::vector<uint8_t> ins_stream = generate(24, 2, true);
+        ins.feed(ins_stream);
+        benchmarks.push_back({"GPSFixCallback/INS", 0, [&ins](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = ins.gpsFix();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+        benchmarks.push_back({"NavSatFixCallback/INS", 0, [&ins](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = ins.navSatFix();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+        benchmarks.push_back({"LocalizationUtmCallback", 0, [&ins](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i)
+                                  {
+                                      auto msg = ins.localization();
+                                      doNotOptimize(msg);
+                                  }
+                              }});
+
+        // The whole path of a block through RxMessage::read(), publishing
+        // discarded
+        auto blocks = splitBlocks(gnss.logger(), gnss_stream);
+        for (uint16_t id : {4007, 4027})
+        {
+            auto block = std::make_shared<std::vector<uint8_t>>(blocks[id]);
+            benchmarks.push_back(
+                {"RxMessage::read/" + StreamGenerator::blockName(id),
+                 block->size(), [block, &gnss](uint64_t n) {
+                     for (uint64_t i = 0; i < n; ++i)
+                     {
+                         bool ok = gnss.read(*block);
+                         doNotOptimize(ok);
+                     }
+                 }});
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    double min_time = 0.5;
+    bool json = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--json")
+            json = true;
+        else if ((arg == "--filter") && (i + 1 < argc))
+            filter = argv[++i];
+        else if ((arg == "--min-time") && (i + 1 < argc))
+            min_time = std::stod(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter <substring>] [--min-time <s>] [--json]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // Only wall time is needed, which works without a ROS master
+    ros::Time::init();
+    // Everything the builders can build is enabled
+    std::map<std::string, std::string> params = {
+        {"receiver_type", "gnss"},          {"publish/gpsfix", "true"},
+        {"publish/navsatfix", "true"},      {"publish/pose", "true"},
+        {"publish/diagnostics", "true"},    {"publish/measepoch", "true"},
+        {"publish/pvtgeodetic", "true"},    {"publish/poscovgeodetic", "true"},
+        {"publish/velcovgeodetic", "true"}, {"publish/atteuler", "true"},
+        {"publish/attcoveuler", "true"},    {"leap_seconds", "18"}};
+    DecodeBenchmark gnss(params);
+    params["receiver_type"] = "ins";
+    params["publish/insnavgeod"] = "true";
+    params["publish/localization"] = "true";
+    DecodeBenchmark ins(params);
+    if (!gnss.init() || !ins.init())
+        return 1;
+
+    std::vector<Benchmark> benchmarks;
+    addSbfParsers(benchmarks, gnss);
+    addNmeaParsers(benchmarks, gnss);
+    addCrc(benchmarks);
+    addSearch(benchmarks, gnss);
+    addBuilders(benchmarks, gnss, ins);
+
+    std::vector<Result> results;
+    if (!json)
+        std::printf("%-40s %12s %11s %9s %8s\n", "benchmark", "iterations",
+                    "ns/op", "MB/s", "allocs");
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        if (!filter.empty() && (benchmark.name.find(filter) == std::string::npos))
+            continue;
+        results.push_back(measure(benchmark, min_time));
+        if (!json)
+        {
+            printRow(results.back());
+            std::fflush(stdout);
+        }
+    }
+    if (json)
+        printJson(min_time, results);
+    return 0;
+}
@@ -0,0 +1,295 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/communication/parse_queue.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+
+/**
+ * @file parse_queue_benchmark.cpp
+ * @date 19/10/26
+ * @brief Measures the throughput of the queue between the reading and the
+ * parsing thread for each drop policy, usage: parse_queue_benchmark [--epochs
+ * <n>] [--capacity <bytes>] [--max-read <bytes>]
+ *
+ * What reaches the parser is checked by test/parse_queue_test.cpp.
+ */
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+    using io_comm_rx::DropPolicy;
+    using io_comm_rx::RxStatistics;
+
+    //! Reply of the Rx to a command, which is not part of any frame
+    const std::string COMMAND_REPLY = "$R: gecm\r\n  IP10\r\nIP10>";
+    //! A command reply follows every that many epochs
+    const uint32_t REPLY_INTERVAL = 5;
+    //! The parser falls behind and catches up after every that many epochs
+    const uint32_t BATCH_EPOCHS = 64;
+
+    //! Generated stream as read from the Rx
+    struct Input
+    {
+        std::vector<uint8_t> bytes;
+        //! Offsets after which the parser catches up, at epoch boundaries
+        std::vector<std::size_t> batch_ends;
+        //! Size of the largest epoch in bytes
+        std::size_t largest_epoch = 0;
+    };
+
+    //! What reached the parser
+    struct Received
+    {
+        uint64_t reads = 0;
+        uint64_t bytes = 0;
+        uint64_t ns = 0;
+    };
+
+    uint64_t elapsedNs(Clock::time_point start)
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                 start)
+                .count());
+    }
+
+    Input generate(uint32_t epochs)
+    {
+        Input input;
+        io_comm_rx::StreamGenerator generator;
+        for (uint32_t i = 1; i <= epochs; ++i)
+        {
+            std::size_t start = input.bytes.size();
+            generator.epoch(input.bytes);
+            input.largest_epoch =
+                std::max(input.largest_epoch, input.bytes.size() - start);
+            if ((i % REPLY_INTERVAL) == 0)
+                input.bytes.insert(input.bytes.end(), COMMAND_REPLY.begin(),
+                                   COMMAND_REPLY.end());
+            if (((i % BATCH_EPOCHS) == 0) || (i == epochs))
+                input.batch_ends.push_back(input.bytes.size());
+        }
+        return input;
+    }
+
+    //! Cuts the stream into reads of 1 to max_read bytes, which split frames,
+    //! such that the last read of each batch ends at the batch end
+    std::vector<std::size_t> readSizes(const Input& input, std::size_t max_read)
+    {
+        std::vector<std::size_t> sizes;
+        uint32_t state = 12345;
+        std::size_t pos = 0;
+        for (std::size_t end : input.batch_ends)
+        {
+            while (pos < end)
+            {
+                // Deterministic, so that runs can be compared
+                state = state * 1103515245 + 12345;
+                std::size_t n = 1 + (state >> 8) % max_read;
+                n = std::min(n, end - pos);
+                sizes.push_back(n);
+                pos += n;
+            }
+        }
+        return sizes;
+    }
+
+    //! The parser catches up at the end of each batch, the queue drops in
+    //! between
+    Received runDropping(const Input& input,
+                         const std::vector<std::size_t>& sizes,
+                         std::size_t capacity, DropPolicy policy,
+                         LogSink* logger, RxStatistics::Snapshot& snapshot)
+    {
+        Received received;
+        RxStatistics statistics;
+        io_comm_rx::ParseQueue queue(logger, &statistics, capacity, policy);
+        std::vector<uint8_t> data;
+        uint64_t recv_time;
+        std::size_t pos = 0;
+        auto batch_end = input.batch_ends.begin();
+        for (std::size_t n : sizes)
+        {
+            Clock::time_point start = Clock::now();
+            queue.push(pos, input.bytes.data() + pos, n);
+            received.ns += elapsedNs(start);
+            pos += n;
+            if (pos != *batch_end)
+                continue;
+            ++batch_end;
+            while (true)
+            {
+                data.clear();
+                start = Clock::now();
+                bool popped =
+                    queue.pop(data, recv_time, std::chrono::milliseconds(0));
+                received.ns += elapsedNs(start);
+                if (!popped)
+                    break;
+                ++received.reads;
+                received.bytes += data.size();
+            }
+        }
+        statistics.snapshot(snapshot);
+        return received;
+    }
+
+    //! The parser runs in its own thread as in the driver. A single read
+    //! larger than the queue, the whole stream, follows the reads.
+    Received runBlocking(const Input& input,
+                         const std::vector<std::size_t>& sizes,
+                         std::size_t capacity, LogSink* logger,
+                         RxStatistics::Snapshot& snapshot)
+    {
+        Received received;
+        RxStatistics statistics;
+        io_comm_rx::ParseQueue queue(logger, &statistics, capacity,
+                                     DropPolicy::BLOCK);
+        const std::size_t total = 2 * input.bytes.size();
+        Clock::time_point start = Clock::now();
+        std::thread parser([&]() {
+            std::vector<uint8_t> data;
+            uint64_t recv_time;
+            while (received.bytes < total)
+            {
+                data.clear();
+                if (!queue.pop(data, recv_time, std::chrono::seconds(10)))
+                    break;
+                ++received.reads;
+                received.bytes += data.size();
+            }
+        });
+        std::size_t pos = 0;
+        for (std::size_t n : sizes)
+        {
+            if (!queue.push(pos, input.bytes.data() + pos, n))
+                break;
+            pos += n;
+        }
+        queue.push(pos, input.bytes.data(), input.bytes.size());
+        parser.join();
+        received.ns = elapsedNs(start);
+        queue.close();
+        statistics.snapshot(snapshot);
+        return received;
+    }
+
+    const char* policyName(DropPolicy policy)
+    {
+        switch (policy)
+        {
+        case DropPolicy::BLOCK:
+            return "block";
+        case DropPolicy::DROP_OLDEST:
+            return "drop_oldest";
+        default:
+            return "drop_low_priority";
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t epochs = 6000;
+    std::size_t capacity = 65536;
+    std::size_t max_read = 4096;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if ((arg == "--epochs") && (i + 1 < argc))
+            epochs = std::stoul(argv[++i]);
+        else if ((arg == "--capacity") && (i + 1 < argc))
+            capacity = std::stoul(argv[++i]);
+        else if ((arg == "--max-read") && (i + 1 < argc))
+            max_read = std::stoul(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--epochs <n>] [--capacity <bytes>]"
+                         " [--max-read <bytes>]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (epochs == 0)
+        epochs = 1;
+    if (max_read == 0)
+        max_read = 1;
+
+    StreamLogSink logger(std::cerr, LogLevel::ERROR);
+    Input input = generate(epochs);
+    // Only then an epoch is dropped before its last block is read
+    if (capacity < 2 * input.largest_epoch)
+    {
+        std::cerr << "The capacity has to hold at least two epochs of "
+                  << input.largest_epoch << " bytes" << std::endl;
+        return 1;
+    }
+    std::vector<std::size_t> sizes = readSizes(input, max_read);
+
+    std::printf("Generated %u epochs, %zu bytes in %zu reads, capacity %zu "
+                "bytes\n\n",
+                epochs, input.bytes.size(), sizes.size(), capacity);
+    std::printf("%-18s %8s %9s %8s %9s %10s %8s\n", "policy", "reads", "MB/s",
+                "blocked", "dropped", "frames", "nav");
+    for (io_comm_rx::DropPolicy policy : {DropPolicy::BLOCK, DropPolicy::DROP_OLDEST,
+                              DropPolicy::DROP_LOW_PRIORITY})
+    {
+        io_comm_rx::RxStatistics::Snapshot snapshot;
+        Received received =
+            (policy == DropPolicy::BLOCK)
+                ? runBlocking(input, sizes, capacity, &logger, snapshot)
+                : runDropping(input, sizes, capacity, policy, &logger,
+                              snapshot);
+        std::printf("%-18s %8llu %9.2f %8llu %9llu %10llu %8llu\n",
+                    policyName(policy),
+                    static_cast<unsigned long long>(received.reads),
+                    // Bytes read, whether parsed or dropped
+                    received.ns ? (received.bytes + snapshot.dropped_bytes) *
+                                      1.0e3 / received.ns
+                                : 0.0,
+                    static_cast<unsigned long long>(snapshot.blocked_reads),
+                    static_cast<unsigned long long>(snapshot.dropped_bytes),
+                    static_cast<unsigned long long>(snapshot.dropped_frames),
+                    static_cast<unsigned long long>(
+                        snapshot.dropped_navigation_frames));
+    }
+    return 0;
+}
@@ -0,0 +1,410 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/benchmark/allocation_counter.hpp>
+#include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/decompressing_reader.hpp>
+#include <septentrio_gnss_driver/communication/mapped_file.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+
+/**
+ * @file replay_benchmark.cpp
+ * @date 19/10/26
+ * @brief Measures the throughput of framing, decoding and message building on
+ * a recorded or generated stream with publishing stubbed out, usage:
+ * replay_benchmark [--input <file>] [--epochs <n>] [--satellites <n>]
+ * [--repetitions <n>] [--json] [name:=value ...]
+ */
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    //! Read size of the end-to-end pass, as for SBF file replay
+    const std::size_t REPLAY_CHUNK_SIZE = 65536;
+
+    /**
+     * @brief Accumulated cost of one kind of frame, or of a whole pass
+     */
+    struct Cost
+    {
+        std::string type;
+        std::string name;
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        uint64_t ns = 0;
+        uint64_t allocations = 0;
+    };
+
+    /**
+     * @class ReplayBenchmark
+     * @brief Node without ROS master and bag whose messages are discarded, such
+     * that only framing, decoding and message building are measured
+     */
+    class ReplayBenchmark : ROSaicNodeBase
+    {
+    public:
+        explicit ReplayBenchmark(const std::map<std::string, std::string>& params) :
+            ROSaicNodeBase(nullptr, params), IO_(this, &settings_)
+        {
+            // There is no receiver to be reset when the benchmark is destroyed
+            settings_.read_from_sbf_log = true;
+            settings_.read_from_pcap = false;
+        }
+
+        //! Reads the parameters and defines the messages as for SBF replay
+        bool init()
+        {
+            if (!getOutputParams())
+                return false;
+            getUint32Param("polling_period/pvt", settings_.polling_period_pvt,
+                           static_cast<uint32_t>(100));
+            getUint32Param("polling_period/rest", settings_.polling_period_rest,
+                           static_cast<uint32_t>(1000));
+            settings_.use_gnss_time = true;
+            settings_.replay_rate = 0.0;
+            settings_.publish_clock = false;
+            IO_.defineMessages();
+            return true;
+        }
+
+        //! Parses data as read from the Rx, returns the bytes consumed
+        std::size_t parse(const uint8_t* data, std::size_t size)
+        {
+            try
+            {
+                IO_.parse(0, data, size);
+            } catch (std::size_t offset)
+            {
+                return offset;
+            }
+            return size;
+        }
+
+        LogSink* logger() { return this; }
+
+    private:
+        //! No velocity is sent to a receiver offline
+        void sendVelocity(const std::string& velNmea) {}
+
+        //! Handles decoding and message building
+        io_comm_rx::Comm_IO IO_;
+    };
+
+    uint64_t elapsedNs(Clock::time_point start)
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                 start)
+                .count());
+    }
+
+    //! Key and name of a frame, e.g. "SBF 4007" and "PVTGeodetic"
+    void classify(const Frame& frame, std::string& key, std::string& name)
+    {
+        if (frame.type == FrameType::SBF)
+        {
+            uint16_t id = (frame.data[4] | (frame.data[5] << 8)) & 8191;
+            key = "SBF " + std::to_string(id);
+            name = io_comm_rx::StreamGenerator::blockName(id);
+        } else
+        {
+            std::size_t n = 1;
+            while ((n < frame.size) && (n < 7) && (frame.data[n] != ','))
+                ++n;
+            name = std::string(reinterpret_cast<const char*>(frame.data) + 1,
+                               n - 1);
+            key = "NMEA " + name;
+        }
+    }
+
+    //! Loads a plain or compressed SBF file
+    std::vector<uint8_t> loadFile(const std::string& file_name)
+    {
+        std::vector<uint8_t> stream;
+        if (io_comm_rx::DecompressingReader::isCompressed(file_name))
+        {
+            io_comm_rx::DecompressingReader reader(file_name);
+            std::size_t n;
+            do
+            {
+                std::size_t pos = stream.size();
+                stream.resize(pos + REPLAY_CHUNK_SIZE);
+                n = reader.read(stream.data() + pos, REPLAY_CHUNK_SIZE);
+                stream.resize(pos + n);
+            } while (n > 0);
+        } else
+        {
+            io_comm_rx::MappedFile file(file_name);
+            stream.assign(file.data(), file.data() + file.size());
+        }
+        return stream;
+    }
+
+    double perSecond(double value, uint64_t ns)
+    {
+        return ns ? value * 1.0e9 / ns : 0.0;
+    }
+
+    double perCount(double value, uint64_t count)
+    {
+        return count ? value / count : 0.0;
+    }
+
+    void printJson(const std::string& input, uint32_t repetitions,
+                   const Cost& framing, const Cost& replay,
+                   const std::vector<Cost>& frames)
+    {
+        auto entry = [](const Cost& c) {
+            std::printf("{\"type\": \"%s\", \"name\": \"%s\", \"count\": %llu, "
+                        "\"bytes\": %llu, \"ns\": %llu, \"ns_per_block\": %.1f, "
+                        "\"blocks_per_s\": %.1f, \"mb_per_s\": %.2f, "
+                        "\"allocations_per_block\": %.2f}",
+                        c.type.c_str(), c.name.c_str(),
+                        static_cast<unsigned long long>(c.count),
+                        static_cast<unsigned long long>(c.bytes),
+                        static_cast<unsigned long long>(c.ns),
+                        perCount(c.ns, c.count), perSecond(c.count, c.ns),
+                        perSecond(c.bytes / 1.0e6, c.ns),
+                        perCount(c.allocations, c.count));
+        };
+        std::printf("{\n  \"input\": \"%s\",\n  \"repetitions\": %u,\n",
+                    input.c_str(), repetitions);
+        std::printf("  \"framing\": ");
+        entry(framing);
+        std::printf(",\n  \"replay\": ");
+        entry(replay);
+        std::printf(",\n  \"blocks\": [");
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            std::printf(i ? ",\n    " : "\n    ");
+            entry(frames[i]);
+        }
+        std::printf("\n  ]\n}\n");
+    }
+
+    void printTable(const std::string& input, uint32_t repetitions,
+                    const Cost& framing, const Cost& replay,
+                    const std::vector<Cost>& frames)
+    {
+        auto row = [](const Cost& c) {
+            std::printf("%-5s %-16s %10llu %10.1f %12.0f %9.2f %8.2f\n",
+                        c.type.c_str(), c.name.c_str(),
+                        static_cast<unsigned long long>(c.count),
+                        perCount(c.ns, c.count), perSecond(c.count, c.ns),
+                        perSecond(c.bytes / 1.0e6, c.ns),
+                        perCount(c.allocations, c.count));
+        };
+        std::printf("Input: %s, %u repetitions\n\n", input.c_str(), repetitions);
+        std::printf("%-5s %-16s %10s %10s %12s %9s %8s\n", "type", "name",
+                    "count", "ns/block", "blocks/s", "MB/s", "allocs");
+        row(framing);
+        row(replay);
+        std::printf("\n");
+        for (const auto& c : frames)
+            row(c);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string input;
+    uint32_t epochs = 6000;
+    uint32_t satellites = 24;
+    uint32_t repetitions = 5;
+    bool json = false;
+    // Everything the node can build from the generated stream is enabled
+    std::map<std::string, std::string> params = {
+        {"receiver_type", "gnss"},          {"publish/gpsfix", "true"},
+        {"publish/navsatfix", "true"},      {"publish/pose", "true"},
+        {"publish/diagnostics", "true"},    {"publish/measepoch", "true"},
+        {"publish/pvtcartesian", "true"},   {"publish/pvtgeodetic", "true"},
+        {"publish/poscovgeodetic", "true"}, {"publish/velcovgeodetic", "true"},
+        {"publish/atteuler", "true"},       {"publish/attcoveuler", "true"},
+        {"publish/gpgga", "true"},          {"publish/gprmc", "true"},
+        {"publish/gpgsa", "true"},          {"publish/gpgsv", "true"}};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        std::size_t pos = arg.find(":=");
+        if (pos != std::string::npos)
+            params[arg.substr(0, pos)] = arg.substr(pos + 2);
+        else if (arg == "--json")
+            json = true;
+        else if ((arg == "--input") && (i + 1 < argc))
+            input = argv[++i];
+        else if ((arg == "--epochs") && (i + 1 < argc))
+            epochs = std::stoul(argv[++i]);
+        else if ((arg == "--satellites") && (i + 1 < argc))
+            satellites = std::stoul(argv[++i]);
+        else if ((arg == "--repetitions") && (i + 1 < argc))
+            repetitions = std::stoul(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--input <file>] [--epochs <n>] [--satellites <n>]"
+                         " [--repetitions <n>] [--json] [name:=value ...]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (repetitions == 0)
+        repetitions = 1;
+
+    std::vector<uint8_t> stream;
+    std::string description;
+    try
+    {
+        if (!input.empty())
+        {
+            stream = loadFile(input);
+            description = input;
+        } else
+        {
+            io_comm_rx::StreamGenerator generator(
+                static_cast<uint8_t>(std::min<uint32_t>(satellites, 72)));
+            for (uint32_t i = 0; i < epochs; ++i)
+                generator.epoch(stream);
+            description = "generated, " + std::to_string(epochs) + " epochs, " +
+                          std::to_string(satellites) + " satellites";
+        }
+    } catch (const std::runtime_error& e)
+    {
+        std::cerr << "Could not read " << input << ": " << e.what() << std::endl;
+        return 1;
+    }
+    std::size_t size = stream.size();
+    // The parsers may look a few bytes past the end of the data
+    stream.resize(size + 8, 0);
+
+    // Only wall time is needed, which works without a ROS master
+    ros::Time::init();
+    ReplayBenchmark node(params);
+    if (!node.init())
+        return 1;
+
+    // Warm-up, also fills the message pools and caches
+    for (std::size_t pos = 0; pos < size;)
+    {
+        std::size_t consumed =
+            node.parse(stream.data() + pos, std::min(REPLAY_CHUNK_SIZE, size - pos));
+        pos += (consumed > 0) ? consumed : std::min(REPLAY_CHUNK_SIZE, size - pos);
+    }
+
+    Cost framing;
+    framing.type = "all";
+    framing.name = "framing";
+    std::vector<Frame> frames;
+    for (uint32_t r = 0; r < repetitions; ++r)
+    {
+        Framer framer(node.logger());
+        const uint8_t* data = stream.data();
+        std::size_t count = size;
+        Frame frame;
+        frames.clear();
+        frames.reserve(size / 64);
+        uint64_t allocations = benchmark_utilities::allocations();
+        Clock::time_point start = Clock::now();
+        while (framer.next(data, count, frame))
+            frames.push_back(frame);
+        framing.ns += elapsedNs(start);
+        framing.allocations += benchmark_utilities::allocations() - allocations;
+        framing.count += frames.size();
+        framing.bytes += size;
+    }
+
+    // End-to-end, in reads as large as for SBF file replay
+    Cost replay;
+    replay.type = "all";
+    replay.name = "replay";
+    for (uint32_t r = 0; r < repetitions; ++r)
+    {
+        uint64_t allocations = benchmark_utilities::allocations();
+        Clock::time_point start = Clock::now();
+        for (std::size_t pos = 0; pos < size;)
+        {
+            std::size_t n = std::min(REPLAY_CHUNK_SIZE, size - pos);
+            std::size_t consumed = node.parse(stream.data() + pos, n);
+            pos += (consumed > 0) ? consumed : n;
+        }
+        replay.ns += elapsedNs(start);
+        replay.allocations += benchmark_utilities::allocations() - allocations;
+        replay.count += frames.size();
+        replay.bytes += size;
+    }
+
+    // Frame by frame, the clock reading adds some tens of ns per frame
+    std::map<std::string, Cost> costs;
+    for (uint32_t r = 0; r < repetitions; ++r)
+    {
+        for (const Frame& frame : frames)
+        {
+            uint64_t allocations = benchmark_utilities::allocations();
+            Clock::time_point start = Clock::now();
+            node.parse(frame.data, frame.size);
+            uint64_t ns = elapsedNs(start);
+            uint64_t allocated = benchmark_utilities::allocations() - allocations;
+
+            std::string key, name;
+            classify(frame, key, name);
+            Cost& c = costs[key];
+            if (c.count == 0)
+            {
+                c.type = (frame.type == FrameType::SBF) ? "SBF" : "NMEA";
+                c.name = name;
+            }
+            ++c.count;
+            c.bytes += frame.size;
+            c.ns += ns;
+            c.allocations += allocated;
+        }
+    }
+    std::vector<Cost> by_type;
+    for (const auto& c : costs)
+        by_type.push_back(c.second);
+
+    if (json)
+        printJson(description, repetitions, framing, replay, by_type);
+    else
+        printTable(description, repetitions, framing, replay, by_type);
+    return 0;
+}
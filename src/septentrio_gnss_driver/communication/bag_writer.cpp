@@ -0,0 +1,125 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/bag_writer.hpp>
+
+/**
+ * @file bag_writer.cpp
+ * @brief Defines a class that writes ROS messages to a rosbag in a thread of its
+ * own
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    BagWriter::BagWriter(const std::string& file_name, std::size_t max_queued) :
+        max_queued_(max_queued)
+    {
+        bag_.open(file_name, rosbag::bagmode::Write);
+        thread_ = std::thread(&BagWriter::run, this);
+    }
+
+    BagWriter::~BagWriter()
+    {
+        try
+        {
+            close();
+        } catch (const std::exception&)
+        {
+            // Whoever wants to know closes explicitly
+        }
+    }
+
+    void BagWriter::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closing_)
+                return;
+            closing_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        bag_.close();
+        if (error_)
+            std::rethrow_exception(error_);
+    }
+
+    uint64_t BagWriter::written() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return written_;
+    }
+
+    void BagWriter::push(std::function<void(rosbag::Bag&)> op)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() {
+                return error_ || (queue_.size() < max_queued_);
+            });
+            // Nothing is written anymore after an error
+            if (error_)
+                return;
+            queue_.push_back(std::move(op));
+        }
+        cv_.notify_all();
+    }
+
+    void BagWriter::run()
+    {
+        while (true)
+        {
+            std::function<void(rosbag::Bag&)> op;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return closing_ || !queue_.empty(); });
+                if (queue_.empty())
+                    return;
+                op = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            cv_.notify_all();
+            try
+            {
+                op(bag_);
+            } catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+                queue_.clear();
+                cv_.notify_all();
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++written_;
+        }
+    }
+} // namespace io_comm_rx
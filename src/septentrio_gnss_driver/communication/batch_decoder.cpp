@@ -0,0 +1,288 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/batch_decoder.hpp>
+#include <septentrio_gnss_driver/communication/sbf_block_table.hpp>
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <boost/make_shared.hpp>
+
+/**
+ * @file batch_decoder.cpp
+ * @brief Defines a decoder that converts whole SBF logs on all cores
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Size of the chunks the log is cut into
+    static const std::size_t CHUNK_SIZE = 4 << 20;
+    //! Number of chunks per worker that may be decoded ahead of the merge
+    static const std::size_t CHUNKS_AHEAD = 2;
+    //! Do-not-use value of TOW
+    static const uint32_t TOW_DNU = 4294967295;
+    //! Do-not-use value of WNc
+    static const uint16_t WNC_DNU = 65535;
+    //! GPS week counter starts at 1980-01-06 which is 315964800 seconds since
+    //! Unix epoch (1970-01-01 UTC)
+    static const uint64_t NS_OF_GPS_START = 315964800000000000;
+
+    //! Orders decoded blocks by time only, so that stable algorithms keep the
+    //! file order within an epoch
+    static bool earlier(const DecodedBlock& lhs, const DecodedBlock& rhs)
+    {
+        return lhs.gps_time < rhs.gps_time;
+    }
+
+    /**
+     * @brief Parses a block into a newly allocated message and stamps it
+     * @return False if the block could not be parsed
+     */
+    template <typename M, typename Parser>
+    static bool addMessage(uint64_t gps_time, Timestamp stamp, const char* topic,
+                           const std::string& frame_id, Parser parser,
+                           std::vector<DecodedBlock>& blocks)
+    {
+        boost::shared_ptr<M> msg = boost::make_shared<M>();
+        if (!parser(*msg))
+            return false;
+        msg->header.frame_id = frame_id;
+        msg->header.stamp = timestampToRos(stamp);
+        blocks.push_back({gps_time, topic, msg});
+        return true;
+    }
+
+    BatchDecoder::BatchDecoder(LogSink* logger, const Settings* settings,
+                               unsigned threads) :
+        logger_(logger),
+        settings_(settings),
+        threads_(threads ? threads
+                         : std::max(1u, std::thread::hardware_concurrency())),
+        parse_errors_(0)
+    {
+    }
+
+    std::vector<std::string> BatchDecoder::unsupportedOutputs() const
+    {
+        const Settings& s = *settings_;
+        std::vector<std::pair<bool, const char*>> outputs = {
+            {s.publish_gpsfix, "/gpsfix"},
+            {s.publish_navsatfix, "/navsatfix"},
+            {s.publish_pose, "/pose"},
+            {s.publish_imu, "/imu"},
+            {s.publish_twist, "/twist"},
+            {s.publish_localization, "/localization"},
+            {s.publish_tf, "/tf"},
+            {s.publish_gpst, "/gpst"},
+            {s.publish_diagnostics, "/diagnostics"},
+            {s.publish_gpgga, "/gpgga"},
+            {s.publish_gprmc, "/gprmc"},
+            {s.publish_gpgsa, "/gpgsa"},
+            {s.publish_gpgsv, "/gpgsv"}};
+        std::vector<std::string> unsupported;
+        for (const auto& output : outputs)
+        {
+            if (output.first)
+                unsupported.push_back(output.second);
+        }
+        return unsupported;
+    }
+
+    int32_t BatchDecoder::leapSeconds(const uint8_t* data, std::size_t size)
+    {
+        if (settings_->leap_seconds != -128)
+            return settings_->leap_seconds;
+        Framer framer(logger_);
+        Frame frame;
+        while (framer.next(data, size, frame))
+        {
+            if ((frame.type != FrameType::SBF) ||
+                (parsing_utilities::getId(frame.data) != 5914))
+                continue;
+            ReceiverTimeMsg msg;
+            if (ReceiverTimeParser(logger_, frame.data, frame.data + frame.size,
+                                   msg) &&
+                (msg.delta_ls != -128))
+                return msg.delta_ls;
+        }
+        logger_->log(LogLevel::WARN,
+                     "No leap seconds in log or settings, assuming 18 s.");
+        return 18;
+    }
+
+    void BatchDecoder::decode(const uint8_t* data, std::size_t size,
+                              DecodeSink& sink, const std::atomic<bool>* stop)
+    {
+        leap_seconds_ = leapSeconds(data, size);
+        decoded_messages_ = 0;
+        parse_errors_ = 0;
+
+        std::size_t chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        std::vector<std::vector<DecodedBlock>> results(chunks);
+        std::vector<bool> ready(chunks, false);
+        std::size_t next_chunk = 0;
+        std::size_t merged_chunks = 0;
+        bool aborted = false;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        auto worker = [&]() {
+            while (true)
+            {
+                std::size_t i;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    // Bounds the memory held by decoded but unmerged chunks
+                    std::size_t ahead = CHUNKS_AHEAD * threads_;
+                    cv.wait(lock, [&]() {
+                        return aborted || (next_chunk >= chunks) ||
+                               (next_chunk < merged_chunks + ahead);
+                    });
+                    if (aborted || (next_chunk >= chunks))
+                        return;
+                    i = next_chunk++;
+                }
+                std::size_t begin = i * CHUNK_SIZE;
+                std::size_t end = std::min(size, begin + CHUNK_SIZE);
+                decodeChunk(data, size, begin, end, results[i]);
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[i] = true;
+                cv.notify_all();
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads_; ++t)
+            workers.emplace_back(worker);
+
+        // Blocks of a chunk may be older than the last ones of the chunk before,
+        // so decoded blocks are only written once no later chunk can precede
+        // them anymore
+        std::vector<DecodedBlock> pending;
+        for (std::size_t i = 0; i < chunks; ++i)
+        {
+            std::vector<DecodedBlock> chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() { return ready[i]; });
+                chunk.swap(results[i]);
+                ++merged_chunks;
+                if (stop && *stop)
+                    aborted = true;
+                cv.notify_all();
+            }
+            if (aborted)
+                break;
+            std::stable_sort(chunk.begin(), chunk.end(), earlier);
+            if (chunk.empty())
+                continue;
+            auto split = std::upper_bound(pending.begin(), pending.end(),
+                                          chunk.front(), earlier);
+            for (auto it = pending.begin(); it != split; ++it)
+                sink.write(it->topic, it->msg);
+            decoded_messages_ += split - pending.begin();
+            std::vector<DecodedBlock> merged;
+            merged.reserve((pending.end() - split) + chunk.size());
+            std::merge(split, pending.end(), chunk.begin(), chunk.end(),
+                       std::back_inserter(merged), earlier);
+            pending.swap(merged);
+        }
+        if (!aborted)
+        {
+            for (const auto& block : pending)
+                sink.write(block.topic, block.msg);
+            decoded_messages_ += pending.size();
+        }
+        for (auto& t : workers)
+            t.join();
+    }
+
+    void BatchDecoder::decodeChunk(const uint8_t* data, std::size_t size,
+                                   std::size_t begin, std::size_t end,
+                                   std::vector<DecodedBlock>& blocks)
+    {
+        Framer framer(logger_);
+        const uint8_t* next = data + begin;
+        std::size_t count = size - begin;
+        Frame frame;
+        // Copy of the current block, parsers may read a few bytes beyond a
+        // malformed block and must not run off the end of the log
+        std::vector<uint8_t> block;
+        while (framer.next(next, count, frame))
+        {
+            if (static_cast<std::size_t>(frame.data - data) >= end)
+                break;
+            if (frame.type != FrameType::SBF)
+                continue;
+            block.assign(frame.data, frame.data + frame.size);
+            decodeBlock(block, blocks);
+        }
+    }
+
+    void BatchDecoder::decodeBlock(const std::vector<uint8_t>& block,
+                                   std::vector<DecodedBlock>& blocks)
+    {
+        uint32_t tow = parsing_utilities::getTow(block.data());
+        uint16_t wnc = parsing_utilities::getWnc(block.data());
+        if ((tow == TOW_DNU) || (wnc == WNC_DNU))
+            return;
+        uint64_t gps_time = static_cast<uint64_t>(wnc) * 604800000 + tow;
+        Timestamp stamp = NS_OF_GPS_START + gps_time * 1000000 -
+                          static_cast<int64_t>(leap_seconds_) * 1000000000;
+        auto it = block.begin();
+        auto itEnd = block.end();
+        bool parsed = true;
+        visitSbfBlock(
+            parsing_utilities::getId(block.data()), *settings_,
+            [&](auto tag, const SbfBlockInfo& info, auto parser) {
+                typedef typename decltype(tag)::type M;
+                if (!parsed || !info.publish)
+                    return;
+                parsed = addMessage<M>(
+                    gps_time, stamp, info.topic, info.frame_id,
+                    [&](M& msg) { return parser(logger_, it, itEnd, msg); },
+                    blocks);
+            });
+        if (!parsed)
+        {
+            ++parse_errors_;
+            logger_->log(LogLevel::ERROR,
+                         "septentrio_gnss_driver: parse error in SBF block " +
+                             std::to_string(parsing_utilities::getId(block.data())));
+        }
+    }
+} // namespace io_comm_rx
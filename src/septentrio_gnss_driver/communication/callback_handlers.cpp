@@ -28,6 +28,8 @@
 //
 // *****************************************************************************
 
+#include <algorithm>
+#include <chrono>
 #include <septentrio_gnss_driver/communication/callback_handlers.hpp>
 
 /**
@@ -37,9 +39,8 @@
  */
 
 std::pair<std::string, uint32_t> gpsfix_pairs[] = {
-    std::make_pair("4013", 0), std::make_pair("4027", 1), std::make_pair("4001", 2),
-    std::make_pair("4007", 3), std::make_pair("5906", 4), std::make_pair("5908", 5),
-    std::make_pair("5938", 6), std::make_pair("5939", 7), std::make_pair("4226", 8)};
+    std::make_pair("4007", 0), std::make_pair("5906", 1), std::make_pair("5908", 2),
+    std::make_pair("5938", 3), std::make_pair("5939", 4), std::make_pair("4226", 0)};
 
 std::pair<std::string, uint32_t> navsatfix_pairs[] = {
     std::make_pair("4007", 0), std::make_pair("5906", 1), std::make_pair("4226", 2)};
@@ -57,34 +58,22 @@ std::pair<std::string, uint32_t> imu_pairs[] = {std::make_pair("4226", 0),
 std::pair<std::string, uint32_t> localization_pairs[] = {std::make_pair("4226", 0)};
 
 namespace io_comm_rx {
-    boost::mutex CallbackHandlers::callback_mutex_;
-
-    CallbackHandlers::GPSFixMap CallbackHandlers::gpsfix_map(gpsfix_pairs,
-                                                             gpsfix_pairs + 9);
-    CallbackHandlers::NavSatFixMap
+    const CallbackHandlers::GPSFixMap
+        CallbackHandlers::gpsfix_map(gpsfix_pairs, gpsfix_pairs + 6);
+    const CallbackHandlers::NavSatFixMap
         CallbackHandlers::navsatfix_map(navsatfix_pairs, navsatfix_pairs + 3);
-    CallbackHandlers::PoseWithCovarianceStampedMap
+    const CallbackHandlers::PoseWithCovarianceStampedMap
         CallbackHandlers::pose_map(pose_pairs, pose_pairs + 5);
-    CallbackHandlers::DiagnosticArrayMap
+    const CallbackHandlers::DiagnosticArrayMap
         CallbackHandlers::diagnosticarray_map(diagnosticarray_pairs,
                                               diagnosticarray_pairs + 2);
-    CallbackHandlers::ImuMap CallbackHandlers::imu_map(imu_pairs, imu_pairs + 2);
+    const CallbackHandlers::ImuMap CallbackHandlers::imu_map(imu_pairs,
+                                                           imu_pairs + 2);
 
-    CallbackHandlers::LocalizationMap
+    const CallbackHandlers::LocalizationMap
         CallbackHandlers::localization_map(localization_pairs,
                                            localization_pairs + 1);
 
-    std::string CallbackHandlers::do_gpsfix_ = "4007";
-    std::string CallbackHandlers::do_navsatfix_ = "4007";
-    std::string CallbackHandlers::do_pose_ = "4007";
-    std::string CallbackHandlers::do_diagnostics_ = "4014";
-
-    std::string CallbackHandlers::do_insgpsfix_ = "4226";
-    std::string CallbackHandlers::do_insnavsatfix_ = "4226";
-    std::string CallbackHandlers::do_inspose_ = "4226";
-    std::string CallbackHandlers::do_imu_ = "4226";
-    std::string CallbackHandlers::do_inslocalization_ = "4226";
-
     //! The for loop forwards to a ROS message specific handle if the latter was
     //! added via callbackmap_.insert at some earlier point.
     void CallbackHandlers::handle()
@@ -398,8 +387,9 @@ namespace io_comm_rx {
                 }
                 CallbackMap::key_type key2 = "GPSFix";
                 if (ID_temp == do_gpsfix_)
-                // The last incoming block among ChannelStatus (4013), MeasEpoch
-                // (4027), and DOP (4001) triggers the publishing of GPSFix.
+                // The last incoming block among PVTGeodetic (4007), PosCovGeodetic
+                // (5906), VelCovGeodetic (5908), AttEuler (5938) and AttCovEuler
+                // (5939) triggers the publishing of GPSFix.
                 {
                     for (CallbackMap::iterator callback =
                              callbackmap_.lower_bound(key2);
@@ -444,8 +434,7 @@ namespace io_comm_rx {
                 }
                 CallbackMap::key_type key2 = "INSGPSFix";
                 if (ID_temp == do_insgpsfix_)
-                // The last incoming block among ChannelStatus (4013), MeasEpoch
-                // (4027) and DOP (4001) triggers the publishing of INSGPSFix.
+                // INSNavGeod (4226) triggers the publishing of INSGPSFix.
                 {
                     for (CallbackMap::iterator callback =
                              callbackmap_.lower_bound(key2);
@@ -465,197 +454,350 @@ namespace io_comm_rx {
         }
     }
 
+    void CallbackHandlers::prioritize(const std::vector<int32_t>& block_numbers)
+    {
+        priority_.clear();
+        if (block_numbers.empty())
+            return;
+        priority_.assign(8192, false);
+        for (int32_t block_number : block_numbers)
+        {
+            if (block_number < 0 || block_number >= 8192)
+            {
+                node_->log(LogLevel::WARN,
+                           "Ignoring invalid SBF block number " +
+                               std::to_string(block_number) +
+                               " in decode_priority/blocks.");
+                continue;
+            }
+            priority_[block_number] = true;
+        }
+
+        // Composite messages are built from the last blocks of each type. If
+        // only some of their blocks were decoded ahead, they would mix blocks of
+        // the current and the previous read, hence their blocks are decoded
+        // ahead together.
+        struct Composite
+        {
+            bool enabled;
+            const char* topic;
+            std::vector<uint16_t> blocks;
+        };
+        bool gnss = (settings_->septentrio_receiver_type == "gnss");
+        const std::vector<Composite> composites = {
+            {gnss && settings_->publish_gpsfix, "/gpsfix",
+             {4007, 5906, 5908, 5938, 5939}},
+            {gnss && settings_->publish_navsatfix, "/navsatfix", {4007, 5906}},
+            {gnss && settings_->publish_pose, "/pose", {4007, 5906, 5938, 5939}},
+            {gnss && settings_->publish_twist, "/twist", {4007, 5908}},
+            {settings_->publish_diagnostics, "/diagnostics", {4014, 4082}}};
+        // Completing one composite may split another one
+        bool completed;
+        do
+        {
+            completed = false;
+            for (const Composite& composite : composites)
+            {
+                if (!composite.enabled)
+                    continue;
+                std::size_t prioritized = std::count_if(
+                    composite.blocks.begin(), composite.blocks.end(),
+                    [this](uint16_t block) { return priority_[block]; });
+                if ((prioritized == 0) ||
+                    (prioritized == composite.blocks.size()))
+                    continue;
+                std::string added;
+                for (uint16_t block : composite.blocks)
+                {
+                    if (priority_[block])
+                        continue;
+                    priority_[block] = true;
+                    added += " " + std::to_string(block);
+                }
+                node_->log(LogLevel::WARN,
+                           "decode_priority/blocks holds only some of the SBF "
+                           "blocks of " +
+                               std::string(composite.topic) +
+                               ", also decoding ahead:" + added);
+                completed = true;
+            }
+        } while (completed);
+    }
+
     void CallbackHandlers::readCallback(Timestamp recvTimestamp, const uint8_t* data,
                                         std::size_t& size)
     {
+        // Files are read in windows spanning many epochs, only live reads are
+        // reordered
+        bool reorder = !priority_.empty() && !settings_->read_from_sbf_log &&
+                          !settings_->read_from_pcap;
+        deferred_.clear();
         rx_message_.newData(recvTimestamp, data, size);
-        // Read !all! (there might be many) messages in the buffer
-        while (rx_message_.search() != rx_message_.getEndBuffer() &&
-               rx_message_.found())
+        try
         {
-            // Print the found message (if NMEA) or just show messageID (if SBF)..
-            if (rx_message_.isSBF())
+            // Read !all! (there might be many) messages in the buffer
+            while (rx_message_.search() != rx_message_.getEndBuffer() &&
+                   rx_message_.found())
             {
-                std::size_t sbf_block_length;
-                std::string ID_temp = rx_message_.messageID();
-                sbf_block_length =
-                    static_cast<std::size_t>(rx_message_.getBlockLength());
-                node_->log(LogLevel::DEBUG,
-                           "ROSaic reading SBF block " + ID_temp + " made up of " +
-                               std::to_string(sbf_block_length) + " bytes...");
-                // If full message did not yet arrive, throw an error message.
-                if (sbf_block_length > rx_message_.getCount())
-                {
-                    node_->log(
-                        LogLevel::DEBUG,
-                        "Not a valid SBF block, parts of the SBF block are yet to be received. Ignore..");
-                    throw(
-                        static_cast<std::size_t>(rx_message_.getPosBuffer() - data));
-                }
-                if (settings_->septentrio_receiver_type == "gnss")
+                // Complete SBF blocks of low priority wait for the rest of the
+                // read, unless their CRC is wrong, which decode() handles
+                if (reorder && rx_message_.isSBF() &&
+                    !priority_[parsing_utilities::getId(
+                        rx_message_.getPosBuffer())] &&
+                    rx_message_.getBlockLength() <= rx_message_.getCount())
                 {
-                    if (settings_->publish_gpsfix == true &&
-                        (ID_temp == "4013" || ID_temp == "4027" ||
-                         ID_temp == "4001" || ID_temp == "4007" ||
-                         ID_temp == "5906" || ID_temp == "5908" ||
-                         ID_temp == "5938" || ID_temp == "5939"))
+                    std::size_t offset = static_cast<std::size_t>(
+                        rx_message_.getPosBuffer() - data);
+                    if (rx_message_.skipBlock())
                     {
-                        if (rx_message_.gnss_gpsfix_complete(gpsfix_map[ID_temp]))
-                        {
-                            do_gpsfix_ = ID_temp;
-                        }
+                        deferred_.push_back(offset);
+                        continue;
                     }
                 }
-                if (settings_->septentrio_receiver_type == "ins")
-                {
-                    if (settings_->publish_gpsfix == true &&
-                        (ID_temp == "4013" || ID_temp == "4027" ||
-                         ID_temp == "4001" || ID_temp == "4226"))
-                    {
-                        if (rx_message_.ins_gpsfix_complete(gpsfix_map[ID_temp]))
-                        {
-                            do_insgpsfix_ = ID_temp;
-                        }
-                    }
-                }
-                if (settings_->septentrio_receiver_type == "gnss")
+                decode(data);
+            }
+        } catch (std::size_t&)
+        {
+            // The incomplete tail is carried over to the next read only after
+            // the blocks preceding it have been decoded
+            decodeDeferred(recvTimestamp, data, size);
+            throw;
+        }
+        decodeDeferred(recvTimestamp, data, size);
+    }
+
+    void CallbackHandlers::decodeDeferred(Timestamp recvTimestamp,
+                                          const uint8_t* data, std::size_t size)
+    {
+        // In their original order, so that each topic is published in order
+        for (std::size_t offset : deferred_)
+        {
+            std::size_t remaining = size - offset;
+            rx_message_.newData(recvTimestamp, data + offset, remaining);
+            if (rx_message_.search() == rx_message_.getEndBuffer() ||
+                !rx_message_.found())
+                continue;
+            try
+            {
+                decode(data);
+            } catch (std::size_t&)
+            {
+                // The blocks after it have been decoded already, carrying it
+                // over would publish them twice
+                node_->statistics().addDroppedDeferredBlock();
+                node_->log(LogLevel::DEBUG,
+                           "Dropping deferred SBF block that could not be decoded.");
+            }
+        }
+        deferred_.clear();
+    }
+
+    void CallbackHandlers::decode(const uint8_t* data)
+    {
+        // Print the found message (if NMEA) or just show messageID (if SBF)..
+        if (rx_message_.isSBF())
+        {
+            std::size_t sbf_block_length;
+            std::string ID_temp = rx_message_.messageID();
+            sbf_block_length =
+                static_cast<std::size_t>(rx_message_.getBlockLength());
+            node_->log(LogLevel::DEBUG,
+                       "ROSaic reading SBF block " + ID_temp + " made up of " +
+                           std::to_string(sbf_block_length) + " bytes...");
+            // If full message did not yet arrive, throw an error message.
+            if (sbf_block_length > rx_message_.getCount())
+            {
+                node_->log(
+                    LogLevel::DEBUG,
+                    "Not a valid SBF block, parts of the SBF block are yet to be received. Ignore..");
+                node_->statistics().addIncompleteCarry();
+                throw(
+                    static_cast<std::size_t>(rx_message_.getPosBuffer() - data));
+            }
+            node_->statistics().addBlock(
+                parsing_utilities::getId(rx_message_.getPosBuffer()));
+            if (settings_->septentrio_receiver_type == "gnss")
+            {
+                // ChannelStatus, MeasEpoch and DOP only update the stored
+                // satellite state and do not take part in the triggering
+                if (settings_->publish_gpsfix == true &&
+                    (ID_temp == "4007" || ID_temp == "5906" ||
+                     ID_temp == "5908" || ID_temp == "5938" ||
+                     ID_temp == "5939"))
                 {
-                    if (settings_->publish_navsatfix == true &&
-                        (ID_temp == "4007" || ID_temp == "5906"))
+                    if (rx_message_.gnss_gpsfix_complete(gpsfix_map.at(ID_temp)))
                     {
-                        if (rx_message_.gnss_navsatfix_complete(
-                                navsatfix_map[ID_temp]))
-                        {
-                            do_navsatfix_ = ID_temp;
-                        }
+                        do_gpsfix_ = ID_temp;
                     }
                 }
-                if (settings_->septentrio_receiver_type == "ins")
+            }
+            if (settings_->septentrio_receiver_type == "ins")
+            {
+                if (settings_->publish_gpsfix == true && (ID_temp == "4226"))
                 {
-                    if (settings_->publish_navsatfix == true && (ID_temp == "4226"))
+                    if (rx_message_.ins_gpsfix_complete(gpsfix_map.at(ID_temp)))
                     {
-                        if (rx_message_.ins_navsatfix_complete(
-                                navsatfix_map[ID_temp]))
-                        {
-                            do_insnavsatfix_ = ID_temp;
-                        }
+                        do_insgpsfix_ = ID_temp;
                     }
                 }
-                if (settings_->septentrio_receiver_type == "gnss")
+            }
+            if (settings_->septentrio_receiver_type == "gnss")
+            {
+                if (settings_->publish_navsatfix == true &&
+                    (ID_temp == "4007" || ID_temp == "5906"))
                 {
-                    if (settings_->publish_pose == true &&
-                        (ID_temp == "4007" || ID_temp == "5906" ||
-                         ID_temp == "5938" || ID_temp == "5939"))
+                    if (rx_message_.gnss_navsatfix_complete(
+                            navsatfix_map.at(ID_temp)))
                     {
-                        if (rx_message_.gnss_pose_complete(pose_map[ID_temp]))
-                        {
-                            do_pose_ = ID_temp;
-                        }
+                        do_navsatfix_ = ID_temp;
                     }
                 }
-                if (settings_->septentrio_receiver_type == "ins")
+            }
+            if (settings_->septentrio_receiver_type == "ins")
+            {
+                if (settings_->publish_navsatfix == true && (ID_temp == "4226"))
                 {
-                    if (settings_->publish_pose == true && (ID_temp == "4226"))
+                    if (rx_message_.ins_navsatfix_complete(
+                            navsatfix_map.at(ID_temp)))
                     {
-                        if (rx_message_.ins_pose_complete(pose_map[ID_temp]))
-                        {
-                            do_inspose_ = ID_temp;
-                        }
+                        do_insnavsatfix_ = ID_temp;
                     }
                 }
-                if (settings_->publish_diagnostics == true &&
-                    (ID_temp == "4014" || ID_temp == "4082"))
+            }
+            if (settings_->septentrio_receiver_type == "gnss")
+            {
+                if (settings_->publish_pose == true &&
+                    (ID_temp == "4007" || ID_temp == "5906" ||
+                     ID_temp == "5938" || ID_temp == "5939"))
                 {
-                    if (rx_message_.diagnostics_complete(
-                            diagnosticarray_map[ID_temp]))
+                    if (rx_message_.gnss_pose_complete(pose_map.at(ID_temp)))
                     {
-                        do_diagnostics_ = ID_temp;
+                        do_pose_ = ID_temp;
                     }
                 }
-                if ((settings_->publish_localization || settings_->publish_tf) &&
-                    (ID_temp == "4226"))
+            }
+            if (settings_->septentrio_receiver_type == "ins")
+            {
+                if (settings_->publish_pose == true && (ID_temp == "4226"))
                 {
-                    if (rx_message_.ins_localization_complete(
-                            localization_map[ID_temp]))
+                    if (rx_message_.ins_pose_complete(pose_map.at(ID_temp)))
                     {
-                        do_inslocalization_ = ID_temp;
+                        do_inspose_ = ID_temp;
                     }
                 }
             }
-            if (rx_message_.isNMEA())
-            {
-                boost::char_separator<char> sep("\r"); // Carriage Return (CR)
-                typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
-                std::size_t nmea_size = rx_message_.messageSize();
-                // Syntax: new_string_name (const char* s, size_t n); size_t is
-                // either 2 or 8 bytes, depending on your system
-                std::string block_in_string(
-                    reinterpret_cast<const char*>(rx_message_.getPosBuffer()),
-                    nmea_size);
-                tokenizer tokens(block_in_string, sep);
-                node_->log(LogLevel::DEBUG,
-                           "The NMEA message contains " + std::to_string(nmea_size) +
-                               " bytes and is ready to be parsed. It reads: " +
-                               *tokens.begin());
-            }
-            if (rx_message_.isResponse()) // If the response is not sent at once,
-                                          // only first part is ROS_DEBUG-printed
-            {
-                std::size_t response_size = rx_message_.messageSize();
-                std::string block_in_string(
-                    reinterpret_cast<const char*>(rx_message_.getPosBuffer()),
-                    response_size);
-                node_->log(LogLevel::DEBUG, "The Rx's response contains " +
-                                                std::to_string(response_size) +
-                                                " bytes and reads:\n " +
-                                                block_in_string);
-                {
-                    boost::mutex::scoped_lock lock(g_response_mutex);
-                    g_response_received = true;
-                    lock.unlock();
-                    g_response_condition.notify_one();
-                }
-                if (rx_message_.isErrorMessage())
+            if (settings_->publish_diagnostics == true &&
+                (ID_temp == "4014" || ID_temp == "4082"))
+            {
+                if (rx_message_.diagnostics_complete(
+                        diagnosticarray_map.at(ID_temp)))
                 {
-                    node_->log(
-                        LogLevel::ERROR,
-                        "Invalid command just sent to the Rx! The Rx's response contains " +
-                            std::to_string(response_size) + " bytes and reads:\n " +
-                            block_in_string);
+                    do_diagnostics_ = ID_temp;
                 }
-                continue;
             }
-            if (rx_message_.isConnectionDescriptor())
+            if ((settings_->publish_localization || settings_->publish_tf) &&
+                (ID_temp == "4226"))
             {
-                std::string cd(
-                    reinterpret_cast<const char*>(rx_message_.getPosBuffer()), 4);
-                g_rx_tcp_port = cd;
-                if (g_cd_count == 0)
-                {
-                    node_->log(
-                        LogLevel::INFO,
-                        "The connection descriptor for the TCP connection is " + cd);
-                }
-                if (g_cd_count < 3)
-                    ++g_cd_count;
-                if (g_cd_count == 2)
+                if (rx_message_.ins_localization_complete(
+                        localization_map.at(ID_temp)))
                 {
-                    boost::mutex::scoped_lock lock(g_cd_mutex);
-                    g_cd_received = true;
-                    lock.unlock();
-                    g_cd_condition.notify_one();
+                    do_inslocalization_ = ID_temp;
                 }
-                continue;
             }
-            try
-            {
-                handle();
-            } catch (std::runtime_error& e)
+        }
+        if (rx_message_.isNMEA())
+        {
+            if (!rx_message_.isValidNMEA())
             {
                 node_->log(LogLevel::DEBUG,
-                           "Incomplete message: " + std::string(e.what()));
-                throw(static_cast<std::size_t>(rx_message_.getPosBuffer() - data));
+                           "NMEA checksum is wrong. Ignoring the message..");
+                node_->statistics().addNmeaChecksumFailure();
+                return;
+            }
+            node_->statistics().addBlock(0);
+            boost::char_separator<char> sep("\r"); // Carriage Return (CR)
+            typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+            std::size_t nmea_size = rx_message_.messageSize();
+            // Syntax: new_string_name (const char* s, size_t n); size_t is
+            // either 2 or 8 bytes, depending on your system
+            std::string block_in_string(
+                reinterpret_cast<const char*>(rx_message_.getPosBuffer()),
+                nmea_size);
+            tokenizer tokens(block_in_string, sep);
+            node_->log(LogLevel::DEBUG,
+                       "The NMEA message contains " + std::to_string(nmea_size) +
+                           " bytes and is ready to be parsed. It reads: " +
+                           *tokens.begin());
+        }
+        if (rx_message_.isResponse()) // If the response is not sent at once,
+                                      // only first part is ROS_DEBUG-printed
+        {
+            std::size_t response_size = rx_message_.messageSize();
+            std::string block_in_string(
+                reinterpret_cast<const char*>(rx_message_.getPosBuffer()),
+                response_size);
+            node_->log(LogLevel::DEBUG, "The Rx's response contains " +
+                                            std::to_string(response_size) +
+                                            " bytes and reads:\n " +
+                                            block_in_string);
+            {
+                boost::mutex::scoped_lock lock(connection_.response_mutex);
+                connection_.response_received = true;
+                lock.unlock();
+                connection_.response_condition.notify_one();
+            }
+            if (rx_message_.isErrorMessage())
+            {
+                node_->log(
+                    LogLevel::ERROR,
+                    "Invalid command just sent to the Rx! The Rx's response contains " +
+                        std::to_string(response_size) + " bytes and reads:\n " +
+                        block_in_string);
+            }
+            return;
+        }
+        if (rx_message_.isConnectionDescriptor())
+        {
+            std::string cd(
+                reinterpret_cast<const char*>(rx_message_.getPosBuffer()), 4);
+            connection_.rx_tcp_port = cd;
+            if (connection_.cd_count == 0)
+            {
+                node_->log(
+                    LogLevel::INFO,
+                    "The connection descriptor for the TCP connection is " + cd);
+            }
+            if (connection_.cd_count < 3)
+                ++connection_.cd_count;
+            if (connection_.cd_count == 2)
+            {
+                boost::mutex::scoped_lock lock(connection_.cd_mutex);
+                connection_.cd_received = true;
+                lock.unlock();
+                connection_.cd_condition.notify_one();
             }
+            return;
+        }
+        // Only SBF blocks and NMEA messages are left, the latter counted as 0
+        uint16_t block_number =
+            rx_message_.isSBF()
+                ? parsing_utilities::getId(rx_message_.getPosBuffer())
+                : 0;
+        auto decode_start = std::chrono::steady_clock::now();
+        try
+        {
+            handle();
+        } catch (std::runtime_error& e)
+        {
+            node_->log(LogLevel::DEBUG,
+                       "Incomplete message: " + std::string(e.what()));
+            node_->statistics().addIncompleteCarry();
+            throw(static_cast<std::size_t>(rx_message_.getPosBuffer() - data));
         }
+        node_->statistics().addDecodeTime(
+            block_number,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - decode_start)
+                .count());
     }
 } // namespace io_comm_rx
\ No newline at end of file
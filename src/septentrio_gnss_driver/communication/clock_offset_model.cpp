@@ -0,0 +1,177 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/clock_offset_model.hpp>
+
+#include <cmath>
+
+/**
+ * @file clock_offset_model.cpp
+ * @brief Defines an online model of the offset between GNSS and host time
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Nanoseconds per second
+    static const uint64_t NSEC_PER_SEC = 1000000000;
+    //! Deviation of a second's minimum from the model that restarts it in ns
+    static const double STEP = 1e9;
+    //! Number of completed seconds needed to estimate the drift
+    static const std::size_t MIN_BINS_FOR_DRIFT = 8;
+
+    void ClockOffsetModel::addSample(uint64_t gnss_time, uint64_t host_time)
+    {
+        int64_t offset =
+            static_cast<int64_t>(host_time) - static_cast<int64_t>(gnss_time);
+        if (!has_current_)
+        {
+            reference_time_ = gnss_time;
+            reference_offset_ = offset;
+        }
+        Bin sample;
+        sample.second = gnss_time / NSEC_PER_SEC;
+        sample.time = static_cast<double>(static_cast<int64_t>(gnss_time) -
+                                          static_cast<int64_t>(reference_time_));
+        sample.offset = static_cast<double>(offset - reference_offset_);
+
+        if (!has_current_)
+        {
+            current_ = sample;
+            has_current_ = true;
+            fit();
+            return;
+        }
+        if (sample.second == current_.second)
+        {
+            if (sample.offset < current_.offset)
+            {
+                current_ = sample;
+                if (bins_.empty())
+                    fit();
+            }
+            return;
+        }
+        // Blocks of an older second, e.g. of a lower rate, are only taken into
+        // account in their own second
+        if (sample.second < current_.second)
+            return;
+
+        // The current second is complete
+        if (!bins_.empty() &&
+            (std::fabs(current_.offset - model(current_.time)) > STEP))
+        {
+            // The host clock was set, the model starts anew from this sample
+            reset();
+            addSample(gnss_time, host_time);
+            return;
+        }
+        bins_.push_back(current_);
+        if (bins_.size() > WINDOW)
+            bins_.pop_front();
+        current_ = sample;
+        fit();
+    }
+
+    uint64_t ClockOffsetModel::toHost(uint64_t gnss_time)
+    {
+        if (!has_current_)
+            return gnss_time;
+        double time = static_cast<double>(static_cast<int64_t>(gnss_time) -
+                                          static_cast<int64_t>(reference_time_));
+        uint64_t host_time = static_cast<uint64_t>(
+            static_cast<int64_t>(gnss_time) + reference_offset_ +
+            std::llround(model(time)));
+        // Blocks of the same epoch get the same stamp and later epochs do not get
+        // earlier stamps, even if the model was updated in between
+        if (gnss_time == last_gnss_time_)
+            return last_host_time_;
+        if (gnss_time > last_gnss_time_)
+        {
+            if (host_time < last_host_time_)
+                host_time = last_host_time_;
+            last_gnss_time_ = gnss_time;
+            last_host_time_ = host_time;
+        }
+        return host_time;
+    }
+
+    double ClockOffsetModel::offset() const
+    {
+        if (!has_current_)
+            return 0.0;
+        return static_cast<double>(reference_offset_) + model(current_.time);
+    }
+
+    void ClockOffsetModel::reset()
+    {
+        bins_.clear();
+        has_current_ = false;
+        offset_ = 0.0;
+        drift_ = 0.0;
+        fit_time_ = 0.0;
+        last_gnss_time_ = 0;
+        last_host_time_ = 0;
+    }
+
+    void ClockOffsetModel::fit()
+    {
+        if (bins_.empty())
+        {
+            offset_ = current_.offset;
+            drift_ = 0.0;
+            fit_time_ = current_.time;
+            return;
+        }
+        double mean_time = 0.0;
+        double mean_offset = 0.0;
+        for (const Bin& bin : bins_)
+        {
+            mean_time += bin.time;
+            mean_offset += bin.offset;
+        }
+        mean_time /= bins_.size();
+        mean_offset /= bins_.size();
+        offset_ = mean_offset;
+        fit_time_ = mean_time;
+        drift_ = 0.0;
+        if (bins_.size() < MIN_BINS_FOR_DRIFT)
+            return;
+        double covariance = 0.0;
+        double variance = 0.0;
+        for (const Bin& bin : bins_)
+        {
+            covariance += (bin.time - mean_time) * (bin.offset - mean_offset);
+            variance += (bin.time - mean_time) * (bin.time - mean_time);
+        }
+        if (variance > 0.0)
+            drift_ = covariance / variance;
+    }
+} // namespace io_comm_rx
@@ -34,7 +34,12 @@
 // Boost includes
 #include <boost/regex.hpp>
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/decode_sinks.hpp>
+#include <septentrio_gnss_driver/communication/decompressing_reader.hpp>
+#include <septentrio_gnss_driver/communication/mapped_file.hpp>
 #include <septentrio_gnss_driver/communication/pcap_reader.hpp>
+#include <septentrio_gnss_driver/communication/replay_clock.hpp>
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
 
 #ifndef ANGLE_MAX
 #define ANGLE_MAX 180
@@ -98,34 +103,13 @@
  * @brief Highest-Level view on communication services
  */
 
-//! Mutex to control changes of global variable "g_response_received"
-boost::mutex g_response_mutex;
-//! Determines whether a command reply was received from the Rx
-bool g_response_received;
-//! Condition variable complementing "g_response_mutex"
-boost::condition_variable g_response_condition;
-//! Mutex to control changes of global variable "g_cd_received"
-boost::mutex g_cd_mutex;
-//! Determines whether the connection descriptor was received from the Rx
-bool g_cd_received;
-//! Condition variable complementing "g_cd_mutex"
-boost::condition_variable g_cd_condition;
-//! Whether or not we still want to read the connection descriptor, which we only
-//! want in the very beginning to know whether it is IP10, IP11 etc.
-bool g_read_cd;
-//! Rx TCP port, e.g. IP10 or IP11, to which ROSaic is connected to
-std::string g_rx_tcp_port;
-//! Since after SSSSSSSSSSS we need to wait for second connection descriptor, we have
-//! to count the connection descriptors
-uint32_t g_cd_count;
-
-io_comm_rx::Comm_IO::Comm_IO(ROSaicNodeBase* node, Settings* settings) :
-    node_(node), handlers_(node, settings), settings_(settings), stopping_(false)
+io_comm_rx::Comm_IO::Comm_IO(
+    ROSaicNodeBase* node, Settings* settings,
+    const boost::shared_ptr<boost::asio::io_service>& io_service) :
+    node_(node),
+    handlers_(node, settings), settings_(settings), shared_io_service_(io_service),
+    stopping_(false)
 {
-    g_response_received = false;
-    g_cd_received = false;
-    g_read_cd = true;
-    g_cd_count = 0;
 }
 
 io_comm_rx::Comm_IO::~Comm_IO()
@@ -190,22 +174,27 @@ io_comm_rx::Comm_IO::~Comm_IO()
 
 void io_comm_rx::Comm_IO::resetMainPort()
 {
-    // It is imperative to hold a lock on the mutex  "g_cd_mutex" while
-    // modifying the variable and "g_cd_received".
-    boost::mutex::scoped_lock lock_cd(g_cd_mutex);
+    // It is imperative to hold a lock on the mutex  "cd_mutex" while
+    // modifying the variable and "cd_received".
+    ConnectionState& connection = handlers_.connection();
+    boost::mutex::scoped_lock lock_cd(connection.cd_mutex);
     // Escape sequence (escape from correction mode), ensuring that we can send
     // our real commands afterwards...
     std::string cmd("\x0DSSSSSSSSSSSSSSSSSSS\x0D\x0D");
     manager_.get()->send(cmd);
     // We wait for the connection descriptor before we send another command,
     // otherwise the latter would not be processed.
-    g_cd_condition.wait(lock_cd, []() { return g_cd_received; });
-    g_cd_received = false;
+    connection.cd_condition.wait(lock_cd,
+                                 [&connection]() { return connection.cd_received; });
+    connection.cd_received = false;
 }
 
 void io_comm_rx::Comm_IO::initializeIO()
 {
     node_->log(LogLevel::DEBUG, "Called initializeIO() method");
+    // Before any data is read
+    if (settings_->decode_priority)
+        prioritize(settings_->decode_priority_blocks);
     boost::smatch match;
     // In fact: smatch is a typedef of match_results<string::const_iterator>
     if (boost::regex_match(settings_->device, match,
@@ -226,8 +215,10 @@ void io_comm_rx::Comm_IO::initializeIO()
         serial_ = false;
         connectionThread_.reset(
             new boost::thread(boost::bind(&Comm_IO::connect, this)));
-    } else if (boost::regex_match(settings_->device, match,
-                                  boost::regex("(file_name):(/|(?:/[\\w-]+)+.sbf)")))
+    } else if (boost::regex_match(
+                   settings_->device, match,
+                   boost::regex("(file_name):(/|(?:/[\\w-]+)+.sbf"
+                                "(?:\\.gz|\\.zst)?)")))
     {
         serial_ = false;
         settings_->read_from_sbf_log = true;
@@ -237,7 +228,8 @@ void io_comm_rx::Comm_IO::initializeIO()
 
     } else if (boost::regex_match(
                    settings_->device, match,
-                   boost::regex("(file_name):(/|(?:/[\\w-]+)+.pcap)")))
+                   boost::regex("(file_name):(/|(?:/[\\w-]+)+.pcap"
+                                "(?:\\.gz|\\.zst)?)")))
     {
         serial_ = false;
         settings_->read_from_pcap = true;
@@ -262,10 +254,12 @@ void io_comm_rx::Comm_IO::initializeIO()
         ss << "Device is unsupported. Perhaps you meant 'tcp://host:port' or 'file_name:xxx.sbf' or 'serial:/path/to/device'?";
         node_->log(LogLevel::ERROR, ss.str());
     }
+    if (connectionThread_)
+        node_->configureThread(connectionThread_->native_handle(), "connection");
     node_->log(LogLevel::DEBUG, "Leaving initializeIO() method");
 }
 
-void io_comm_rx::Comm_IO::prepareSBFFileReading(std::string file_name)
+bool io_comm_rx::Comm_IO::prepareSBFFileReading(std::string file_name)
 {
     try
     {
@@ -279,7 +273,28 @@ void io_comm_rx::Comm_IO::prepareSBFFileReading(std::string file_name)
         ss << "Comm_IO::initializeSBFFileReading() failed for SBF File" << file_name
            << " due to: " << e.what();
         node_->log(LogLevel::ERROR, ss.str());
+        return false;
     }
+    return true;
+}
+
+bool io_comm_rx::Comm_IO::readSBFFile(const std::string& file_name)
+{
+    serial_ = false;
+    settings_->read_from_sbf_log = true;
+    settings_->use_gnss_time = true;
+    return prepareSBFFileReading(file_name);
+}
+
+void io_comm_rx::Comm_IO::parse(Timestamp recv_time, const uint8_t* data,
+                                std::size_t size)
+{
+    handlers_.readCallback(recv_time, data, size);
+}
+
+void io_comm_rx::Comm_IO::prioritize(const std::vector<int32_t>& block_numbers)
+{
+    handlers_.prioritize(block_numbers);
 }
 
 void io_comm_rx::Comm_IO::preparePCAPFileReading(std::string file_name)
@@ -404,7 +419,7 @@ void io_comm_rx::Comm_IO::configureRx()
     resetMainPort();
     if (proto == "tcp")
     {
-        mainPort_ = g_rx_tcp_port;
+        mainPort_ = handlers_.connection().rx_tcp_port;
     } else
     {
         mainPort_ = settings_->rx_serial_port;
@@ -454,7 +469,8 @@ void io_comm_rx::Comm_IO::configureRx()
     // Setting up SBF blocks with rx_period_pvt
     {
         std::stringstream blocks;
-        if (settings_->use_gnss_time)
+        // Leap seconds are needed for GNSS time and latency estimation
+        if (settings_->use_gnss_time || settings_->publish_latency)
         {
             blocks << " +ReceiverTime";
         }
@@ -516,7 +532,8 @@ void io_comm_rx::Comm_IO::configureRx()
         {
             blocks << " +AttCovEuler";
         }
-        if (settings_->publish_measepoch || settings_->publish_gpsfix)
+        if (settings_->publish_measepoch || settings_->publish_measepoch_columnar ||
+            settings_->publish_gpsfix)
         {
             blocks << " +MeasEpoch";
         }
@@ -986,7 +1003,8 @@ void io_comm_rx::Comm_IO::defineMessages()
 {
     node_->log(LogLevel::DEBUG, "Called defineMessages() method");
 
-    if (settings_->use_gnss_time || settings_->publish_gpst)
+    if (settings_->use_gnss_time || settings_->publish_gpst ||
+        settings_->publish_latency)
     {
         handlers_.callbackmap_ = handlers_.insert<ReceiverTimeMsg>("5914");
     }
@@ -1063,7 +1081,8 @@ void io_comm_rx::Comm_IO::defineMessages()
     {
         handlers_.callbackmap_ = handlers_.insert<AttCovEulerMsg>("5939");
     }
-    if (settings_->publish_measepoch || settings_->publish_gpsfix)
+    if (settings_->publish_measepoch || settings_->publish_measepoch_columnar ||
+        settings_->publish_gpsfix)
     {
         handlers_.callbackmap_ =
             handlers_.insert<int32_t>("4027"); // MeasEpoch block
@@ -1191,13 +1210,15 @@ void io_comm_rx::Comm_IO::defineMessages()
 
 void io_comm_rx::Comm_IO::send(const std::string& cmd)
 {
-    // It is imperative to hold a lock on the mutex "g_response_mutex" while
-    // modifying the variable "g_response_received".
-    boost::mutex::scoped_lock lock(g_response_mutex);
+    // It is imperative to hold a lock on the mutex "response_mutex" while
+    // modifying the variable "response_received".
+    ConnectionState& connection = handlers_.connection();
+    boost::mutex::scoped_lock lock(connection.response_mutex);
     // Determine byte size of cmd and hand over to send() method of manager_
     manager_.get()->send(cmd);
-    g_response_condition.wait(lock, []() { return g_response_received; });
-    g_response_received = false;
+    connection.response_condition.wait(
+        lock, [&connection]() { return connection.response_received; });
+    connection.response_received = false;
 }
 
 void io_comm_rx::Comm_IO::sendVelocity(const std::string& velNmea)
@@ -1213,8 +1234,9 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
     port_ = port;
     // The io_context, of which io_service is a typedef of; it represents your
     // program's link to the operating system's I/O services.
-    boost::shared_ptr<boost::asio::io_service> io_service(
-        new boost::asio::io_service);
+    boost::shared_ptr<boost::asio::io_service> io_service =
+        shared_io_service_ ? shared_io_service_
+                           : boost::make_shared<boost::asio::io_service>();
     boost::asio::ip::tcp::resolver::iterator endpoint;
 
     try
@@ -1263,8 +1285,14 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
             "You have called the InitializeTCP() method though an AsyncManager object is already available! Start all anew..");
         return false;
     }
+    DropPolicy queue_policy = DropPolicy::BLOCK;
+    ParseQueue::toPolicy(settings_->parse_queue_policy, queue_policy);
+    std::size_t queue_capacity =
+        static_cast<std::size_t>(settings_->parse_queue_capacity) * 1024;
     setManager(boost::shared_ptr<Manager>(
-        new AsyncManager<boost::asio::ip::tcp::socket>(node_, socket, io_service)));
+        new AsyncManager<boost::asio::ip::tcp::socket>(
+            node_, socket, io_service, static_cast<bool>(shared_io_service_),
+            queue_policy, queue_capacity)));
     node_->log(LogLevel::DEBUG, "Leaving initializeTCP() method..");
     return true;
 }
@@ -1272,63 +1300,211 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
 void io_comm_rx::Comm_IO::initializeSBFFileReading(std::string file_name)
 {
     node_->log(LogLevel::DEBUG, "Calling initializeSBFFileReading() method..");
-    std::size_t buffer_size = 8192;
-    uint8_t* to_be_parsed;
-    to_be_parsed = new uint8_t[buffer_size];
-    std::ifstream bin_file(file_name, std::ios::binary);
-    std::vector<uint8_t> vec_buf;
-    if (bin_file.good())
-    {
-        /* Reads binary data using streambuffer iterators.
-        Copies all SBF file content into bin_data. */
-        std::vector<uint8_t> v_buf((std::istreambuf_iterator<char>(bin_file)),
-                                   (std::istreambuf_iterator<char>()));
-        vec_buf = v_buf;
-        bin_file.close();
-    } else
+    if (DecompressingReader::isCompressed(file_name))
     {
-        throw std::runtime_error("I could not find your file. Or it is corrupted.");
+        readCompressedSBFFile(file_name);
+        return;
     }
-    // The spec now guarantees that vectors store their elements contiguously.
-    to_be_parsed = vec_buf.data();
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    MappedFile file(file_name);
     std::stringstream ss;
-    ss << "Opened and copied over from " << file_name;
+    ss << "Mapped " << file_name << " (" << file.size() << " bytes)";
     node_->log(LogLevel::DEBUG, ss.str());
 
-    while (!stopping_) // Loop will stop if we are done reading the SBF file
+    const uint8_t* to_be_parsed = file.data();
+    const uint8_t* file_end = file.data() + file.size();
+    if ((settings_->replay_start_time > 0.0) || (settings_->replay_end_time > 0.0))
     {
+        SbfIndex index;
+        std::string index_name = file_name + ".idx";
+        if (!settings_->replay_index_file || !index.load(index_name, file.size()))
+        {
+            node_->log(LogLevel::INFO, "Indexing " + file_name + " ...");
+            index.build(node_, file.data(), file.size());
+            if (settings_->replay_index_file && !index.save(index_name, file.size()))
+                node_->log(LogLevel::WARN, "Unable to write index " + index_name);
+        }
+        // Unix time of the parameters to GPS time
+        int32_t leap_seconds =
+            (settings_->leap_seconds != -128) ? settings_->leap_seconds : 18;
+        auto toGpsTime = [leap_seconds](double unix_time) {
+            return static_cast<uint64_t>(
+                std::max(0.0, (unix_time - 315964800.0 + leap_seconds) * 1000.0));
+        };
+        if (settings_->replay_start_time > 0.0)
+            to_be_parsed += index.startOffset(
+                toGpsTime(settings_->replay_start_time), file.size());
+        if (settings_->replay_end_time > 0.0)
+            file_end = file.data() + index.endOffset(
+                                         toGpsTime(settings_->replay_end_time),
+                                         file.size());
+        ss.str("");
+        ss << "Replaying bytes " << (to_be_parsed - file.data()) << " to "
+           << (file_end - file.data()) << " (" << index.epochs().size()
+           << " epochs indexed)";
+        node_->log(LogLevel::INFO, ss.str());
+    }
+
+    if (settings_->replay_batch)
+    {
+        BatchDecoder decoder(node_, settings_);
+        PublisherSink publisher_sink(node_);
+        std::unique_ptr<BagSink> bag_sink;
+        if (!settings_->replay_batch_output.empty())
+            bag_sink.reset(new BagSink(settings_->replay_batch_output));
+        DecodeSink& sink = bag_sink ? static_cast<DecodeSink&>(*bag_sink)
+                                    : publisher_sink;
+        std::vector<std::string> unsupported = decoder.unsupportedOutputs();
+        if (!unsupported.empty())
+        {
+            ss.str("");
+            ss << "Batch mode only produces the SBF topics, not";
+            for (const auto& topic : unsupported)
+                ss << " " << topic;
+            ss << ". Disable replay/batch to get them.";
+            node_->log(LogLevel::WARN, ss.str());
+        }
+        node_->log(LogLevel::INFO, "Decoding " + file_name + " in batch mode ...");
+        decoder.decode(to_be_parsed, file_end - to_be_parsed, sink, &stopping_);
+        // Throws if writing the bag failed
+        if (bag_sink)
+            bag_sink->close();
+        ss.str("");
+        ss << "Decoded " << decoder.decodedMessages() << " messages, "
+           << decoder.parseErrors() << " parse errors";
+        node_->log(LogLevel::INFO, ss.str());
+        return;
+    }
+
+    // Window handed to the parser at once, grows if a block does not fit. The
+    // length field of an SBF block is 16 bits wide, which caps the growth.
+    const std::size_t default_window = 8192;
+    std::size_t window = default_window;
+    // The last window is parsed from a zero-padded copy since the parser may
+    // peek a few bytes past the data it has been given, which must not run off
+    // the end of the mapping
+    std::vector<uint8_t> tail;
+    while (!stopping_ && (to_be_parsed < file_end))
+    {
+        std::size_t remaining = static_cast<std::size_t>(file_end - to_be_parsed);
+        std::size_t buffer_size = std::min(window, remaining);
+        bool last_window = (buffer_size == remaining);
+        const uint8_t* window_start = to_be_parsed;
+        if (last_window)
+        {
+            tail.assign(to_be_parsed, file_end);
+            tail.resize(remaining + 8, 0);
+            window_start = tail.data();
+        }
         try
         {
             node_->log(
                 LogLevel::DEBUG,
                 "Calling read_callback_() method, with number of bytes to be parsed being " +
-                    buffer_size);
-            handlers_.readCallback(node_->getTime(), to_be_parsed, buffer_size);
+                    std::to_string(buffer_size));
+            handlers_.readCallback(node_->getTime(), window_start, buffer_size);
         } catch (std::size_t& parsing_failed_here)
         {
-            if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
+            node_->log(LogLevel::DEBUG, "Parsing_failed_here is " +
+                                            std::to_string(parsing_failed_here));
+            if (last_window)
             {
+                node_->log(LogLevel::WARN,
+                           "Last SBF block of " + file_name + " is truncated");
                 break;
             }
-            to_be_parsed = to_be_parsed + parsing_failed_here;
-            node_->log(LogLevel::DEBUG,
-                       "Parsing_failed_here is " + parsing_failed_here);
+            if (parsing_failed_here == 0)
+            {
+                // The block at the start is longer than the window. It is only
+                // waited for if its CRC holds, otherwise its length field is
+                // corrupt and parsing resyncs one byte further, as for PCAP.
+                std::size_t length =
+                    parsing_utilities::getLength(to_be_parsed);
+                if ((length > window) && (length <= remaining) &&
+                    isValid(to_be_parsed))
+                {
+                    window = length;
+                    continue;
+                }
+                node_->statistics().addSkippedBytes(1);
+                parsing_failed_here = 1;
+            }
+            window = default_window;
+            node_->statistics().addBytes(parsing_failed_here);
+            to_be_parsed += parsing_failed_here;
             continue;
         }
-        if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
-        {
+        window = default_window;
+        node_->statistics().addBytes(buffer_size);
+        to_be_parsed += buffer_size;
+    }
+    node_->log(LogLevel::DEBUG, "Leaving initializeSBFFileReading() method..");
+}
+
+void io_comm_rx::Comm_IO::readCompressedSBFFile(const std::string& file_name)
+{
+    // Neither seeking by index nor cutting into chunks is possible in a
+    // compressed stream
+    if ((settings_->replay_start_time > 0.0) ||
+        (settings_->replay_end_time > 0.0) || settings_->replay_batch)
+        node_->log(LogLevel::WARN, "replay/start_time, replay/end_time and "
+                                   "replay/batch are ignored for compressed "
+                                   "logs such as " +
+                                       file_name);
+
+    // Throws std::runtime_error if the file cannot be opened
+    DecompressingReader reader(file_name);
+    node_->log(LogLevel::DEBUG, "Decompressing " + file_name);
+
+    // Bytes read from the reader at once
+    const std::size_t read_size = 65536;
+    // Holds the bytes not parsed yet, i.e. at most an incomplete SBF block plus
+    // one read. The parser may peek a few bytes past the data it has been
+    // given, hence zero padding is kept behind the data.
+    const std::size_t padding = 8;
+    std::vector<uint8_t> buffer;
+    std::size_t buffered = 0;
+    while (!stopping_)
+    {
+        buffer.resize(buffered + read_size + padding);
+        std::size_t n = reader.read(buffer.data() + buffered, read_size);
+        bool at_end = (n == 0);
+        node_->statistics().addBytes(n);
+        buffered += n;
+        if (buffered == 0)
             break;
+        std::fill(buffer.begin() + buffered, buffer.begin() + buffered + padding,
+                  0);
+
+        std::size_t buffer_size = buffered;
+        try
+        {
+            handlers_.readCallback(node_->getTime(), buffer.data(), buffer_size);
+        } catch (std::size_t& parsing_failed_here)
+        {
+            if (at_end)
+            {
+                node_->log(LogLevel::WARN,
+                           "Last SBF block of " + file_name + " is truncated");
+                break;
+            }
+            // Keep the incomplete SBF block for the next read
+            std::copy(buffer.begin() + parsing_failed_here,
+                      buffer.begin() + buffered, buffer.begin());
+            buffered -= parsing_failed_here;
+            continue;
         }
-        to_be_parsed = to_be_parsed + buffer_size;
+        buffered = 0;
+        if (at_end)
+            break;
     }
-    node_->log(LogLevel::DEBUG, "Leaving initializeSBFFileReading() method..");
+    node_->log(LogLevel::DEBUG, "Leaving readCompressedSBFFile() method..");
 }
 
 void io_comm_rx::Comm_IO::initializePCAPFileReading(std::string file_name)
 {
     node_->log(LogLevel::DEBUG, "Calling initializePCAPFileReading() method..");
-    pcapReader::buffer_t vec_buf;
-    pcapReader::PcapDevice device(node_, vec_buf);
+    pcapReader::PcapDevice device(node_, settings_->pcap_filter);
 
     if (!device.connect(file_name.c_str()))
     {
@@ -1337,43 +1513,44 @@ void io_comm_rx::Comm_IO::initializePCAPFileReading(std::string file_name)
     }
 
     node_->log(LogLevel::INFO, "Reading ...");
-    while (device.isConnected() && device.read() == pcapReader::READ_SUCCESS)
-        ;
-    device.disconnect();
-
-    std::size_t buffer_size = pcapReader::PcapDevice::BUFFSIZE;
-    uint8_t* to_be_parsed = new uint8_t[buffer_size];
-    to_be_parsed = vec_buf.data();
-
-    while (!stopping_) // Loop will stop if we are done reading the SBF file
+    // Packets are released relative to the wall clock time at which the first
+    // one was read, so that processing time does not accumulate as drift
+    bool pace_by_packets = (settings_->pcap_pacing == "packet");
+    ReplayClock replay_clock(settings_->replay_rate);
+    while (!stopping_ && device.isConnected())
     {
-        try
-        {
-            node_->log(
-                LogLevel::DEBUG,
-                "Calling read_callback_() method, with number of bytes to be parsed being " +
-                    buffer_size);
-            handlers_.readCallback(node_->getTime(), to_be_parsed, buffer_size);
-        } catch (std::size_t& parsing_failed_here)
-        {
-            if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
+        if (device.read() != pcapReader::READ_SUCCESS)
+            break;
+        if (pace_by_packets && (device.lastPacketTime() != 0))
+            replay_clock.sleepUntil(device.lastPacketTime());
+
+        // Each TCP flow is parsed as a stream of its own, which holds only the
+        // payload not parsed yet, i.e. at most an incomplete SBF block plus one
+        // packet
+        while (pcapReader::buffer_t* stream = device.nextStream())
+        {
+            if (stream->empty())
+                continue;
+            std::size_t buffer_size = stream->size();
+            std::size_t parsed = buffer_size;
+            try
             {
-                break;
+                handlers_.readCallback(node_->getTime(), stream->data(),
+                                       buffer_size);
+            } catch (std::size_t& parsing_failed_here)
+            {
+                // Keep the incomplete SBF block for the next packets, unless it
+                // is longer than any block can be, i.e. its length field is
+                // corrupt
+                parsed = parsing_failed_here;
+                if ((parsed == 0) && (stream->size() > 65535))
+                    parsed = 1;
             }
-            if (!parsing_failed_here)
-                parsing_failed_here = 1;
-
-            to_be_parsed = to_be_parsed + parsing_failed_here;
-            node_->log(LogLevel::DEBUG,
-                       "Parsing_failed_here is " + parsing_failed_here);
-            continue;
-        }
-        if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
-        {
-            break;
+            node_->statistics().addBytes(parsed);
+            stream->erase(stream->begin(), stream->begin() + parsed);
         }
-        to_be_parsed = to_be_parsed + buffer_size;
     }
+    device.disconnect();
     node_->log(LogLevel::DEBUG, "Leaving initializePCAPFileReading() method..");
 }
 
@@ -1385,8 +1562,9 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
     baudrate_ = baudrate;
     // The io_context, of which io_service is a typedef of; it represents your
     // program's link to the operating system's I/O services.
-    boost::shared_ptr<boost::asio::io_service> io_service(
-        new boost::asio::io_service);
+    boost::shared_ptr<boost::asio::io_service> io_service =
+        shared_io_service_ ? shared_io_service_
+                           : boost::make_shared<boost::asio::io_service>();
     // To perform I/O operations the program needs an I/O object, here "serial".
     boost::shared_ptr<boost::asio::serial_port> serial(
         new boost::asio::serial_port(*io_service));
@@ -1455,8 +1633,14 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
         return false;
     }
     node_->log(LogLevel::DEBUG, "Creating new Async-Manager object..");
+    DropPolicy queue_policy = DropPolicy::BLOCK;
+    ParseQueue::toPolicy(settings_->parse_queue_policy, queue_policy);
+    std::size_t queue_capacity =
+        static_cast<std::size_t>(settings_->parse_queue_capacity) * 1024;
     setManager(boost::shared_ptr<Manager>(
-        new AsyncManager<boost::asio::serial_port>(node_, serial, io_service)));
+        new AsyncManager<boost::asio::serial_port>(
+            node_, serial, io_service, static_cast<bool>(shared_io_service_),
+            queue_policy, queue_capacity)));
 
     // Setting the baudrate, incrementally..
     node_->log(LogLevel::DEBUG,
@@ -1555,6 +1739,15 @@ void io_comm_rx::Comm_IO::setManager(const boost::shared_ptr<Manager>& manager)
     if (manager_)
         return;
     manager_ = manager;
+    if (!settings_->record_directory.empty())
+    {
+        recorder_.reset(new StreamRecorder(
+            node_, settings_->record_directory, settings_->record_prefix,
+            static_cast<uint64_t>(settings_->record_max_file_size) * 1024 * 1024,
+            settings_->record_max_file_duration));
+        node_->configureThread(recorder_->nativeHandle(), "recorder");
+        manager_->setRecorder(recorder_.get());
+    }
     manager_->setCallback(boost::bind(&CallbackHandlers::readCallback, &handlers_,
                                       bp::_1, bp::_2, bp::_3));
     node_->log(LogLevel::DEBUG, "Leaving setManager() method");
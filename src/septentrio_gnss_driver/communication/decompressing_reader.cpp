@@ -0,0 +1,326 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/decompressing_reader.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef WITH_COMPRESSION
+#include <zlib.h>
+#include <zstd.h>
+#endif
+
+/**
+ * @file decompressing_reader.cpp
+ * @brief Defines a class that reads gzip or zstd compressed files as a stream
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Size of the compressed input read at once
+    static const std::size_t COMPRESSED_READ_SIZE = 256 * 1024;
+
+    //! Read function of the FILE returned by openStream()
+    static ssize_t readStream(void* cookie, char* buf, std::size_t size)
+    {
+        try
+        {
+            DecompressingReader* reader = static_cast<DecompressingReader*>(cookie);
+            return static_cast<ssize_t>(
+                reader->read(reinterpret_cast<uint8_t*>(buf), size));
+        } catch (std::runtime_error&)
+        {
+            errno = EIO;
+            return -1;
+        }
+    }
+
+    //! Close function of the FILE returned by openStream(), the reader stays open
+    static int closeStream(void*) { return 0; }
+
+    DecompressingReader::DecompressingReader(const std::string& file_name,
+                                             std::size_t chunk_size,
+                                             std::size_t max_chunks) :
+        chunk_size_(chunk_size),
+        max_chunks_(std::max<std::size_t>(max_chunks, 1))
+    {
+        file_ = std::fopen(file_name.c_str(), "rb");
+        if (!file_)
+            throw std::runtime_error("Could not open " + file_name + ": " +
+                                     std::strerror(errno));
+        uint8_t magic[4] = {0, 0, 0, 0};
+        std::size_t n = std::fread(magic, 1, sizeof(magic), file_);
+        std::rewind(file_);
+        if ((n >= 2) && (magic[0] == 0x1F) && (magic[1] == 0x8B))
+            format_ = GZIP;
+        else if ((n == 4) && (magic[0] == 0x28) && (magic[1] == 0xB5) &&
+                 (magic[2] == 0x2F) && (magic[3] == 0xFD))
+            format_ = ZSTD;
+        else
+        {
+            std::fclose(file_);
+            throw std::runtime_error(file_name +
+                                     " is neither gzip nor zstd compressed");
+        }
+#ifndef WITH_COMPRESSION
+        std::fclose(file_);
+        throw std::runtime_error(file_name +
+                                 " is compressed, but the driver was built "
+                                 "without WITH_COMPRESSION");
+#endif
+        thread_ = std::thread(&DecompressingReader::run, this);
+    }
+
+    DecompressingReader::~DecompressingReader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        std::fclose(file_);
+    }
+
+    bool DecompressingReader::isCompressed(const std::string& file_name)
+    {
+        auto endsWith = [&file_name](const std::string& suffix) {
+            return (file_name.size() >= suffix.size()) &&
+                   (file_name.compare(file_name.size() - suffix.size(),
+                                      suffix.size(), suffix) == 0);
+        };
+        return endsWith(".gz") || endsWith(".zst");
+    }
+
+    std::size_t DecompressingReader::read(uint8_t* data, std::size_t size)
+    {
+        std::size_t copied = 0;
+        while (copied < size)
+        {
+            if (current_pos_ == current_.size())
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return !chunks_.empty() || finished_; });
+                if (chunks_.empty())
+                {
+                    // Bytes decompressed before an error are handed out first
+                    if ((copied == 0) && !error_.empty())
+                        throw std::runtime_error(error_);
+                    return copied;
+                }
+                current_ = std::move(chunks_.front());
+                chunks_.pop_front();
+                current_pos_ = 0;
+                lock.unlock();
+                cv_.notify_all();
+            }
+            std::size_t n = std::min(size - copied, current_.size() - current_pos_);
+            std::memcpy(data + copied, current_.data() + current_pos_, n);
+            copied += n;
+            current_pos_ += n;
+        }
+        return copied;
+    }
+
+    FILE* DecompressingReader::openStream()
+    {
+        cookie_io_functions_t functions = {readStream, nullptr, nullptr,
+                                           closeStream};
+        return fopencookie(this, "r", functions);
+    }
+
+    void DecompressingReader::run()
+    {
+        std::string error = (format_ == GZIP) ? inflateGzip() : decompressZstd();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = error;
+            finished_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool DecompressingReader::push(std::vector<uint8_t>&& chunk)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock,
+                 [this]() { return stopping_ || (chunks_.size() < max_chunks_); });
+        if (stopping_)
+            return false;
+        chunks_.push_back(std::move(chunk));
+        lock.unlock();
+        cv_.notify_all();
+        return true;
+    }
+
+#ifdef WITH_COMPRESSION
+    std::string DecompressingReader::inflateGzip()
+    {
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        // 32 enables detection of the gzip header
+        if (inflateInit2(&stream, 15 + 32) != Z_OK)
+            return "Could not initialize gzip decompression";
+
+        std::vector<uint8_t> in(COMPRESSED_READ_SIZE);
+        std::vector<uint8_t> out(chunk_size_);
+        stream.next_out = out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        std::string error;
+        bool member_ended = false;
+        while (true)
+        {
+            if (stream.avail_in == 0)
+            {
+                std::size_t n = std::fread(in.data(), 1, in.size(), file_);
+                if (n == 0)
+                {
+                    if (std::ferror(file_))
+                        error = "Could not read compressed file";
+                    else if (!member_ended)
+                        error = "Compressed file is truncated";
+                    break;
+                }
+                stream.next_in = in.data();
+                stream.avail_in = static_cast<uInt>(n);
+            }
+            member_ended = false;
+            int ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END)
+            {
+                // Another gzip member may follow
+                member_ended = true;
+                inflateReset(&stream);
+            } else if ((ret != Z_OK) && (ret != Z_BUF_ERROR))
+            {
+                error = std::string("gzip decompression failed: ") +
+                        (stream.msg ? stream.msg : "unknown error");
+                break;
+            }
+            if (stream.avail_out == 0)
+            {
+                if (!push(std::move(out)))
+                    break;
+                out.assign(chunk_size_, 0);
+                stream.next_out = out.data();
+                stream.avail_out = static_cast<uInt>(out.size());
+            }
+        }
+        out.resize(out.size() - stream.avail_out);
+        if (!out.empty())
+            push(std::move(out));
+        inflateEnd(&stream);
+        return error;
+    }
+
+    std::string DecompressingReader::decompressZstd()
+    {
+        ZSTD_DStream* stream = ZSTD_createDStream();
+        if (!stream || ZSTD_isError(ZSTD_initDStream(stream)))
+        {
+            ZSTD_freeDStream(stream);
+            return "Could not initialize zstd decompression";
+        }
+
+        std::vector<uint8_t> in(
+            std::max(ZSTD_DStreamInSize(), COMPRESSED_READ_SIZE));
+        std::vector<uint8_t> out(chunk_size_);
+        ZSTD_outBuffer output = {out.data(), out.size(), 0};
+        std::string error;
+        // 0 once a frame is complete, else a hint of the input still expected
+        std::size_t remaining = 0;
+        bool stopped = false;
+        // Decompresses the input, and whatever the decoder still holds back if
+        // the output was full
+        auto decompress = [&](ZSTD_inBuffer& input) {
+            bool output_full;
+            do
+            {
+                remaining = ZSTD_decompressStream(stream, &output, &input);
+                if (ZSTD_isError(remaining))
+                {
+                    error = std::string("zstd decompression failed: ") +
+                            ZSTD_getErrorName(remaining);
+                    return false;
+                }
+                output_full = (output.pos == output.size);
+                if (output_full)
+                {
+                    if (!push(std::move(out)))
+                    {
+                        stopped = true;
+                        return false;
+                    }
+                    out.assign(chunk_size_, 0);
+                    output = {out.data(), out.size(), 0};
+                }
+            } while ((input.pos < input.size) || output_full);
+            return true;
+        };
+        while (true)
+        {
+            std::size_t n = std::fread(in.data(), 1, in.size(), file_);
+            if (n == 0)
+            {
+                if (std::ferror(file_))
+                    error = "Could not read compressed file";
+                else if (remaining != 0)
+                    error = "Compressed file is truncated";
+                break;
+            }
+            ZSTD_inBuffer input = {in.data(), n, 0};
+            if (!decompress(input))
+                break;
+        }
+        if (!stopped)
+        {
+            out.resize(output.pos);
+            if (!out.empty())
+                push(std::move(out));
+        }
+        ZSTD_freeDStream(stream);
+        return error;
+    }
+#else
+    std::string DecompressingReader::inflateGzip()
+    {
+        return "Built without gzip support";
+    }
+
+    std::string DecompressingReader::decompressZstd()
+    {
+        return "Built without zstd support";
+    }
+#endif
+} // namespace io_comm_rx
@@ -0,0 +1,140 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/latency_estimator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @file latency_estimator.cpp
+ * @brief Defines the estimator of the transport latency of SBF blocks
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Weight of a new sample in the robust track
+    static const double TRACK_WEIGHT = 0.05;
+    //! Innovations are clipped to this multiple of the mean absolute deviation
+    static const double TRACK_CLIP = 3.0;
+    //! Lower bound of the deviation used for clipping in seconds
+    static const double TRACK_MIN_DEVIATION = 1e-4;
+    //! Weight by which the baseline rises per sample towards the estimate
+    static const double BASELINE_RISE = 1e-4;
+
+    void RobustTrack::update(double x)
+    {
+        ++count_;
+        if (count_ == 1)
+        {
+            estimate_ = x;
+            return;
+        }
+        double innovation = x - estimate_;
+        double limit = TRACK_CLIP * std::max(deviation_, TRACK_MIN_DEVIATION);
+        double clipped = std::max(-limit, std::min(innovation, limit));
+        estimate_ += TRACK_WEIGHT * clipped;
+        // A lasting step lets the deviation and thus the limit grow, such that
+        // the estimate follows it
+        deviation_ += TRACK_WEIGHT * (std::fabs(clipped) - deviation_);
+    }
+
+    LatencyEstimator::LatencyEstimator() :
+        baseline_(std::numeric_limits<double>::infinity())
+    {
+        window_.reserve(WINDOW);
+    }
+
+    void LatencyEstimator::addSample(uint16_t block_number, int64_t latency_ns)
+    {
+        double latency = static_cast<double>(latency_ns) * 1e-9;
+        std::lock_guard<std::mutex> lock(mutex_);
+        overall_.update(latency);
+        blocks_[block_number].update(latency);
+        double estimate = overall_.estimate();
+        if (estimate < baseline_)
+            baseline_ = estimate;
+        else
+            baseline_ += BASELINE_RISE * (estimate - baseline_);
+        if (window_.size() < WINDOW)
+            window_.push_back(latency);
+        else
+            window_[window_pos_] = latency;
+        window_pos_ = (window_pos_ + 1) % WINDOW;
+    }
+
+    void LatencyEstimator::addReportedLatency(uint16_t block_number,
+                                              uint16_t latency)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reported_[block_number].update(latency * 1e-4);
+    }
+
+    void LatencyEstimator::summary(Summary& summary) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        summary.samples = overall_.count();
+        summary.latency = overall_.estimate();
+        summary.deviation = overall_.deviation();
+        summary.baseline = baseline_;
+        if (!window_.empty())
+        {
+            std::vector<double> sorted(window_);
+            std::sort(sorted.begin(), sorted.end());
+            auto quantile = [&sorted](double q) {
+                return sorted[static_cast<std::size_t>(q * (sorted.size() - 1))];
+            };
+            summary.minimum = sorted.front();
+            summary.median = quantile(0.5);
+            summary.percentile90 = quantile(0.9);
+            summary.percentile99 = quantile(0.99);
+            summary.maximum = sorted.back();
+        }
+        summary.blocks.clear();
+        for (const auto& block : blocks_)
+            summary.blocks[block.first] = block.second.estimate();
+        summary.reported.clear();
+        for (const auto& block : reported_)
+            summary.reported[block.first] = block.second.estimate();
+    }
+
+    void LatencyEstimator::reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        overall_ = RobustTrack();
+        blocks_.clear();
+        reported_.clear();
+        baseline_ = std::numeric_limits<double>::infinity();
+        window_.clear();
+        window_pos_ = 0;
+    }
+} // namespace io_comm_rx
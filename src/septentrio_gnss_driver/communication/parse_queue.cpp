@@ -0,0 +1,334 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/parse_queue.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file parse_queue.cpp
+ * @brief Defines the bounded queue between the reading and the parsing thread
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Buffers of popped segments kept for reuse at most
+    static const std::size_t MAX_SPARE_BUFFERS = 256;
+    //! Minimum interval between warnings about dropped data
+    static const std::chrono::seconds WARNING_INTERVAL(10);
+
+    ParseQueue::ParseQueue(LogSink* logger, RxStatistics* statistics,
+                           std::size_t capacity, DropPolicy policy) :
+        logger_(logger),
+        statistics_(statistics), capacity_(capacity), policy_(policy),
+        framer_(logger)
+    {
+        statistics_->setBufferCapacity(capacity_);
+        last_warning_ = std::chrono::steady_clock::now() - WARNING_INTERVAL;
+    }
+
+    bool ParseQueue::toPolicy(const std::string& name, DropPolicy& policy)
+    {
+        if (name == "block")
+            policy = DropPolicy::BLOCK;
+        else if (name == "drop_oldest")
+            policy = DropPolicy::DROP_OLDEST;
+        else if (name == "drop_low_priority")
+            policy = DropPolicy::DROP_LOW_PRIORITY;
+        else
+            return false;
+        return true;
+    }
+
+    bool ParseQueue::isNavigation(uint16_t block_number)
+    {
+        switch (block_number)
+        {
+        case 4006: // PVTCartesian
+        case 4007: // PVTGeodetic
+        case 4028: // BaseVectorGeod
+        case 4043: // BaseVectorCart
+        case 4050: // ExtSensorMeas
+        case 4225: // INSNavCart
+        case 4226: // INSNavGeod
+        case 5905: // PosCovCartesian
+        case 5906: // PosCovGeodetic
+        case 5907: // VelCovCartesian
+        case 5908: // VelCovGeodetic
+        case 5938: // AttEuler
+        case 5939: // AttCovEuler
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool ParseQueue::push(uint64_t recv_time, const uint8_t* data,
+                          std::size_t size)
+    {
+        if (size == 0)
+            return true;
+        const uint8_t* buffer = data;
+        std::size_t count = size;
+        std::size_t staged = size;
+        bool carried = !carry_.empty();
+        if (policy_ != DropPolicy::BLOCK)
+        {
+            // An incomplete frame is completed by the bytes of this read
+            if (carried)
+            {
+                carry_.insert(carry_.end(), data, data + size);
+                buffer = carry_.data();
+                count = carry_.size();
+            }
+            staged = frame(buffer, count);
+        } else
+        {
+            staged_.clear();
+            staged_.push_back(Staged{0, size, epoch_, Priority::UNFRAMED});
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if ((policy_ == DropPolicy::BLOCK) && (size_ > 0) &&
+                (size_ + size > capacity_))
+            {
+                statistics_->addBlockedRead();
+                not_full_.wait(lock, [this, size]() {
+                    return closed_ || (size_ == 0) || (size_ + size <= capacity_);
+                });
+            }
+            if (closed_)
+                return false;
+            ++read_;
+            for (const Staged& segment : staged_)
+                enqueue(recv_time, buffer, segment);
+            // A single read larger than the queue is not dropped with BLOCK
+            while ((policy_ != DropPolicy::BLOCK) && (size_ > capacity_) &&
+                   dropOne())
+                ;
+            statistics_->updateBufferLevel(size_);
+        }
+        if (!staged_.empty())
+            not_empty_.notify_one();
+
+        if (carried)
+            carry_.erase(carry_.begin(), carry_.begin() + staged);
+        else
+            carry_.assign(buffer + staged, buffer + count);
+        return true;
+    }
+
+    bool ParseQueue::pop(std::vector<uint8_t>& data, uint64_t& recv_time,
+                         std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!not_empty_.wait_for(lock, timeout, [this]() {
+                return closed_ || !segments_.empty();
+            }) ||
+            closed_)
+            return false;
+        recv_time = segments_.front().recv_time;
+        uint64_t read = segments_.front().read;
+        while (!segments_.empty() && (segments_.front().read == read))
+        {
+            Segment& segment = segments_.front();
+            data.insert(data.end(), segment.bytes.begin(), segment.bytes.end());
+            size_ -= segment.bytes.size();
+            if (spare_.size() < MAX_SPARE_BUFFERS)
+                spare_.push_back(std::move(segment.bytes));
+            segments_.pop_front();
+        }
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void ParseQueue::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    std::size_t ParseQueue::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    std::size_t ParseQueue::frame(const uint8_t* data, std::size_t size)
+    {
+        staged_.clear();
+        const uint8_t* next = data;
+        std::size_t count = size;
+        Frame frame;
+        while (true)
+        {
+            const uint8_t* start = next;
+            bool found = framer_.next(next, count, frame);
+            const uint8_t* end = found ? frame.data : next;
+            if (end > start)
+                stageUnframed(start - data, end - start);
+            if (!found)
+                break;
+            Staged segment;
+            segment.offset = frame.data - data;
+            segment.size = frame.size;
+            if (frame.type == FrameType::SBF)
+            {
+                uint32_t tow = parsing_utilities::getTow(frame.data);
+                if (tow != tow_)
+                {
+                    tow_ = tow;
+                    ++epoch_;
+                }
+                segment.priority =
+                    isNavigation(parsing_utilities::getId(frame.data))
+                        ? Priority::NAVIGATION
+                        : Priority::LOW;
+            } else
+            {
+                // Position fixes, e.g. $GPGGA, unlike satellite information
+                bool position = (frame.size > 6) &&
+                                ((std::memcmp(frame.data + 3, "GGA", 3) == 0) ||
+                                 (std::memcmp(frame.data + 3, "RMC", 3) == 0));
+                segment.priority =
+                    position ? Priority::NAVIGATION : Priority::LOW;
+            }
+            segment.epoch = epoch_;
+            staged_.push_back(segment);
+        }
+        // The Framer keeps a last byte that could start a frame, yet only $
+        // can, e.g. not the end of a command prompt
+        if ((count == 1) && (*next != '$'))
+        {
+            stageUnframed(next - data, 1);
+            ++next;
+        }
+        return next - data;
+    }
+
+    void ParseQueue::stageUnframed(std::size_t offset, std::size_t size)
+    {
+        if (!staged_.empty() && (staged_.back().priority == Priority::UNFRAMED) &&
+            (staged_.back().offset + staged_.back().size == offset))
+            staged_.back().size += size;
+        else
+            staged_.push_back(Staged{offset, size, epoch_, Priority::UNFRAMED});
+    }
+
+    void ParseQueue::enqueue(uint64_t recv_time, const uint8_t* data,
+                             const Staged& staged)
+    {
+        segments_.emplace_back();
+        Segment& segment = segments_.back();
+        segment.recv_time = recv_time;
+        segment.read = read_;
+        segment.epoch = staged.epoch;
+        segment.priority = staged.priority;
+        if (!spare_.empty())
+        {
+            segment.bytes = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        segment.bytes.assign(data + staged.offset,
+                             data + staged.offset + staged.size);
+        size_ += staged.size;
+    }
+
+    bool ParseQueue::dropOne()
+    {
+        if (segments_.empty())
+            return false;
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_warning_ >= WARNING_INTERVAL)
+        {
+            last_warning_ = now;
+            logger_->log(LogLevel::WARN,
+                         "Parser falls behind, dropping data from the full "
+                         "parse queue, see the dropped frames in the runtime "
+                         "statistics.");
+        }
+        if (policy_ == DropPolicy::DROP_LOW_PRIORITY)
+        {
+            for (auto it = segments_.begin(); it != segments_.end(); ++it)
+            {
+                if (it->priority == Priority::LOW)
+                {
+                    drop(it);
+                    return true;
+                }
+            }
+        }
+        if (dropOldestEpoch())
+            return true;
+        // Only bytes outside of frames are left
+        drop(segments_.begin());
+        return true;
+    }
+
+    bool ParseQueue::dropOldestEpoch()
+    {
+        auto oldest = std::find_if(
+            segments_.begin(), segments_.end(),
+            [](const Segment& segment) {
+                return segment.priority != Priority::UNFRAMED;
+            });
+        if (oldest == segments_.end())
+            return false;
+        uint64_t epoch = oldest->epoch;
+        for (auto it = oldest; it != segments_.end();)
+        {
+            if ((it->priority != Priority::UNFRAMED) && (it->epoch == epoch))
+                it = drop(it);
+            else
+                ++it;
+        }
+        return true;
+    }
+
+    std::deque<ParseQueue::Segment>::iterator
+    ParseQueue::drop(std::deque<Segment>::iterator it)
+    {
+        size_ -= it->bytes.size();
+        statistics_->addQueueDrop(it->bytes.size(),
+                                  it->priority == Priority::NAVIGATION);
+        if (spare_.size() < MAX_SPARE_BUFFERS)
+            spare_.push_back(std::move(it->bytes));
+        return segments_.erase(it);
+    }
+} // namespace io_comm_rx
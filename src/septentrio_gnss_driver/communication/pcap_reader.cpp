@@ -30,12 +30,21 @@
 
 #include "septentrio_gnss_driver/communication/pcap_reader.hpp"
 
-#include <chrono>
-#include <net/ethernet.h>
-#include <netinet/ip.h>
-#include <netinet/tcp.h>
+#include <algorithm>
+#include <cstring>
+#include <netinet/in.h>
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
-#include <thread>
+
+// Link types missing in the headers of older libpcap versions
+#ifndef DLT_IPV4
+#define DLT_IPV4 228
+#endif
+#ifndef DLT_IPV6
+#define DLT_IPV6 229
+#endif
+#ifndef DLT_LINUX_SLL2
+#define DLT_LINUX_SLL2 276
+#endif
 
 /**
  * @file pcap_reader.cpp
@@ -44,14 +53,26 @@
  *
  * @brief Implements auxiliary reader object for handling pcap files.
  *
- * Functions include connecting to the file, reading the contents to the
- * specified data buffer and graceful exit.
+ * Functions include connecting to the file, reassembling the TCP payload and
+ * graceful exit.
  */
 
 namespace pcapReader {
 
-    PcapDevice::PcapDevice(ROSaicNodeBase* node, buffer_t& buffer) :
-        node_(node), m_dataBuff{buffer}
+    //! Reads a big-endian 16 bit integer
+    static uint16_t readBe16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+
+    //! Reads a big-endian 32 bit integer
+    static uint32_t readBe32(const uint8_t* data)
+    {
+        return (static_cast<uint32_t>(readBe16(data)) << 16) | readBe16(data + 2);
+    }
+
+    PcapDevice::PcapDevice(ROSaicNodeBase* node, const std::string& filter) :
+        node_(node), m_filter(filter), m_reassembler(node)
     {
     }
 
@@ -61,15 +82,73 @@ namespace pcapReader {
     {
         if (isConnected())
             return true;
-        // Try to open pcap file
-        if ((m_device = pcap_open_offline(device, m_errBuff)) == nullptr)
+        // Try to open pcap file, compressed captures are decompressed on a thread
+        // of their own
+        if (io_comm_rx::DecompressingReader::isCompressed(device))
+        {
+            try
+            {
+                m_reader.reset(new io_comm_rx::DecompressingReader(device));
+            } catch (std::runtime_error& e)
+            {
+                node_->log(LogLevel::ERROR, e.what());
+                return false;
+            }
+            FILE* stream = m_reader->openStream();
+            if (stream)
+            {
+                m_device = pcap_fopen_offline(stream, m_errBuff);
+                if (!m_device)
+                    std::fclose(stream);
+            }
+            if (!m_device)
+            {
+                m_reader.reset();
+                return false;
+            }
+        } else if ((m_device = pcap_open_offline(device, m_errBuff)) == nullptr)
             return false;
 
         m_deviceName = (char*)device;
-        // Try to compile filter program
-        if (pcap_compile(m_device, &m_pktFilter, "tcp dst port 3001", 1,
-                         PCAP_NETMASK_UNKNOWN) != 0)
+        // Try to compile and apply filter program
+        if ((pcap_compile(m_device, &m_pktFilter, m_filter.c_str(), 1,
+                          PCAP_NETMASK_UNKNOWN) != 0) ||
+            (pcap_setfilter(m_device, &m_pktFilter) != 0))
+        {
+            node_->log(LogLevel::ERROR, "Invalid pcap filter \"" + m_filter +
+                                            "\": " + pcap_geterr(m_device));
+            pcap_freecode(&m_pktFilter);
+            pcap_close(m_device);
+            m_device = nullptr;
+            m_reader.reset();
+            return false;
+        }
+        pcap_freecode(&m_pktFilter);
+
+        m_linkType = pcap_datalink(m_device);
+        switch (m_linkType)
+        {
+        case DLT_EN10MB:
+        case DLT_LINUX_SLL:
+        case DLT_LINUX_SLL2:
+        case DLT_NULL:
+        case DLT_LOOP:
+        case DLT_RAW:
+        case DLT_IPV4:
+        case DLT_IPV6:
+            break;
+        default:
+        {
+            const char* name = pcap_datalink_val_to_name(m_linkType);
+            node_->log(LogLevel::ERROR,
+                       "Unsupported link type " +
+                           std::string(name ? name : std::to_string(m_linkType)));
+            pcap_close(m_device);
+            m_device = nullptr;
+            m_reader.reset();
             return false;
+        }
+        }
 
         node_->log(LogLevel::INFO, "Connected to" + std::string(m_deviceName));
         return true;
@@ -82,6 +161,7 @@ namespace pcapReader {
 
         pcap_close(m_device);
         m_device = nullptr;
+        m_reader.reset();
         node_->log(LogLevel::INFO, "Disconnected from " + std::string(m_deviceName));
     }
 
@@ -100,87 +180,22 @@ namespace pcapReader {
 
         if (result >= 0)
         {
-            auto ipHdr =
-                reinterpret_cast<const iphdr*>(pktData + sizeof(struct ethhdr));
-            uint32_t ipHdrLen = ipHdr->ihl * 4u;
-
-            switch (ipHdr->protocol)
-            {
-            case 6:
-            {
-                if (header->len == 54)
-                {
-                    return READ_SUCCESS;
-                }
-                bool storePkt = true;
-
-                if (!m_lastPkt.empty())
-                {
-                    auto tcpHdr = reinterpret_cast<const tcphdr*>(
-                        pktData + ipHdrLen + sizeof(struct ethhdr));
-
-                    auto lastIpHdr = reinterpret_cast<const iphdr*>(&(m_lastPkt[0]));
-                    uint32_t lastIpHdrLen = lastIpHdr->ihl * 4u;
-                    auto lastTcpHdr = reinterpret_cast<const tcphdr*>(
-                        &(m_lastPkt[0]) + lastIpHdrLen);
-                    uint16_t lastLen =
-                        ntohs(static_cast<uint16_t>(lastIpHdr->tot_len));
-                    uint16_t newLen = ntohs(static_cast<uint16_t>(ipHdr->tot_len));
-                    uint32_t lastSeq = ntohl(lastTcpHdr->seq);
-                    uint32_t newSeq = ntohl(tcpHdr->seq);
-
-                    if (newSeq != lastSeq)
-                    {
-                        uint32_t dataOffset = lastTcpHdr->doff * 4;
-                        m_dataBuff.insert(m_dataBuff.end(),
-                                          m_lastPkt.begin() + lastIpHdrLen +
-                                              dataOffset,
-                                          m_lastPkt.end());
-                    } else if (newLen <= lastLen)
-                    {
-                        storePkt = false;
-                    }
-                }
-
-                if (storePkt)
-                {
-                    m_lastPkt.clear();
-                    m_lastPkt.insert(m_lastPkt.end(),
-                                     pktData + sizeof(struct ethhdr),
-                                     pktData + header->len);
-                }
-                break;
-            }
-
-            default:
-            {
-                node_->log(LogLevel::ERROR,
-                           "Skipping protocol: " + std::to_string(result));
-                return READ_ERROR;
-            }
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
+            m_lastPktTime =
+                static_cast<Timestamp>(header->ts.tv_sec) * 1000000000 +
+                static_cast<Timestamp>(header->ts.tv_usec) * 1000;
+            processPacket(pktData, header->caplen);
             return READ_SUCCESS;
         } else if (result == -2)
         {
             node_->log(LogLevel::INFO,
                        "Done reading from " + std::string(m_deviceName));
-            if (!m_lastPkt.empty())
-            {
-                auto lastIpHdr = reinterpret_cast<const iphdr*>(&(m_lastPkt[0]));
-                uint32_t ipHdrLength = lastIpHdr->ihl * 4u;
-
-                auto lastTcpHdr =
-                    reinterpret_cast<const tcphdr*>(&(m_lastPkt[0]) + ipHdrLength);
-                uint32_t dataOffset = lastTcpHdr->doff * 4u;
-
-                m_dataBuff.insert(m_dataBuff.end(),
-                                  m_lastPkt.begin() + ipHdrLength + dataOffset,
-                                  m_lastPkt.end());
-
-                m_lastPkt.clear();
-            }
+            m_reassembler.flush();
+            if (m_reassembler.gaps() > 0)
+                node_->log(LogLevel::WARN,
+                           std::to_string(m_reassembler.missingBytes()) +
+                               " bytes missing in " +
+                               std::to_string(m_reassembler.gaps()) +
+                               " gaps of the TCP flows");
             disconnect();
             return READ_SUCCESS;
         } else
@@ -189,4 +204,122 @@ namespace pcapReader {
             return READ_ERROR;
         }
     }
-} // namespace pcapReader
\ No newline at end of file
+
+    void PcapDevice::processPacket(const uint8_t* data, std::size_t length)
+    {
+        // Link layer, ethertype 0 if the IP version has to be taken from the
+        // IP header
+        std::size_t offset = 0;
+        uint16_t etherType = 0;
+        switch (m_linkType)
+        {
+        case DLT_EN10MB:
+        {
+            if (length < 14)
+                return;
+            etherType = readBe16(data + 12);
+            offset = 14;
+            // 802.1Q and 802.1ad VLAN tags, possibly stacked
+            while (((etherType == 0x8100) || (etherType == 0x88A8) ||
+                    (etherType == 0x9100)) &&
+                   (length >= offset + 4))
+            {
+                etherType = readBe16(data + offset + 2);
+                offset += 4;
+            }
+            break;
+        }
+        case DLT_LINUX_SLL:
+        {
+            if (length < 16)
+                return;
+            etherType = readBe16(data + 14);
+            offset = 16;
+            break;
+        }
+        case DLT_LINUX_SLL2:
+        {
+            if (length < 20)
+                return;
+            etherType = readBe16(data);
+            offset = 20;
+            break;
+        }
+        case DLT_NULL:
+        case DLT_LOOP:
+        {
+            // Address family in host or network byte order
+            offset = 4;
+            break;
+        }
+        default:
+            break;
+        }
+        if (length <= offset)
+            return;
+        const uint8_t* ip = data + offset;
+        std::size_t ipLength = length - offset;
+        uint8_t ipVersion = ip[0] >> 4;
+        if (etherType == 0)
+            etherType = (ipVersion == 4) ? 0x0800 : 0x86DD;
+
+        TcpFlowKey key;
+        std::size_t ipHdrLen;
+        std::size_t ipTotalLen;
+        if ((etherType == 0x0800) && (ipVersion == 4))
+        {
+            if (ipLength < 20)
+                return;
+            ipHdrLen = (ip[0] & 0x0F) * 4u;
+            ipTotalLen = readBe16(ip + 2);
+            if (ip[9] != IPPROTO_TCP)
+            {
+                node_->log(LogLevel::DEBUG,
+                           "Skipping protocol: " + std::to_string(ip[9]));
+                return;
+            }
+            // More fragments flag or fragment offset
+            if ((readBe16(ip + 6) & 0x3FFF) != 0)
+            {
+                node_->log(LogLevel::DEBUG, "Skipping fragmented IP packet");
+                return;
+            }
+            key.ip_version = 4;
+            std::memcpy(key.src_addr.data(), ip + 12, 4);
+            std::memcpy(key.dst_addr.data(), ip + 16, 4);
+        } else if ((etherType == 0x86DD) && (ipVersion == 6))
+        {
+            if (ipLength < 40)
+                return;
+            // Extension headers are not supported
+            if (ip[6] != IPPROTO_TCP)
+            {
+                node_->log(LogLevel::DEBUG,
+                           "Skipping next header: " + std::to_string(ip[6]));
+                return;
+            }
+            ipHdrLen = 40;
+            ipTotalLen = 40u + readBe16(ip + 4);
+            key.ip_version = 6;
+            std::memcpy(key.src_addr.data(), ip + 8, 16);
+            std::memcpy(key.dst_addr.data(), ip + 24, 16);
+        } else
+            return;
+
+        // The total length excludes Ethernet padding, the captured length may
+        // be shorter if the capture was truncated
+        std::size_t ipEnd = std::min(ipTotalLen, ipLength);
+        if ((ipHdrLen < 20) || (ipEnd < ipHdrLen + 20))
+            return;
+        const uint8_t* tcp = ip + ipHdrLen;
+        std::size_t tcpLength = ipEnd - ipHdrLen;
+        std::size_t dataOffset = (tcp[12] >> 4) * 4u;
+        if ((dataOffset < 20) || (dataOffset > tcpLength))
+            return;
+        key.src_port = readBe16(tcp);
+        key.dst_port = readBe16(tcp + 2);
+        bool syn = (tcp[13] & 0x02) != 0;
+        m_reassembler.addSegment(key, readBe32(tcp + 4), syn, tcp + dataOffset,
+                                 tcpLength - dataOffset);
+    }
+} // namespace pcapReader
@@ -0,0 +1,142 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/realtime.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <malloc.h>
+#include <memory>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @file realtime.cpp
+ * @brief Defines naming, affinity and scheduling of threads and locking of
+ * memory
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+    namespace realtime {
+
+        bool configureThread(pthread_t thread, const std::string& name,
+                             const ThreadSettings& settings, std::string& error)
+        {
+            bool ok = true;
+            // 16 bytes including the terminating null character
+            int res = pthread_setname_np(thread, name.substr(0, 15).c_str());
+            // A short-lived thread, e.g. connecting, may already have finished
+            if ((res == ENOENT) || (res == ESRCH))
+                return true;
+            if (res != 0)
+            {
+                error += "name: " + std::string(std::strerror(res)) + ". ";
+                ok = false;
+            }
+
+            if (!settings.cpus.empty())
+            {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                for (int32_t cpu : settings.cpus)
+                {
+                    if ((cpu < 0) || (cpu >= CPU_SETSIZE))
+                    {
+                        error += "invalid CPU " + std::to_string(cpu) + ". ";
+                        return false;
+                    }
+                    CPU_SET(cpu, &cpus);
+                }
+                res = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+                if (res != 0)
+                {
+                    error += "affinity: " + std::string(std::strerror(res)) + ". ";
+                    ok = false;
+                }
+            }
+
+            int policy;
+            if (settings.policy == "fifo")
+                policy = SCHED_FIFO;
+            else if (settings.policy == "rr")
+                policy = SCHED_RR;
+            else if (settings.policy == "other")
+                return ok;
+            else
+            {
+                error += "unknown policy " + settings.policy + ". ";
+                return false;
+            }
+            sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = settings.priority;
+            res = pthread_setschedparam(thread, policy, &param);
+            if (res != 0)
+            {
+                error += "scheduling: " + std::string(std::strerror(res)) + ". ";
+                ok = false;
+            }
+            return ok;
+        }
+
+        bool lockMemory(std::size_t prefault_heap, std::string& error)
+        {
+            // Freed memory is kept in the heap instead of being returned to the
+            // system, and large blocks are taken from the heap as well instead of
+            // separate mappings, as either would fault again on reuse
+            mallopt(M_TRIM_THRESHOLD, -1);
+            mallopt(M_MMAP_MAX, 0);
+            if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+            {
+                error = std::strerror(errno);
+                return false;
+            }
+            if (prefault_heap > 0)
+            {
+                std::unique_ptr<uint8_t[]> heap(new uint8_t[prefault_heap]);
+                prefault(heap.get(), prefault_heap);
+            }
+            return true;
+        }
+
+        void prefault(uint8_t* data, std::size_t size)
+        {
+            static const std::size_t page_size =
+                static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            volatile uint8_t* bytes = data;
+            for (std::size_t i = 0; i < size; i += page_size)
+                bytes[i] = bytes[i];
+            if (size > 0)
+                bytes[size - 1] = bytes[size - 1];
+        }
+    } // namespace realtime
+} // namespace io_comm_rx
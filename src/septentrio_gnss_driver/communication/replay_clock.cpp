@@ -0,0 +1,77 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/replay_clock.hpp>
+
+#include <thread>
+
+/**
+ * @file replay_clock.cpp
+ * @brief Defines a clock that paces the replay of logs
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Backward jump of the log time in nanoseconds that re-anchors the clock
+    static const uint64_t REANCHOR_JUMP = 1000000000;
+
+    ReplayClock::ReplayClock(double rate) : rate_(rate) {}
+
+    void ReplayClock::setRate(double rate)
+    {
+        if (rate == rate_)
+            return;
+        rate_ = rate;
+        anchored_ = false;
+    }
+
+    void ReplayClock::sleepUntil(uint64_t log_time)
+    {
+        if (rate_ <= 0.0)
+            return;
+        if (!anchored_ || (log_time + REANCHOR_JUMP < last_log_time_))
+        {
+            anchored_ = true;
+            anchor_log_time_ = log_time;
+            anchor_wall_time_ = std::chrono::steady_clock::now();
+            last_log_time_ = log_time;
+            return;
+        }
+        if (log_time > last_log_time_)
+            last_log_time_ = log_time;
+        if (log_time <= anchor_log_time_)
+            return;
+
+        auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+            static_cast<double>(log_time - anchor_log_time_) / rate_));
+        std::this_thread::sleep_until(anchor_wall_time_ + offset);
+    }
+} // namespace io_comm_rx
@@ -30,7 +30,9 @@
 
 #include <GeographicLib/UTMUPS.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <septentrio_gnss_driver/communication/rx_message.hpp>
+#include <septentrio_gnss_driver/communication/sbf_block_table.hpp>
 #include <thread>
 
 /**
@@ -51,6 +53,155 @@ using parsing_utilities::deg2rad;
 using parsing_utilities::deg2radSq;
 using parsing_utilities::rad2deg;
 
+/**
+ * The rotational sequence convention we adopt here (and Septentrio receivers'
+ * pitch, roll, yaw definition too) is the yaw-pitch-roll sequence, i.e. the
+ * 3-2-1 sequence: The body first does yaw around the Z=Down-axis, then pitches
+ * around the new Y=East=right-axis and finally rolls around the new
+ * X=North=forward-axis.
+ */
+static QuaternionMsg convertEulerToQuaternion(double yaw, double pitch,
+                                              double roll)
+{
+    // Abbreviations for the angular functions
+    double cy = std::cos(yaw * 0.5);
+    double sy = std::sin(yaw * 0.5);
+    double cp = std::cos(pitch * 0.5);
+    double sp = std::sin(pitch * 0.5);
+    double cr = std::cos(roll * 0.5);
+    double sr = std::sin(roll * 0.5);
+
+    QuaternionMsg q;
+    q.w = cr * cp * cy + sr * sp * sy;
+    q.x = sr * cp * cy - cr * sp * sy;
+    q.y = cr * sp * cy + sr * cp * sy;
+    q.z = cr * cp * sy - sr * sp * cy;
+
+    return q;
+}
+
+/**
+ * The NMEA parsers of the protocol core fill plain structs with the field names
+ * of nmea_msgs, which are copied over here.
+ */
+template <typename M>
+static void fillNmeaHeader(const NmeaHeader& header, M& msg)
+{
+    msg.header.stamp = timestampToRos(header.stamp);
+    msg.header.frame_id = header.frame_id;
+}
+
+static GpggaMsg toRosMsg(const Gpgga& gga)
+{
+    GpggaMsg msg;
+    fillNmeaHeader(gga.header, msg);
+    msg.message_id = gga.message_id;
+    msg.utc_seconds = gga.utc_seconds;
+    msg.lat = gga.lat;
+    msg.lon = gga.lon;
+    msg.lat_dir = gga.lat_dir;
+    msg.lon_dir = gga.lon_dir;
+    msg.gps_qual = gga.gps_qual;
+    msg.num_sats = gga.num_sats;
+    msg.hdop = gga.hdop;
+    msg.alt = gga.alt;
+    msg.altitude_units = gga.altitude_units;
+    msg.undulation = gga.undulation;
+    msg.undulation_units = gga.undulation_units;
+    msg.diff_age = gga.diff_age;
+    msg.station_id = gga.station_id;
+    return msg;
+}
+
+static GprmcMsg toRosMsg(const Gprmc& rmc)
+{
+    GprmcMsg msg;
+    fillNmeaHeader(rmc.header, msg);
+    msg.message_id = rmc.message_id;
+    msg.utc_seconds = rmc.utc_seconds;
+    msg.position_status = rmc.position_status;
+    msg.lat = rmc.lat;
+    msg.lon = rmc.lon;
+    msg.lat_dir = rmc.lat_dir;
+    msg.lon_dir = rmc.lon_dir;
+    msg.speed = rmc.speed;
+    msg.track = rmc.track;
+    msg.date = rmc.date;
+    msg.mag_var = rmc.mag_var;
+    msg.mag_var_direction = rmc.mag_var_direction;
+    msg.mode_indicator = rmc.mode_indicator;
+    return msg;
+}
+
+static GpgsaMsg toRosMsg(const Gpgsa& gsa)
+{
+    GpgsaMsg msg;
+    fillNmeaHeader(gsa.header, msg);
+    msg.message_id = gsa.message_id;
+    msg.auto_manual_mode = gsa.auto_manual_mode;
+    msg.fix_mode = gsa.fix_mode;
+    msg.sv_ids = gsa.sv_ids;
+    msg.pdop = gsa.pdop;
+    msg.hdop = gsa.hdop;
+    msg.vdop = gsa.vdop;
+    return msg;
+}
+
+static GpgsvMsg toRosMsg(const Gpgsv& gsv)
+{
+    GpgsvMsg msg;
+    fillNmeaHeader(gsv.header, msg);
+    msg.message_id = gsv.message_id;
+    msg.n_msgs = gsv.n_msgs;
+    msg.msg_number = gsv.msg_number;
+    msg.n_satellites = gsv.n_satellites;
+    msg.satellites.resize(gsv.satellites.size());
+    for (std::size_t i = 0; i < gsv.satellites.size(); ++i)
+    {
+        msg.satellites[i].prn = gsv.satellites[i].prn;
+        msg.satellites[i].elevation = gsv.satellites[i].elevation;
+        msg.satellites[i].azimuth = gsv.satellites[i].azimuth;
+        msg.satellites[i].snr = gsv.satellites[i].snr;
+    }
+    return msg;
+}
+
+/**
+ * Messages drawn from a MessagePool still carry the content of their previous use.
+ * The scalar fields are reset to their defaults while the satellite arrays are
+ * only cleared in place, such that they keep their capacity.
+ */
+static void resetRecycled(GPSFixMsg& msg)
+{
+    msg.header.seq = 0;
+    msg.header.stamp = TimestampRos();
+    msg.header.frame_id.clear();
+
+    msg.status.header = msg.header;
+    msg.status.satellites_used = 0;
+    msg.status.satellite_used_prn.clear();
+    msg.status.satellites_visible = 0;
+    msg.status.satellite_visible_prn.clear();
+    msg.status.satellite_visible_z.clear();
+    msg.status.satellite_visible_azimuth.clear();
+    msg.status.satellite_visible_snr.clear();
+    msg.status.status = 0;
+    msg.status.motion_source = 0;
+    msg.status.orientation_source = 0;
+    msg.status.position_source = 0;
+
+    msg.latitude = msg.longitude = msg.altitude = 0.0;
+    msg.track = msg.speed = msg.climb = 0.0;
+    msg.pitch = msg.roll = msg.dip = 0.0;
+    msg.time = 0.0;
+    msg.gdop = msg.pdop = msg.hdop = msg.vdop = msg.tdop = 0.0;
+    msg.err = msg.err_horz = msg.err_vert = 0.0;
+    msg.err_track = msg.err_speed = msg.err_climb = msg.err_time = 0.0;
+    msg.err_pitch = msg.err_roll = msg.err_dip = 0.0;
+    msg.position_covariance.fill(0.0);
+    msg.position_covariance_type = 0;
+}
+
 PoseWithCovarianceStampedMsg
 io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
 {
@@ -67,7 +218,7 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
         double roll = 0.0;
         if (validValue(last_atteuler_.roll))
             roll = last_atteuler_.roll;
-        msg.pose.pose.orientation = parsing_utilities::convertEulerToQuaternion(
+        msg.pose.pose.orientation = convertEulerToQuaternion(
             deg2rad(yaw), deg2rad(pitch), deg2rad(roll));
         msg.pose.pose.position.x = rad2deg(last_pvtgeodetic_.longitude);
         msg.pose.pose.position.y = rad2deg(last_pvtgeodetic_.latitude);
@@ -126,7 +277,7 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
             if (validValue(last_insnavgeod_.roll))
                 roll = last_insnavgeod_.roll;
             // Attitude
-            msg.pose.pose.orientation = parsing_utilities::convertEulerToQuaternion(
+            msg.pose.pose.orientation = convertEulerToQuaternion(
                 deg2rad(yaw), deg2rad(pitch), deg2rad(roll));
         } else
         {
@@ -184,15 +335,19 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
     return msg;
 };
 
-DiagnosticArrayMsg io_comm_rx::RxMessage::DiagnosticArrayCallback()
+DiagnosticArrayMsg::Ptr io_comm_rx::RxMessage::DiagnosticArrayCallback()
 {
-    DiagnosticArrayMsg msg;
-    std::string serialnumber(last_receiversetup_.rx_serial_number);
-    DiagnosticStatusMsg gnss_status;
+    DiagnosticArrayMsg::Ptr msg = diagnosticarray_pool_.acquire();
+    // The status entry of a recycled message is reused, such that its values
+    // vector and strings keep their capacity.
+    msg->status.resize(1);
+    DiagnosticStatusMsg& gnss_status = msg->status[0];
+    gnss_status.level = DiagnosticStatusMsg::OK;
     // Constructing the "level of operation" field
     uint16_t indicators_type_mask = static_cast<uint16_t>(255);
     uint16_t indicators_value_mask = static_cast<uint16_t>(3840);
-    uint16_t qualityind_pos;
+    // No overall quality indicator, if the position stays out of range
+    uint16_t qualityind_pos = static_cast<uint16_t>(last_qualityind_.n);
     for (uint16_t i = static_cast<uint16_t>(0);
          i < last_qualityind_.indicators.size(); ++i)
     {
@@ -223,8 +378,10 @@ DiagnosticArrayMsg io_comm_rx::RxMessage::DiagnosticArrayCallback()
     {
         gnss_status.level = DiagnosticStatusMsg::ERROR;
     }
-    // Creating an array of values associated with the GNSS status
-    gnss_status.values.resize(static_cast<uint16_t>(last_qualityind_.n - 1));
+    // Creating an array of values associated with the GNSS status, room is made
+    // for the indicators and the satellite counts
+    gnss_status.values.resize(static_cast<uint16_t>(last_qualityind_.n) + 2);
+    std::size_t nr_values = 0;
     for (uint16_t i = static_cast<uint16_t>(0);
          i != static_cast<uint16_t>(last_qualityind_.n); ++i)
     {
@@ -232,62 +389,76 @@ DiagnosticArrayMsg io_comm_rx::RxMessage::DiagnosticArrayCallback()
         {
             continue;
         }
+        diagnostic_msgs::KeyValue& value = gnss_status.values[nr_values++];
         if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
             static_cast<uint16_t>(1))
         {
-            gnss_status.values[i].key = "GNSS Signals, Main Antenna";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "GNSS Signals, Main Antenna";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(2))
         {
-            gnss_status.values[i].key = "GNSS Signals, Aux1 Antenna";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "GNSS Signals, Aux1 Antenna";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(11))
         {
-            gnss_status.values[i].key = "RF Power, Main Antenna";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "RF Power, Main Antenna";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(12))
         {
-            gnss_status.values[i].key = "RF Power, Aux1 Antenna";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "RF Power, Aux1 Antenna";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(21))
         {
-            gnss_status.values[i].key = "CPU Headroom";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "CPU Headroom";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(25))
         {
-            gnss_status.values[i].key = "OCXO Stability";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "OCXO Stability";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else if ((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(30))
         {
-            gnss_status.values[i].key = "Base Station Measurements";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "Base Station Measurements";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         } else
         {
             assert((last_qualityind_.indicators[i] & indicators_type_mask) ==
                    static_cast<uint16_t>(31));
-            gnss_status.values[i].key = "RTK Post-Processing";
-            gnss_status.values[i].value = std::to_string(
+            value.key = "RTK Post-Processing";
+            value.value = std::to_string(
                 (last_qualityind_.indicators[i] & indicators_value_mask) >> 8);
         }
     }
-    gnss_status.hardware_id = serialnumber;
+    // Satellite counts from the satellite store, if the blocks are enabled
+    if (satellite_store_.hasMeasEpoch())
+    {
+        diagnostic_msgs::KeyValue& value = gnss_status.values[nr_values++];
+        value.key = "Satellites in Sync";
+        value.value = std::to_string(satellite_store_.numberOfSatellitesInSync());
+    }
+    if (satellite_store_.hasChannelStatus())
+    {
+        diagnostic_msgs::KeyValue& value = gnss_status.values[nr_values++];
+        value.key = "Satellites used in PVT";
+        value.value = std::to_string(satellite_store_.numberOfSatellitesUsed());
+    }
+    gnss_status.values.resize(nr_values);
+    gnss_status.hardware_id = last_receiversetup_.rx_serial_number;
     gnss_status.name = "gnss";
     gnss_status.message =
         "Quality Indicators (from 0 for low quality to 10 for high quality, 15 if unknown)";
-    msg.status.push_back(gnss_status);
     return msg;
 };
 
@@ -330,7 +501,7 @@ ImuMsg io_comm_rx::RxMessage::ImuCallback()
                         validValue(last_insnavgeod_.roll))
                     {
                         msg.orientation =
-                            parsing_utilities::convertEulerToQuaternion(
+                            convertEulerToQuaternion(
                                 deg2rad(last_insnavgeod_.heading),
                                 deg2rad(last_insnavgeod_.pitch),
                                 deg2rad(last_insnavgeod_.roll));
@@ -710,8 +881,7 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
     if ((last_insnavgeod_.sb_list & 2) != 0)
     {
         // Attitude
-        msg.pose.pose.orientation =
-            parsing_utilities::convertEulerToQuaternion(yaw, pitch, roll);
+        msg.pose.pose.orientation = convertEulerToQuaternion(yaw, pitch, roll);
     } else
     {
         msg.pose.pose.orientation.w = std::numeric_limits<double>::quiet_NaN();
@@ -1093,124 +1263,48 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
  * block could provide hundredths of degrees precision. Change if imperative for your
  * application... Definition of "visible satellite" adopted here: We define a visible
  * satellite as being !up to! "in sync" mode with the receiver, which corresponds to
- * last_measepoch_.N (signal-to-noise ratios are thereby available for these), though
+ * MeasEpoch.N (signal-to-noise ratios are thereby available for these), though
  * not last_channelstatus_.N, which also includes those "in search". In case certain
  * values appear unphysical, please consult the firmware, since those most likely
  * refer to Do-Not-Use values.
  */
-GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
+GPSFixMsg::Ptr io_comm_rx::RxMessage::GPSFixCallback()
 {
-    GPSFixMsg msg;
+    GPSFixMsg::Ptr msg_ptr = gpsfix_pool_.acquire();
+    GPSFixMsg& msg = *msg_ptr;
+    resetRecycled(msg);
     msg.status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_.nr_sv);
 
-    // MeasEpoch Processing
-    std::vector<int32_t> cno_tracked;
-    std::vector<int32_t> svid_in_sync;
-    {
-        cno_tracked.reserve(last_measepoch_.type1.size());
-        svid_in_sync.reserve(last_measepoch_.type1.size());
-        for (const auto& measepoch_channel_type1 : last_measepoch_.type1)
-        {
-            // Define MeasEpochChannelType1 struct for the corresponding sub-block
-            svid_in_sync.push_back(
-                static_cast<int32_t>(measepoch_channel_type1.sv_id));
-            uint8_t type_mask =
-                15; // We extract the first four bits using this mask.
-            if (((measepoch_channel_type1.type & type_mask) ==
-                 static_cast<uint8_t>(1)) ||
-                ((measepoch_channel_type1.type & type_mask) ==
-                 static_cast<uint8_t>(2)))
-            {
-                cno_tracked.push_back(
-                    static_cast<int32_t>(measepoch_channel_type1.cn0) / 4);
-            } else
-            {
-                cno_tracked.push_back(
-                    static_cast<int32_t>(measepoch_channel_type1.cn0) / 4 +
-                    static_cast<int32_t>(10));
-            }
-        }
-    }
-
-    // ChannelStatus Processing
-    std::vector<int32_t> svid_in_sync_2;
-    std::vector<int32_t> elevation_tracked;
-    std::vector<int32_t> azimuth_tracked;
-    std::vector<int32_t> svid_pvt;
-    svid_pvt.clear();
-    std::vector<int32_t> ordering;
+    // Satellite information is taken from the satellite store, the arrays follow
+    // the order of the last ChannelStatus block.
+    msg.status.satellites_visible =
+        static_cast<uint16_t>(satellite_store_.numberOfChannelsInSync());
+    const std::vector<ChannelEntry>& channels = satellite_store_.channels();
+    msg.status.satellite_used_prn.reserve(channels.size());
+    msg.status.satellite_visible_prn.reserve(channels.size());
+    msg.status.satellite_visible_z.reserve(channels.size());
+    msg.status.satellite_visible_azimuth.reserve(channels.size());
+    msg.status.satellite_visible_snr.reserve(channels.size());
+    for (const auto& channel : channels)
     {
-        svid_in_sync_2.reserve(last_channelstatus_.satInfo.size());
-        elevation_tracked.reserve(last_channelstatus_.satInfo.size());
-        azimuth_tracked.reserve(last_channelstatus_.satInfo.size());
-        for (const auto& channel_sat_info : last_channelstatus_.satInfo)
+        if (satellite_store_.inSync(channel.svid))
         {
-            bool to_be_added = false;
-            for (int32_t j = 0; j < static_cast<int32_t>(svid_in_sync.size()); ++j)
-            {
-                if (svid_in_sync[j] == static_cast<int32_t>(channel_sat_info.sv_id))
-                {
-                    ordering.push_back(j);
-                    to_be_added = true;
-                    break;
-                }
-            }
-            if (to_be_added)
-            {
-                svid_in_sync_2.push_back(
-                    static_cast<int32_t>(channel_sat_info.sv_id));
-                elevation_tracked.push_back(
-                    static_cast<int32_t>(channel_sat_info.elev));
-                static uint16_t azimuth_mask = 511;
-                azimuth_tracked.push_back(static_cast<int32_t>(
-                    (channel_sat_info.az_rise_set & azimuth_mask)));
-            }
-            svid_pvt.reserve(channel_sat_info.stateInfo.size());
-            for (const auto& channel_state_info : channel_sat_info.stateInfo)
-            {
-                // Define ChannelStateInfo struct for the corresponding sub-block
-                bool pvt_status = false;
-                uint16_t pvt_status_mask = std::pow(2, 15) + std::pow(2, 14);
-                for (int k = 15; k != -1; k -= 2)
-                {
-                    uint16_t pvt_status_value =
-                        (channel_state_info.pvt_status & pvt_status_mask) >> k - 1;
-                    if (pvt_status_value == 2)
-                    {
-                        pvt_status = true;
-                    }
-                    if (k > 1)
-                    {
-                        pvt_status_mask = pvt_status_mask - std::pow(2, k) -
-                                          std::pow(2, k - 1) + std::pow(2, k - 2) +
-                                          std::pow(2, k - 3);
-                    }
-                }
-                if (pvt_status)
-                {
-                    svid_pvt.push_back(static_cast<int32_t>(channel_sat_info.sv_id));
-                }
-            }
+            const SatelliteState& satellite =
+                satellite_store_.satellite(channel.svid);
+            msg.status.satellite_visible_prn.push_back(
+                static_cast<int32_t>(channel.svid));
+            msg.status.satellite_visible_z.push_back(
+                static_cast<int32_t>(satellite.elevation));
+            msg.status.satellite_visible_azimuth.push_back(
+                static_cast<int32_t>(satellite.azimuth));
+            msg.status.satellite_visible_snr.push_back(satellite.cno);
         }
-    }
-    msg.status.satellite_used_prn =
-        svid_pvt; // Entries such as int32[] in ROS messages are to be treated as
-                  // std::vectors.
-    msg.status.satellites_visible = static_cast<uint16_t>(svid_in_sync.size());
-    msg.status.satellite_visible_prn = svid_in_sync_2;
-    msg.status.satellite_visible_z = elevation_tracked;
-    msg.status.satellite_visible_azimuth = azimuth_tracked;
-
-    // Reordering CNO vector to that of all previous arrays
-    std::vector<int32_t> cno_tracked_reordered;
-    if (static_cast<int32_t>(last_channelstatus_.n) != 0)
-    {
-        for (int32_t k = 0; k < static_cast<int32_t>(ordering.size()); ++k)
+        for (uint16_t k = 0; k < channel.pvt_signals; ++k)
         {
-            cno_tracked_reordered.push_back(cno_tracked[ordering[k]]);
+            msg.status.satellite_used_prn.push_back(
+                static_cast<int32_t>(channel.svid));
         }
     }
-    msg.status.satellite_visible_snr = cno_tracked_reordered;
     msg.err_time = 2 * std::sqrt(last_poscovgeodetic_.cov_bb);
 
     if (settings_->septentrio_receiver_type == "gnss")
@@ -1535,7 +1629,7 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         }
         msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
     }
-    return msg;
+    return msg_ptr;
 };
 
 Timestamp io_comm_rx::RxMessage::timestampSBF(const uint8_t* data,
@@ -1547,6 +1641,19 @@ Timestamp io_comm_rx::RxMessage::timestampSBF(const uint8_t* data,
     return timestampSBF(tow, wnc, use_gnss_time);
 }
 
+Timestamp io_comm_rx::RxMessage::gpsTimestamp(uint32_t tow, uint16_t wnc)
+{
+    static uint64_t secToNSec = 1000000000;
+    static uint64_t mSec2NSec = 1000000;
+    static uint64_t nsOfGpsStart =
+        315964800 *
+        secToNSec; // GPS week counter starts at 1980-01-06 which is 315964800
+                   // seconds since Unix epoch (1970-01-01 UTC)
+    static uint64_t nsecPerWeek = 7 * 24 * 60 * 60 * secToNSec;
+
+    return nsOfGpsStart + tow * mSec2NSec + wnc * nsecPerWeek;
+}
+
 /// If the current time shall be employed, it is calculated via the time(NULL)
 /// function found in the \<ctime\> library At the time of writing the code (2020),
 /// the GPS time was ahead of UTC time by 18 (leap) seconds. Adapt the
@@ -1560,18 +1667,15 @@ Timestamp io_comm_rx::RxMessage::timestampSBF(uint32_t tow, uint16_t wnc,
     {
         // conversion from GPS time of week and week number to UTC taking leap
         // seconds into account
-        static uint64_t secToNSec = 1000000000;
-        static uint64_t mSec2NSec = 1000000;
-        static uint64_t nsOfGpsStart =
-            315964800 *
-            secToNSec; // GPS week counter starts at 1980-01-06 which is 315964800
-                       // seconds since Unix epoch (1970-01-01 UTC)
-        static uint64_t nsecPerWeek = 7 * 24 * 60 * 60 * secToNSec;
-
-        time_obj = nsOfGpsStart + tow * mSec2NSec + wnc * nsecPerWeek;
+        time_obj = gpsTimestamp(tow, wnc);
 
         if (current_leap_seconds_ != -128)
-            time_obj -= current_leap_seconds_ * secToNSec;
+            time_obj -= static_cast<int64_t>(current_leap_seconds_) * 1000000000;
+    } else if (clock_model_.valid() && validValue(tow) && validValue(wnc))
+    {
+        // GNSS time in the host clock, free of the jitter of the delivery and of
+        // blocks parsed from one read sharing their receive time
+        time_obj = clock_model_.toHost(gpsTimestamp(tow, wnc));
     } else
     {
         time_obj = recvTimestamp_;
@@ -1586,7 +1690,7 @@ bool io_comm_rx::RxMessage::found()
 
     // Verify header bytes
     if (!this->isSBF() && !this->isNMEA() && !this->isResponse() &&
-        !(g_read_cd && this->isConnectionDescriptor()))
+        !(readCd() && this->isConnectionDescriptor()))
     {
         return false;
     }
@@ -1597,19 +1701,28 @@ bool io_comm_rx::RxMessage::found()
 
 const uint8_t* io_comm_rx::RxMessage::search()
 {
+    // NMEA messages and command replies are only jumped over by one byte, the
+    // rest of them and the trailing <CR><LF> are not counted as skipped
+    std::size_t message_rest = 0;
     if (found_)
     {
+        if (this->isNMEA() || this->isResponse())
+            message_rest = this->messageSize() + 1;
         next();
     }
+    const uint8_t* start = data_;
     // Search for message or a response header
     for (; count_ > 0; --count_, ++data_)
     {
         if (this->isSBF() || this->isNMEA() || this->isResponse() ||
-            (g_read_cd && this->isConnectionDescriptor()))
+            (readCd() && this->isConnectionDescriptor()))
         {
             break;
         }
     }
+    std::size_t scanned = static_cast<std::size_t>(data_ - start);
+    if (scanned > message_rest)
+        node_->statistics().addSkippedBytes(scanned - message_rest);
     found_ = true;
     return data_;
 }
@@ -1721,6 +1834,37 @@ bool io_comm_rx::RxMessage::isNMEA()
     }
 }
 
+bool io_comm_rx::RxMessage::isValidNMEA()
+{
+    std::size_t size = this->messageSize();
+    // Not yet complete
+    if (size >= count_)
+        return true;
+    const uint8_t* end = data_ + size;
+    const uint8_t* star = std::find(data_, end, '*');
+    if (star == end)
+        return true;
+    if (end - star < 3)
+        return false;
+    uint8_t checksum = 0;
+    for (const uint8_t* it = data_ + 1; it != star; ++it)
+        checksum ^= *it;
+    int32_t transmitted = 0;
+    for (const uint8_t* it = star + 1; it != star + 3; ++it)
+    {
+        transmitted <<= 4;
+        if ((*it >= '0') && (*it <= '9'))
+            transmitted |= *it - '0';
+        else if ((*it >= 'A') && (*it <= 'F'))
+            transmitted |= *it - 'A' + 10;
+        else if ((*it >= 'a') && (*it <= 'f'))
+            transmitted |= *it - 'a' + 10;
+        else
+            return false;
+    }
+    return transmitted == checksum;
+}
+
 bool io_comm_rx::RxMessage::isResponse()
 {
     if (count_ >= 2)
@@ -1824,11 +1968,12 @@ void io_comm_rx::RxMessage::next()
     if (found())
     {
         if (this->isNMEA() || this->isResponse() ||
-            (g_read_cd && this->isConnectionDescriptor()))
+            (readCd() && this->isConnectionDescriptor()))
         {
-            if (g_read_cd && this->isConnectionDescriptor() && g_cd_count == 2)
+            if (readCd() && this->isConnectionDescriptor() &&
+                connection_->cd_count == 2)
             {
-                g_read_cd = false;
+                connection_->read_cd = false;
             }
             jump_size = static_cast<uint32_t>(1);
         }
@@ -1857,6 +2002,19 @@ void io_comm_rx::RxMessage::next()
     return; // For readability
 }
 
+/**
+ * The CRC is checked as in read(), such that a block with corrupt length field
+ * is not jumped over, but left to read() and the resync of search().
+ */
+bool io_comm_rx::RxMessage::skipBlock()
+{
+    crc_check_ = isValid(data_);
+    if (!crc_check_)
+        return false;
+    next();
+    return true;
+}
+
 /**
  * If GNSS time is used, Publishing is only done with valid leap seconds
  */
@@ -1867,9 +2025,12 @@ void io_comm_rx::RxMessage::publish(const std::string& topic, const M& msg)
     if (!settings_->use_gnss_time ||
         (settings_->use_gnss_time && (current_leap_seconds_ != -128)))
     {
-        node_->publishMessage<M>(topic, msg);
+        // Deduced, such that pooled messages held by shared pointer are handed
+        // over to ROS without copy
+        node_->publishMessage(topic, msg);
     } else
     {
+        node_->statistics().addDroppedPublish();
         node_->log(
             LogLevel::DEBUG,
             "Not publishing message with GNSS time because no leap seconds are available yet.");
@@ -1893,6 +2054,7 @@ void io_comm_rx::RxMessage::publishTf(const LocalizationUtmMsg& msg)
         node_->publishTf(msg);
     } else
     {
+        node_->statistics().addDroppedPublish();
         node_->log(
             LogLevel::DEBUG,
             "Not publishing tf with GNSS time because no leap seconds are available yet.");
@@ -1926,36 +2088,68 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         crc_check_ = isValid(data_);
         if (!crc_check_)
         {
+            node_->statistics().addCrcFailure();
             node_->log(
                 LogLevel::DEBUG,
                 "CRC Check returned False. Not a valid data block. Retrieving full SBF block.");
             return false;
         }
+        // The receive time of logs is not the one of the Rx
+        uint32_t tow = parsing_utilities::getTow(data_);
+        uint16_t wnc = parsing_utilities::getWnc(data_);
+        if (!settings_->read_from_sbf_log && !settings_->read_from_pcap &&
+            validValue(tow) && validValue(wnc))
+        {
+            Timestamp gps_time = gpsTimestamp(tow, wnc);
+            // GNSS time can only be compared to the receive time once the leap
+            // seconds came with ReceiverTime, the clock offset model includes
+            // them in its offset instead
+            if (current_leap_seconds_ != -128)
+                node_->latency().addSample(
+                    parsing_utilities::getId(data_),
+                    static_cast<int64_t>(recvTimestamp_) -
+                        static_cast<int64_t>(gps_time) +
+                        static_cast<int64_t>(current_leap_seconds_) * 1000000000);
+            if (settings_->use_clock_model)
+                clock_model_.addSample(gps_time, recvTimestamp_);
+        }
     }
     switch (rx_id_map[message_key])
     {
-    case evPVTCartesian: // Position and velocity in XYZ
-    { // The curly bracket here is crucial: Declarations inside a block remain
-        // inside, and will die at
-        // the end of the block. Otherwise variable overloading etc.
-        PVTCartesianMsg msg;
+    // Blocks that are published as they are, see sbf_block_table.hpp
+    case evPVTCartesian:
+    case evBaseVectorCart:
+    case evBaseVectorGeod:
+    case evPosCovCartesian:
+    case evIMUSetup:
+    case evVelSensorSetup:
+    case evExtEventINSNavCart:
+    case evExtEventINSNavGeod:
+    {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!PVTCartesianParser(node_, dvec.begin(), dvec.end(), msg))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in PVTCartesian");
-            break;
-        }
-        msg.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<PVTCartesianMsg>("/pvtcartesian", msg);
+        visitSbfBlock(
+            parsing_utilities::getId(data_), *settings_,
+            [&](auto tag, const SbfBlockInfo& info, auto parser) {
+                typename decltype(tag)::type msg;
+                if (!parser(node_, dvec.begin(), dvec.end(), msg))
+                {
+                    node_->log(LogLevel::ERROR,
+                               "septentrio_gnss_driver: parse error in " +
+                                   std::string(info.name));
+                    return;
+                }
+                msg.header.frame_id = info.frame_id;
+                msg.header.stamp = timestampToRos(time_obj);
+                // Wait as long as necessary (only when reading from SBF/PCAP
+                // file)
+                if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+                {
+                    wait(time_obj);
+                }
+                publish(info.topic, msg);
+            });
         break;
     }
     case evPVTGeodetic: // Position and velocity in geodetic coordinate frame (ENU
@@ -1963,13 +2157,13 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!PVTGeodeticParser(node_, dvec.begin(), dvec.end(), last_pvtgeodetic_))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_pvtgeodetic_))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in PVTGeodetic");
             break;
         }
-        last_pvtgeodetic_.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_pvtgeodetic_.header.stamp = timestampToRos(time_obj);
         pvtgeodetic_has_arrived_gpsfix_ = true;
@@ -1984,78 +2178,12 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             publish<PVTGeodeticMsg>("/pvtgeodetic", last_pvtgeodetic_);
         break;
     }
-    case evBaseVectorCart:
-    {
-        BaseVectorCartMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!BaseVectorCartParser(node_, dvec.begin(), dvec.end(), msg))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in BaseVectorCart");
-            break;
-        }
-        msg.header.frame_id = settings_->frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<BaseVectorCartMsg>("/basevectorcart", msg);
-        break;
-    }
-    case evBaseVectorGeod:
-    {
-        BaseVectorGeodMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!BaseVectorGeodParser(node_, dvec.begin(), dvec.end(), msg))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in BaseVectorGeod");
-            break;
-        }
-        msg.header.frame_id = settings_->frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<BaseVectorGeodMsg>("/basevectorgeod", msg);
-        break;
-    }
-    case evPosCovCartesian:
-    {
-        PosCovCartesianMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!PosCovCartesianParser(node_, dvec.begin(), dvec.end(), msg))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in PosCovCartesian");
-            break;
-        }
-        msg.header.frame_id = settings_->frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<PosCovCartesianMsg>("/poscovcartesian", msg);
-        break;
-    }
     case evPosCovGeodetic:
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!PosCovGeodeticParser(node_, dvec.begin(), dvec.end(),
-                                  last_poscovgeodetic_))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_poscovgeodetic_))
         {
             poscovgeodetic_has_arrived_gpsfix_ = false;
             poscovgeodetic_has_arrived_navsatfix_ = false;
@@ -2064,7 +2192,6 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in PosCovGeodetic");
             break;
         }
-        last_poscovgeodetic_.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_poscovgeodetic_.header.stamp = timestampToRos(time_obj);
         poscovgeodetic_has_arrived_gpsfix_ = true;
@@ -2083,8 +2210,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!AttEulerParser(node_, dvec.begin(), dvec.end(), last_atteuler_,
-                            settings_->use_ros_axis_orientation))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_atteuler_))
         {
             atteuler_has_arrived_gpsfix_ = false;
             atteuler_has_arrived_pose_ = false;
@@ -2092,7 +2219,6 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in AttEuler");
             break;
         }
-        last_atteuler_.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_atteuler_.header.stamp = timestampToRos(time_obj);
         atteuler_has_arrived_gpsfix_ = true;
@@ -2110,8 +2236,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!AttCovEulerParser(node_, dvec.begin(), dvec.end(), last_attcoveuler_,
-                               settings_->use_ros_axis_orientation))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_attcoveuler_))
         {
             attcoveuler_has_arrived_gpsfix_ = false;
             attcoveuler_has_arrived_pose_ = false;
@@ -2119,7 +2245,6 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in AttCovEuler");
             break;
         }
-        last_attcoveuler_.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_attcoveuler_.header.stamp = timestampToRos(time_obj);
         attcoveuler_has_arrived_gpsfix_ = true;
@@ -2139,20 +2264,16 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         INSNavCartMsg msg;
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!INSNavCartParser(node_, dvec.begin(), dvec.end(), msg,
-                              settings_->use_ros_axis_orientation))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in INSNavCart");
             break;
         }
-        if (settings_->ins_use_poi)
-        {
-            msg.header.frame_id = settings_->poi_frame_id;
-        } else
-        {
-            msg.header.frame_id = settings_->frame_id;
-        }
+        if (validValue(msg.latency))
+            node_->latency().addReportedLatency(parsing_utilities::getId(data_),
+                                                msg.latency);
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         msg.header.stamp = timestampToRos(time_obj);
         // Wait as long as necessary (only when reading from SBF/PCAP file)
@@ -2168,8 +2289,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!INSNavGeodParser(node_, dvec.begin(), dvec.end(), last_insnavgeod_,
-                              settings_->use_ros_axis_orientation))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_insnavgeod_))
         {
             insnavgeod_has_arrived_gpsfix_ = false;
             insnavgeod_has_arrived_navsatfix_ = false;
@@ -2179,13 +2300,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in INSNavGeod");
             break;
         }
-        if (settings_->ins_use_poi)
-        {
-            last_insnavgeod_.header.frame_id = settings_->poi_frame_id;
-        } else
-        {
-            last_insnavgeod_.header.frame_id = settings_->frame_id;
-        }
+        if (validValue(last_insnavgeod_.latency))
+            node_->latency().addReportedLatency(parsing_utilities::getId(data_),
+                                                last_insnavgeod_.latency);
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_insnavgeod_.header.stamp = timestampToRos(time_obj);
         insnavgeod_has_arrived_gpsfix_ = true;
@@ -2207,115 +2324,6 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         break;
     }
 
-    case evIMUSetup: // IMU orientation and lever arm
-    {
-        IMUSetupMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!IMUSetupParser(node_, dvec.begin(), dvec.end(), msg,
-                            settings_->use_ros_axis_orientation))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in IMUSetup");
-            break;
-        }
-        msg.header.frame_id = settings_->vehicle_frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<IMUSetupMsg>("/imusetup", msg);
-        break;
-    }
-
-    case evVelSensorSetup: // Velocity sensor lever arm
-    {
-        VelSensorSetupMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!VelSensorSetupParser(node_, dvec.begin(), dvec.end(), msg,
-                                  settings_->use_ros_axis_orientation))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in VelSensorSetup");
-            break;
-        }
-        msg.header.frame_id = settings_->vehicle_frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<VelSensorSetupMsg>("/velsensorsetup", msg);
-        break;
-    }
-
-    case evExtEventINSNavCart: // Position, velocity and orientation in cartesian
-                               // coordinate frame (ENU frame)
-    {
-        INSNavCartMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavCartParser(node_, dvec.begin(), dvec.end(), msg,
-                              settings_->use_ros_axis_orientation))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in ExtEventINSNavCart");
-            break;
-        }
-        if (settings_->ins_use_poi)
-        {
-            msg.header.frame_id = settings_->poi_frame_id;
-        } else
-        {
-            msg.header.frame_id = settings_->frame_id;
-        }
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<INSNavCartMsg>("/exteventinsnavcart", msg);
-        break;
-    }
-
-    case evExtEventINSNavGeod:
-    {
-        INSNavGeodMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavGeodParser(node_, dvec.begin(), dvec.end(), msg,
-                              settings_->use_ros_axis_orientation))
-        {
-            node_->log(LogLevel::ERROR,
-                       "septentrio_gnss_driver: parse error in ExtEventINSNavGeod");
-            break;
-        }
-        if (settings_->ins_use_poi)
-        {
-            msg.header.frame_id = settings_->poi_frame_id;
-        } else
-        {
-            msg.header.frame_id = settings_->frame_id;
-        }
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
-        // Wait as long as necessary (only when reading from SBF/PCAP file)
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-        {
-            wait(time_obj);
-        }
-        publish<INSNavGeodMsg>("/exteventinsnavgeod", msg);
-        break;
-    }
-
     case evExtSensorMeas:
     {
         std::vector<uint8_t> dvec(data_,
@@ -2400,8 +2408,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         GpggaParser parser_obj;
         try
         {
-            msg = parser_obj.parseASCII(gga_message, settings_->frame_id,
-                                        settings_->use_gnss_time, time_obj);
+            msg = toRosMsg(parser_obj.parseASCII(
+                gga_message, settings_->frame_id, settings_->use_gnss_time,
+                time_obj));
         } catch (ParseException& e)
         {
             node_->log(LogLevel::DEBUG, "GpggaMsg: " + std::string(e.what()));
@@ -2442,8 +2451,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         GprmcParser parser_obj;
         try
         {
-            msg = parser_obj.parseASCII(rmc_message, settings_->frame_id,
-                                        settings_->use_gnss_time, time_obj);
+            msg = toRosMsg(parser_obj.parseASCII(
+                rmc_message, settings_->frame_id, settings_->use_gnss_time,
+                time_obj));
         } catch (ParseException& e)
         {
             node_->log(LogLevel::DEBUG, "GprmcMsg: " + std::string(e.what()));
@@ -2482,8 +2492,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         GpgsaParser parser_obj;
         try
         {
-            msg = parser_obj.parseASCII(gsa_message, settings_->frame_id,
-                                        settings_->use_gnss_time, node_->getTime());
+            msg = toRosMsg(parser_obj.parseASCII(
+                gsa_message, settings_->frame_id, settings_->use_gnss_time,
+                node_->getTime()));
         } catch (ParseException& e)
         {
             node_->log(LogLevel::DEBUG, "GpgsaMsg: " + std::string(e.what()));
@@ -2540,8 +2551,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         GpgsvParser parser_obj;
         try
         {
-            msg = parser_obj.parseASCII(gsv_message, settings_->frame_id,
-                                        settings_->use_gnss_time, node_->getTime());
+            msg = toRosMsg(parser_obj.parseASCII(
+                gsv_message, settings_->frame_id, settings_->use_gnss_time,
+                node_->getTime()));
         } catch (ParseException& e)
         {
             node_->log(LogLevel::DEBUG, "GpgsvMsg: " + std::string(e.what()));
@@ -2639,7 +2651,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         {
         case evGPSFix:
         {
-            GPSFixMsg msg;
+            GPSFixMsg::Ptr msg;
             try
             {
                 msg = GPSFixCallback();
@@ -2648,15 +2660,12 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                 node_->log(LogLevel::DEBUG, "GPSFixMsg: " + std::string(e.what()));
                 break;
             }
-            msg.header.frame_id = settings_->frame_id;
-            msg.status.header.frame_id = settings_->frame_id;
+            msg->header.frame_id = settings_->frame_id;
+            msg->status.header.frame_id = settings_->frame_id;
             Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-            msg.header.stamp = timestampToRos(time_obj);
-            msg.status.header.stamp = timestampToRos(time_obj);
+            msg->header.stamp = timestampToRos(time_obj);
+            msg->status.header.stamp = timestampToRos(time_obj);
             ++count_gpsfix_;
-            channelstatus_has_arrived_gpsfix_ = false;
-            measepoch_has_arrived_gpsfix_ = false;
-            dop_has_arrived_gpsfix_ = false;
             pvtgeodetic_has_arrived_gpsfix_ = false;
             poscovgeodetic_has_arrived_gpsfix_ = false;
             velcovgeodetic_has_arrived_gpsfix_ = false;
@@ -2667,7 +2676,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             {
                 wait(time_obj);
             }
-            publish<GPSFixMsg>("/gpsfix", msg);
+            publish("/gpsfix", msg);
             break;
         }
         }
@@ -2675,7 +2684,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         {
         case evINSGPSFix:
         {
-            GPSFixMsg msg;
+            GPSFixMsg::Ptr msg;
             try
             {
                 msg = GPSFixCallback();
@@ -2686,26 +2695,23 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             }
             if (settings_->ins_use_poi)
             {
-                msg.header.frame_id = settings_->poi_frame_id;
+                msg->header.frame_id = settings_->poi_frame_id;
             } else
             {
-                msg.header.frame_id = settings_->frame_id;
+                msg->header.frame_id = settings_->frame_id;
             }
-            msg.status.header.frame_id = msg.header.frame_id;
+            msg->status.header.frame_id = msg->header.frame_id;
             Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-            msg.header.stamp = timestampToRos(time_obj);
-            msg.status.header.stamp = timestampToRos(time_obj);
+            msg->header.stamp = timestampToRos(time_obj);
+            msg->status.header.stamp = timestampToRos(time_obj);
             ++count_gpsfix_;
-            channelstatus_has_arrived_gpsfix_ = false;
-            measepoch_has_arrived_gpsfix_ = false;
-            dop_has_arrived_gpsfix_ = false;
             insnavgeod_has_arrived_gpsfix_ = false;
             // Wait as long as necessary (only when reading from SBF/PCAP file)
             if (settings_->read_from_sbf_log || settings_->read_from_pcap)
             {
                 wait(time_obj);
             }
-            publish<GPSFixMsg>("/gpsfix", msg);
+            publish("/gpsfix", msg);
             break;
         }
         }
@@ -2783,25 +2789,47 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in ChannelStatus");
             break;
         }
-        channelstatus_has_arrived_gpsfix_ = true;
+        satellite_store_.update(last_channelstatus_);
         break;
     }
     case evMeasEpoch:
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!MeasEpochParser(node_, dvec.begin(), dvec.end(), last_measepoch_))
+        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
+        if (settings_->publish_measepoch_columnar)
+        {
+            MeasEpochColumnarMsg::Ptr msg = measepoch_columnar_pool_.acquire();
+            // /measepoch and the satellite state of /gpsfix do not depend on
+            // the columnar message
+            if (MeasEpochColumnarParser(node_, dvec.begin(), dvec.end(), *msg))
+            {
+                msg->header.frame_id = settings_->frame_id;
+                msg->header.stamp = timestampToRos(time_obj);
+                publish("/measepoch_columnar", msg);
+            } else
+            {
+                node_->log(
+                    LogLevel::ERROR,
+                    "septentrio_gnss_driver: parse error in columnar MeasEpoch");
+            }
+        }
+        if (!settings_->publish_measepoch && !settings_->publish_gpsfix)
+            break;
+        // Parse into a recycled message, the one published before may still be
+        // held by subscribers
+        MeasEpochMsg::Ptr msg = measepoch_pool_.acquire();
+        if (!MeasEpochParser(node_, dvec.begin(), dvec.end(), *msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in MeasEpoch");
             break;
         }
-        last_measepoch_.header.frame_id = settings_->frame_id;
-        Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_measepoch_.header.stamp = timestampToRos(time_obj);
-        measepoch_has_arrived_gpsfix_ = true;
+        msg->header.frame_id = settings_->frame_id;
+        msg->header.stamp = timestampToRos(time_obj);
+        satellite_store_.update(*msg);
         if (settings_->publish_measepoch)
-            publish<MeasEpochMsg>("/measepoch", last_measepoch_);
+            publish("/measepoch", msg);
         break;
     }
     case evDOP:
@@ -2810,27 +2838,24 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                                   data_ + parsing_utilities::getLength(data_));
         if (!DOPParser(node_, dvec.begin(), dvec.end(), last_dop_))
         {
-            dop_has_arrived_gpsfix_ = false;
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in DOP");
             break;
         }
-        dop_has_arrived_gpsfix_ = true;
         break;
     }
     case evVelCovGeodetic:
     {
         std::vector<uint8_t> dvec(data_,
                                   data_ + parsing_utilities::getLength(data_));
-        if (!VelCovGeodeticParser(node_, dvec.begin(), dvec.end(),
-                                  last_velcovgeodetic_))
+        if (!parseSbfBlock(node_, *settings_, parsing_utilities::getId(data_),
+                           dvec.begin(), dvec.end(), last_velcovgeodetic_))
         {
             velcovgeodetic_has_arrived_gpsfix_ = false;
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in VelCovGeodetic");
             break;
         }
-        last_velcovgeodetic_.header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
         last_velcovgeodetic_.header.stamp = timestampToRos(time_obj);
         velcovgeodetic_has_arrived_gpsfix_ = true;
@@ -2850,7 +2875,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evDiagnosticArray:
     {
-        DiagnosticArrayMsg msg;
+        DiagnosticArrayMsg::Ptr msg;
         try
         {
             msg = DiagnosticArrayCallback();
@@ -2862,20 +2887,20 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         }
         if (settings_->septentrio_receiver_type == "gnss")
         {
-            msg.header.frame_id = settings_->frame_id;
+            msg->header.frame_id = settings_->frame_id;
         }
         if (settings_->septentrio_receiver_type == "ins")
         {
             if (settings_->ins_use_poi)
             {
-                msg.header.frame_id = settings_->poi_frame_id;
+                msg->header.frame_id = settings_->poi_frame_id;
             } else
             {
-                msg.header.frame_id = settings_->frame_id;
+                msg->header.frame_id = settings_->frame_id;
             }
         }
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        msg.header.stamp = timestampToRos(time_obj);
+        msg->header.stamp = timestampToRos(time_obj);
         receiverstatus_has_arrived_diagnostics_ = false;
         qualityind_has_arrived_diagnostics_ = false;
         // Wait as long as necessary (only when reading from SBF/PCAP file)
@@ -2883,7 +2908,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         {
             wait(time_obj);
         }
-        publish<DiagnosticArrayMsg>("/diagnostics", msg);
+        publish("/diagnostics", msg);
         break;
     }
     case evLocalization:
@@ -3044,18 +3069,22 @@ void io_comm_rx::RxMessage::wait(Timestamp time_obj)
 {
     Timestamp unix_old = unix_time_;
     unix_time_ = time_obj;
-    if ((unix_old != 0) && (unix_time_ != unix_old))
+    // PCAP replay may be paced by the capture time of the packets instead
+    bool paced_by_packets =
+        settings_->read_from_pcap && (settings_->pcap_pacing == "packet");
+    if (!paced_by_packets)
     {
-        if (unix_time_ > unix_old)
-        {
-            auto sleep_nsec = unix_time_ - unix_old;
-
-            std::stringstream ss;
-            ss << "Waiting for " << sleep_nsec / 1000000 << " milliseconds...";
-            node_->log(LogLevel::DEBUG, ss.str());
+        // Scheduled against a wall clock anchor, so that decoding and publishing
+        // times do not add up as drift
+        replay_clock_.setRate(settings_->replay_rate);
+        replay_clock_.sleepUntil(unix_time_);
+    }
 
-            std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_nsec));
-        }
+    if (settings_->publish_clock && (unix_time_ != unix_old))
+    {
+        ClockMsg msg;
+        msg.clock = timestampToRos(unix_time_);
+        node_->publishMessage("/clock", msg);
     }
 
     // set leap seconds to paramter only if it was not set otherwise (by
@@ -3066,22 +3095,16 @@ void io_comm_rx::RxMessage::wait(Timestamp time_obj)
 
 bool io_comm_rx::RxMessage::gnss_gpsfix_complete(uint32_t id)
 {
-    std::vector<bool> gpsfix_vec = {channelstatus_has_arrived_gpsfix_,
-                                    measepoch_has_arrived_gpsfix_,
-                                    dop_has_arrived_gpsfix_,
-                                    pvtgeodetic_has_arrived_gpsfix_,
-                                    poscovgeodetic_has_arrived_gpsfix_,
-                                    velcovgeodetic_has_arrived_gpsfix_,
-                                    atteuler_has_arrived_gpsfix_,
-                                    attcoveuler_has_arrived_gpsfix_};
+    std::vector<bool> gpsfix_vec = {
+        pvtgeodetic_has_arrived_gpsfix_, poscovgeodetic_has_arrived_gpsfix_,
+        velcovgeodetic_has_arrived_gpsfix_, atteuler_has_arrived_gpsfix_,
+        attcoveuler_has_arrived_gpsfix_};
     return allTrue(gpsfix_vec, id);
 }
 
 bool io_comm_rx::RxMessage::ins_gpsfix_complete(uint32_t id)
 {
-    std::vector<bool> gpsfix_vec = {
-        channelstatus_has_arrived_gpsfix_, measepoch_has_arrived_gpsfix_,
-        dop_has_arrived_gpsfix_, insnavgeod_has_arrived_gpsfix_};
+    std::vector<bool> gpsfix_vec = {insnavgeod_has_arrived_gpsfix_};
     return allTrue(gpsfix_vec, id);
 }
 
@@ -0,0 +1,110 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/rx_statistics.hpp>
+
+/**
+ * @file rx_statistics.cpp
+ * @brief Defines the runtime statistics of the stream from the Rx
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    static std::chrono::steady_clock::rep now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    RxStatistics::RxStatistics() : start_(now()) {}
+
+    void RxStatistics::snapshot(Snapshot& snapshot) const
+    {
+        snapshot.uptime_ns = static_cast<uint64_t>(
+            now() - start_.load(std::memory_order_relaxed));
+        snapshot.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+        snapshot.crc_failures = crc_failures_.load(std::memory_order_relaxed);
+        snapshot.skipped_bytes = skipped_bytes_.load(std::memory_order_relaxed);
+        snapshot.incomplete_carries =
+            incomplete_carries_.load(std::memory_order_relaxed);
+        snapshot.dropped_deferred_blocks =
+            dropped_deferred_blocks_.load(std::memory_order_relaxed);
+        snapshot.nmea_checksum_failures =
+            nmea_checksum_failures_.load(std::memory_order_relaxed);
+        snapshot.dropped_publishes =
+            dropped_publishes_.load(std::memory_order_relaxed);
+        snapshot.buffer_high_water =
+            buffer_high_water_.load(std::memory_order_relaxed);
+        snapshot.buffer_capacity = buffer_capacity_.load(std::memory_order_relaxed);
+        snapshot.blocked_reads = blocked_reads_.load(std::memory_order_relaxed);
+        snapshot.dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+        snapshot.dropped_frames = dropped_frames_.load(std::memory_order_relaxed);
+        snapshot.dropped_navigation_frames =
+            dropped_navigation_frames_.load(std::memory_order_relaxed);
+        snapshot.blocks.clear();
+        for (std::size_t id = 0; id < NR_BLOCK_NUMBERS; ++id)
+        {
+            const BlockCounters& counters = blocks_[id];
+            Block block;
+            block.count = counters.count.load(std::memory_order_relaxed);
+            block.decoded = counters.decoded.load(std::memory_order_relaxed);
+            if ((block.count == 0) && (block.decoded == 0))
+                continue;
+            block.id = static_cast<uint16_t>(id);
+            block.decode_ns = counters.decode_ns.load(std::memory_order_relaxed);
+            snapshot.blocks.push_back(block);
+        }
+    }
+
+    void RxStatistics::reset()
+    {
+        bytes_received_.store(0, std::memory_order_relaxed);
+        crc_failures_.store(0, std::memory_order_relaxed);
+        skipped_bytes_.store(0, std::memory_order_relaxed);
+        incomplete_carries_.store(0, std::memory_order_relaxed);
+        dropped_deferred_blocks_.store(0, std::memory_order_relaxed);
+        nmea_checksum_failures_.store(0, std::memory_order_relaxed);
+        dropped_publishes_.store(0, std::memory_order_relaxed);
+        buffer_high_water_.store(0, std::memory_order_relaxed);
+        blocked_reads_.store(0, std::memory_order_relaxed);
+        dropped_bytes_.store(0, std::memory_order_relaxed);
+        dropped_frames_.store(0, std::memory_order_relaxed);
+        dropped_navigation_frames_.store(0, std::memory_order_relaxed);
+        for (BlockCounters& counters : blocks_)
+        {
+            counters.count.store(0, std::memory_order_relaxed);
+            counters.decoded.store(0, std::memory_order_relaxed);
+            counters.decode_ns.store(0, std::memory_order_relaxed);
+        }
+        start_.store(now(), std::memory_order_relaxed);
+    }
+} // namespace io_comm_rx
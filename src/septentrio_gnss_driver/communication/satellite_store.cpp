@@ -0,0 +1,161 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/satellite_store.hpp>
+
+/**
+ * @file satellite_store.cpp
+ * @brief Defines a class keeping the state of each satellite and signal across
+ * epochs
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! C/N0 in dB-Hz from the CN0 field of MeasEpoch, signals 1 (GPS L1P) and
+    //! 2 (GPS L2P) have no 10 dB-Hz offset
+    static float cnoFromMeasEpoch(uint8_t signal, uint8_t cn0)
+    {
+        if (signal == 1 || signal == 2)
+            return cn0 * 0.25f;
+        return cn0 * 0.25f + 10.0f;
+    }
+
+    void SatelliteStore::update(const MeasEpochMsg& msg)
+    {
+        ++measepoch_epoch_;
+        // 0 marks entries never seen
+        if (measepoch_epoch_ == 0)
+            ++measepoch_epoch_;
+        const uint32_t tow = msg.block_header.tow;
+        const uint16_t wnc = msg.block_header.wnc;
+
+        channels_in_sync_ = msg.type1.size();
+        satellites_in_sync_ = 0;
+        for (const auto& type1 : msg.type1)
+        {
+            const uint8_t signal_number =
+                measEpochSignal(type1.type, type1.obs_info);
+            SatelliteState& satellite = satellites_[type1.sv_id];
+            // If a satellite is tracked on several channels, the first one
+            // determines its C/N0
+            if (satellite.measepoch_epoch != measepoch_epoch_)
+            {
+                ++satellites_in_sync_;
+                satellite.measepoch_epoch = measepoch_epoch_;
+                satellite.measepoch_tow = tow;
+                satellite.measepoch_wnc = wnc;
+                // Truncated to integer dB-Hz as in GPSFix
+                satellite.cno = static_cast<int32_t>(
+                    cnoFromMeasEpoch(signal_number, type1.cn0));
+            }
+
+            SignalState& signal = satellite.signals[signal_number];
+            signal.epoch = measepoch_epoch_;
+            signal.tow = tow;
+            signal.wnc = wnc;
+            signal.lock_time = type1.lock_time;
+            signal.cno = cnoFromMeasEpoch(signal_number, type1.cn0);
+            for (const auto& type2 : type1.type2)
+            {
+                const uint8_t signal_number2 =
+                    measEpochSignal(type2.type, type2.obs_info);
+                SignalState& signal2 = satellite.signals[signal_number2];
+                signal2.epoch = measepoch_epoch_;
+                signal2.tow = tow;
+                signal2.wnc = wnc;
+                signal2.lock_time = type2.lock_time;
+                signal2.cno = cnoFromMeasEpoch(signal_number2, type2.cn0);
+            }
+        }
+    }
+
+    void SatelliteStore::update(const ChannelStatus& msg)
+    {
+        ++channelstatus_epoch_;
+        // 0 marks entries never seen
+        if (channelstatus_epoch_ == 0)
+            ++channelstatus_epoch_;
+        const uint32_t tow = msg.block_header.tow;
+        const uint16_t wnc = msg.block_header.wnc;
+
+        static const uint16_t azimuth_mask = 511;
+        channels_.clear();
+        satellites_used_ = 0;
+        for (const auto& channel_sat_info : msg.satInfo)
+        {
+            updateVisibility(channel_sat_info.sv_id, channel_sat_info.elev,
+                             channel_sat_info.az_rise_set & azimuth_mask, tow,
+                             wnc);
+
+            ChannelEntry entry;
+            entry.svid = channel_sat_info.sv_id;
+            entry.pvt_signals = 0;
+            for (const auto& channel_state_info : channel_sat_info.stateInfo)
+            {
+                // PVTStatus holds one 2-bit field per signal type, a value of 2
+                // means that the signal is used in the PVT computation
+                for (int shift = 14; shift >= 0; shift -= 2)
+                {
+                    if (((channel_state_info.pvt_status >> shift) & 3) == 2)
+                    {
+                        ++entry.pvt_signals;
+                        break;
+                    }
+                }
+            }
+            channels_.push_back(entry);
+
+            SatelliteState& satellite = satellites_[channel_sat_info.sv_id];
+            if (satellite.channelstatus_epoch != channelstatus_epoch_)
+            {
+                satellite.channelstatus_epoch = channelstatus_epoch_;
+                satellite.used_in_pvt = false;
+            }
+            if ((entry.pvt_signals > 0) && !satellite.used_in_pvt)
+            {
+                satellite.used_in_pvt = true;
+                ++satellites_used_;
+            }
+        }
+    }
+
+    void SatelliteStore::updateVisibility(uint8_t svid, int16_t elevation,
+                                          uint16_t azimuth, uint32_t tow,
+                                          uint16_t wnc)
+    {
+        SatelliteState& satellite = satellites_[svid];
+        satellite.visibility_valid = true;
+        satellite.visibility_tow = tow;
+        satellite.visibility_wnc = wnc;
+        satellite.elevation = elevation;
+        satellite.azimuth = azimuth;
+    }
+} // namespace io_comm_rx
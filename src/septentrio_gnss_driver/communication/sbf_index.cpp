@@ -0,0 +1,187 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+/**
+ * @file sbf_index.cpp
+ * @brief Defines an index of the epochs in an SBF log
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Identifies sidecar files and their format version
+    static const char INDEX_MAGIC[8] = {'S', 'B', 'F', 'I', 'D', 'X', '0', '1'};
+    //! Chunks smaller than this are not worth a thread of their own
+    static const std::size_t MIN_CHUNK_SIZE = 1 << 20;
+    //! Do-not-use value of TOW
+    static const uint32_t TOW_DNU = 4294967295;
+    //! Do-not-use value of WNc
+    static const uint16_t WNC_DNU = 65535;
+
+    /**
+     * @brief Indexes the epochs starting within [begin, end) of the log
+     *
+     * Blocks may reach beyond end, so the framer is given the rest of the log.
+     */
+    static void indexChunk(LogSink* logger, const uint8_t* data, std::size_t size,
+                           std::size_t begin, std::size_t end,
+                           std::vector<SbfEpoch>& epochs)
+    {
+        Framer framer(logger);
+        const uint8_t* next = data + begin;
+        std::size_t count = size - begin;
+        Frame frame;
+        uint64_t last_time = 0;
+        while (framer.next(next, count, frame))
+        {
+            std::size_t offset = static_cast<std::size_t>(frame.data - data);
+            if (offset >= end)
+                break;
+            if (frame.type != FrameType::SBF)
+                continue;
+            uint32_t tow = parsing_utilities::getTow(frame.data);
+            uint16_t wnc = parsing_utilities::getWnc(frame.data);
+            if ((tow == TOW_DNU) || (wnc == WNC_DNU))
+                continue;
+            uint64_t gps_time = SbfIndex::gpsTime(wnc, tow);
+            if (epochs.empty() || (gps_time != last_time))
+                epochs.push_back({gps_time, offset});
+            last_time = gps_time;
+        }
+    }
+
+    void SbfIndex::build(LogSink* logger, const uint8_t* data, std::size_t size,
+                         unsigned threads)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        std::size_t chunks = std::max<std::size_t>(
+            1, std::min<std::size_t>(threads, size / MIN_CHUNK_SIZE));
+        std::size_t chunk_size = size / chunks;
+
+        std::vector<std::vector<SbfEpoch>> chunk_epochs(chunks);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            std::size_t end = (i + 1 == chunks) ? size : (i + 1) * chunk_size;
+            workers.emplace_back(indexChunk, logger, data, size, i * chunk_size,
+                                 end, std::ref(chunk_epochs[i]));
+        }
+        indexChunk(logger, data, size, 0, std::min(chunk_size, size),
+                   chunk_epochs[0]);
+        for (auto& worker : workers)
+            worker.join();
+
+        // An epoch split across chunks is kept at its first block only
+        epochs_.clear();
+        for (const auto& epochs : chunk_epochs)
+        {
+            for (const auto& epoch : epochs)
+            {
+                if (epochs_.empty() || (epoch.gps_time != epochs_.back().gps_time))
+                    epochs_.push_back(epoch);
+            }
+        }
+    }
+
+    bool SbfIndex::load(const std::string& file_name, uint64_t log_size)
+    {
+        std::ifstream file(file_name, std::ios::binary);
+        if (!file)
+            return false;
+        char magic[sizeof(INDEX_MAGIC)];
+        uint64_t size = 0;
+        uint64_t count = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || (std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) ||
+            (size != log_size) || (count > log_size))
+            return false;
+
+        std::vector<SbfEpoch> epochs(count);
+        for (auto& epoch : epochs)
+        {
+            file.read(reinterpret_cast<char*>(&epoch.gps_time),
+                      sizeof(epoch.gps_time));
+            file.read(reinterpret_cast<char*>(&epoch.offset), sizeof(epoch.offset));
+        }
+        if (!file)
+            return false;
+        epochs_.swap(epochs);
+        return true;
+    }
+
+    bool SbfIndex::save(const std::string& file_name, uint64_t log_size) const
+    {
+        std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        uint64_t count = epochs_.size();
+        file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        file.write(reinterpret_cast<const char*>(&log_size), sizeof(log_size));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& epoch : epochs_)
+        {
+            file.write(reinterpret_cast<const char*>(&epoch.gps_time),
+                       sizeof(epoch.gps_time));
+            file.write(reinterpret_cast<const char*>(&epoch.offset),
+                       sizeof(epoch.offset));
+        }
+        return static_cast<bool>(file);
+    }
+
+    uint64_t SbfIndex::startOffset(uint64_t gps_time, uint64_t log_size) const
+    {
+        auto it = std::lower_bound(epochs_.begin(), epochs_.end(), gps_time,
+                                   [](const SbfEpoch& epoch, uint64_t time) {
+                                       return epoch.gps_time < time;
+                                   });
+        return (it == epochs_.end()) ? log_size : it->offset;
+    }
+
+    uint64_t SbfIndex::endOffset(uint64_t gps_time, uint64_t log_size) const
+    {
+        auto it = std::upper_bound(epochs_.begin(), epochs_.end(), gps_time,
+                                   [](uint64_t time, const SbfEpoch& epoch) {
+                                       return time < epoch.gps_time;
+                                   });
+        return (it == epochs_.end()) ? log_size : it->offset;
+    }
+} // namespace io_comm_rx
@@ -0,0 +1,105 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/socket_timestamps.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <time.h>
+
+/**
+ * @file socket_timestamps.cpp
+ * @brief Defines reading from sockets with kernel receive timestamps
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+    namespace socket_timestamps {
+
+        bool enable(int fd)
+        {
+#ifdef SO_TIMESTAMPNS
+            int on = 1;
+            return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) ==
+                   0;
+#else
+            (void)fd;
+            return false;
+#endif
+        }
+
+        ssize_t receive(int fd, uint8_t* data, std::size_t size,
+                        uint64_t& recv_time)
+        {
+            recv_time = 0;
+            iovec iov;
+            iov.iov_base = data;
+            iov.iov_len = size;
+            // Room for a timestamp and, e.g. with SO_TIMESTAMPING set by
+            // somebody else, a further control message
+            union
+            {
+                cmsghdr align;
+                char buffer[2 * CMSG_SPACE(3 * sizeof(timespec))];
+            } control;
+            msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.buffer;
+            msg.msg_controllen = sizeof(control.buffer);
+
+            ssize_t n;
+            do
+            {
+                n = recvmsg(fd, &msg, MSG_DONTWAIT);
+            } while ((n < 0) && (errno == EINTR));
+            if (n <= 0)
+                return n;
+
+#ifdef SCM_TIMESTAMPNS
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+                 cmsg = CMSG_NXTHDR(&msg, cmsg))
+            {
+                if ((cmsg->cmsg_level == SOL_SOCKET) &&
+                    (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+                {
+                    timespec ts;
+                    std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                    recv_time = static_cast<uint64_t>(ts.tv_sec) * 1000000000 +
+                                static_cast<uint64_t>(ts.tv_nsec);
+                }
+            }
+#endif
+            return n;
+        }
+    } // namespace socket_timestamps
+} // namespace io_comm_rx
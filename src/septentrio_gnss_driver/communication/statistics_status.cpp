@@ -0,0 +1,216 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/statistics_status.hpp>
+
+#include <sstream>
+
+/**
+ * @file statistics_status.cpp
+ * @brief Defines the conversion of the runtime statistics and latency estimates
+ * of the core library into diagnostic statuses
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Input buffer occupancy, as fraction of its capacity, that raises a warning
+    static const double BUFFER_WARNING_LEVEL = 0.9;
+    //! Latency below which the system clock is considered to be behind in seconds
+    static const double NEGATIVE_LATENCY = -1e-3;
+
+    static void addValue(DiagnosticStatusMsg& status, const std::string& key,
+                         const std::string& value)
+    {
+        diagnostic_msgs::KeyValue key_value;
+        key_value.key = key;
+        key_value.value = value;
+        status.values.push_back(key_value);
+    }
+
+    static std::string toString(double value)
+    {
+        std::ostringstream ss;
+        ss.precision(6);
+        ss << value;
+        return ss.str();
+    }
+
+    static void addMilliseconds(DiagnosticStatusMsg& status,
+                                const std::string& key, double seconds)
+    {
+        std::ostringstream ss;
+        ss.precision(4);
+        ss << std::fixed << seconds * 1e3;
+        addValue(status, key + " [ms]", ss.str());
+    }
+
+    void toStatus(const RxStatistics::Snapshot& current,
+                  const RxStatistics::Snapshot* previous,
+                  DiagnosticStatusMsg& status)
+    {
+        // After a reset, the rates are given since the reset
+        if (previous && (previous->uptime_ns >= current.uptime_ns))
+            previous = nullptr;
+        double interval =
+            static_cast<double>(current.uptime_ns -
+                                (previous ? previous->uptime_ns : 0)) *
+            1e-9;
+
+        status.name = "rx_statistics";
+        status.values.clear();
+        if (current.dropped_frames > (previous ? previous->dropped_frames : 0))
+        {
+            status.level = DiagnosticStatusMsg::WARN;
+            status.message = "Input buffer full, data dropped, parser backlog";
+        } else if ((current.buffer_capacity > 0) &&
+            (current.buffer_high_water >=
+             BUFFER_WARNING_LEVEL * current.buffer_capacity))
+        {
+            status.level = DiagnosticStatusMsg::WARN;
+            status.message = "Input buffer close to overflow, parser backlog";
+        } else
+        {
+            status.level = DiagnosticStatusMsg::OK;
+            status.message = "Throughput, error and buffer statistics";
+        }
+
+        addValue(status, "Uptime [s]",
+                 toString(static_cast<double>(current.uptime_ns) * 1e-9));
+        addValue(status, "Bytes received", std::to_string(current.bytes_received));
+        if (interval > 0.0)
+            addValue(status, "Throughput [B/s]",
+                     toString(static_cast<double>(
+                                  current.bytes_received -
+                                  (previous ? previous->bytes_received : 0)) /
+                              interval));
+        addValue(status, "CRC failures", std::to_string(current.crc_failures));
+        addValue(status, "Resync bytes skipped",
+                 std::to_string(current.skipped_bytes));
+        addValue(status, "Incomplete frame carries",
+                 std::to_string(current.incomplete_carries));
+        addValue(status, "Deferred blocks dropped undecoded",
+                 std::to_string(current.dropped_deferred_blocks));
+        addValue(status, "NMEA checksum failures",
+                 std::to_string(current.nmea_checksum_failures));
+        addValue(status, "Dropped publishes",
+                 std::to_string(current.dropped_publishes));
+        addValue(status, "Input buffer high-water mark [B]",
+                 std::to_string(current.buffer_high_water));
+        addValue(status, "Input buffer capacity [B]",
+                 std::to_string(current.buffer_capacity));
+        addValue(status, "Reads blocked by full input buffer",
+                 std::to_string(current.blocked_reads));
+        addValue(status, "Bytes dropped from input buffer",
+                 std::to_string(current.dropped_bytes));
+        addValue(status, "Frames dropped from input buffer",
+                 std::to_string(current.dropped_frames));
+        addValue(status, "PVT/INS frames dropped from input buffer",
+                 std::to_string(current.dropped_navigation_frames));
+
+        std::size_t p = 0;
+        for (const RxStatistics::Block& block : current.blocks)
+        {
+            // Both lists are ascending in id
+            uint64_t previous_count = 0;
+            if (previous)
+            {
+                while ((p < previous->blocks.size()) &&
+                       (previous->blocks[p].id < block.id))
+                    ++p;
+                if ((p < previous->blocks.size()) &&
+                    (previous->blocks[p].id == block.id))
+                    previous_count = previous->blocks[p].count;
+            }
+            std::string name =
+                (block.id == 0) ? "NMEA" : "Block " + std::to_string(block.id);
+            addValue(status, name + " count", std::to_string(block.count));
+            if (interval > 0.0)
+                addValue(
+                    status, name + " rate [Hz]",
+                    toString(static_cast<double>(block.count - previous_count) /
+                             interval));
+            if (block.decoded > 0)
+                addValue(status, name + " mean decode time [us]",
+                         toString(static_cast<double>(block.decode_ns) * 1e-3 /
+                                  block.decoded));
+        }
+    }
+
+    void toStatus(const LatencyEstimator& latency, double congestion_threshold,
+                  DiagnosticStatusMsg& status)
+    {
+        LatencyEstimator::Summary summary;
+        latency.summary(summary);
+        status.name = "rx_latency";
+        status.values.clear();
+        if (summary.samples == 0)
+        {
+            status.level = DiagnosticStatusMsg::OK;
+            status.message = "No samples yet, leap seconds from ReceiverTime and "
+                             "a connected Rx are needed";
+        } else if (summary.latency < NEGATIVE_LATENCY)
+        {
+            status.level = DiagnosticStatusMsg::WARN;
+            status.message =
+                "Negative latency, the system clock is not synchronized";
+        } else if (summary.latency - summary.baseline > congestion_threshold)
+        {
+            status.level = DiagnosticStatusMsg::WARN;
+            status.message = "Latency above baseline, link congested or buffering";
+        } else
+        {
+            status.level = DiagnosticStatusMsg::OK;
+            status.message = "Receive time minus GNSS time of SBF blocks";
+        }
+
+        addValue(status, "Samples", std::to_string(summary.samples));
+        if (summary.samples > 0)
+        {
+            addMilliseconds(status, "Latency", summary.latency);
+            addMilliseconds(status, "Deviation", summary.deviation);
+            addMilliseconds(status, "Baseline", summary.baseline);
+            addMilliseconds(status, "Minimum", summary.minimum);
+            addMilliseconds(status, "Median", summary.median);
+            addMilliseconds(status, "90th percentile", summary.percentile90);
+            addMilliseconds(status, "99th percentile", summary.percentile99);
+            addMilliseconds(status, "Maximum", summary.maximum);
+        }
+        for (const auto& block : summary.blocks)
+            addMilliseconds(status,
+                            "Block " + std::to_string(block.first) + " latency",
+                            block.second);
+        for (const auto& block : summary.reported)
+            addMilliseconds(status,
+                            "Block " + std::to_string(block.first) +
+                                " latency reported by Rx",
+                            block.second);
+    }
+} // namespace io_comm_rx
@@ -0,0 +1,763 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+#include <septentrio_gnss_driver/crc/crc.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+/**
+ * @file stream_generator.cpp
+ * @brief Defines a class that generates synthetic SBF and NMEA streams
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Center of the circle the receiver moves on, latitude in degrees
+    static const double GENERATOR_LATITUDE = 47.3686;
+    //! Center of the circle the receiver moves on, longitude in degrees
+    static const double GENERATOR_LONGITUDE = 8.5392;
+    //! Ellipsoidal height in meters
+    static const double GENERATOR_HEIGHT = 450.0;
+    //! Geoid undulation in meters
+    static const float GENERATOR_UNDULATION = 47.5f;
+    //! Radius of the circle in meters
+    static const double GENERATOR_RADIUS = 50.0;
+    //! Time for one round on the circle in seconds
+    static const double GENERATOR_ROUND_TIME = 60.0;
+    //! Leap seconds between GPS time and UTC
+    static const int8_t GENERATOR_LEAP_SECONDS = 18;
+    //! GPS time of the first epoch, mid-week
+    static const uint64_t GENERATOR_START_TIME =
+        2230ull * 604800000 + 345600000;
+    //! GPS time of 1980-01-06 as Unix time
+    static const time_t GPS_EPOCH = 315964800;
+    static const double WGS84_A = 6378137.0;
+    static const double WGS84_E2 = 6.69437999014e-3;
+
+    /**
+     * @brief Appends one SBF block field by field, little endian as on the
+     * wire, and completes padding, length and CRC when finished
+     */
+    class BlockBuilder
+    {
+    public:
+        BlockBuilder(std::vector<uint8_t>& out, uint16_t id, uint8_t revision,
+                     uint32_t tow, uint16_t wnc) :
+            out_(out),
+            start_(out.size())
+        {
+            put<uint8_t>(0x24);
+            put<uint8_t>(0x40);
+            put<uint16_t>(0); // CRC
+            put<uint16_t>(static_cast<uint16_t>(id | (revision << 13)));
+            put<uint16_t>(0); // length
+            put(tow);
+            put(wnc);
+        }
+
+        template <typename T>
+        void put(T val)
+        {
+            std::size_t pos = out_.size();
+            out_.resize(pos + sizeof(T));
+            std::memcpy(&out_[pos], &val, sizeof(T));
+        }
+
+        void skip(std::size_t n) { out_.resize(out_.size() + n, 0); }
+
+        void finish()
+        {
+            skip((4 - (out_.size() - start_) % 4) % 4);
+            uint16_t length = static_cast<uint16_t>(out_.size() - start_);
+            std::memcpy(&out_[start_ + 6], &length, sizeof(length));
+            uint16_t crc = compute16CCITT(&out_[start_ + 4], length - 4);
+            std::memcpy(&out_[start_ + 2], &crc, sizeof(crc));
+        }
+
+    private:
+        std::vector<uint8_t>& out_;
+        std::size_t start_;
+    };
+
+    //! SVID in SBF numbering: GPS first, then Galileo
+    static uint8_t svid(uint8_t index)
+    {
+        return (index < 32) ? index + 1 : index - 32 + 71;
+    }
+
+    //! Azimuth of a satellite in degrees, fixed per satellite
+    static uint16_t azimuth(uint8_t index) { return (index * 37) % 360; }
+
+    //! Elevation of a satellite in degrees, fixed per satellite
+    static int8_t elevation(uint8_t index) { return 10 + (index * 13) % 75; }
+
+    //! Signal number of the n-th signal of a satellite
+    static uint8_t signalType(uint8_t index, uint8_t n)
+    {
+        static const uint8_t GPS_SIGNALS[] = {0, 4, 3};
+        static const uint8_t GALILEO_SIGNALS[] = {17, 20, 22};
+        return (index < 32) ? GPS_SIGNALS[n % 3] : GALILEO_SIGNALS[n % 3];
+    }
+
+    StreamGenerator::StreamGenerator(uint8_t satellites, uint8_t signals,
+                                     uint32_t period, bool nmea, bool ins) :
+        satellites_(satellites),
+        signals_(signals < 1 ? 1 : signals),
+        period_(period < 1 ? 1 : period), nmea_(nmea), ins_(ins),
+        ins_sb_list_(1 | 2 | 4 | 8 | 16), time_(GENERATOR_START_TIME),
+        start_(GENERATOR_START_TIME)
+    {
+    }
+
+    void StreamGenerator::epoch(std::vector<uint8_t>& out)
+    {
+        if (((time_ - start_) % 1000) < period_)
+            status(out);
+        pvt(out);
+        measurements(out);
+        if (nmea_)
+            nmea(out);
+        time_ += period_;
+    }
+
+    void StreamGenerator::setTime(uint64_t gps_time)
+    {
+        if (gps_time < start_)
+            start_ = gps_time;
+        time_ = gps_time;
+    }
+
+    void StreamGenerator::pvt(std::vector<uint8_t>& out)
+    {
+        State s = state();
+        if (ins_)
+        {
+            insNavGeod(out, s);
+            return;
+        }
+        pvtCartesian(out, s);
+        pvtGeodetic(out, s);
+        posCovGeodetic(out);
+        velCovGeodetic(out);
+        attEuler(out, s);
+        attCovEuler(out);
+        dop(out);
+    }
+
+    void StreamGenerator::imu(std::vector<uint8_t>& out)
+    {
+        State s = state();
+        double omega = 2.0 * M_PI / GENERATOR_ROUND_TIME;
+        double v = std::sqrt(s.vn * s.vn + s.ve * s.ve);
+
+        BlockBuilder b(out, 4050, 0, tow(), wnc());
+        b.put<uint8_t>(2);
+        b.put<uint8_t>(28);
+        // Acceleration in m/s^2, centripetal to the left in the vehicle frame
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<double>(0.0);
+        b.put<double>(v * omega);
+        b.put<double>(9.81);
+        // Angular rate in deg/s
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(1);
+        b.put<uint8_t>(0);
+        b.put<double>(0.0);
+        b.put<double>(0.0);
+        b.put<double>(360.0 / GENERATOR_ROUND_TIME);
+        b.finish();
+    }
+
+    void StreamGenerator::measurements(std::vector<uint8_t>& out)
+    {
+        measEpoch(out);
+        channelStatus(out);
+    }
+
+    void StreamGenerator::status(std::vector<uint8_t>& out)
+    {
+        receiverTime(out);
+        receiverStatus(out);
+        qualityInd(out);
+        receiverSetup(out);
+    }
+
+    void StreamGenerator::nmea(std::vector<uint8_t>& out)
+    {
+        State s = state();
+        gga(out, s);
+        rmc(out, s);
+        gsa(out);
+        gsv(out);
+    }
+
+    void StreamGenerator::comment(const std::string& text, uint64_t gps_time,
+                                  std::vector<uint8_t>& out)
+    {
+        std::size_t n = std::min<std::size_t>(text.size(), 120);
+        BlockBuilder b(out, 5936, 0, static_cast<uint32_t>(gps_time % 604800000),
+                       static_cast<uint16_t>(gps_time / 604800000));
+        b.put(static_cast<uint8_t>(n));
+        b.skip(1);
+        for (std::size_t i = 0; i < n; ++i)
+            b.put(text[i]);
+        b.finish();
+    }
+
+    uint64_t StreamGenerator::gpsTime(uint64_t unix_time)
+    {
+        return unix_time + GENERATOR_LEAP_SECONDS * 1000 - GPS_EPOCH * 1000;
+    }
+
+    uint64_t StreamGenerator::unixTime(uint64_t gps_time)
+    {
+        return gps_time + GPS_EPOCH * 1000 - GENERATOR_LEAP_SECONDS * 1000;
+    }
+
+    std::string StreamGenerator::blockName(uint16_t id)
+    {
+        switch (id)
+        {
+        case 4001:
+            return "DOP";
+        case 4006:
+            return "PVTCartesian";
+        case 4007:
+            return "PVTGeodetic";
+        case 4013:
+            return "ChannelStatus";
+        case 4014:
+            return "ReceiverStatus";
+        case 4027:
+            return "MeasEpoch";
+        case 4043:
+            return "BaseVectorCart";
+        case 4044:
+            return "BaseVectorGeod";
+        case 4050:
+            return "ExtSensorMeas";
+        case 4082:
+            return "QualityInd";
+        case 4224:
+            return "IMUSetup";
+        case 4225:
+            return "INSNavCart";
+        case 4226:
+            return "INSNavGeod";
+        case 4244:
+            return "VelSensorSetup";
+        case 5902:
+            return "ReceiverSetup";
+        case 5905:
+            return "PosCovCartesian";
+        case 5906:
+            return "PosCovGeodetic";
+        case 5907:
+            return "VelCovCartesian";
+        case 5908:
+            return "VelCovGeodetic";
+        case 5914:
+            return "ReceiverTime";
+        case 5936:
+            return "Comment";
+        case 5938:
+            return "AttEuler";
+        case 5939:
+            return "AttCovEuler";
+        default:
+            return std::to_string(id);
+        }
+    }
+
+    StreamGenerator::State StreamGenerator::state() const
+    {
+        double omega = 2.0 * M_PI / GENERATOR_ROUND_TIME;
+        double angle = omega * (time_ % 60000) / 1000.0;
+        double lat0 = GENERATOR_LATITUDE * M_PI / 180.0;
+        double w2 = 1.0 - WGS84_E2 * std::sin(lat0) * std::sin(lat0);
+        double r_n = WGS84_A / std::sqrt(w2);
+        double r_m = r_n * (1.0 - WGS84_E2) / w2;
+
+        State s;
+        double north = GENERATOR_RADIUS * std::cos(angle);
+        double east = GENERATOR_RADIUS * std::sin(angle);
+        s.latitude = lat0 + north / r_m;
+        s.longitude = GENERATOR_LONGITUDE * M_PI / 180.0 +
+                      east / (r_n * std::cos(lat0));
+        s.height = GENERATOR_HEIGHT;
+        s.vn = -GENERATOR_RADIUS * omega * std::sin(angle);
+        s.ve = GENERATOR_RADIUS * omega * std::cos(angle);
+        s.heading = std::fmod(std::atan2(s.ve, s.vn) * 180.0 / M_PI + 360.0, 360.0);
+        return s;
+    }
+
+    void StreamGenerator::pvtCartesian(std::vector<uint8_t>& out, const State& s)
+    {
+        double sin_lat = std::sin(s.latitude);
+        double cos_lat = std::cos(s.latitude);
+        double sin_lon = std::sin(s.longitude);
+        double cos_lon = std::cos(s.longitude);
+        double r_n = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+
+        BlockBuilder b(out, 4006, 2, tow(), wnc());
+        b.put<uint8_t>(4); // RTK fixed
+        b.put<uint8_t>(0);
+        b.put((r_n + s.height) * cos_lat * cos_lon);
+        b.put((r_n + s.height) * cos_lat * sin_lon);
+        b.put((r_n * (1.0 - WGS84_E2) + s.height) * sin_lat);
+        b.put(GENERATOR_UNDULATION);
+        b.put(static_cast<float>(-sin_lat * cos_lon * s.vn - sin_lon * s.ve));
+        b.put(static_cast<float>(-sin_lat * sin_lon * s.vn + cos_lon * s.ve));
+        b.put(static_cast<float>(cos_lat * s.vn));
+        b.put(static_cast<float>(s.heading));
+        b.put<double>(0.25);
+        b.put<float>(0.01f);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(satellites_);
+        b.put<uint8_t>(0);
+        b.put<uint16_t>(100);
+        b.put<uint16_t>(120);
+        b.put<uint32_t>(0x00020001);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(1);
+        b.put<uint16_t>(0);
+        b.put<uint16_t>(25);
+        b.put<uint16_t>(2);
+        b.put<uint16_t>(3);
+        b.put<uint8_t>(0);
+        b.finish();
+    }
+
+    void StreamGenerator::pvtGeodetic(std::vector<uint8_t>& out, const State& s)
+    {
+        BlockBuilder b(out, 4007, 2, tow(), wnc());
+        b.put<uint8_t>(4); // RTK fixed
+        b.put<uint8_t>(0);
+        b.put(s.latitude);
+        b.put(s.longitude);
+        b.put(s.height);
+        b.put(GENERATOR_UNDULATION);
+        b.put(static_cast<float>(s.vn));
+        b.put(static_cast<float>(s.ve));
+        b.put<float>(0.0f);
+        b.put(static_cast<float>(s.heading));
+        b.put<double>(0.25);
+        b.put<float>(0.01f);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(satellites_);
+        b.put<uint8_t>(0);
+        b.put<uint16_t>(100);
+        b.put<uint16_t>(120);
+        b.put<uint32_t>(0x00020001);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(1);
+        b.put<uint16_t>(0);
+        b.put<uint16_t>(25);
+        b.put<uint16_t>(2);
+        b.put<uint16_t>(3);
+        b.put<uint8_t>(0);
+        b.finish();
+    }
+
+    void StreamGenerator::posCovGeodetic(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 5906, 0, tow(), wnc());
+        b.put<uint8_t>(4);
+        b.put<uint8_t>(0);
+        b.put<float>(1.0e-4f);
+        b.put<float>(1.2e-4f);
+        b.put<float>(4.0e-4f);
+        b.put<float>(1.0e-3f);
+        for (int i = 0; i < 6; ++i)
+            b.put<float>(1.0e-6f);
+        b.finish();
+    }
+
+    void StreamGenerator::velCovGeodetic(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 5908, 0, tow(), wnc());
+        b.put<uint8_t>(4);
+        b.put<uint8_t>(0);
+        b.put<float>(1.0e-4f);
+        b.put<float>(1.0e-4f);
+        b.put<float>(2.5e-4f);
+        b.put<float>(1.0e-5f);
+        for (int i = 0; i < 6; ++i)
+            b.put<float>(1.0e-7f);
+        b.finish();
+    }
+
+    void StreamGenerator::attEuler(std::vector<uint8_t>& out, const State& s)
+    {
+        BlockBuilder b(out, 5938, 0, tow(), wnc());
+        b.put<uint8_t>(satellites_);
+        b.put<uint8_t>(0);
+        b.put<uint16_t>(4); // heading and pitch, fixed ambiguities
+        b.skip(2);
+        b.put(static_cast<float>(s.heading));
+        b.put<float>(0.5f);
+        b.put<float>(-0.2f);
+        b.put<float>(0.0f);
+        b.put<float>(0.0f);
+        b.put(static_cast<float>(360.0 / GENERATOR_ROUND_TIME));
+        b.finish();
+    }
+
+    void StreamGenerator::attCovEuler(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 5939, 0, tow(), wnc());
+        b.skip(1);
+        b.put<uint8_t>(0);
+        b.put<float>(0.04f);
+        b.put<float>(0.09f);
+        b.put<float>(-2.0e10f); // roll not available
+        b.put<float>(0.001f);
+        b.put<float>(-2.0e10f);
+        b.put<float>(-2.0e10f);
+        b.finish();
+    }
+
+    void StreamGenerator::dop(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 4001, 0, tow(), wnc());
+        b.put<uint8_t>(satellites_);
+        b.skip(1);
+        b.put<uint16_t>(150);
+        b.put<uint16_t>(90);
+        b.put<uint16_t>(80);
+        b.put<uint16_t>(120);
+        b.put<float>(2.5f);
+        b.put<float>(4.0f);
+        b.finish();
+    }
+
+    void StreamGenerator::insNavGeod(std::vector<uint8_t>& out, const State& s)
+    {
+        BlockBuilder b(out, 4226, 0, tow(), wnc());
+        b.put<uint8_t>(4); // RTK fixed
+        b.put<uint8_t>(0);
+        b.put<uint16_t>(0x0003);
+        b.put<uint16_t>(5);
+        b.put(s.latitude);
+        b.put(s.longitude);
+        b.put(s.height);
+        b.put(GENERATOR_UNDULATION);
+        b.put<uint16_t>(3);
+        b.put<uint16_t>(20);
+        b.put<uint8_t>(0);
+        b.skip(1);
+        // Each sub-block holds three floats, in the order of the bits
+        const float sub_blocks[8][3] = {
+            {0.01f, 0.01f, 0.02f},
+            {static_cast<float>(s.heading), 0.5f, -0.2f},
+            {0.1f, 0.05f, 0.05f},
+            {static_cast<float>(s.ve), static_cast<float>(s.vn), 0.0f},
+            {0.01f, 0.01f, 0.02f},
+            {1.0e-5f, 2.0e-5f, 3.0e-5f},
+            {1.0e-4f, 2.0e-4f, 3.0e-4f},
+            {1.0e-5f, 2.0e-5f, 3.0e-5f}};
+        b.put(ins_sb_list_);
+        for (int i = 0; i < 8; ++i)
+        {
+            if ((ins_sb_list_ & (1 << i)) == 0)
+                continue;
+            for (float value : sub_blocks[i])
+                b.put(value);
+        }
+        b.finish();
+    }
+
+    void StreamGenerator::measEpoch(std::vector<uint8_t>& out)
+    {
+        uint64_t elapsed = time_ - start_;
+        BlockBuilder b(out, 4027, 1, tow(), wnc());
+        b.put<uint8_t>(satellites_);
+        b.put<uint8_t>(20);
+        b.put<uint8_t>(12);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(0);
+        b.skip(1);
+        for (uint8_t i = 0; i < satellites_; ++i)
+        {
+            double range = 2.0e7 + 1.0e5 * i + 5.0 * (elapsed % 1000);
+            uint64_t code = static_cast<uint64_t>(range * 1000.0);
+            b.put<uint8_t>(i);
+            b.put(signalType(i, 0));
+            b.put(svid(i));
+            b.put(static_cast<uint8_t>((code >> 32) & 0x0f));
+            b.put(static_cast<uint32_t>(code & 0xffffffff));
+            b.put<int32_t>(-12000 + 500 * i);
+            b.put<uint16_t>(static_cast<uint16_t>(elapsed + 1000 * i));
+            b.put<int8_t>(0);
+            b.put(static_cast<uint8_t>(4 * (45 - 10) - i % 8));
+            b.put<uint16_t>(static_cast<uint16_t>(
+                std::min<uint64_t>(elapsed / 1000, 65534)));
+            b.put<uint8_t>(0x04);
+            b.put(static_cast<uint8_t>(signals_ - 1));
+            for (uint8_t n = 1; n < signals_; ++n)
+            {
+                b.put(signalType(i, n));
+                b.put<uint8_t>(200);
+                b.put(static_cast<uint8_t>(4 * (40 - 10) - i % 8));
+                b.put<uint8_t>(0);
+                b.put<int8_t>(0);
+                b.put<uint8_t>(0x04);
+                b.put<uint16_t>(static_cast<uint16_t>(300 + n));
+                b.put<uint16_t>(static_cast<uint16_t>(elapsed + n));
+                b.put<uint16_t>(static_cast<uint16_t>(100 * n));
+            }
+        }
+        b.finish();
+    }
+
+    void StreamGenerator::channelStatus(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 4013, 0, tow(), wnc());
+        b.put<uint8_t>(satellites_);
+        b.put<uint8_t>(12);
+        b.put<uint8_t>(8);
+        b.skip(3);
+        for (uint8_t i = 0; i < satellites_; ++i)
+        {
+            b.put(svid(i));
+            b.put<uint8_t>(0);
+            b.skip(2);
+            b.put(azimuth(i));
+            b.put<uint16_t>(0);
+            b.put(elevation(i));
+            b.put<uint8_t>(1);
+            b.put<uint8_t>(i);
+            b.skip(1);
+            // ChannelStateInfo of the main antenna, all signals in the PVT
+            b.put<uint8_t>(0);
+            b.skip(1);
+            b.put<uint16_t>(0x000f);
+            b.put<uint16_t>(0x000a);
+            b.put<uint16_t>(0);
+        }
+        b.finish();
+    }
+
+    void StreamGenerator::receiverTime(std::vector<uint8_t>& out)
+    {
+        struct tm t = utc();
+        BlockBuilder b(out, 5914, 0, tow(), wnc());
+        b.put(static_cast<int8_t>(t.tm_year % 100));
+        b.put(static_cast<int8_t>(t.tm_mon + 1));
+        b.put(static_cast<int8_t>(t.tm_mday));
+        b.put(static_cast<int8_t>(t.tm_hour));
+        b.put(static_cast<int8_t>(t.tm_min));
+        b.put(static_cast<int8_t>(t.tm_sec));
+        b.put(GENERATOR_LEAP_SECONDS);
+        b.put<uint8_t>(4); // full sync
+        b.finish();
+    }
+
+    void StreamGenerator::receiverStatus(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 4014, 1, tow(), wnc());
+        b.put<uint8_t>(35);
+        b.put<uint8_t>(0);
+        b.put(static_cast<uint32_t>((time_ - start_) / 1000));
+        b.put<uint32_t>(0x00000004);
+        b.put<uint32_t>(0);
+        b.put<uint8_t>(2);
+        b.put<uint8_t>(4);
+        b.put<uint8_t>(0);
+        b.put<uint8_t>(145); // 45 degrees Celsius
+        for (uint8_t i = 0; i < 2; ++i)
+        {
+            b.put<uint8_t>(i + 1);
+            b.put<int8_t>(30);
+            b.put<uint8_t>(100);
+            b.put<uint8_t>(0);
+        }
+        b.finish();
+    }
+
+    void StreamGenerator::qualityInd(std::vector<uint8_t>& out)
+    {
+        BlockBuilder b(out, 4082, 0, tow(), wnc());
+        b.put<uint8_t>(3);
+        b.skip(1);
+        b.put<uint16_t>(0x0a00); // overall
+        b.put<uint16_t>(0x0a01); // GNSS signals main antenna
+        b.put<uint16_t>(0x0a0b); // RF power main antenna
+        b.finish();
+    }
+
+    void StreamGenerator::receiverSetup(std::vector<uint8_t>& out)
+    {
+        auto text = [](BlockBuilder& b, const std::string& str, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i)
+                b.put<char>(i < str.size() ? str[i] : '\0');
+        };
+
+        BlockBuilder b(out, 5902, 3, tow(), wnc());
+        b.skip(2);
+        text(b, "SIMULATOR", 60);
+        text(b, "", 20);
+        text(b, "", 20);
+        text(b, "", 40);
+        text(b, "0000001", 20);
+        text(b, ins_ ? "AsteRx-SBi3 Pro+" : "mosaic-X5", 20);
+        text(b, ins_ ? "1.4.0" : "4.12.1", 20);
+        text(b, "", 20);
+        text(b, "", 20);
+        b.put<float>(0.0f);
+        b.put<float>(0.0f);
+        b.put<float>(0.0f);
+        text(b, "GEODETIC", 20);
+        text(b, ins_ ? "1.4.0" : "4.12.1", 40);
+        text(b, ins_ ? "AsteRx-SBi3 Pro+" : "mosaic-X5", 40);
+        b.finish();
+    }
+
+    void StreamGenerator::sentence(std::vector<uint8_t>& out,
+                                   const std::string& body)
+    {
+        uint8_t checksum = 0;
+        for (char c : body)
+            checksum ^= static_cast<uint8_t>(c);
+        char tail[8];
+        std::snprintf(tail, sizeof(tail), "*%02X\r\n", checksum);
+        out.push_back('$');
+        out.insert(out.end(), body.begin(), body.end());
+        out.insert(out.end(), tail, tail + std::strlen(tail));
+    }
+
+    struct tm StreamGenerator::utc() const
+    {
+        time_t t = GPS_EPOCH + static_cast<time_t>(time_ / 1000) -
+                   GENERATOR_LEAP_SECONDS;
+        struct tm broken_down;
+        gmtime_r(&t, &broken_down);
+        return broken_down;
+    }
+
+    std::string StreamGenerator::utcTime() const
+    {
+        uint32_t day_ms =
+            (tow() + 86400000 - GENERATOR_LEAP_SECONDS * 1000) % 86400000;
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%02u%02u%05.2f", day_ms / 3600000,
+                      (day_ms / 60000) % 60, (day_ms % 60000) / 1000.0);
+        return buf;
+    }
+
+    //! Formats an angle in radians as NMEA (d)ddmm.mmmmm and hemisphere
+    static std::string nmeaAngle(double rad, int degree_digits, char pos, char neg)
+    {
+        double deg = std::fabs(rad * 180.0 / M_PI);
+        int whole = static_cast<int>(deg);
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%0*d%08.5f,%c", degree_digits, whole,
+                      (deg - whole) * 60.0, rad < 0 ? neg : pos);
+        return buf;
+    }
+
+    void StreamGenerator::gga(std::vector<uint8_t>& out, const State& s)
+    {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf),
+                      "GPGGA,%s,%s,%s,4,%02u,0.8,%.3f,M,%.3f,M,1.2,0000",
+                      utcTime().c_str(),
+                      nmeaAngle(s.latitude, 2, 'N', 'S').c_str(),
+                      nmeaAngle(s.longitude, 3, 'E', 'W').c_str(), satellites_,
+                      s.height - GENERATOR_UNDULATION, GENERATOR_UNDULATION);
+        sentence(out, buf);
+    }
+
+    void StreamGenerator::rmc(std::vector<uint8_t>& out, const State& s)
+    {
+        struct tm t = utc();
+        double speed = std::sqrt(s.vn * s.vn + s.ve * s.ve) * 3600.0 / 1852.0;
+
+        char buf[128];
+        std::snprintf(buf, sizeof(buf),
+                      "GPRMC,%s,A,%s,%s,%.3f,%.1f,%02d%02d%02d,,,R",
+                      utcTime().c_str(),
+                      nmeaAngle(s.latitude, 2, 'N', 'S').c_str(),
+                      nmeaAngle(s.longitude, 3, 'E', 'W').c_str(), speed,
+                      s.heading, t.tm_mday, t.tm_mon + 1, t.tm_year % 100);
+        sentence(out, buf);
+    }
+
+    void StreamGenerator::gsa(std::vector<uint8_t>& out)
+    {
+        std::string body = "GPGSA,A,3";
+        uint8_t listed = 0;
+        for (uint8_t i = 0; (i < satellites_) && (i < 32) && (listed < 12);
+             ++i, ++listed)
+        {
+            char sv[8];
+            std::snprintf(sv, sizeof(sv), ",%02u", svid(i));
+            body += sv;
+        }
+        for (; listed < 12; ++listed)
+            body += ",";
+        body += ",1.5,0.8,1.2";
+        sentence(out, body);
+    }
+
+    void StreamGenerator::gsv(std::vector<uint8_t>& out)
+    {
+        uint8_t in_view = satellites_ < 32 ? satellites_ : 32;
+        if (in_view == 0)
+            return;
+        uint8_t sentences = (in_view + 3) / 4;
+        for (uint8_t n = 0; n < sentences; ++n)
+        {
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "GPGSV,%u,%u,%02u", sentences, n + 1,
+                          in_view);
+            std::string body = buf;
+            for (uint8_t i = 4 * n; i < 4 * n + 4 && i < in_view; ++i)
+            {
+                std::snprintf(buf, sizeof(buf), ",%02u,%02d,%03u,%02u", svid(i),
+                              elevation(i), azimuth(i), 45 - i % 8);
+                body += buf;
+            }
+            sentence(out, body);
+        }
+    }
+} // namespace io_comm_rx
@@ -0,0 +1,286 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/stream_recorder.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @file stream_recorder.cpp
+ * @brief Defines a class that records the raw byte stream of the Rx to disk
+ * @date 19/10/26
+ */
+
+namespace io_comm_rx {
+
+    //! Magic at the start of the receive time index of a recording
+    static const char RECORDING_INDEX_MAGIC[8] = {'S', 'B', 'F', 'T',
+                                                  'S', '0', '0', '1'};
+
+    //! Interval in which partially filled buffers are written to disk
+    static const std::chrono::seconds RECORDING_FLUSH_INTERVAL(1);
+
+    //! Writes all bytes, retrying on partial writes and interrupts
+    static bool writeAll(int fd, const void* data, std::size_t size)
+    {
+        const uint8_t* pos = static_cast<const uint8_t*>(data);
+        while (size > 0)
+        {
+            ssize_t n = ::write(fd, pos, size);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            pos += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    StreamRecorder::StreamRecorder(LogSink* logger, const std::string& directory,
+                                   const std::string& prefix,
+                                   uint64_t max_file_size,
+                                   double max_file_duration,
+                                   std::size_t buffer_size) :
+        logger_(logger),
+        directory_(directory), prefix_(prefix), max_file_size_(max_file_size),
+        max_file_duration_(
+            (max_file_duration > 0.0)
+                ? static_cast<uint64_t>(max_file_duration * 1000000000.0)
+                : 0),
+        buffer_size_(buffer_size), active_(&chunks_[0])
+    {
+        for (Chunk& chunk : chunks_)
+            chunk.data.reserve(buffer_size_);
+        if ((::mkdir(directory_.c_str(), 0755) != 0) && (errno != EEXIST))
+            logger_->log(LogLevel::ERROR, "Could not create " + directory_ + ": " +
+                                              std::strerror(errno));
+        thread_ = std::thread(&StreamRecorder::run, this);
+    }
+
+    StreamRecorder::~StreamRecorder() { close(); }
+
+    void StreamRecorder::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closing_)
+                return;
+            closing_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    uint64_t StreamRecorder::dropped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    void StreamRecorder::write(uint64_t recv_time, const uint8_t* data,
+                               std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closing_)
+            return;
+        if (!active_->data.empty() && (active_->data.size() + size > buffer_size_))
+        {
+            if (flushing_)
+            {
+                dropped_ += size;
+                return;
+            }
+            flushing_ = active_;
+            active_ = (active_ == &chunks_[0]) ? &chunks_[1] : &chunks_[0];
+            cv_.notify_one();
+        }
+        active_->reads.push_back({active_->data.size(), recv_time});
+        active_->data.insert(active_->data.end(), data, data + size);
+    }
+
+    void StreamRecorder::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            cv_.wait_for(lock, RECORDING_FLUSH_INTERVAL,
+                         [this]() { return closing_ || flushing_; });
+            // Also write partially filled buffers, such that little is lost if
+            // the driver is killed
+            if (!flushing_ && !active_->data.empty())
+            {
+                flushing_ = active_;
+                active_ = (active_ == &chunks_[0]) ? &chunks_[1] : &chunks_[0];
+            }
+            if (!flushing_)
+            {
+                if (closing_)
+                    break;
+                continue;
+            }
+            Chunk* chunk = flushing_;
+            uint64_t dropped = dropped_;
+            lock.unlock();
+
+            if (dropped > dropped_reported_)
+            {
+                logger_->log(LogLevel::WARN,
+                             "Disk too slow, dropped " +
+                                 std::to_string(dropped - dropped_reported_) +
+                                 " bytes of the recording");
+                dropped_reported_ = dropped;
+            }
+            writeChunk(*chunk);
+            chunk->data.clear();
+            chunk->reads.clear();
+
+            lock.lock();
+            flushing_ = nullptr;
+        }
+        lock.unlock();
+        closeFiles();
+    }
+
+    void StreamRecorder::writeChunk(const Chunk& chunk)
+    {
+        // Runs of reads that go to the same file are appended by one write
+        std::size_t run_start = 0;
+        std::vector<RecordedRead> run_reads;
+        for (std::size_t i = 0; i < chunk.reads.size(); ++i)
+        {
+            if (failed_)
+                return;
+            const RecordedRead& read = chunk.reads[i];
+            std::size_t read_end = (i + 1 < chunk.reads.size())
+                                       ? chunk.reads[i + 1].offset
+                                       : chunk.data.size();
+            uint64_t size_after = file_size_ + (read_end - run_start);
+            bool rotate =
+                (data_fd_ >= 0) && (file_size_ + (read.offset - run_start) > 0) &&
+                (((max_file_size_ > 0) && (size_after > max_file_size_)) ||
+                 ((max_file_duration_ > 0) &&
+                  (read.recv_time >= file_start_ + max_file_duration_)));
+            if ((data_fd_ >= 0) && !rotate)
+            {
+                run_reads.push_back(
+                    {file_size_ + (read.offset - run_start), read.recv_time});
+                continue;
+            }
+            if (data_fd_ >= 0)
+            {
+                if (!append(chunk.data.data() + run_start, read.offset - run_start,
+                            run_reads))
+                    return;
+                closeFiles();
+            }
+            if (!openFiles(read.recv_time))
+                return;
+            run_start = read.offset;
+            run_reads.assign(1, {0, read.recv_time});
+        }
+        if (data_fd_ >= 0)
+            append(chunk.data.data() + run_start, chunk.data.size() - run_start,
+                   run_reads);
+    }
+
+    bool StreamRecorder::append(const uint8_t* data, std::size_t size,
+                                const std::vector<RecordedRead>& reads)
+    {
+        if (!writeAll(data_fd_, data, size) ||
+            !writeAll(index_fd_, reads.data(), reads.size() * sizeof(RecordedRead)))
+        {
+            fail("Could not write recording");
+            return false;
+        }
+        file_size_ += size;
+        return true;
+    }
+
+    bool StreamRecorder::openFiles(uint64_t recv_time)
+    {
+        std::time_t seconds = static_cast<std::time_t>(recv_time / 1000000000);
+        std::tm utc;
+        gmtime_r(&seconds, &utc);
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &utc);
+        char sequence[16];
+        std::snprintf(sequence, sizeof(sequence), "_%03u", file_count_++);
+        std::string name =
+            directory_ + "/" + prefix_ + "_" + stamp + sequence + ".sbf";
+
+        data_fd_ = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (data_fd_ < 0)
+        {
+            fail("Could not open " + name + ": " + std::strerror(errno));
+            return false;
+        }
+        std::string index_name = name + ".ts";
+        index_fd_ = ::open(index_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if ((index_fd_ < 0) ||
+            !writeAll(index_fd_, RECORDING_INDEX_MAGIC,
+                      sizeof(RECORDING_INDEX_MAGIC)))
+        {
+            fail("Could not open " + index_name + ": " + std::strerror(errno));
+            return false;
+        }
+        file_size_ = 0;
+        file_start_ = recv_time;
+        logger_->log(LogLevel::INFO, "Recording raw stream to " + name);
+        return true;
+    }
+
+    void StreamRecorder::closeFiles()
+    {
+        if (data_fd_ >= 0)
+            ::close(data_fd_);
+        if (index_fd_ >= 0)
+            ::close(index_fd_);
+        data_fd_ = -1;
+        index_fd_ = -1;
+    }
+
+    void StreamRecorder::fail(const std::string& what)
+    {
+        logger_->log(LogLevel::ERROR, what + ", recording stopped");
+        closeFiles();
+        failed_ = true;
+    }
+} // namespace io_comm_rx
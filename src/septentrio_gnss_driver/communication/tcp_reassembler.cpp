@@ -0,0 +1,187 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/tcp_reassembler.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+#include <arpa/inet.h>
+
+/**
+ * @file tcp_reassembler.cpp
+ * @brief Defines a class that reassembles the byte streams of captured TCP
+ * flows
+ * @date 19/10/26
+ */
+
+namespace pcapReader {
+
+    bool TcpFlowKey::operator<(const TcpFlowKey& other) const
+    {
+        return std::tie(ip_version, src_addr, dst_addr, src_port, dst_port) <
+               std::tie(other.ip_version, other.src_addr, other.dst_addr,
+                        other.src_port, other.dst_port);
+    }
+
+    std::string TcpFlowKey::toString() const
+    {
+        int family = (ip_version == 6) ? AF_INET6 : AF_INET;
+        char src[INET6_ADDRSTRLEN] = "";
+        char dst[INET6_ADDRSTRLEN] = "";
+        inet_ntop(family, src_addr.data(), src, sizeof(src));
+        inet_ntop(family, dst_addr.data(), dst, sizeof(dst));
+        return std::string(src) + ":" + std::to_string(src_port) + " -> " + dst +
+               ":" + std::to_string(dst_port);
+    }
+
+    TcpReassembler::TcpReassembler(LogSink* logger, std::size_t max_held_back) :
+        logger_(logger), max_held_back_(max_held_back)
+    {
+    }
+
+    void TcpReassembler::addSegment(const TcpFlowKey& key, uint32_t seq, bool syn,
+                                    const uint8_t* payload, std::size_t length)
+    {
+        auto it = flows_.find(key);
+        if (it == flows_.end())
+        {
+            it = flows_.emplace(key, Flow()).first;
+            it->second.name = key.toString();
+            it->second.next_seq = syn ? seq + 1 : seq;
+        }
+        Flow& flow = it->second;
+        // SYN takes up one sequence number
+        if (syn)
+        {
+            ++seq;
+            // A new connection between the same ports, unless the SYN was
+            // retransmitted
+            if (seq != flow.next_seq)
+            {
+                flow.stream.clear();
+                flow.held_back.clear();
+                flow.held_back_bytes = 0;
+                flow.next_seq = seq;
+            }
+        }
+        if (length == 0)
+            return;
+
+        // Position relative to the next byte expected, modulo 2^32
+        int64_t rel = static_cast<int32_t>(seq - flow.next_seq);
+        if (rel + static_cast<int64_t>(length) <= 0)
+        {
+            retransmitted_bytes_ += length;
+            return;
+        }
+        if (rel <= 0)
+        {
+            std::size_t skip = static_cast<std::size_t>(-rel);
+            retransmitted_bytes_ += skip;
+            append(flow, payload + skip, length - skip);
+            drain(flow);
+            return;
+        }
+
+        std::vector<uint8_t>& held = flow.held_back[flow.next_offset + rel];
+        if (held.size() < length)
+        {
+            flow.held_back_bytes += length - held.size();
+            held.assign(payload, payload + length);
+        } else
+            retransmitted_bytes_ += length;
+        while (flow.held_back_bytes > max_held_back_)
+            skipGap(flow);
+    }
+
+    void TcpReassembler::flush()
+    {
+        for (auto& entry : flows_)
+        {
+            while (!entry.second.held_back.empty())
+                skipGap(entry.second);
+        }
+    }
+
+    std::vector<uint8_t>* TcpReassembler::nextReadyStream()
+    {
+        if (ready_.empty())
+            return nullptr;
+        Flow* flow = ready_.front();
+        ready_.pop_front();
+        flow->ready = false;
+        return &flow->stream;
+    }
+
+    void TcpReassembler::append(Flow& flow, const uint8_t* data, std::size_t length)
+    {
+        flow.stream.insert(flow.stream.end(), data, data + length);
+        flow.next_seq += static_cast<uint32_t>(length);
+        flow.next_offset += length;
+        if (!flow.ready)
+        {
+            flow.ready = true;
+            ready_.push_back(&flow);
+        }
+    }
+
+    void TcpReassembler::drain(Flow& flow)
+    {
+        while (!flow.held_back.empty())
+        {
+            auto it = flow.held_back.begin();
+            if (it->first > flow.next_offset)
+                break;
+            const std::vector<uint8_t>& data = it->second;
+            std::size_t overlap = static_cast<std::size_t>(
+                std::min<uint64_t>(flow.next_offset - it->first, data.size()));
+            retransmitted_bytes_ += overlap;
+            if (overlap < data.size())
+                append(flow, data.data() + overlap, data.size() - overlap);
+            flow.held_back_bytes -= data.size();
+            flow.held_back.erase(it);
+        }
+    }
+
+    void TcpReassembler::skipGap(Flow& flow)
+    {
+        uint64_t next_offset = flow.held_back.begin()->first;
+        uint64_t missing = next_offset - flow.next_offset;
+        ++gaps_;
+        missing_bytes_ += missing;
+        logger_->log(LogLevel::WARN, "Skipping " + std::to_string(missing) +
+                                         " missing bytes in TCP flow " +
+                                         flow.name);
+        flow.next_seq += static_cast<uint32_t>(missing);
+        flow.next_offset = next_offset;
+        drain(flow);
+    }
+} // namespace pcapReader
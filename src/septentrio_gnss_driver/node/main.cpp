@@ -39,7 +39,21 @@
 int main(int argc, char** argv)
 {
     ros::init(argc, argv, "septentrio_gnss");
-  	
+
+    // Several Rxs are handled by one process if their names are given, each
+    // with its parameters in the private namespace of its name
+    ros::NodeHandle pNh("~");
+    std::vector<std::string> receivers;
+    if (pNh.getParam("receivers", receivers) && !receivers.empty())
+    {
+        int io_threads;
+        pNh.param("io_threads", io_threads, 2);
+        rosaic_node::MultiReceiverNode rx_nodes(
+            receivers, static_cast<uint32_t>(std::max(io_threads, 1)));
+        ros::spin();
+        return 0;
+    }
+
     rosaic_node::ROSaicNode
         rx_node; // This launches everything we need, in theory :)
     ros::spin();
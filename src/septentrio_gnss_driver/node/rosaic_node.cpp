@@ -38,7 +38,11 @@
  * @brief The heart of the ROSaic driver: The ROS node that represents it
  */
 
-rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_)
+rosaic_node::ROSaicNode::ROSaicNode(
+    const std::string& name,
+    const boost::shared_ptr<boost::asio::io_service>& io_service) :
+    ROSaicNodeBase(name),
+    IO_(this, &settings_, io_service)
 {
     param("activate_debug_log", settings_.activate_debug_log, false);
     if (settings_.activate_debug_log)
@@ -58,6 +62,19 @@ rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_)
     if (!getROSParams())
         return;
 
+    // Before any thread or buffer of the I/O is created, so that they are
+    // locked as well. An Rx of a MultiReceiverNode relies on the process-wide
+    // setting.
+    if (settings_.lock_memory && name_.empty())
+    {
+        std::string error;
+        if (io_comm_rx::realtime::lockMemory(
+                static_cast<std::size_t>(settings_.prefault_heap) << 20, error))
+            this->log(LogLevel::INFO, "Locked memory of the process.");
+        else
+            this->log(LogLevel::WARN, "Unable to lock memory: " + error);
+    }
+
     // Initializes Connection
     IO_.initializeIO();
 
@@ -72,22 +89,74 @@ rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_)
         IO_.configureRx();
     }
 
+    // Timer and service are handled by ros::spin(), hence never concurrently
+    statisticsService_ = pNh_->advertiseService(
+        "get_statistics", &ROSaicNode::getStatistics, this);
+    if (settings_.publish_statistics || settings_.publish_latency)
+        statisticsTimer_ = pNh_->createTimer(
+            ros::Duration(1.0), &ROSaicNode::publishStatistics, this);
+
     this->log(LogLevel::DEBUG, "Leaving ROSaicNode() constructor..");
 }
 
+void rosaic_node::ROSaicNode::publishStatistics(const ros::TimerEvent& event)
+{
+    DiagnosticArrayMsg msg;
+    msg.header.stamp = ros::Time::now();
+    if (settings_.publish_statistics)
+    {
+        io_comm_rx::RxStatistics::Snapshot current;
+        statistics_.snapshot(current);
+        msg.status.emplace_back();
+        io_comm_rx::toStatus(current, &lastStatistics_, msg.status.back());
+        lastStatistics_ = std::move(current);
+    }
+    if (settings_.publish_latency)
+    {
+        msg.status.emplace_back();
+        io_comm_rx::toStatus(latency_, settings_.latency_congestion_threshold,
+                             msg.status.back());
+    }
+    // Distinguishes the Rxs on the shared /diagnostics
+    if (!name_.empty())
+        for (auto& status : msg.status)
+            status.name = name_ + "/" + status.name;
+    publishMessage<DiagnosticArrayMsg>("/diagnostics", msg);
+}
+
+bool rosaic_node::ROSaicNode::getStatistics(
+    septentrio_gnss_driver::GetStatistics::Request& req,
+    septentrio_gnss_driver::GetStatistics::Response& res)
+{
+    io_comm_rx::RxStatistics::Snapshot current;
+    statistics_.snapshot(current);
+    io_comm_rx::toStatus(current, &lastStatistics_, res.statistics);
+    io_comm_rx::toStatus(latency_, settings_.latency_congestion_threshold,
+                         res.latency);
+    if (req.reset)
+    {
+        statistics_.reset();
+        latency_.reset();
+        statistics_.snapshot(lastStatistics_);
+    } else
+    {
+        lastStatistics_ = std::move(current);
+    }
+    return true;
+}
+
 bool rosaic_node::ROSaicNode::getROSParams()
 {
     param("use_gnss_time", settings_.use_gnss_time, true);
-    param("frame_id", settings_.frame_id, (std::string) "gnss");
-    param("imu_frame_id", settings_.imu_frame_id, (std::string) "imu");
-    param("poi_frame_id", settings_.poi_frame_id, (std::string) "base_link");
-    param("vsm_frame_id", settings_.vsm_frame_id, (std::string) "vsm");
-    param("aux1_frame_id", settings_.aux1_frame_id, (std::string) "aux1");
-    param("vehicle_frame_id", settings_.vehicle_frame_id, settings_.poi_frame_id);
-    param("local_frame_id", settings_.local_frame_id, (std::string) "odom");
-    param("insert_local_frame", settings_.insert_local_frame, false);
-    param("lock_utm_zone", settings_.lock_utm_zone, true);
-    param("leap_seconds", settings_.leap_seconds, -128);
+    param("use_clock_model", settings_.use_clock_model, false);
+    if (settings_.use_gnss_time && settings_.use_clock_model)
+    {
+        this->log(LogLevel::WARN,
+                  "use_clock_model is ignored since use_gnss_time is set.");
+        settings_.use_clock_model = false;
+    }
+    if (!getOutputParams())
+        return false;
 
     // Communication parameters
     param("device", settings_.device, std::string("/dev/ttyACM0"));
@@ -97,23 +166,85 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("serial/rx_serial_port", settings_.rx_serial_port, std::string("USB1"));
     param("login/user", settings_.login_user, std::string(""));
     param("login/password", settings_.login_password, std::string(""));
-    settings_.reconnect_delay_s = 2.0f; // Removed from ROS parameter list.
-    param("receiver_type", settings_.septentrio_receiver_type, std::string("gnss"));
-    if (!((settings_.septentrio_receiver_type == "gnss") ||
-          (settings_.septentrio_receiver_type == "ins") ||
-          (settings_.septentrio_receiver_type == "ins_in_gnss_mode")))
-    {
-        this->log(LogLevel::FATAL, "Unkown septentrio_receiver_type " +
-                                       settings_.septentrio_receiver_type +
-                                       " use either gnss or ins.");
-        return false;
+    param("replay/pcap_filter", settings_.pcap_filter, std::string("tcp"));
+    param("replay/pcap_pacing", settings_.pcap_pacing, std::string("sbf"));
+    if ((settings_.pcap_pacing != "sbf") && (settings_.pcap_pacing != "packet"))
+    {
+        this->log(LogLevel::WARN, "Unknown replay/pcap_pacing " +
+                                      settings_.pcap_pacing + ", using sbf.");
+        settings_.pcap_pacing = "sbf";
+    }
+    std::string replay_mode;
+    param("replay/mode", replay_mode, std::string("realtime"));
+    param("replay/rate", settings_.replay_rate, 1.0);
+    if (replay_mode == "realtime")
+    {
+        settings_.replay_rate = 1.0;
+    } else if (replay_mode == "unthrottled")
+    {
+        settings_.replay_rate = 0.0;
+    } else if (replay_mode != "rate")
+    {
+        this->log(LogLevel::WARN,
+                  "Unknown replay/mode " + replay_mode + ", using realtime.");
+        settings_.replay_rate = 1.0;
+    } else if (settings_.replay_rate <= 0.0)
+    {
+        this->log(LogLevel::WARN,
+                  "replay/rate has to be positive, using unthrottled replay.");
+        settings_.replay_rate = 0.0;
+    }
+    param("replay/publish_clock", settings_.publish_clock, false);
+    param("replay/start_time", settings_.replay_start_time, 0.0);
+    param("replay/end_time", settings_.replay_end_time, 0.0);
+    param("replay/index_file", settings_.replay_index_file, true);
+    param("replay/batch", settings_.replay_batch, false);
+    param("replay/batch_output", settings_.replay_batch_output, std::string(""));
+    param("record/directory", settings_.record_directory, std::string(""));
+    param("record/prefix", settings_.record_prefix, std::string("rx"));
+    getUint32Param("record/max_file_size", settings_.record_max_file_size,
+                   static_cast<uint32_t>(1024));
+    param("record/max_file_duration", settings_.record_max_file_duration, 3600.0);
+    param("parse_queue/policy", settings_.parse_queue_policy,
+          std::string("block"));
+    io_comm_rx::DropPolicy policy;
+    if (!io_comm_rx::ParseQueue::toPolicy(settings_.parse_queue_policy, policy))
+    {
+        this->log(LogLevel::WARN, "Unknown parse_queue/policy " +
+                                      settings_.parse_queue_policy +
+                                      ", using block.");
+        settings_.parse_queue_policy = "block";
+    }
+    getUint32Param("parse_queue/capacity", settings_.parse_queue_capacity,
+                   static_cast<uint32_t>(256));
+    // The longest SBF block has to fit
+    if (settings_.parse_queue_capacity < 64)
+    {
+        this->log(LogLevel::WARN, "parse_queue/capacity is raised to 64 kB.");
+        settings_.parse_queue_capacity = 64;
     }
+    param("decode_priority/enabled", settings_.decode_priority, false);
+    // PVT, covariance, attitude, base vector and INS blocks by default
+    param("decode_priority/blocks", settings_.decode_priority_blocks,
+          std::vector<int32_t>{4006, 4007, 4028, 4043, 4050, 4225, 4226, 5905,
+                               5906, 5907, 5908, 5938, 5939});
+    settings_.reconnect_delay_s = 2.0f; // Removed from ROS parameter list.
 
-    if (settings_.septentrio_receiver_type == "ins_in_gnss_mode")
+    // Real-time parameters
+    for (const std::string& role :
+         {"io", "parsing", "waiting", "connection", "recorder"})
     {
-        settings_.septentrio_receiver_type = "gnss";
-        settings_.ins_in_gnss_mode = true;
+        ThreadSettings thread_settings;
+        param("threads/" + role + "/cpus", thread_settings.cpus,
+              std::vector<int32_t>());
+        param("threads/" + role + "/policy", thread_settings.policy,
+              std::string("other"));
+        param("threads/" + role + "/priority", thread_settings.priority, 0);
+        settings_.threads[role] = thread_settings;
     }
+    param("lock_memory", settings_.lock_memory, false);
+    getUint32Param("prefault_heap", settings_.prefault_heap,
+                   static_cast<uint32_t>(0));
 
     // Polling period parameters
     getUint32Param("polling_period/pvt", settings_.polling_period_pvt,
@@ -137,49 +268,6 @@ bool rosaic_node::ROSaicNode::getROSParams()
         return false;
     }
 
-    // multi_antenna param
-    param("multi_antenna", settings_.multi_antenna, false);
-
-    // Publishing parameters
-    param("publish/gpst", settings_.publish_gpst, false);
-    param("publish/navsatfix", settings_.publish_navsatfix, true);
-    param("publish/gpsfix", settings_.publish_gpsfix, false);
-    param("publish/pose", settings_.publish_pose, false);
-    param("publish/diagnostics", settings_.publish_diagnostics, false);
-    param("publish/gpgga", settings_.publish_gpgga, false);
-    param("publish/gprmc", settings_.publish_gprmc, false);
-    param("publish/gpgsa", settings_.publish_gpgsa, false);
-    param("publish/gpgsv", settings_.publish_gpgsv, false);
-    param("publish/measepoch", settings_.publish_measepoch, false);
-    param("publish/pvtcartesian", settings_.publish_pvtcartesian, false);
-    param("publish/pvtgeodetic", settings_.publish_pvtgeodetic,
-          (settings_.septentrio_receiver_type == "gnss"));
-    param("publish/basevectorcart", settings_.publish_basevectorcart, false);
-    param("publish/basevectorgeod", settings_.publish_basevectorgeod, false);
-    param("publish/poscovcartesian", settings_.publish_poscovcartesian, false);
-    param("publish/poscovgeodetic", settings_.publish_poscovgeodetic,
-          (settings_.septentrio_receiver_type == "gnss"));
-    param("publish/velcovgeodetic", settings_.publish_velcovgeodetic,
-          (settings_.septentrio_receiver_type == "gnss"));
-    param(
-        "publish/atteuler", settings_.publish_atteuler,
-        ((settings_.septentrio_receiver_type == "gnss") && settings_.multi_antenna));
-    param(
-        "publish/attcoveuler", settings_.publish_attcoveuler,
-        ((settings_.septentrio_receiver_type == "gnss") && settings_.multi_antenna));
-    param("publish/insnavcart", settings_.publish_insnavcart, false);
-    param("publish/insnavgeod", settings_.publish_insnavgeod,
-          (settings_.septentrio_receiver_type == "ins"));
-    param("publish/imusetup", settings_.publish_imusetup, false);
-    param("publish/velsensorsetup", settings_.publish_velsensorsetup, false);
-    param("publish/exteventinsnavgeod", settings_.publish_exteventinsnavgeod, false);
-    param("publish/exteventinsnavcart", settings_.publish_exteventinsnavcart, false);
-    param("publish/extsensormeas", settings_.publish_extsensormeas, false);
-    param("publish/imu", settings_.publish_imu, false);
-    param("publish/localization", settings_.publish_localization, false);
-    param("publish/twist", settings_.publish_twist, false);
-    param("publish/tf", settings_.publish_tf, false);
-
     // Datum and marker-to-ARP offset
     param("datum", settings_.datum, std::string("Default"));
     param("ant_type", settings_.ant_type, std::string("Unknown"));
@@ -206,8 +294,6 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("poi_to_arp/delta_n", settings_.delta_n, 0.0f);
     param("poi_to_arp/delta_u", settings_.delta_u, 0.0f);
 
-    param("use_ros_axis_orientation", settings_.use_ros_axis_orientation, true);
-
     // INS Spatial Configuration
     bool getConfigFromTf;
     param("get_spatial_config_from_tf", getConfigFromTf, false);
@@ -362,17 +448,6 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("ins_std_dev_mask/att_std_dev", settings_.att_std_dev, 5.0f);
     param("ins_std_dev_mask/pos_std_dev", settings_.pos_std_dev, 10.0f);
 
-    // INS solution reference point
-    param("ins_use_poi", settings_.ins_use_poi, false);
-
-    if (settings_.publish_tf && !settings_.ins_use_poi)
-    {
-        this->log(
-            LogLevel::ERROR,
-            "If tf shall be published, ins_use_poi has to be set to true! It is set automatically to true.");
-        settings_.ins_use_poi = true;
-    }
-
     // RTK correction parameters
     // NTRIP
     for (uint8_t i = 1; i < 4; ++i)
@@ -496,17 +571,6 @@ bool rosaic_node::ROSaicNode::getROSParams()
                 "Deprecation warning: parameter ntrip_settings/rx_input_corrections_serial has been removed, see README under section rtk_settings.");
     }
 
-    if (settings_.publish_atteuler)
-    {
-        if (!settings_.multi_antenna)
-        {
-            this->log(
-                LogLevel::WARN,
-                "AttEuler needs multi-antenna receiver. Multi-antenna setting automatically activated. Deactivate publishing of AttEuler if multi-antenna operation is not available.");
-            settings_.multi_antenna = true;
-        }
-    }
-
     // VSM - velocity sensor measurements for INS
     if (settings_.septentrio_receiver_type == "ins")
     {
@@ -670,4 +734,69 @@ void rosaic_node::ROSaicNode::getRPY(const QuaternionMsg& qm, double& roll,
 void rosaic_node::ROSaicNode::sendVelocity(const std::string& velNmea)
 {
     IO_.sendVelocity(velNmea);
-}
\ No newline at end of file
+}
+
+rosaic_node::MultiReceiverNode::MultiReceiverNode(
+    const std::vector<std::string>& receivers, uint32_t io_threads) :
+    ioService_(new boost::asio::io_service),
+    work_(new boost::asio::io_service::work(*ioService_)),
+    nodes_(receivers.size())
+{
+    // Process-wide real-time settings live in the private namespace of the
+    // process, those of the threads of each Rx in the one of its name
+    ros::NodeHandle pNh("~");
+    bool lock_memory;
+    pNh.param("lock_memory", lock_memory, false);
+    if (lock_memory)
+    {
+        int prefault_heap;
+        pNh.param("prefault_heap", prefault_heap, 0);
+        std::string error;
+        if (io_comm_rx::realtime::lockMemory(
+                static_cast<std::size_t>(std::max(prefault_heap, 0)) << 20, error))
+            ROS_INFO_STREAM(ros::this_node::getName()
+                            << ": Locked memory of the process.");
+        else
+            ROS_WARN_STREAM(ros::this_node::getName()
+                            << ": Unable to lock memory: " << error);
+    }
+    ThreadSettings io_settings;
+    pNh.param("threads/io/cpus", io_settings.cpus, std::vector<int32_t>());
+    pNh.param("threads/io/policy", io_settings.policy, std::string("other"));
+    pNh.param("threads/io/priority", io_settings.priority, 0);
+    for (uint32_t i = 0; i < std::max(io_threads, 1u); ++i)
+    {
+        boost::thread* worker = workers_.create_thread(
+            boost::bind(&boost::asio::io_service::run, ioService_.get()));
+        std::string error;
+        std::string name = "rx_io" + std::to_string(i);
+        if (!io_comm_rx::realtime::configureThread(worker->native_handle(), name,
+                                                   io_settings, error))
+            ROS_WARN_STREAM(ros::this_node::getName()
+                            << ": Unable to configure thread " << name << ": "
+                            << error);
+    }
+    ROS_INFO_STREAM(ros::this_node::getName()
+                    << ": Handling " << receivers.size() << " Rxs with "
+                    << std::max(io_threads, 1u) << " I/O threads.");
+    // Connecting and configuring blocks until the Rx answers, hence the Rxs
+    // are started concurrently
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        std::unique_ptr<ROSaicNode>* node = &nodes_[i];
+        std::string name = receivers[i];
+        boost::shared_ptr<boost::asio::io_service> io_service = ioService_;
+        starters_.create_thread([node, name, io_service]() {
+            node->reset(new ROSaicNode(name, io_service));
+        });
+    }
+}
+
+rosaic_node::MultiReceiverNode::~MultiReceiverNode()
+{
+    starters_.join_all();
+    nodes_.clear();
+    work_.reset();
+    ioService_->stop();
+    workers_.join_all();
+}
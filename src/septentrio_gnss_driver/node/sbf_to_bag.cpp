@@ -0,0 +1,115 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <iostream>
+
+#include <septentrio_gnss_driver/node/sbf_to_bag.hpp>
+
+/**
+ * @file sbf_to_bag.cpp
+ * @date 19/10/26
+ * @brief Converts SBF logs to rosbags without a ROS master, usage:
+ * sbf_to_bag <input.sbf> <output.bag> [name:=value ...]
+ */
+
+rosaic_node::SbfToBag::SbfToBag(io_comm_rx::BagWriter* bag_writer,
+                                const std::map<std::string, std::string>& params) :
+    ROSaicNodeBase(bag_writer, params), IO_(this, &settings_)
+{
+    // There is no receiver to be reset when the converter is destroyed
+    settings_.read_from_sbf_log = true;
+    settings_.read_from_pcap = false;
+}
+
+bool rosaic_node::SbfToBag::convert(const std::string& file_name)
+{
+    if (!getOutputParams())
+        return false;
+    getUint32Param("polling_period/pvt", settings_.polling_period_pvt,
+                   static_cast<uint32_t>(1000));
+    getUint32Param("polling_period/rest", settings_.polling_period_rest,
+                   static_cast<uint32_t>(1000));
+
+    // The whole log is converted as fast as possible, bag times are GNSS times
+    settings_.device = "file_name:" + file_name;
+    settings_.use_gnss_time = true;
+    settings_.replay_rate = 0.0;
+    settings_.publish_clock = false;
+    settings_.replay_start_time = 0.0;
+    settings_.replay_end_time = 0.0;
+    settings_.replay_index_file = false;
+    settings_.replay_batch = false;
+
+    IO_.defineMessages();
+    return IO_.readSBFFile(file_name);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <input.sbf> <output.bag> [name:=value ...]" << std::endl;
+        return 1;
+    }
+    std::map<std::string, std::string> params;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        std::size_t pos = arg.find(":=");
+        if (pos == std::string::npos)
+        {
+            std::cerr << "Ignoring argument " << arg
+                      << ", parameters are given as name:=value" << std::endl;
+            continue;
+        }
+        params[arg.substr(0, pos)] = arg.substr(pos + 2);
+    }
+
+    // Only wall time is needed, which works without a ROS master
+    ros::Time::init();
+    try
+    {
+        io_comm_rx::BagWriter writer(argv[2]);
+        rosaic_node::SbfToBag converter(&writer, params);
+        if (!converter.convert(argv[1]))
+            return 1;
+        writer.close();
+        std::cout << "Wrote " << writer.written() << " messages to " << argv[2]
+                  << std::endl;
+    } catch (const std::exception& e)
+    {
+        // E.g. rosbag::BagException if the bag cannot be opened or written
+        std::cerr << "Could not write " << argv[2] << ": " << e.what()
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
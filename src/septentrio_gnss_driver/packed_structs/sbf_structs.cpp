@@ -0,0 +1,68 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+
+/**
+ * @file sbf_structs.cpp
+ * @brief Instantiates the SBF parsers for the plain structs on raw buffers
+ *
+ * Users of the protocol core thereby link the decoders instead of compiling
+ * them anew, and the core library fails to build if a parser starts to depend
+ * on a ROS message.
+ * @date 19/10/26
+ */
+
+typedef const uint8_t* SbfIt;
+
+template bool ChannelStatusParser(LogSink*, SbfIt, SbfIt, ChannelStatus&);
+template bool DOPParser(LogSink*, SbfIt, SbfIt, DOP&);
+template bool MeasEpochParser(LogSink*, SbfIt, SbfIt, MeasEpoch&);
+template bool MeasEpochColumnarParser(LogSink*, SbfIt, SbfIt, MeasEpochColumnar&);
+template bool ReceiverSetupParser(LogSink*, SbfIt, SbfIt, ReceiverSetup&);
+template bool ReceiverTimeParser(LogSink*, SbfIt, SbfIt, ReceiverTime&);
+template bool PVTCartesianParser(LogSink*, SbfIt, SbfIt, PVTCartesian&);
+template bool PVTGeodeticParser(LogSink*, SbfIt, SbfIt, PVTGeodetic&);
+template bool AttEulerParser(LogSink*, SbfIt, SbfIt, AttEuler&, bool);
+template bool AttCovEulerParser(LogSink*, SbfIt, SbfIt, AttCovEuler&, bool);
+template bool BaseVectorCartParser(LogSink*, SbfIt, SbfIt, BaseVectorCart&);
+template bool BaseVectorGeodParser(LogSink*, SbfIt, SbfIt, BaseVectorGeod&);
+template bool PosCovCartesianParser(LogSink*, SbfIt, SbfIt, PosCovCartesian&);
+template bool PosCovGeodeticParser(LogSink*, SbfIt, SbfIt, PosCovGeodetic&);
+template bool VelCovCartesianParser(LogSink*, SbfIt, SbfIt, VelCovCartesian&);
+template bool VelCovGeodeticParser(LogSink*, SbfIt, SbfIt, VelCovGeodetic&);
+template bool QualityIndParser(LogSink*, SbfIt, SbfIt, QualityInd&);
+template bool ReceiverStatusParser(LogSink*, SbfIt, SbfIt, ReceiverStatus&);
+template bool INSNavCartParser(LogSink*, SbfIt, SbfIt, INSNavCart&, bool);
+template bool INSNavGeodParser(LogSink*, SbfIt, SbfIt, INSNavGeod&, bool);
+template bool IMUSetupParser(LogSink*, SbfIt, SbfIt, IMUSetup&, bool);
+template bool VelSensorSetupParser(LogSink*, SbfIt, SbfIt, VelSensorSetup&, bool);
+template bool ExtSensorMeasParser(LogSink*, SbfIt, SbfIt, ExtSensorMeas&, bool,
+                                  bool&);
@@ -0,0 +1,115 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+/**
+ * @file framer.cpp
+ * @brief Defines a class that cuts a byte stream into SBF blocks and NMEA
+ * sentences
+ * @date 19/10/26
+ */
+
+//! Length of the SBF header up to and including the length field
+static const std::size_t SBF_HEADER_LENGTH = 8;
+//! Longest NMEA sentence accepted, proprietary ones exceed the 82 characters
+//! of the standard
+static const std::size_t MAX_NMEA_LENGTH = 1024;
+//! 0x24 is ASCII for $ - 1st byte of an NMEA sentence
+static const uint8_t NMEA_SYNC_1 = 0x24;
+//! 0x47 is ASCII for G - 2nd byte of a standardized NMEA sentence
+static const uint8_t NMEA_SYNC_2_STANDARD = 0x47;
+//! 0x50 is ASCII for P - 2nd byte of a proprietary NMEA sentence
+static const uint8_t NMEA_SYNC_2_PROPRIETARY = 0x50;
+
+Framer::Framer(LogSink* logger, bool crc_check) :
+    logger_(logger), crc_check_(crc_check)
+{
+}
+
+bool Framer::next(const uint8_t*& data, std::size_t& count, Frame& frame)
+{
+    while (count >= 2)
+    {
+        if ((data[0] == SBF_SYNC_BYTE_1) && (data[1] == SBF_SYNC_BYTE_2))
+        {
+            if (count < SBF_HEADER_LENGTH)
+                return false;
+            uint16_t length = parsing_utilities::getLength(data);
+            if ((length >= SBF_HEADER_LENGTH) && ((length % 4) == 0))
+            {
+                if (count < length)
+                    return false;
+                if (!crc_check_ || isValid(data))
+                {
+                    frame.type = FrameType::SBF;
+                    frame.data = data;
+                    frame.size = length;
+                    data += length;
+                    count -= length;
+                    return true;
+                }
+                ++crc_errors_;
+                logger_->log(LogLevel::DEBUG,
+                             "CRC check failed for SBF block " +
+                                 std::to_string(parsing_utilities::getId(data)));
+            }
+        } else if ((data[0] == NMEA_SYNC_1) &&
+                   ((data[1] == NMEA_SYNC_2_STANDARD) ||
+                    (data[1] == NMEA_SYNC_2_PROPRIETARY)))
+        {
+            std::size_t search_length = std::min(count, MAX_NMEA_LENGTH);
+            const void* lf = std::memchr(data, '\n', search_length);
+            if (lf)
+            {
+                std::size_t length = static_cast<const uint8_t*>(lf) - data + 1;
+                frame.type = FrameType::NMEA;
+                frame.data = data;
+                frame.size = length;
+                data += length;
+                count -= length;
+                return true;
+            }
+            if (count < MAX_NMEA_LENGTH)
+                return false;
+            logger_->log(LogLevel::DEBUG, "NMEA sentence without line feed");
+        }
+        ++data;
+        --count;
+        ++skipped_bytes_;
+    }
+    return false;
+}
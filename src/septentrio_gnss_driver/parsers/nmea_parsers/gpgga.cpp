@@ -50,9 +50,9 @@ const std::string GpggaParser::getMessageID() const
  * the argument "sentence" here, though the checksum is never parsed: It would be
  * sentence.get_body()[15] if anybody ever needs it.
  */
-GpggaMsg GpggaParser::parseASCII(const NMEASentence& sentence,
-                                 const std::string& frame_id, bool use_gnss_time,
-                                 Timestamp time_obj) noexcept(false)
+Gpgga GpggaParser::parseASCII(const NMEASentence& sentence,
+                              const std::string& frame_id, bool use_gnss_time,
+                              Timestamp time_obj) noexcept(false)
 {
     // ROS_DEBUG("Just testing that first entry is indeed what we expect it to be:
     // %s", sentence.get_body()[0].c_str());
@@ -66,7 +66,7 @@ GpggaMsg GpggaParser::parseASCII(const NMEASentence& sentence,
         throw ParseException(error.str());
     }
 
-    GpggaMsg msg;
+    Gpgga msg;
     msg.header.frame_id = frame_id;
 
     msg.message_id = sentence.get_body()[0];
@@ -93,10 +93,10 @@ GpggaMsg GpggaParser::parseASCII(const NMEASentence& sentence,
                 Timestamp unix_time_nanoseconds =
                     unix_time_seconds * 1000000000 +
                     (static_cast<Timestamp>(utc_double * 100) % 100) * 10000;
-                msg.header.stamp = timestampToRos(unix_time_nanoseconds);
+                msg.header.stamp = unix_time_nanoseconds;
             } else
             {
-                msg.header.stamp = timestampToRos(time_obj);
+                msg.header.stamp = time_obj;
             }
         } else
         {
@@ -50,9 +50,9 @@ const std::string GpgsvParser::getMessageID() const
  * the argument "sentence" here, though the checksum is never parsed: E.g. for
  * message with 4 Svs it would be sentence.get_body()[20] if anybody ever needs it.
  */
-GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
-                                 const std::string& frame_id, bool /*use_gnss_time*/,
-                                 Timestamp /*time_obj*/) noexcept(false)
+Gpgsv GpgsvParser::parseASCII(const NMEASentence& sentence,
+                              const std::string& frame_id, bool /*use_gnss_time*/,
+                              Timestamp /*time_obj*/) noexcept(false)
 {
 
     const size_t MIN_LENGTH = 4;
@@ -64,7 +64,7 @@ GpgsvMsg GpgsvParser::parseASCII(const NMEASentence& sentence,
               << ". The actual length is " << sentence.get_body().size();
         throw ParseException(error.str());
     }
-    GpgsvMsg msg;
+    Gpgsv msg;
     msg.header.frame_id = frame_id;
     msg.message_id = sentence.get_body()[0];
     if (!parsing_utilities::parseUInt8(sentence.get_body()[1], msg.n_msgs))
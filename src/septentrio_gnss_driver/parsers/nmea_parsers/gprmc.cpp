@@ -54,9 +54,9 @@ const std::string GprmcParser::getMessageID() const
  * you should thus ignore it. This usually occurs when the GPS is still searching for
  * satellites. WasLastGPRMCValid() will return false in this case.
  */
-GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
-                                 const std::string& frame_id, bool use_gnss_time,
-                                 Timestamp time_obj) noexcept(false)
+Gprmc GprmcParser::parseASCII(const NMEASentence& sentence,
+                              const std::string& frame_id, bool use_gnss_time,
+                              Timestamp time_obj) noexcept(false)
 {
 
     // Checking the length first, it should be between 13 and 14 elements
@@ -71,7 +71,7 @@ GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
         throw ParseException(error.str());
     }
 
-    GprmcMsg msg;
+    Gprmc msg;
 
     msg.header.frame_id = frame_id;
 
@@ -97,10 +97,10 @@ GprmcMsg GprmcParser::parseASCII(const NMEASentence& sentence,
                 Timestamp unix_time_nanoseconds =
                     unix_time_seconds * 1000000000 +
                     (static_cast<Timestamp>(utc_double * 100) % 100) * 10000;
-                msg.header.stamp = timestampToRos(unix_time_nanoseconds);
+                msg.header.stamp = unix_time_nanoseconds;
             } else
             {
-                msg.header.stamp = timestampToRos(time_obj);
+                msg.header.stamp = time_obj;
             }
         } else
         {
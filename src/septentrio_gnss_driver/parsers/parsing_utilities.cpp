@@ -301,30 +301,6 @@ namespace parsing_utilities {
         return date;
     }
 
-    //! The rotational sequence convention we adopt here (and Septentrio receivers'
-    //! pitch, roll, yaw definition too) is the yaw-pitch-roll sequence, i.e. the
-    //! 3-2-1 sequence: The body first does yaw around the Z=Down-axis, then pitches
-    //! around the new Y=East=right-axis and finally rolls around the new
-    //! X=North=forward-axis.
-    QuaternionMsg convertEulerToQuaternion(double yaw, double pitch, double roll)
-    {
-        // Abbreviations for the angular functions
-        double cy = std::cos(yaw * 0.5);
-        double sy = std::sin(yaw * 0.5);
-        double cp = std::cos(pitch * 0.5);
-        double sp = std::sin(pitch * 0.5);
-        double cr = std::cos(roll * 0.5);
-        double sr = std::sin(roll * 0.5);
-
-        QuaternionMsg q;
-        q.w = cr * cp * cy + sr * sp * sy;
-        q.x = sr * cp * cy - cr * sp * sy;
-        q.y = cr * sp * cy + sr * cp * sy;
-        q.z = cr * cp * sy - sr * sp * cy;
-
-        return q;
-    }
-
     std::string convertUserPeriodToRxCommand(uint32_t period_user)
     {
         std::string cmd;
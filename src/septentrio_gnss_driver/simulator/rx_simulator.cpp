@@ -0,0 +1,981 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+// POSIX includes
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/decompressing_reader.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+#include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/simulator/rx_simulator.hpp>
+
+/**
+ * @file rx_simulator.cpp
+ * @date 19/10/26
+ * @brief Simulator of a Septentrio receiver: Answers the commands of the driver
+ * and streams SBF and NMEA over TCP, a pseudo terminal or UDP
+ */
+
+namespace {
+    //! Milliseconds in a GPS week
+    const uint64_t MS_PER_WEEK = 604800000;
+    //! Largest UDP payload that is not fragmented on Ethernet
+    const std::size_t MAX_DATAGRAM = 1472;
+    //! Timeout of poll() in milliseconds, bounds the reaction to stop
+    const int POLL_TIMEOUT = 100;
+
+    /**
+     * @brief Command abbreviations with the names the receiver replies with
+     *
+     * Covers all commands configureRx() sends. Get commands are accepted with
+     * 'g' in place of the leading 's'.
+     */
+    const std::pair<const char*, const char*> COMMANDS[] = {
+        {"sao", "AntennaOffset"},       {"sat", "AntennaType"},
+        {"scs", "COMSettings"},         {"sdio", "DataInOut"},
+        {"sga", "GNSSAttitude"},        {"sgd", "GeodeticDatum"},
+        {"sial", "INSAntLeverArm"},     {"siih", "INSInitialHeading"},
+        {"sinc", "INSNavConfig"},       {"sipl", "INSPOILeverArm"},
+        {"siss", "IPServerSettings"},   {"sism", "INSStandstillMode"},
+        {"sivl", "INSVSMLeverArm"},     {"sno", "NMEAOutput"},
+        {"snti", "NMEATalkerID"},       {"sntp", "NTPServer"},
+        {"snts", "NTRIPSettings"},      {"sntt", "NTRIPTLSSettings"},
+        {"sso", "SBFOutput"},           {"sto", "AttitudeOffset"}};
+
+    uint64_t unixTimeMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    uint64_t unixTimeNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    std::string trim(const std::string& s)
+    {
+        std::size_t begin = s.find_first_not_of(" \t\"");
+        if (begin == std::string::npos)
+            return std::string();
+        std::size_t end = s.find_last_not_of(" \t\"");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    //! Splits a command line at its commas, fields trimmed
+    std::vector<std::string> split(const std::string& line)
+    {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+            fields.push_back(trim(field));
+        return fields;
+    }
+
+    //! Period in milliseconds of a rate in Hz, 0 if disabled
+    uint64_t periodOf(double rate)
+    {
+        if (rate <= 0.0)
+            return 0;
+        return std::max<uint64_t>(1, static_cast<uint64_t>(1000.0 / rate + 0.5));
+    }
+
+    void setNonBlocking(int fd)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+} // namespace
+
+namespace rx_simulator {
+
+    Session::Session(LogSink* logger, int fd, const std::string& name,
+                     const std::string& prompt, const Options& options,
+                     const sockaddr_storage* destination,
+                     socklen_t destination_length) :
+        logger_(logger),
+        fd_(fd), name_(name), prompt_(prompt),
+        send_timestamps_(options.send_timestamps),
+        max_queued_(options.max_queued), destination_length_(destination_length),
+        sbf_on_(options.stream_on_connect || destination),
+        nmea_on_(options.stream_on_connect || destination)
+    {
+        std::memset(&destination_, 0, sizeof(destination_));
+        if (destination)
+            std::memcpy(&destination_, destination, destination_length);
+        setNonBlocking(fd_);
+        logger_->log(LogLevel::INFO, "Opened " + name_);
+        // Like the receiver, a TCP client is greeted with the prompt
+        if (!prompt_.empty() && name_.compare(0, 3, "TCP") == 0)
+            reply("");
+        if (!prompt_.empty())
+            reader_ = std::thread(&Session::readLoop, this);
+        writer_ = std::thread(&Session::writeLoop, this);
+    }
+
+    Session::~Session()
+    {
+        stop_ = true;
+        queue_condition_.notify_all();
+        if (reader_.joinable())
+            reader_.join();
+        if (writer_.joinable())
+            writer_.join();
+        close(fd_);
+        logger_->log(LogLevel::INFO, "Closed " + name_);
+    }
+
+    void Session::push(const Chunk& chunk, bool nmea)
+    {
+        if (closed_ || !(nmea ? nmea_on_ : sbf_on_))
+            return;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (queue_.size() >= max_queued_)
+            {
+                ++dropped_chunks_;
+                return;
+            }
+            queue_.push_back(chunk);
+        }
+        queue_condition_.notify_one();
+    }
+
+    void Session::readLoop()
+    {
+        std::string line;
+        char last = '\0';
+        char buffer[1024];
+        while (!stop_ && !closed_)
+        {
+            pollfd pfd = {fd_, POLLIN, 0};
+            int ready = poll(&pfd, 1, POLL_TIMEOUT);
+            if (ready <= 0)
+                continue;
+            ssize_t n = read(fd_, buffer, sizeof(buffer));
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                continue;
+            if (n <= 0)
+            {
+                closed_ = true;
+                break;
+            }
+            for (ssize_t i = 0; i < n; ++i)
+            {
+                char c = buffer[i];
+                // A line feed after a carriage return ends no second line
+                if (c == '\n' && last == '\r')
+                {
+                    last = c;
+                    continue;
+                }
+                last = c;
+                if (c == '\r' || c == '\n')
+                {
+                    handleCommand(line);
+                    line.clear();
+                } else if (line.size() < 4096)
+                    line += c;
+            }
+        }
+        queue_condition_.notify_all();
+    }
+
+    void Session::handleCommand(const std::string& raw)
+    {
+        std::string line = trim(raw);
+        // Empty lines and the escape sequence of the driver yield the prompt
+        if (line.empty() || line.find_first_not_of('S') == std::string::npos)
+        {
+            reply("");
+            return;
+        }
+        // Echoed NMEA, e.g. velocity input, is not answered
+        if (line[0] == '$')
+            return;
+
+        std::vector<std::string> fields = split(line);
+        std::string command = fields[0];
+        std::string arguments;
+        for (std::size_t i = 1; i < fields.size(); ++i)
+            arguments += ", " + fields[i];
+
+        if (command == "login" || command == "logout")
+        {
+            reply("$R: " + line + "\r\n  " + command + arguments + "\r\n");
+            return;
+        }
+        if (command == "lif")
+        {
+            reply("$R; " + line + "\r\n---->\r\n  Rx simulator\r\n");
+            return;
+        }
+
+        const char* long_name = nullptr;
+        bool get = false;
+        for (const auto& entry : COMMANDS)
+        {
+            if (command == entry.first)
+                long_name = entry.second;
+            else if (command[0] == 'g' &&
+                     command.substr(1) == std::string(entry.first).substr(1))
+            {
+                long_name = entry.second;
+                get = true;
+            }
+        }
+        if (!long_name)
+        {
+            reply("$R? " + line + ": Invalid command!\r\n");
+            return;
+        }
+
+        // sso and sno with stream, port, messages and interval switch output
+        if (!get && (command == "sso" || command == "sno") && fields.size() >= 5)
+        {
+            std::set<std::string>& streams =
+                (command == "sso") ? sbf_streams_ : nmea_streams_;
+            bool enable = (fields[3] != "none") && (fields[4] != "off");
+            if (fields[1] == "all")
+            {
+                streams.clear();
+                if (enable)
+                    streams.insert(fields[1]);
+            } else if (enable)
+                streams.insert(fields[1]);
+            else
+                streams.erase(fields[1]);
+            ((command == "sso") ? sbf_on_ : nmea_on_) = !streams.empty();
+        }
+        std::string setting = std::string(long_name) + arguments;
+        // The receiver drops the separator of message lists in the reply
+        for (char& c : setting)
+        {
+            if (c == '+')
+                c = ' ';
+        }
+        reply("$R: " + line + "\r\n  " + setting + "\r\n");
+    }
+
+    void Session::reply(const std::string& text)
+    {
+        std::string message = text + prompt_ + ">";
+        writeAll(reinterpret_cast<const uint8_t*>(message.data()),
+                 message.size());
+    }
+
+    bool Session::writeAll(const uint8_t* data, std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (destination_length_ > 0)
+        {
+            // Datagrams that cannot be delivered are lost, as with the receiver
+            for (std::size_t pos = 0; pos < size; pos += MAX_DATAGRAM)
+            {
+                std::size_t length = std::min(MAX_DATAGRAM, size - pos);
+                if (sendto(fd_, data + pos, length, 0,
+                           reinterpret_cast<const sockaddr*>(&destination_),
+                           destination_length_) == static_cast<ssize_t>(length))
+                    sent_bytes_ += length;
+            }
+            return true;
+        }
+        while (size > 0)
+        {
+            if (stop_ || closed_)
+                return false;
+            ssize_t n = write(fd_, data, size);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    closed_ = true;
+                    return false;
+                }
+                pollfd pfd = {fd_, POLLOUT, 0};
+                poll(&pfd, 1, POLL_TIMEOUT);
+                continue;
+            }
+            data += n;
+            size -= n;
+            sent_bytes_ += n;
+        }
+        return true;
+    }
+
+    void Session::writeLoop()
+    {
+        std::vector<uint8_t> stamp;
+        while (true)
+        {
+            Chunk chunk;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                queue_condition_.wait(lock, [this]() {
+                    return stop_ || closed_ || !queue_.empty();
+                });
+                if (stop_ || closed_)
+                    return;
+                chunk = queue_.front();
+                queue_.pop_front();
+            }
+            if (send_timestamps_)
+            {
+                // Taken right before the write, after queueing delays
+                stamp.clear();
+                uint64_t now = unixTimeNs();
+                io_comm_rx::StreamGenerator::comment(
+                    "send_time_ns=" + std::to_string(now),
+                    io_comm_rx::StreamGenerator::gpsTime(now / 1000000), stamp);
+                if (!writeAll(stamp.data(), stamp.size()))
+                    return;
+            }
+            if (!writeAll(chunk->data(), chunk->size()))
+                return;
+        }
+    }
+
+    RxSimulator::RxSimulator(LogSink* logger, const Options& options) :
+        logger_(logger), options_(options)
+    {
+    }
+
+    RxSimulator::~RxSimulator()
+    {
+        stop_ = true;
+        if (acceptor_.joinable())
+            acceptor_.join();
+        sessions_.clear();
+        if (listener_ >= 0)
+            close(listener_);
+        if (pty_slave_ >= 0)
+            close(pty_slave_);
+        if (!options_.pty_link.empty())
+            unlink(options_.pty_link.c_str());
+    }
+
+    bool RxSimulator::run()
+    {
+        if (options_.tcp_port == 0 && !options_.pty &&
+            options_.udp_destination.empty())
+        {
+            logger_->log(LogLevel::ERROR, "No interface to simulate");
+            return false;
+        }
+        if ((options_.tcp_port != 0 && !openTcp()) ||
+            (options_.pty && !openPty()) ||
+            (!options_.udp_destination.empty() && !openUdp()))
+            return false;
+        if (listener_ >= 0)
+            acceptor_ = std::thread(&RxSimulator::acceptLoop, this);
+
+        last_statistics_ = unixTimeMs();
+        bool ok = options_.input.empty() ? (generate(), true) : replay();
+
+        stop_ = true;
+        if (acceptor_.joinable())
+            acceptor_.join();
+        logStatistics();
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions_.clear();
+        return ok;
+    }
+
+    bool RxSimulator::openTcp()
+    {
+        listener_ = socket(AF_INET6, SOCK_STREAM, 0);
+        if (listener_ < 0)
+        {
+            logger_->log(LogLevel::ERROR, "Could not create TCP socket: " +
+                                              std::string(strerror(errno)));
+            return false;
+        }
+        int on = 1;
+        int off = 0;
+        setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        // Dual stack, such that IPv4 clients connect as well
+        setsockopt(listener_, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+        sockaddr_in6 address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin6_family = AF_INET6;
+        address.sin6_addr = in6addr_any;
+        address.sin6_port = htons(options_.tcp_port);
+        if (bind(listener_, reinterpret_cast<sockaddr*>(&address),
+                 sizeof(address)) < 0 ||
+            listen(listener_, 8) < 0)
+        {
+            logger_->log(LogLevel::ERROR,
+                         "Could not listen on TCP port " +
+                             std::to_string(options_.tcp_port) + ": " +
+                             std::string(strerror(errno)));
+            return false;
+        }
+        setNonBlocking(listener_);
+        logger_->log(LogLevel::INFO, "Listening on TCP port " +
+                                         std::to_string(options_.tcp_port));
+        return true;
+    }
+
+    bool RxSimulator::openPty()
+    {
+        int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0)
+        {
+            logger_->log(LogLevel::ERROR, "Could not open pseudo terminal: " +
+                                              std::string(strerror(errno)));
+            if (master >= 0)
+                close(master);
+            return false;
+        }
+        std::string slave_name(ptsname(master));
+        // Holding the slave open keeps the master readable while no client is
+        // connected
+        pty_slave_ = open(slave_name.c_str(), O_RDWR | O_NOCTTY);
+        if (pty_slave_ < 0)
+        {
+            logger_->log(LogLevel::ERROR,
+                         "Could not open " + slave_name + ": " + strerror(errno));
+            close(master);
+            return false;
+        }
+        termios tio;
+        tcgetattr(pty_slave_, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(pty_slave_, TCSANOW, &tio);
+
+        std::string name = "pseudo terminal " + slave_name;
+        if (!options_.pty_link.empty())
+        {
+            struct stat link_stat;
+            if (lstat(options_.pty_link.c_str(), &link_stat) == 0 &&
+                S_ISLNK(link_stat.st_mode))
+                unlink(options_.pty_link.c_str());
+            if (symlink(slave_name.c_str(), options_.pty_link.c_str()) < 0)
+            {
+                logger_->log(LogLevel::ERROR, "Could not create link " +
+                                                  options_.pty_link + ": " +
+                                                  strerror(errno));
+                options_.pty_link.clear();
+                close(master);
+                return false;
+            }
+            name += " (" + options_.pty_link + ")";
+        }
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions_.emplace_back(
+            new Session(logger_, master, name, options_.pty_prompt, options_));
+        return true;
+    }
+
+    bool RxSimulator::openUdp()
+    {
+        const std::string& destination = options_.udp_destination;
+        std::size_t colon = destination.rfind(':');
+        if (colon == std::string::npos)
+        {
+            logger_->log(LogLevel::ERROR, "UDP destination " + destination +
+                                              " is not given as host:port");
+            return false;
+        }
+        std::string host = destination.substr(0, colon);
+        std::string port = destination.substr(colon + 1);
+        if (host.size() > 1 && host.front() == '[' && host.back() == ']')
+            host = host.substr(1, host.size() - 2);
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        int error = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+        if (error != 0)
+        {
+            logger_->log(LogLevel::ERROR, "Could not resolve " + destination +
+                                              ": " + gai_strerror(error));
+            return false;
+        }
+        int fd = socket(result->ai_family, SOCK_DGRAM, 0);
+        if (fd < 0)
+        {
+            logger_->log(LogLevel::ERROR, "Could not create UDP socket: " +
+                                              std::string(strerror(errno)));
+            freeaddrinfo(result);
+            return false;
+        }
+        sockaddr_storage address;
+        std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+        socklen_t length = result->ai_addrlen;
+        freeaddrinfo(result);
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions_.emplace_back(new Session(logger_, fd, "UDP to " + destination,
+                                           "", options_, &address, length));
+        return true;
+    }
+
+    void RxSimulator::acceptLoop()
+    {
+        while (!stop_)
+        {
+            pollfd pfd = {listener_, POLLIN, 0};
+            if (poll(&pfd, 1, POLL_TIMEOUT) <= 0)
+                continue;
+            sockaddr_storage address;
+            socklen_t length = sizeof(address);
+            int fd =
+                accept(listener_, reinterpret_cast<sockaddr*>(&address), &length);
+            if (fd < 0)
+                continue;
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            char host[NI_MAXHOST] = "?";
+            char port[NI_MAXSERV] = "?";
+            getnameinfo(reinterpret_cast<sockaddr*>(&address), length, host,
+                        sizeof(host), port, sizeof(port),
+                        NI_NUMERICHOST | NI_NUMERICSERV);
+            // The receiver serves its IP ports IP10 to IP19 in turn
+            std::string prompt = "IP1" + std::to_string(connections_++ % 10);
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            sessions_.emplace_back(new Session(
+                logger_, fd,
+                "TCP client " + std::string(host) + ":" + port + " on " + prompt,
+                prompt, options_));
+        }
+    }
+
+    void RxSimulator::generate()
+    {
+        enum Group
+        {
+            PVT,
+            IMU,
+            MEASUREMENTS,
+            STATUS,
+            NMEA,
+            GROUPS
+        };
+        const uint64_t periods[GROUPS] = {
+            periodOf(options_.pvt_rate), periodOf(options_.imu_rate),
+            periodOf(options_.meas_rate), periodOf(options_.status_rate),
+            periodOf(options_.nmea_rate)};
+        io_comm_rx::StreamGenerator generator(
+            options_.satellites, options_.signals,
+            periods[PVT] ? static_cast<uint32_t>(periods[PVT]) : 100, false,
+            options_.ins);
+
+        // Epochs fall on full multiples of the period, as with the receiver
+        uint64_t due[GROUPS];
+        uint64_t now = unixTimeMs();
+        for (int g = 0; g < GROUPS; ++g)
+            due[g] = periods[g] ? (now / periods[g] + 1) * periods[g] : UINT64_MAX;
+
+        std::vector<uint8_t> sbf;
+        std::vector<uint8_t> nmea;
+        while (!stop_)
+        {
+            uint64_t next = *std::min_element(due, due + GROUPS);
+            if (next == UINT64_MAX)
+            {
+                logger_->log(LogLevel::ERROR, "All rates are zero");
+                return;
+            }
+            if (!sleepUntil(next))
+                return;
+            now = unixTimeMs();
+
+            generator.setTime(io_comm_rx::StreamGenerator::gpsTime(next));
+            for (int g = 0; g < GROUPS; ++g)
+            {
+                if (due[g] != next)
+                    continue;
+                switch (g)
+                {
+                case PVT:
+                    generator.pvt(sbf);
+                    break;
+                case IMU:
+                    generator.imu(sbf);
+                    break;
+                case MEASUREMENTS:
+                    generator.measurements(sbf);
+                    break;
+                case STATUS:
+                    generator.status(sbf);
+                    break;
+                case NMEA:
+                    generator.nmea(nmea);
+                    break;
+                }
+                due[g] += periods[g];
+                if (now >= due[g])
+                {
+                    ++late_;
+                    // Far behind, e.g. after suspension: skip to the present
+                    if (now >= due[g] + 1000)
+                        due[g] = (now / periods[g] + 1) * periods[g];
+                }
+            }
+            broadcast(std::move(sbf), std::move(nmea));
+            sbf.clear();
+            nmea.clear();
+            logStatisticsPeriodically();
+        }
+    }
+
+    bool RxSimulator::replay()
+    {
+        std::unique_ptr<io_comm_rx::DecompressingReader> decompressor;
+        std::ifstream file;
+        bool first_pass = true;
+        // Unix time the first block of the pass is sent at
+        uint64_t start = unixTimeMs();
+        // Unix time the last block was sent at, and the last gap between times
+        uint64_t last_sent = start;
+        uint64_t last_gap = 100;
+
+        std::vector<uint8_t> buffer;
+        std::vector<uint8_t> sbf;
+        std::vector<uint8_t> nmea;
+        uint64_t pending_time = 0;
+        while (!stop_)
+        {
+            // Each pass continues after the last one in time
+            try
+            {
+                if (io_comm_rx::DecompressingReader::isCompressed(options_.input))
+                    decompressor.reset(
+                        new io_comm_rx::DecompressingReader(options_.input));
+                else
+                {
+                    file.close();
+                    file.clear();
+                    file.open(options_.input, std::ios::binary);
+                    if (!file)
+                        throw std::runtime_error("could not open file");
+                }
+            } catch (const std::runtime_error& e)
+            {
+                logger_->log(LogLevel::ERROR, "Could not read " + options_.input +
+                                                  ": " + e.what());
+                return false;
+            }
+            if (!first_pass)
+            {
+                logger_->log(LogLevel::DEBUG, "Replaying " + options_.input +
+                                                  " again");
+                start = last_sent + last_gap;
+            }
+            bool timed = false;
+            uint64_t t0 = 0;
+            uint64_t last_time = 0;
+            Framer framer(logger_);
+            buffer.clear();
+
+            while (!stop_)
+            {
+                std::size_t size = buffer.size();
+                buffer.resize(size + 65536);
+                std::size_t read_size = 0;
+                if (decompressor)
+                    read_size = decompressor->read(buffer.data() + size, 65536);
+                else
+                {
+                    file.read(reinterpret_cast<char*>(buffer.data() + size),
+                              65536);
+                    read_size = file.gcount();
+                }
+                buffer.resize(size + read_size);
+                if (read_size == 0)
+                    break;
+
+                const uint8_t* data = buffer.data();
+                std::size_t count = buffer.size();
+                Frame frame;
+                while (!stop_ && framer.next(data, count, frame))
+                {
+                    if (frame.type == FrameType::NMEA)
+                    {
+                        nmea.insert(nmea.end(), frame.data,
+                                    frame.data + frame.size);
+                        continue;
+                    }
+                    uint32_t tow;
+                    uint16_t wnc;
+                    std::memcpy(&tow, frame.data + 8, sizeof(tow));
+                    std::memcpy(&wnc, frame.data + 12, sizeof(wnc));
+                    std::size_t pos = sbf.size();
+                    sbf.insert(sbf.end(), frame.data, frame.data + frame.size);
+                    // Blocks without time are sent with the preceding ones
+                    if (tow == UINT32_MAX || wnc == UINT16_MAX)
+                        continue;
+
+                    uint64_t time = wnc * MS_PER_WEEK + tow;
+                    // Time jumps, e.g. between concatenated logs, restart pacing
+                    if (!timed || time < last_time || time > last_time + 60000)
+                    {
+                        if (timed)
+                            start = pending_time + last_gap;
+                        t0 = time;
+                        timed = true;
+                    } else if (time > last_time)
+                        last_gap = time - last_time;
+                    last_time = time;
+                    uint64_t send_time = start + (time - t0);
+
+                    if (send_time != pending_time && (pos > 0 || !nmea.empty()))
+                    {
+                        // Flush the blocks of the preceding epoch first
+                        std::vector<uint8_t> block(sbf.begin() + pos, sbf.end());
+                        sbf.resize(pos);
+                        if (!sleepUntil(pending_time))
+                            return true;
+                        broadcast(std::move(sbf), std::move(nmea));
+                        sbf = std::move(block);
+                        nmea.clear();
+                        pos = 0;
+                        last_sent = pending_time;
+                        logStatisticsPeriodically();
+                    }
+                    pending_time = send_time;
+
+                    // Restamp to the time it is sent
+                    uint64_t gps_time =
+                        io_comm_rx::StreamGenerator::gpsTime(send_time);
+                    tow = static_cast<uint32_t>(gps_time % MS_PER_WEEK);
+                    wnc = static_cast<uint16_t>(gps_time / MS_PER_WEEK);
+                    uint8_t* block = sbf.data() + pos;
+                    std::memcpy(block + 8, &tow, sizeof(tow));
+                    std::memcpy(block + 12, &wnc, sizeof(wnc));
+                    uint16_t crc = compute16CCITT(block + 4, frame.size - 4);
+                    std::memcpy(block + 2, &crc, sizeof(crc));
+                }
+                buffer.erase(buffer.begin(),
+                             buffer.begin() + (data - buffer.data()));
+            }
+            if (!sbf.empty() || !nmea.empty())
+            {
+                if (!sleepUntil(pending_time))
+                    return true;
+                broadcast(std::move(sbf), std::move(nmea));
+                sbf.clear();
+                nmea.clear();
+                last_sent = pending_time;
+            }
+            if (!timed)
+            {
+                logger_->log(LogLevel::ERROR,
+                             options_.input + " holds no SBF blocks with time");
+                return false;
+            }
+            first_pass = false;
+        }
+        return true;
+    }
+
+    bool RxSimulator::sleepUntil(uint64_t unix_time)
+    {
+        // Sleeps in slices, such that stop() takes effect soon
+        while (!stop_)
+        {
+            uint64_t now = unixTimeMs();
+            if (now >= unix_time)
+                return true;
+            uint64_t slice = std::min<uint64_t>(unix_time - now, POLL_TIMEOUT);
+            std::this_thread::sleep_until(
+                std::chrono::system_clock::time_point(
+                    std::chrono::milliseconds(now + slice)));
+        }
+        return false;
+    }
+
+    void RxSimulator::broadcast(std::vector<uint8_t>&& sbf,
+                                std::vector<uint8_t>&& nmea)
+    {
+        bytes_ += sbf.size() + nmea.size();
+        Chunk sbf_chunk =
+            std::make_shared<const std::vector<uint8_t>>(std::move(sbf));
+        Chunk nmea_chunk =
+            std::make_shared<const std::vector<uint8_t>>(std::move(nmea));
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto it = sessions_.begin(); it != sessions_.end();)
+        {
+            if ((*it)->closed())
+            {
+                it = sessions_.erase(it);
+                continue;
+            }
+            if (!sbf_chunk->empty())
+                (*it)->push(sbf_chunk, false);
+            if (!nmea_chunk->empty())
+                (*it)->push(nmea_chunk, true);
+            ++it;
+        }
+    }
+
+    void RxSimulator::logStatisticsPeriodically()
+    {
+        uint64_t now = unixTimeMs();
+        if (now < last_statistics_ + 10000)
+            return;
+        last_statistics_ = now;
+        logStatistics();
+    }
+
+    void RxSimulator::logStatistics()
+    {
+        std::stringstream ss;
+        ss << "Sent " << bytes_ << " bytes, " << late_ << " late epochs";
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (const auto& session : sessions_)
+        {
+            ss << "; " << session->name() << ": " << session->sentBytes()
+               << " bytes written, " << session->droppedChunks() << " dropped";
+        }
+        logger_->log(LogLevel::INFO, ss.str());
+    }
+} // namespace rx_simulator
+
+namespace {
+    rx_simulator::RxSimulator* g_simulator = nullptr;
+
+    void handleSignal(int) { if (g_simulator) g_simulator->stop(); }
+
+    void printUsage(const char* name)
+    {
+        std::cerr
+            << "Usage: " << name << " [options]\n"
+            << "  --tcp <port>          TCP port, 0 for none (default 28784)\n"
+            << "  --pty                 Open a pseudo terminal\n"
+            << "  --pty-link <path>     Symbolic link to the pseudo terminal\n"
+            << "  --pty-prompt <port>   Port name in its prompt (default COM1)\n"
+            << "  --udp <host:port>     Also stream to a UDP destination\n"
+            << "  --input <file>        Replay an SBF log (.sbf, .gz, .zst)\n"
+            << "  --ins                 Simulate an INS\n"
+            << "  --satellites <n>      Tracked satellites (default 24)\n"
+            << "  --signals <n>         Signals per satellite (default 2)\n"
+            << "  --pvt-rate <Hz>       PVT blocks (default 10)\n"
+            << "  --imu-rate <Hz>       ExtSensorMeas (default 0)\n"
+            << "  --meas-rate <Hz>      MeasEpoch and ChannelStatus (default 1)\n"
+            << "  --status-rate <Hz>    Status blocks (default 1)\n"
+            << "  --nmea-rate <Hz>      NMEA sentences (default 1)\n"
+            << "  --stream-on-connect   Stream without sso and sno commands\n"
+            << "  --send-timestamps     Precede writes by a Comment block with\n"
+            << "                        the send time\n";
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    rx_simulator::Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        bool has_value = (i + 1 < argc);
+        try
+        {
+            if (arg == "--tcp" && has_value)
+                options.tcp_port = static_cast<uint16_t>(std::stoul(argv[++i]));
+            else if (arg == "--pty")
+                options.pty = true;
+            else if (arg == "--pty-link" && has_value)
+            {
+                options.pty = true;
+                options.pty_link = argv[++i];
+            } else if (arg == "--pty-prompt" && has_value)
+                options.pty_prompt = argv[++i];
+            else if (arg == "--udp" && has_value)
+                options.udp_destination = argv[++i];
+            else if (arg == "--input" && has_value)
+                options.input = argv[++i];
+            else if (arg == "--ins")
+                options.ins = true;
+            else if (arg == "--satellites" && has_value)
+                options.satellites = static_cast<uint8_t>(
+                    std::min(std::stoul(argv[++i]), 72ul));
+            else if (arg == "--signals" && has_value)
+                options.signals = static_cast<uint8_t>(
+                    std::max(1ul, std::min(std::stoul(argv[++i]), 3ul)));
+            else if (arg == "--pvt-rate" && has_value)
+                options.pvt_rate = std::stod(argv[++i]);
+            else if (arg == "--imu-rate" && has_value)
+                options.imu_rate = std::stod(argv[++i]);
+            else if (arg == "--meas-rate" && has_value)
+                options.meas_rate = std::stod(argv[++i]);
+            else if (arg == "--status-rate" && has_value)
+                options.status_rate = std::stod(argv[++i]);
+            else if (arg == "--nmea-rate" && has_value)
+                options.nmea_rate = std::stod(argv[++i]);
+            else if (arg == "--stream-on-connect")
+                options.stream_on_connect = true;
+            else if (arg == "--send-timestamps")
+                options.send_timestamps = true;
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&)
+        {
+            std::cerr << "Invalid value for " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    StreamLogSink logger(std::cerr);
+    rx_simulator::RxSimulator simulator(&logger, options);
+    g_simulator = &simulator;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    // Closed connections are detected by the failing write instead
+    std::signal(SIGPIPE, SIG_IGN);
+    bool ok = simulator.run();
+    g_simulator = nullptr;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,321 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/log_sink.hpp>
+#include <septentrio_gnss_driver/communication/parse_queue.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+#include <septentrio_gnss_driver/parsers/framer.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+/**
+ * @file parse_queue_test.cpp
+ * @date 19/10/26
+ * @brief Checks that the queue between the reading and the parsing thread hands
+ * only complete SBF blocks and NMEA sentences to the parser with each drop
+ * policy
+ */
+
+namespace {
+
+    using io_comm_rx::DropPolicy;
+    using io_comm_rx::ParseQueue;
+    using io_comm_rx::RxStatistics;
+
+    //! Reply of the Rx to a command, which is not part of any frame
+    const std::string COMMAND_REPLY = "$R: gecm\r\n  IP10\r\nIP10>";
+    //! A command reply follows every that many epochs
+    const uint32_t REPLY_INTERVAL = 5;
+    //! The parser falls behind and catches up after every that many epochs
+    const uint32_t BATCH_EPOCHS = 64;
+    //! Number of generated epochs
+    const uint32_t EPOCHS = 1000;
+    //! Capacity of the queue in bytes
+    const std::size_t CAPACITY = 65536;
+    //! Reads are 1 to that many bytes long
+    const std::size_t MAX_READ = 4096;
+
+    //! Generated stream as read from the Rx
+    struct Input
+    {
+        std::vector<uint8_t> bytes;
+        //! Offsets after which the parser catches up, at epoch boundaries
+        std::vector<std::size_t> batch_ends;
+        //! Number of SBF blocks per TOW
+        std::map<uint32_t, uint32_t> blocks;
+        //! Number of command replies
+        uint32_t replies = 0;
+        //! Size of the largest epoch in bytes
+        std::size_t largest_epoch = 0;
+    };
+
+    //! What reached the parser
+    struct Received
+    {
+        uint64_t reads = 0;
+        uint64_t bytes = 0;
+        //! Bytes outside of SBF blocks and NMEA sentences
+        std::string unframed;
+        //! Number of SBF blocks per TOW
+        std::map<uint32_t, uint32_t> blocks;
+    };
+
+    //! Number of command replies in data
+    template <typename Iterator>
+    uint32_t countReplies(Iterator begin, Iterator end)
+    {
+        uint32_t replies = 0;
+        while ((begin = std::search(begin, end, COMMAND_REPLY.begin(),
+                                    COMMAND_REPLY.end())) != end)
+        {
+            ++replies;
+            begin += COMMAND_REPLY.size();
+        }
+        return replies;
+    }
+
+    class ParseQueueTest : public ::testing::Test
+    {
+    protected:
+        ParseQueueTest() : logger_(std::cerr, LogLevel::ERROR) {}
+
+        void SetUp() override
+        {
+            io_comm_rx::StreamGenerator generator;
+            for (uint32_t i = 1; i <= EPOCHS; ++i)
+            {
+                std::size_t start = input_.bytes.size();
+                generator.epoch(input_.bytes);
+                input_.largest_epoch = std::max(input_.largest_epoch,
+                                                input_.bytes.size() - start);
+                if ((i % REPLY_INTERVAL) == 0)
+                {
+                    input_.bytes.insert(input_.bytes.end(),
+                                        COMMAND_REPLY.begin(),
+                                        COMMAND_REPLY.end());
+                    ++input_.replies;
+                }
+                if (((i % BATCH_EPOCHS) == 0) || (i == EPOCHS))
+                    input_.batch_ends.push_back(input_.bytes.size());
+            }
+            Framer framer(&logger_);
+            const uint8_t* data = input_.bytes.data();
+            std::size_t count = input_.bytes.size();
+            Frame frame;
+            while (framer.next(data, count, frame))
+                if (frame.type == FrameType::SBF)
+                    ++input_.blocks[parsing_utilities::getTow(frame.data)];
+            // Only then an epoch is dropped before its last block is read
+            ASSERT_GE(CAPACITY, 2 * input_.largest_epoch);
+
+            // Reads of 1 to MAX_READ bytes split frames, the last read of each
+            // batch ends at the batch end
+            uint32_t state = 12345;
+            std::size_t pos = 0;
+            for (std::size_t end : input_.batch_ends)
+            {
+                while (pos < end)
+                {
+                    state = state * 1103515245 + 12345;
+                    std::size_t n = 1 + (state >> 8) % MAX_READ;
+                    n = std::min(n, end - pos);
+                    sizes_.push_back(n);
+                    pos += n;
+                }
+            }
+        }
+
+        //! Checks that a read handed to the parser holds complete frames only,
+        //! besides the bytes outside of frames, which are collected since a
+        //! command reply may be split across reads
+        void checkRead(const std::vector<uint8_t>& data, Received& received)
+        {
+            Framer framer(&logger_);
+            const uint8_t* next = data.data();
+            std::size_t count = data.size();
+            Frame frame;
+            while (true)
+            {
+                const uint8_t* start = next;
+                bool found = framer.next(next, count, frame);
+                const uint8_t* end = found ? frame.data : next;
+                received.unframed.append(start, end);
+                if (!found)
+                    break;
+                if (frame.type == FrameType::SBF)
+                    ++received.blocks[parsing_utilities::getTow(frame.data)];
+            }
+            // The Framer keeps a last byte that could start a frame, only $ can
+            EXPECT_FALSE((count > 1) || ((count == 1) && (*next == '$')))
+                << "incomplete frame at the end of read " << received.reads;
+            EXPECT_EQ(0u, framer.crcErrors())
+                << "SBF block with wrong CRC in read " << received.reads;
+            received.unframed.append(next, next + count);
+        }
+
+        //! The parser catches up at the end of each batch, the queue drops in
+        //! between
+        Received runDropping(DropPolicy policy, RxStatistics::Snapshot& snapshot)
+        {
+            Received received;
+            RxStatistics statistics;
+            ParseQueue queue(&logger_, &statistics, CAPACITY, policy);
+            std::vector<uint8_t> data;
+            uint64_t recv_time;
+            std::size_t pos = 0;
+            auto batch_end = input_.batch_ends.begin();
+            for (std::size_t n : sizes_)
+            {
+                queue.push(pos, input_.bytes.data() + pos, n);
+                pos += n;
+                if (pos != *batch_end)
+                    continue;
+                ++batch_end;
+                data.clear();
+                while (queue.pop(data, recv_time, std::chrono::milliseconds(0)))
+                {
+                    checkRead(data, received);
+                    ++received.reads;
+                    received.bytes += data.size();
+                    data.clear();
+                }
+            }
+            statistics.snapshot(snapshot);
+            return received;
+        }
+
+        //! Checks what reached the parser with a dropping policy
+        void checkDropping(const Received& received,
+                           const RxStatistics::Snapshot& snapshot)
+        {
+            uint32_t replies =
+                countReplies(received.unframed.begin(), received.unframed.end());
+            EXPECT_EQ(input_.replies, replies) << "command replies dropped";
+            // Anything else would be part of a frame cut by the queue
+            EXPECT_EQ(replies * COMMAND_REPLY.size(), received.unframed.size())
+                << "bytes of partial frames received";
+            EXPECT_EQ(input_.bytes.size(),
+                      received.bytes + snapshot.dropped_bytes)
+                << "bytes received and dropped do not add up to the bytes read";
+            // The parser falls behind, otherwise nothing would be checked
+            EXPECT_GT(snapshot.dropped_frames, 0u);
+        }
+
+        StreamLogSink logger_;
+        Input input_;
+        std::vector<std::size_t> sizes_;
+    };
+
+    //! The parser runs in its own thread as in the driver. A single read
+    //! larger than the queue, the whole stream, follows the reads.
+    TEST_F(ParseQueueTest, BlockPassesStreamUnchanged)
+    {
+        RxStatistics statistics;
+        ParseQueue queue(&logger_, &statistics, CAPACITY, DropPolicy::BLOCK);
+        const std::size_t total = 2 * input_.bytes.size();
+        std::vector<uint8_t> output;
+        output.reserve(total);
+        bool timed_out = false;
+        std::thread parser([&]() {
+            std::vector<uint8_t> data;
+            uint64_t recv_time;
+            while (output.size() < total)
+            {
+                data.clear();
+                if (!queue.pop(data, recv_time, std::chrono::seconds(10)))
+                {
+                    timed_out = true;
+                    break;
+                }
+                output.insert(output.end(), data.begin(), data.end());
+            }
+        });
+        std::size_t pos = 0;
+        for (std::size_t n : sizes_)
+        {
+            if (!queue.push(pos, input_.bytes.data() + pos, n))
+                break;
+            pos += n;
+        }
+        queue.push(pos, input_.bytes.data(), input_.bytes.size());
+        parser.join();
+        queue.close();
+
+        RxStatistics::Snapshot snapshot;
+        statistics.snapshot(snapshot);
+        ASSERT_FALSE(timed_out) << "parser received nothing for 10 s";
+        // Reads are passed on as they are, the parser carries incomplete
+        // frames itself, hence the stream has to arrive unchanged
+        ASSERT_EQ(total, output.size());
+        EXPECT_TRUE(std::equal(input_.bytes.begin(), input_.bytes.end(),
+                               output.begin()));
+        EXPECT_TRUE(std::equal(input_.bytes.begin(), input_.bytes.end(),
+                               output.begin() + input_.bytes.size()));
+        EXPECT_EQ(0u, snapshot.dropped_bytes);
+    }
+
+    TEST_F(ParseQueueTest, DropOldestDropsWholeEpochs)
+    {
+        RxStatistics::Snapshot snapshot;
+        Received received = runDropping(DropPolicy::DROP_OLDEST, snapshot);
+        checkDropping(received, snapshot);
+        for (const auto& epoch : input_.blocks)
+        {
+            auto it = received.blocks.find(epoch.first);
+            if (it != received.blocks.end())
+                EXPECT_EQ(epoch.second, it->second)
+                    << "epoch with TOW " << epoch.first << " partially dropped";
+        }
+    }
+
+    TEST_F(ParseQueueTest, DropLowPriorityKeepsFramesComplete)
+    {
+        RxStatistics::Snapshot snapshot;
+        Received received =
+            runDropping(DropPolicy::DROP_LOW_PRIORITY, snapshot);
+        checkDropping(received, snapshot);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,251 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+// Google Test includes
+#include <gtest/gtest.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/callback_handlers.hpp>
+#include <septentrio_gnss_driver/communication/stream_generator.hpp>
+
+/**
+ * @file reorder_test.cpp
+ * @date 19/10/26
+ * @brief Checks that decoding some SBF blocks of each read ahead of the others,
+ * as with decode_priority, changes the order of decoding only
+ */
+
+namespace {
+
+    using io_comm_rx::RxStatistics;
+
+    //! Read size, as for a live Rx
+    const std::size_t READ_SIZE = 16384;
+    //! Number of generated epochs
+    const uint32_t EPOCHS = 600;
+    //! The default of decode_priority/blocks
+    const std::vector<int32_t> DEFAULT_PRIORITY = {4006, 4007, 4028, 4043, 4050,
+                                                   4225, 4226, 5905, 5906, 5907,
+                                                   5908, 5938, 5939};
+
+    /**
+     * @class LiveNode
+     * @brief Node without ROS master and bag whose messages are discarded,
+     * parsing data as read from a live Rx
+     */
+    class LiveNode : public ROSaicNodeBase
+    {
+    public:
+        LiveNode() :
+            ROSaicNodeBase(nullptr, PARAMS), handlers_(this, &settings_)
+        {
+            getOutputParams();
+            settings_.use_gnss_time = true;
+            settings_.read_from_sbf_log = false;
+            settings_.read_from_pcap = false;
+            defineMessages();
+        }
+
+        void prioritize(const std::vector<int32_t>& block_numbers)
+        {
+            handlers_.prioritize(block_numbers);
+        }
+
+        //! Parses the stream in reads of READ_SIZE bytes, an incomplete tail is
+        //! handed over again with the next read
+        void parse(const std::vector<uint8_t>& stream, std::size_t size)
+        {
+            for (std::size_t pos = 0; pos < size;)
+            {
+                std::size_t n = std::min(READ_SIZE, size - pos);
+                std::size_t consumed = n;
+                try
+                {
+                    handlers_.readCallback(0, stream.data() + pos, n);
+                } catch (std::size_t offset)
+                {
+                    if (offset > 0)
+                        consumed = offset;
+                }
+                pos += consumed;
+            }
+        }
+
+        void log(LogLevel logLevel, const std::string& s) override
+        {
+            if (logLevel >= LogLevel::WARN)
+                warnings_.push_back(s);
+        }
+
+        const std::vector<std::string>& warnings() const { return warnings_; }
+
+    private:
+        //! Everything built from PVT, attitude and status blocks is enabled
+        static const std::map<std::string, std::string> PARAMS;
+
+        //! No velocity is sent to a receiver offline
+        void sendVelocity(const std::string& velNmea) {}
+
+        //! Callbacks of the blocks and sentences the StreamGenerator outputs,
+        //! as Comm_IO::defineMessages() inserts them for PARAMS
+        void defineMessages()
+        {
+            handlers_.callbackmap_ = handlers_.insert<ReceiverTimeMsg>("5914");
+            handlers_.callbackmap_ = handlers_.insert<GpggaMsg>("$GPGGA");
+            handlers_.callbackmap_ = handlers_.insert<PVTGeodeticMsg>("4007");
+            handlers_.callbackmap_ = handlers_.insert<PosCovGeodeticMsg>("5906");
+            handlers_.callbackmap_ = handlers_.insert<VelCovGeodeticMsg>("5908");
+            handlers_.callbackmap_ = handlers_.insert<AttEulerMsg>("5938");
+            handlers_.callbackmap_ = handlers_.insert<AttCovEulerMsg>("5939");
+            handlers_.callbackmap_ = handlers_.insert<NavSatFixMsg>("NavSatFix");
+            handlers_.callbackmap_ = handlers_.insert<GPSFixMsg>("GPSFix");
+            handlers_.callbackmap_ = handlers_.insert<int32_t>("4013");
+            handlers_.callbackmap_ = handlers_.insert<int32_t>("4001");
+            handlers_.callbackmap_ =
+                handlers_.insert<PoseWithCovarianceStampedMsg>(
+                    "PoseWithCovarianceStamped");
+            handlers_.callbackmap_ =
+                handlers_.insert<DiagnosticArrayMsg>("DiagnosticArray");
+            handlers_.callbackmap_ = handlers_.insert<int32_t>("4014");
+            handlers_.callbackmap_ = handlers_.insert<int32_t>("4082");
+            handlers_.callbackmap_ = handlers_.insert<int32_t>("5902");
+        }
+
+        //! Handles decoding and message building
+        io_comm_rx::CallbackHandlers handlers_;
+        //! Warnings and errors logged
+        std::vector<std::string> warnings_;
+    };
+
+    const std::map<std::string, std::string> LiveNode::PARAMS = {
+        {"receiver_type", "gnss"},          {"publish/gpsfix", "true"},
+        {"publish/navsatfix", "true"},      {"publish/pose", "true"},
+        {"publish/diagnostics", "true"},    {"publish/pvtgeodetic", "true"},
+        {"publish/poscovgeodetic", "true"}, {"publish/velcovgeodetic", "true"},
+        {"publish/atteuler", "true"},       {"publish/attcoveuler", "true"},
+        {"publish/gpgga", "true"}};
+
+    class ReorderTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            // Only wall time is needed, which works without a ROS master
+            ros::Time::init();
+            io_comm_rx::StreamGenerator generator;
+            for (uint32_t i = 0; i < EPOCHS; ++i)
+                generator.epoch(stream_);
+            size_ = stream_.size();
+            // The parsers may look a few bytes past the end of the data
+            stream_.resize(size_ + 8, 0);
+        }
+
+        //! Parses the stream with the given SBF blocks decoded ahead
+        RxStatistics::Snapshot decode(const std::vector<int32_t>& priority,
+                                      std::vector<std::string>& warnings)
+        {
+            LiveNode node;
+            node.prioritize(priority);
+            node.parse(stream_, size_);
+            RxStatistics::Snapshot snapshot;
+            node.statistics().snapshot(snapshot);
+            warnings = node.warnings();
+            return snapshot;
+        }
+
+        //! Checks that the same blocks and sentences were decoded
+        void expectSameDecoding(const RxStatistics::Snapshot& in_order,
+                                const RxStatistics::Snapshot& reordered)
+        {
+            EXPECT_EQ(in_order.crc_failures, reordered.crc_failures);
+            EXPECT_EQ(in_order.skipped_bytes, reordered.skipped_bytes);
+            EXPECT_EQ(in_order.incomplete_carries, reordered.incomplete_carries);
+            EXPECT_EQ(in_order.nmea_checksum_failures,
+                      reordered.nmea_checksum_failures);
+            EXPECT_EQ(0u, reordered.dropped_deferred_blocks);
+
+            std::map<uint16_t, uint64_t> expected, decoded;
+            uint64_t total = 0;
+            for (const auto& block : in_order.blocks)
+            {
+                if (block.decoded > 0)
+                    expected[block.id] = block.decoded;
+                total += block.decoded;
+            }
+            for (const auto& block : reordered.blocks)
+                if (block.decoded > 0)
+                    decoded[block.id] = block.decoded;
+            EXPECT_EQ(expected, decoded);
+            // Each epoch holds at least the PVT and attitude blocks
+            EXPECT_GE(total, 5u * EPOCHS);
+        }
+
+        std::vector<uint8_t> stream_;
+        std::size_t size_ = 0;
+    };
+
+    TEST_F(ReorderTest, DefaultPriorityChangesOrderOnly)
+    {
+        std::vector<std::string> warnings;
+        RxStatistics::Snapshot in_order = decode({}, warnings);
+        RxStatistics::Snapshot reordered = decode(DEFAULT_PRIORITY, warnings);
+        expectSameDecoding(in_order, reordered);
+    }
+
+    TEST_F(ReorderTest, SplitCompositesAreCompleted)
+    {
+        std::vector<std::string> warnings;
+        RxStatistics::Snapshot in_order = decode({}, warnings);
+        // Only PVTGeodetic of /gpsfix, /navsatfix and /pose
+        RxStatistics::Snapshot reordered = decode({4007}, warnings);
+        expectSameDecoding(in_order, reordered);
+
+        std::vector<std::string> completed;
+        for (const std::string& warning : warnings)
+            if (warning.find("decode_priority/blocks holds only some") !=
+                std::string::npos)
+                completed.push_back(warning);
+        ASSERT_EQ(1u, completed.size());
+        // /gpsfix needs the most blocks, which complete the others
+        EXPECT_NE(std::string::npos, completed[0].find("/gpsfix"));
+        EXPECT_NE(std::string::npos,
+                  completed[0].find(" 5906 5908 5938 5939"));
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}